@@ -0,0 +1,129 @@
+#include <octoon/lightmap/lightmap.h>
+#include <octoon/camera/camera.h>
+#include <octoon/material/mesh_basic_material.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Bakes a Cornell box, open at the top so a directional light reaches the floor, and times
+// each stage of the lightmap: building the patches and clusters, the direct light and the
+// hierarchical radiosity solve for the indirect bounces.
+
+namespace
+{
+	using namespace octoon;
+
+	struct Quad
+	{
+		math::float3 origin;
+		math::float3 u;
+		math::float3 v;
+		math::float3 color;
+	};
+
+	// Every quad keeps its own vertices and is a subset of its own, so each gets its own color.
+	std::shared_ptr<Geometry>
+	makeCornellBox()
+	{
+		const math::float3 white(0.73f, 0.73f, 0.73f);
+		const math::float3 red(0.65f, 0.05f, 0.05f);
+		const math::float3 green(0.12f, 0.45f, 0.15f);
+
+		std::vector<Quad> quads =
+		{
+			{ math::float3(-1, 0, -1), math::float3(2, 0, 0), math::float3(0, 0, 2), white },
+			{ math::float3(-1, 0, 1), math::float3(2, 0, 0), math::float3(0, 2, 0), white },
+			{ math::float3(-1, 0, -1), math::float3(0, 0, 2), math::float3(0, 2, 0), red },
+			{ math::float3(1, 0, -1), math::float3(0, 2, 0), math::float3(0, 0, 2), green },
+		};
+
+		// A short and a tall block standing on the floor, their four sides and top.
+		auto block = [&](const math::float3& min, const math::float3& size)
+		{
+			auto max = min + size;
+			quads.push_back({ math::float3(min.x, max.y, min.z), math::float3(0, 0, size.z), math::float3(size.x, 0, 0), white });
+			quads.push_back({ math::float3(min.x, min.y, min.z), math::float3(size.x, 0, 0), math::float3(0, size.y, 0), white });
+			quads.push_back({ math::float3(min.x, min.y, max.z), math::float3(0, size.y, 0), math::float3(size.x, 0, 0), white });
+			quads.push_back({ math::float3(min.x, min.y, min.z), math::float3(0, size.y, 0), math::float3(0, 0, size.z), white });
+			quads.push_back({ math::float3(max.x, min.y, min.z), math::float3(0, 0, size.z), math::float3(0, size.y, 0), white });
+		};
+
+		block(math::float3(-0.7f, 0.0f, -0.6f), math::float3(0.6f, 0.6f, 0.6f));
+		block(math::float3(0.1f, 0.0f, -0.1f), math::float3(0.6f, 1.2f, 0.6f));
+
+		math::float3s vertices;
+		std::vector<MaterialPtr> materials;
+
+		auto mesh = std::make_shared<Mesh>();
+
+		for (std::size_t i = 0; i < quads.size(); i++)
+		{
+			auto& quad = quads[i];
+			auto first = static_cast<std::uint32_t>(vertices.size());
+
+			vertices.push_back(quad.origin);
+			vertices.push_back(quad.origin + quad.u);
+			vertices.push_back(quad.origin + quad.u + quad.v);
+			vertices.push_back(quad.origin + quad.v);
+
+			mesh->setIndicesArray(math::uint1s{ first, first + 1, first + 2, first, first + 2, first + 3 }, i);
+			materials.push_back(std::make_shared<MeshBasicMaterial>(quad.color));
+		}
+
+		mesh->setVertexArray(std::move(vertices));
+		mesh->computeLightMap(128, 128);
+
+		auto geometry = std::make_shared<Geometry>();
+		geometry->setMesh(std::move(mesh));
+		geometry->setMaterials(std::move(materials));
+
+		return geometry;
+	}
+
+	template<typename Function>
+	double
+	measure(Function&& function)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+		function();
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto bounces = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2;
+	auto threshold = argc > 2 ? std::strtof(argv[2], nullptr) : 1e-2f;
+
+	auto geometry = makeCornellBox();
+
+	DirectionalLight light;
+	light.setColor(math::float3::One);
+	light.setIntensity(3.0f);
+
+	// Tilted 60 degrees down from +z, so the light falls on the floor and the back wall.
+	math::float4x4 transform = math::float4x4::One;
+	light.setTransform(transform.makeRotationX(math::radians(60.0f)));
+
+	Camera camera;
+
+	bake::Lightmap lightmap;
+	lightmap.setIndirectBounces(bounces);
+	lightmap.setRefineThreshold(threshold);
+
+	auto setup = measure([&]() { lightmap.setGeometry(*geometry); });
+	auto direct = measure([&]() { lightmap.renderLight(light); });
+	auto indirect = measure([&]() { lightmap.render(camera); });
+
+	math::float3 total = math::float3::Zero;
+	for (auto& texel : lightmap.fronBuffer())
+		total += texel;
+
+	std::cout << "bounces: " << bounces << ", refine threshold: " << threshold << std::endl;
+	std::cout << "setup: " << setup << " ms, direct: " << direct << " ms, indirect: " << indirect << " ms" << std::endl;
+	std::cout << "indirect sum: " << total.x << " " << total.y << " " << total.z << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include <octoon/math/math.h>
+#include <octoon/math/simd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+// Times the SSE paths of math::simd against the scalar operators they replace, on arrays
+// the size of a skinned mesh. Both sides must produce the same bits, the run fails if not.
+
+namespace
+{
+	using namespace octoon;
+
+	template<typename Function>
+	double
+	measure(std::size_t iterations, Function&& function)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; i++)
+			function();
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+	}
+
+	template<typename T>
+	bool
+	report(const char* name, double scalar, double simd, const std::vector<T>& expected, const std::vector<T>& result)
+	{
+		auto identical = std::memcmp(expected.data(), result.data(), expected.size() * sizeof(T)) == 0;
+		std::cout << name << ": scalar " << scalar << " ms, simd " << simd << " ms, speedup " << scalar / simd << (identical ? "" : " (results differ)") << std::endl;
+		return identical;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+	auto iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+
+#if !defined(OCTOON_MATH_SIMD)
+	std::cout << "SSE2 is not available, math::simd forwards to the scalar operators" << std::endl;
+#endif
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	auto makeMatrix = [&]()
+	{
+		math::float4x4 m = math::float4x4::One;
+		m.makeRotation(math::Quaternion(math::normalize(math::float3(distribution(random), distribution(random), 1.0f)), distribution(random)));
+		m.setTranslate(math::float3(distribution(random), distribution(random), distribution(random)));
+		return m;
+	};
+
+	std::vector<math::float3> vectors(count);
+	for (auto& it : vectors)
+		it = math::float3(distribution(random), distribution(random), distribution(random));
+
+	std::vector<math::float4x4> matrices(count);
+	std::vector<math::float4x4> parents(count);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		matrices[i] = makeMatrix();
+		parents[i] = makeMatrix();
+	}
+
+	auto m = makeMatrix();
+	auto q = math::Quaternion(math::normalize(math::float3(0.3f, 1.0f, -0.2f)), 0.7f);
+
+	std::vector<math::float3> expected(count);
+	std::vector<math::float3> result(count);
+	std::vector<math::float4x4> expectedMatrices(count);
+	std::vector<math::float4x4> resultMatrices(count);
+
+	bool identical = true;
+
+	{
+		auto scalar = measure(iterations, [&]() { for (std::size_t i = 0; i < count; i++) expected[i] = m * vectors[i]; });
+		auto simd = measure(iterations, [&]() { math::simd::transformPoints(m, vectors.data(), result.data(), count); });
+		identical &= report("transformPoints", scalar, simd, expected, result);
+	}
+
+	{
+		auto scalar = measure(iterations, [&]() { for (std::size_t i = 0; i < count; i++) expected[i] = (math::float3x3)m * vectors[i]; });
+		auto simd = measure(iterations, [&]() { math::simd::transformNormals(m, vectors.data(), result.data(), count); });
+		identical &= report("transformNormals", scalar, simd, expected, result);
+	}
+
+	{
+		auto scalar = measure(iterations, [&]() { for (std::size_t i = 0; i < count; i++) expected[i] = math::rotate(q, vectors[i]); });
+		auto simd = measure(iterations, [&]() { math::simd::rotate(q, vectors.data(), result.data(), count); });
+		identical &= report("rotate", scalar, simd, expected, result);
+	}
+
+	{
+		auto scalar = measure(iterations, [&]() { for (std::size_t i = 0; i < count; i++) expectedMatrices[i] = parents[i] * matrices[i]; });
+		auto simd = measure(iterations, [&]() { math::simd::multiply(parents.data(), matrices.data(), resultMatrices.data(), count); });
+		identical &= report("multiply", scalar, simd, expectedMatrices, resultMatrices);
+	}
+
+	{
+		auto scalar = measure(iterations, [&]() { for (std::size_t i = 0; i < count; i++) expectedMatrices[i] = math::transformMultiply(parents[i], matrices[i]); });
+		auto simd = measure(iterations, [&]() { math::simd::transformMultiply(parents.data(), matrices.data(), resultMatrices.data(), count); });
+		identical &= report("transformMultiply", scalar, simd, expectedMatrices, resultMatrices);
+	}
+
+	return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,134 @@
+#include <octoon/hal/graphics.h>
+#include <octoon/hal/graphics_command.h>
+#include <octoon/video/renderer.h>
+#include <octoon/video/render_scene.h>
+#include <octoon/camera/perspective_camera.h>
+#include <octoon/light/directional_light.h>
+#include <octoon/mesh/cube_mesh.h>
+#include <octoon/material/mesh_standard_material.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Renders a synthetic scene through the null graphics device, so the time measured is the
+// CPU side of the renderer alone. The command recorder of the null context counts what
+// each frame sent to the device.
+
+namespace
+{
+	using namespace octoon;
+
+	template<typename Function>
+	double
+	measure(std::size_t iterations, Function&& function)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; i++)
+			function();
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 32;
+	auto frames = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+
+	constexpr std::uint32_t width = 1280;
+	constexpr std::uint32_t height = 720;
+
+	try
+	{
+		hal::GraphicsDeviceDesc deviceDesc;
+		deviceDesc.setDeviceType(hal::GraphicsDeviceType::Null);
+
+		auto device = hal::GraphicsSystem::instance()->createDevice(deviceDesc);
+		if (!device)
+			throw std::runtime_error("createDevice() failed");
+
+		hal::GraphicsSwapchainDesc swapchainDesc;
+		swapchainDesc.setWidth(width);
+		swapchainDesc.setHeight(height);
+		swapchainDesc.setColorFormat(hal::GraphicsFormat::B8G8R8A8UNorm);
+		swapchainDesc.setDepthStencilFormat(hal::GraphicsFormat::X8_D24UNormPack32);
+
+		hal::GraphicsContextDesc contextDesc;
+		contextDesc.setSwapchain(device->createSwapchain(swapchainDesc));
+
+		auto context = device->createDeviceContext(contextDesc);
+		if (!context)
+			throw std::runtime_error("createDeviceContext() failed");
+
+		auto recorder = dynamic_cast<hal::GraphicsCommandRecorder*>(context.get());
+
+		Renderer::instance()->setup(context, width, height);
+
+		auto scene = std::make_shared<RenderScene>();
+
+		PerspectiveCamera camera(60.0f, 0.1f, 1000.0f);
+		camera.setTransform(math::makeLookatRH(math::float3(0.0f, size * 0.5f, size * 1.5f), math::float3::Zero, math::float3::UnitY));
+		scene->addCamera(&camera);
+
+		DirectionalLight light;
+		light.setIntensity(2.0f);
+		scene->addLight(&light);
+
+		// A grid of cubes sharing one mesh, with a handful of materials between them.
+		auto mesh = std::make_shared<CubeMesh>(0.8f, 0.8f, 0.8f);
+
+		std::vector<MaterialPtr> materials;
+		for (std::uint32_t i = 0; i < 8; i++)
+			materials.push_back(std::make_shared<MeshStandardMaterial>(math::float3(i / 8.0f, 0.5f, 1.0f - i / 8.0f)));
+
+		std::vector<std::unique_ptr<Geometry>> geometries;
+		for (std::uint32_t y = 0; y < size; y++)
+		{
+			for (std::uint32_t x = 0; x < size; x++)
+			{
+				auto geometry = std::make_unique<Geometry>();
+				geometry->setMesh(mesh);
+				geometry->setMaterial(materials[(y * size + x) % materials.size()]);
+
+				math::float4x4 transform = math::float4x4::One;
+				geometry->setTransform(transform.makeTranslate(x - size * 0.5f, 0.0f, y - size * 0.5f));
+
+				scene->addGeometry(geometry.get());
+				geometries.push_back(std::move(geometry));
+			}
+		}
+
+		auto frame = [&]()
+		{
+			context->renderBegin();
+			Renderer::instance()->render(scene);
+			context->renderEnd();
+		};
+
+		// The first frame compiles the programs and uploads the meshes, keep it out of the average.
+		auto first = measure(1, frame);
+		auto average = measure(frames, frame);
+
+		std::cout << "objects: " << size * size << ", frames: " << frames << std::endl;
+		std::cout << "first frame: " << first << " ms, average frame: " << average << " ms" << std::endl;
+
+		if (recorder)
+		{
+			auto& statistics = recorder->getFrameStatistics();
+			std::cout << "draw calls: " << statistics.drawCalls << ", vertices: " << statistics.vertices << std::endl;
+			std::cout << "state changes: " << statistics.stateChanges << " (" << statistics.redundantStateChanges << " redundant)";
+			std::cout << ", pipelines: " << statistics.pipelineChanges << ", descriptor sets: " << statistics.descriptorSetChanges << std::endl;
+			std::cout << "uploads: " << statistics.uploads << " (" << statistics.uploadBytes << " bytes), uniform bytes: " << context->getUniformBytes() << std::endl;
+		}
+
+		Renderer::instance()->close();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
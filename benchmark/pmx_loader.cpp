@@ -0,0 +1,160 @@
+#include <octoon/pmx_loader.h>
+#include <octoon/io/fstream.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+
+// Times the PMX loader on a synthetic model: a grid of skinned vertices split over a few
+// untextured materials. Parsing runs on a buffer already in memory, building the model
+// reads the file like the editor does.
+
+namespace
+{
+	using namespace octoon;
+
+	PMX
+	makeModel(std::uint32_t size, std::uint32_t numMaterials)
+	{
+		PMX pmx = {};
+		pmx.header.magic[0] = 'P';
+		pmx.header.magic[1] = 'M';
+		pmx.header.magic[2] = 'X';
+		pmx.header.offset = 0x20;
+		pmx.header.version = 2.0f;
+		pmx.header.dataSize = 0x08;
+		pmx.header.encode = 0;
+		pmx.header.addUVCount = 0;
+		pmx.header.sizeOfIndices = 4;
+		pmx.header.sizeOfTexture = 1;
+		pmx.header.sizeOfMaterial = 1;
+		pmx.header.sizeOfBone = 2;
+		pmx.header.sizeOfMorph = 1;
+		pmx.header.sizeOfBody = 1;
+
+		pmx.numVertices = size * size;
+		pmx.vertices.resize(pmx.numVertices);
+
+		for (std::uint32_t y = 0; y < size; y++)
+		{
+			for (std::uint32_t x = 0; x < size; x++)
+			{
+				auto& vertex = pmx.vertices[y * size + x];
+				vertex.position = { float(x) / size, float(y) / size, 0.0f };
+				vertex.normal = { 0.0f, 0.0f, -1.0f };
+				vertex.coord = { float(x) / size, float(y) / size };
+				vertex.type = PMX_BDEF2;
+				vertex.weight.bone1 = 0;
+				vertex.weight.bone2 = 1;
+				vertex.weight.weight1 = float(y) / size;
+				vertex.edge = 1.0f;
+			}
+		}
+
+		std::vector<std::uint32_t> indices;
+		indices.reserve((size - 1) * (size - 1) * 6);
+
+		for (std::uint32_t y = 0; y + 1 < size; y++)
+		{
+			for (std::uint32_t x = 0; x + 1 < size; x++)
+			{
+				auto i = y * size + x;
+				indices.insert(indices.end(), { i, i + 1, i + size, i + 1, i + size + 1, i + size });
+			}
+		}
+
+		pmx.numIndices = static_cast<PmxUInt32>(indices.size());
+		pmx.indices.resize(indices.size() * sizeof(std::uint32_t));
+		std::memcpy(pmx.indices.data(), indices.data(), pmx.indices.size());
+
+		// Whole triangles per material, the last one takes what is left.
+		auto faces = pmx.numIndices / 3;
+
+		pmx.numMaterials = numMaterials;
+		pmx.materials.resize(numMaterials);
+
+		for (std::uint32_t i = 0; i < numMaterials; i++)
+		{
+			auto& material = pmx.materials[i];
+			material.Diffuse = { 0.8f, 0.8f, 0.8f };
+			material.Opacity = 1.0f;
+			material.Ambient = { 0.5f, 0.5f, 0.5f };
+			material.TextureIndex = 0xFF;
+			material.SphereTextureIndex = 0xFF;
+			material.ToonIndex = 1;
+			material.FaceCount = (i + 1 < numMaterials ? faces / numMaterials : faces - faces / numMaterials * (numMaterials - 1)) * 3;
+		}
+
+		pmx.numBones = 2;
+		pmx.bones.resize(pmx.numBones);
+		pmx.bones[0].Parent = 0xFFFF;
+		pmx.bones[1].Parent = 0;
+		pmx.bones[1].position = { 0.0f, 0.5f, 0.0f };
+
+		return pmx;
+	}
+
+	template<typename Function>
+	double
+	measure(std::size_t iterations, Function&& function)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; i++)
+			function();
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 512;
+	auto iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+	auto path = (std::filesystem::temp_directory_path() / "octoon-benchmark-model.pmx").string();
+
+	PmxLoader loader;
+
+	{
+		io::ofstream stream(path, io::ios_base::in | io::ios_base::out | io::ios_base::trunc);
+		if (!stream || !loader.doSave(stream, makeModel(size, 16)))
+		{
+			std::cerr << "Failed to write " << path << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::ifstream file(path, std::ios_base::binary);
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	bool succeeded = true;
+
+	auto parse = measure(iterations, [&]()
+	{
+		PMX pmx;
+		succeeded &= loader.doLoad(data.data(), data.size(), pmx);
+	});
+
+	auto build = measure(iterations, [&]()
+	{
+		Model model;
+		succeeded &= loader.doLoad(path, model);
+	});
+
+	std::filesystem::remove(path);
+
+	if (!succeeded)
+	{
+		std::cerr << "Failed to load the model" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "vertices: " << size * size << ", size: " << data.size() << " bytes, iterations: " << iterations << std::endl;
+	std::cout << "parse: " << parse << " ms, model: " << build << " ms" << std::endl;
+
+	return EXIT_SUCCESS;
+}
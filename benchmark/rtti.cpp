@@ -0,0 +1,76 @@
+#include <octoon/runtime/rtti_factory.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <random>
+
+// Times Rtti::isDerivedFrom on a random hierarchy, first with the parent chain walk the
+// types use before RttiFactory::open numbers them, then with the interval test after.
+
+namespace
+{
+	using namespace octoon;
+
+	template<typename Function>
+	double
+	measure(std::size_t iterations, Function&& function)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+		function();
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto numTypes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 600;
+	auto numChecks = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+
+	std::mt19937 random(1);
+
+	// Each type derives from one picked at random among the earlier ones, which gives a depth
+	// close to the natural log of the count. The factory keeps pointers, so they stay put.
+	std::deque<runtime::Rtti> types;
+	std::size_t depth = 0;
+
+	for (std::uint32_t i = 0; i < numTypes; i++)
+	{
+		auto parent = i > 0 ? &types[random() % i] : nullptr;
+		types.emplace_back("BenchmarkType" + std::to_string(i), nullptr, parent);
+
+		for (auto it = types.back().getParent(); it; it = it->getParent())
+			depth++;
+	}
+
+	std::vector<std::pair<const runtime::Rtti*, const runtime::Rtti*>> checks(numChecks);
+	for (auto& it : checks)
+		it = std::make_pair(&types[random() % numTypes], &types[random() % numTypes]);
+
+	std::size_t walked = 0;
+	std::size_t walkedByName = 0;
+	std::size_t numbered = 0;
+	std::size_t numberedByName = 0;
+
+	auto walk = measure(numChecks, [&]() { for (auto& it : checks) walked += it.first->isDerivedFrom(it.second); });
+	auto walkByName = measure(numChecks, [&]() { for (auto& it : checks) walkedByName += it.first->isDerivedFrom(it.second->type_name()); });
+
+	runtime::RttiFactory::instance()->open();
+
+	auto interval = measure(numChecks, [&]() { for (auto& it : checks) numbered += it.first->isDerivedFrom(it.second); });
+	auto intervalByName = measure(numChecks, [&]() { for (auto& it : checks) numberedByName += it.first->isDerivedFrom(it.second->type_name()); });
+
+	if (walked != numbered || walked != walkedByName || walked != numberedByName)
+	{
+		std::cerr << "The checks disagree: " << walked << " " << walkedByName << " " << numbered << " " << numberedByName << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "types: " << numTypes << ", average depth: " << double(depth) / numTypes << ", checks: " << numChecks << ", derived: " << walked << std::endl;
+	std::cout << "parent walk: " << walk << " ns, by name: " << walkByName << " ns" << std::endl;
+	std::cout << "interval: " << interval << " ns, by name: " << intervalByName << " ns" << std::endl;
+
+	return EXIT_SUCCESS;
+}
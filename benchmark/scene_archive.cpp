@@ -0,0 +1,85 @@
+#include <octoon/io/json_reader.h>
+#include <octoon/io/binary_archive.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+// Compares loading a scene from the JSON text format against the binary archive format.
+// The scene is synthetic: objects with a name, a transform and a few components, shaped
+// like the trees GameScene::save produces.
+
+namespace
+{
+	std::string
+	makeScene(std::size_t objects)
+	{
+		std::ostringstream stream;
+		stream << "{\"name\":\"benchmark\",\"objects\":[";
+
+		for (std::size_t i = 0; i < objects; i++)
+		{
+			if (i > 0) stream << ",";
+
+			stream << "{\"name\":\"object" << i << "\",\"active\":true,\"layer\":" << (i % 8);
+			stream << ",\"transform\":{\"translate\":[" << i * 0.5f << ",1.25,-3.5],\"scale\":[1,1,1],\"quaternion\":[0,0,0,1]}";
+			stream << ",\"components\":[";
+			stream << "{\"type\":\"MeshFilterComponent\",\"mesh\":\"mesh" << i << "\"},";
+			stream << "{\"type\":\"MeshRendererComponent\",\"material\":{\"color\":[0.8,0.7,0.6],\"roughness\":0.5,\"metalness\":0.1}}";
+			stream << "]}";
+		}
+
+		stream << "]}";
+		return stream.str();
+	}
+
+	template<typename Function>
+	double
+	measure(std::size_t iterations, Function&& function)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; i++)
+			function();
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto objects = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+	auto iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+	auto directory = std::filesystem::temp_directory_path();
+	auto jsonPath = (directory / "octoon-benchmark-scene.json").string();
+	auto binaryPath = (directory / "octoon-benchmark-scene.bin").string();
+
+	try
+	{
+		std::ofstream(jsonPath, std::ios_base::binary) << makeScene(objects);
+
+		octoon::io::BinaryArchiveWrite writer;
+		*writer.rdbuf() = std::move(*octoon::io::JsonReader(jsonPath).rdbuf());
+
+		auto saveBinary = measure(iterations, [&]() { writer.save(binaryPath); });
+		auto loadJson = measure(iterations, [&]() { octoon::io::JsonReader reader(jsonPath); });
+		auto loadBinary = measure(iterations, [&]() { octoon::io::BinaryArchiveReader reader(binaryPath); });
+
+		std::cout << "objects: " << objects << ", iterations: " << iterations << std::endl;
+		std::cout << "json   size: " << std::filesystem::file_size(jsonPath) << " bytes, load: " << loadJson << " ms" << std::endl;
+		std::cout << "binary size: " << std::filesystem::file_size(binaryPath) << " bytes, load: " << loadBinary << " ms, save: " << saveBinary << " ms" << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::filesystem::remove(jsonPath);
+	std::filesystem::remove(binaryPath);
+
+	return EXIT_SUCCESS;
+}
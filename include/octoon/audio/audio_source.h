@@ -52,6 +52,12 @@ namespace octoon
         virtual void setAudioClip(const AudioClip& clip) noexcept = 0;
         virtual void setSampleOffset(std::int32_t sample) noexcept = 0;
 
+        // Streams the reader instead of a clip. It is decoded a little ahead of playback on a
+        // worker thread, so the source holds a fraction of a second of PCM at a time and the
+        // clip only describes its format.
+        virtual void setAudioReader(const std::shared_ptr<AudioReader>& reader) noexcept = 0;
+        virtual const std::shared_ptr<AudioReader>& getAudioReader() const noexcept = 0;
+
         virtual void getTranslate(math::float3& translate) noexcept = 0;
         virtual void getVelocity(math::float3& velocity) noexcept = 0;
         virtual void getOrientation(math::float3& forward, math::float3& up) noexcept = 0;
@@ -4,6 +4,10 @@
 #include <memory>
 #include <cstdint>
 #include <cstddef>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 #include <octoon/runtime/platform.h>
 #include <octoon/math/vector3.h>
@@ -42,11 +46,13 @@ namespace octoon
 		virtual void setMaxDistance(float maxdis) noexcept override;
 		virtual void setMinDistance(float mindis) noexcept override;
 		virtual void setAudioClip(const AudioClip& clip) noexcept override;
+		virtual void setAudioReader(const std::shared_ptr<AudioReader>& reader) noexcept override;
 
 		virtual void getTranslate(math::float3& translate) noexcept override;
 		virtual void getVelocity(math::float3& velocity) noexcept override;
 		virtual void getOrientation(math::float3& forward, math::float3& up) noexcept override;
 		virtual const AudioClip& getAudioClip() const noexcept override;
+		virtual const std::shared_ptr<AudioReader>& getAudioReader() const noexcept override;
 		virtual std::int32_t getSampleOffset() const noexcept override;
 
 		virtual float getVolume() const noexcept override;
@@ -61,6 +67,25 @@ namespace octoon
 		virtual bool isPaused() const noexcept override;
 		virtual bool isLoop() const noexcept override;
 
+	private:
+		// Each streaming buffer holds a quarter of a second, the ring keeps a second queued.
+		static constexpr std::uint32_t NUM_STREAM_BUFFERS = 4;
+		static constexpr std::uint32_t STREAM_BUFFERS_PER_SECOND = 4;
+
+		struct StreamBuffer
+		{
+			std::uint32_t buffer;
+			std::uint64_t start;
+			std::uint64_t frames;
+		};
+
+		void streamThread() noexcept;
+		void stopStream() noexcept;
+
+		// Both expect mutex_ to be held.
+		void rewind(std::uint64_t frame) noexcept;
+		bool fill(std::uint32_t buffer) noexcept;
+
 	private:
 		bool isLoop_;
 		bool isPlaying_;
@@ -73,6 +98,19 @@ namespace octoon
 		std::vector<AudioSourceListener*> listeners_;
 
 		AudioClip audioClip_;
+
+		std::shared_ptr<AudioReader> reader_;
+		std::uint32_t streamBuffers_[NUM_STREAM_BUFFERS];
+		std::deque<StreamBuffer> queue_;
+		std::vector<std::uint32_t> idle_;
+		std::vector<char> staging_;
+		std::uint64_t cursor_;
+		std::uint32_t frameSize_;
+
+		bool quit_;
+		mutable std::mutex mutex_;
+		std::condition_variable wakeup_;
+		std::thread thread_;
 	};
 }
 
@@ -34,11 +34,14 @@ namespace octoon
 		virtual std::uint32_t frequency() const noexcept override;
 
 	private:
+		// PCM frames are decoded from the file as they are read.
+		struct Decoder;
+
 		std::uint32_t hz_;
 		std::uint32_t channels_;
 		std::uint64_t samples_;
 		std::streamoff pos_;
-		std::vector<std::uint8_t> buffer_;
+		std::unique_ptr<Decoder> decoder_;
 	};
 
 	class OCTOON_EXPORT WavAudioReader final : public AudioReader
@@ -38,7 +38,7 @@ namespace octoon
 		void onFrame() except;
 		void onFrameEnd() noexcept override;
 
-		void onFixedUpdate(const std::any& data) noexcept;
+		void onFixedUpdate(float timeInterval) noexcept;
 
 	public:
 		nv::cloth::Factory* getContext();
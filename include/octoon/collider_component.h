@@ -26,7 +26,11 @@ namespace octoon
 		virtual float getRestOffset() const noexcept = 0;
 
 		virtual const math::float4x4& getLocalPose() const noexcept = 0;
-	
+
+	protected:
+		// Shapes must not be modified while an asynchronous physics step is running.
+		void waitSimulate() noexcept;
+
 	private:
 		friend class RigidbodyComponent;
 		virtual std::shared_ptr<PhysicsShape> getShape() noexcept = 0;
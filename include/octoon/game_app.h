@@ -36,6 +36,8 @@ namespace octoon
 		bool openScene(std::string_view name) except;
 		void closeScene(std::string_view name) noexcept;
 
+		bool saveScene(const GameScenePtr& scene, std::string_view filename) except;
+
 		GameScenePtr findScene(std::string_view name) noexcept;
 
 		template<typename T, typename ...Args, typename = std::enable_if_t<std::is_base_of<GameFeature, T>::value>>
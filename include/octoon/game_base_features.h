@@ -18,13 +18,14 @@ namespace octoon
 
 	private:
 		void onActivate() noexcept override;
+		void onDeactivate() noexcept override;
 
 		void onFrameBegin() noexcept override;
 		void onFrame() noexcept override;
 		void onFrameEnd() noexcept override;
 
 		void onInputEvent(const std::any& data) noexcept;
-		void onFixedUpdate(const std::any& data) noexcept;
+		void onFixedUpdate(float timeInterval) noexcept;
 	};
 }
 
@@ -57,6 +57,15 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		template<typename T>
+		void sendEvent(const runtime::Event<T>& event, const T& data) noexcept { assert(gameObject_); gameObject_->sendEvent(event, data); }
+		void sendEvent(const runtime::Event<void>& event) noexcept { assert(gameObject_); gameObject_->sendEvent(event); }
+
+		template<auto Fn, typename T, typename C>
+		void addEventListener(const runtime::Event<T>& event, C* object) noexcept { assert(gameObject_); gameObject_->addEventListener<Fn>(event, object); }
+		template<auto Fn, typename T, typename C>
+		void removeEventListener(const runtime::Event<T>& event, C* object) noexcept { assert(gameObject_); gameObject_->removeEventListener<Fn>(event, object); }
+
 		template<typename T, typename = std::enable_if_t<std::is_base_of<GameFeature, T>::value>>
 		T* tryGetFeature() const noexcept { return dynamic_cast<T*>(this->tryGetFeature(T::RTTI)); }
 		GameFeature* tryGetFeature(const runtime::Rtti* rtti) const noexcept;
@@ -2,6 +2,7 @@
 #define OCTOON_GAME_FEATURE_H_
 
 #include <octoon/game_types.h>
+#include <octoon/runtime/event.h>
 
 #include <any>
 #include <functional>
@@ -30,6 +31,19 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		template<typename T>
+		void sendEvent(const runtime::Event<T>& event, const T& data) noexcept { this->getEventDispatcher().dispatch(event, data); }
+		void sendEvent(const runtime::Event<void>& event) noexcept { this->getEventDispatcher().dispatch(event); }
+
+		template<typename T>
+		void postEvent(const runtime::Event<T>& event, const T& data) noexcept { this->getEventDispatcher().post(event, data); }
+		void postEvent(const runtime::Event<void>& event) noexcept { this->getEventDispatcher().post(event); }
+
+		template<auto Fn, typename T, typename C>
+		void addEventListener(const runtime::Event<T>& event, C* object) noexcept { this->getEventDispatcher().addListener<Fn>(event, object); }
+		template<auto Fn, typename T, typename C>
+		void removeEventListener(const runtime::Event<T>& event, C* object) noexcept { this->getEventDispatcher().removeListener<Fn>(event, object); }
+
 		GameServer* getGameServer() noexcept;
 
 	protected:
@@ -49,6 +63,8 @@ namespace octoon
 		friend GameServer;
 		void _setGameServer(GameServer* server) noexcept;
 
+		runtime::EventDispatcher& getEventDispatcher() noexcept;
+
 	private:
 		GameFeature(const GameFeature&) noexcept = delete;
 		GameFeature& operator=(const GameFeature&) noexcept = delete;
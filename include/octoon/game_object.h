@@ -3,10 +3,12 @@
 
 #include <octoon/game_types.h>
 #include <octoon/runtime/sigslot.h>
+#include <octoon/runtime/event.h>
 #include <octoon/io/iarchive.h>
 
 #include <any>
 #include <functional>
+#include <map>
 
 namespace octoon
 {
@@ -91,6 +93,16 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		// Typed events, for the ones sent every frame. Handlers are member functions of `object`.
+		template<typename T>
+		void sendEvent(const runtime::Event<T>& event, const T& data) noexcept { events_.dispatch(event, data); }
+		void sendEvent(const runtime::Event<void>& event) noexcept { events_.dispatch(event); }
+
+		template<auto Fn, typename T, typename C>
+		void addEventListener(const runtime::Event<T>& event, C* object) noexcept { events_.addListener<Fn>(event, object); }
+		template<auto Fn, typename T, typename C>
+		void removeEventListener(const runtime::Event<T>& event, C* object) noexcept { events_.removeListener<Fn>(event, object); }
+
 		virtual GameScene* getGameScene() noexcept;
 		virtual const GameScene* getGameScene() const noexcept;
 
@@ -147,6 +159,7 @@ namespace octoon
 		GameComponents components_;
 		std::vector<GameComponentRaws> dispatchComponents_;
 		std::map<std::string, runtime::signal<void(const std::any&)>, std::less<>> dispatchEvents_;
+		runtime::EventDispatcher events_;
 	};
 }
 
@@ -1,6 +1,7 @@
 #ifndef OCTOON_GAME_OBJECT_MANAGER_H_
 #define OCTOON_GAME_OBJECT_MANAGER_H_
 
+#include <map>
 #include <stack>
 #include <shared_mutex>
 #include <octoon/game_object.h>
@@ -3,6 +3,7 @@
 
 #include <octoon/game_types.h>
 #include <octoon/runtime/sigslot.h>
+#include <octoon/runtime/event.h>
 
 #include <any>
 #include <map>
@@ -28,6 +29,9 @@ namespace octoon
 		bool openScene(std::string_view scene_name) noexcept;
 		void closeScene(std::string_view scene_name) noexcept;
 
+		// Writes the scene in the binary archive format, which openScene reads back.
+		bool saveScene(const GameScenePtr& scene, std::string_view filename) noexcept;
+
 		bool addScene(const GameScenePtr& scene) noexcept;
 		void closeScene(const GameScenePtr& scene) noexcept;
 
@@ -59,6 +63,9 @@ namespace octoon
 		void addMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 		void removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept;
 
+		// Typed events of the features, the posted ones are sent at the end of the frame.
+		runtime::EventDispatcher& getEventDispatcher() noexcept;
+
 		GameApp* getGameApp() noexcept;
 
 		void update() noexcept(false);
@@ -84,7 +91,8 @@ namespace octoon
 
 		GameApp* gameApp_;
 		GameListenerPtr listener_;
-		std::map<std::string, runtime::signal<void(const std::any&)>> dispatchEvents_;
+		std::map<std::string, runtime::signal<void(const std::any&)>, std::less<>> dispatchEvents_;
+		runtime::EventDispatcher events_;
 	};
 }
 
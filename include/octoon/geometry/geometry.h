@@ -23,6 +23,10 @@ namespace octoon
 		void setGlobalIllumination(bool enable) noexcept;
 		bool getGlobalIllumination() const noexcept;
 
+		// A static geometry promises not to move, so the renderer may merge it into a batch.
+		void setStatic(bool enable) noexcept;
+		bool getStatic() const noexcept;
+
 		void setMesh(std::shared_ptr<Mesh>&& mesh) noexcept;
 		void setMesh(const std::shared_ptr<Mesh>& mesh) noexcept;
 		const std::shared_ptr<Mesh>& getMesh() const noexcept;
@@ -39,6 +43,7 @@ namespace octoon
 		bool isCastShadow_;
 		bool isReceiveShadow_;
 		bool isGlobalIllumination_;
+		bool isStatic_;
 
 		std::shared_ptr<Mesh> mesh_;
 		std::vector<std::shared_ptr<Material>> materials_;
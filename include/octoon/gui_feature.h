@@ -24,6 +24,10 @@ namespace octoon
 		void setFramebufferScale(std::uint32_t w, std::uint32_t h) noexcept;
 		void getFramebufferScale(std::uint32_t& w, std::uint32_t& h) noexcept;
 
+		// Shows the CPU and GPU timings of the last profiled frame, enabling the profiler with it.
+		void setProfilerOverlay(bool enable) noexcept;
+		bool getProfilerOverlay() const noexcept;
+
 	private:
 		void onActivate() except override;
 		void onDeactivate() noexcept override;
@@ -33,6 +37,7 @@ namespace octoon
 		void onFrameEnd() noexcept override;
 
 		void onInputEvent(const std::any& data) noexcept;
+		void onProfilerOverlay() noexcept;
 
 	private:
 		WindHandle window_;
@@ -42,6 +47,8 @@ namespace octoon
 		std::uint32_t framebuffer_w_;
 		std::uint32_t framebuffer_h_;
 
+		bool profilerOverlay_;
+
 		std::unique_ptr<imgui::System> system_;
 	};
 }
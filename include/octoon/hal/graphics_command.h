@@ -0,0 +1,146 @@
+#ifndef OCTOON_GRAPHICS_COMMAND_H_
+#define OCTOON_GRAPHICS_COMMAND_H_
+
+#include <octoon/hal/graphics_types.h>
+
+namespace octoon
+{
+	namespace hal
+	{
+		enum class GraphicsCommandOp : std::uint8_t
+		{
+			RenderBegin = 0,
+			RenderEnd = 1,
+			SetViewport = 2,
+			SetScissor = 3,
+			SetStencilCompareMask = 4,
+			SetStencilReference = 5,
+			SetStencilWriteMask = 6,
+			SetRenderPipeline = 7,
+			SetDescriptorSet = 8,
+			SetVertexBuffer = 9,
+			SetIndexBuffer = 10,
+			SetFramebuffer = 11,
+			ClearFramebuffer = 12,
+			DiscardFramebuffer = 13,
+			BlitFramebuffer = 14,
+			ReadFramebuffer = 15,
+			GenerateMipmap = 16,
+			Draw = 17,
+			DrawIndexed = 18,
+			DrawIndirect = 19,
+			DrawIndexedIndirect = 20,
+			Present = 21,
+			SetUniform = 22,
+		};
+
+		struct GraphicsCommand
+		{
+			GraphicsCommandOp op;
+			const void* object;
+			std::uint32_t args[5];
+		};
+
+		struct GraphicsFrameStatistics
+		{
+			std::uint32_t commands;
+			std::uint32_t stateChanges;
+			std::uint32_t redundantStateChanges;
+			std::uint32_t pipelineChanges;
+			std::uint32_t descriptorSetChanges;
+			std::uint32_t bufferChanges;
+			std::uint32_t framebufferChanges;
+			std::uint32_t clears;
+			std::uint32_t drawCalls;
+			std::uint32_t instances;
+			std::uint64_t vertices;
+			std::uint32_t uploads;
+			std::uint64_t uploadBytes;
+		};
+
+		// Implemented by contexts that keep the commands of the current frame, such as the null device.
+		class OCTOON_EXPORT GraphicsCommandRecorder
+		{
+		public:
+			GraphicsCommandRecorder() noexcept = default;
+			virtual ~GraphicsCommandRecorder() = default;
+
+			virtual void setCommandCapture(bool enable) noexcept = 0;
+			virtual bool getCommandCapture() const noexcept = 0;
+
+			virtual const std::vector<GraphicsCommand>& getCommands() const noexcept = 0;
+			virtual const GraphicsFrameStatistics& getFrameStatistics() const noexcept = 0;
+		};
+
+		/*
+		* Context calls recorded into one flat byte stream, so draws can be built on worker
+		* threads and replayed later on the thread that owns the GraphicsContext. Uniform writes
+		* are recorded too, since descriptor sets are shared between draws. Resources are kept as
+		* raw pointers and must stay alive until the list has been executed; `clear` keeps the
+		* storage, so a list reused every frame stops allocating once it has grown.
+		*/
+		class OCTOON_EXPORT GraphicsCommandList final
+		{
+		public:
+			GraphicsCommandList() noexcept;
+			~GraphicsCommandList() noexcept;
+
+			void clear() noexcept;
+			bool empty() const noexcept;
+			std::size_t size() const noexcept;
+
+			void setViewport(std::uint32_t i, const float4& viewport) noexcept;
+			void setScissor(std::uint32_t i, const uint4& scissor) noexcept;
+
+			void setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept;
+			void setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept;
+			void setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept;
+
+			void setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept;
+			void setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept;
+
+			void setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept;
+			void setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t offset, GraphicsIndexType indexType) noexcept;
+
+			void generateMipmap(const GraphicsTexturePtr& texture) noexcept;
+
+			void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept;
+			void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept;
+			void discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags = GraphicsClearFlagBits::AllBit) noexcept;
+			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags = GraphicsClearFlagBits::ColorBit) noexcept;
+
+			void draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept;
+			void drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept;
+			void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
+			void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
+
+			void uniform1b(const GraphicsUniformSetPtr& uniform, bool value) noexcept;
+			void uniform1i(const GraphicsUniformSetPtr& uniform, std::int32_t value) noexcept;
+			void uniform2i(const GraphicsUniformSetPtr& uniform, const int2& value) noexcept;
+			void uniform3i(const GraphicsUniformSetPtr& uniform, const int3& value) noexcept;
+			void uniform4i(const GraphicsUniformSetPtr& uniform, const int4& value) noexcept;
+			void uniform1f(const GraphicsUniformSetPtr& uniform, float value) noexcept;
+			void uniform2f(const GraphicsUniformSetPtr& uniform, const float2& value) noexcept;
+			void uniform3f(const GraphicsUniformSetPtr& uniform, const float3& value) noexcept;
+			void uniform4f(const GraphicsUniformSetPtr& uniform, const float4& value) noexcept;
+			void uniform3fmat(const GraphicsUniformSetPtr& uniform, const float3x3& value) noexcept;
+			void uniform4fmat(const GraphicsUniformSetPtr& uniform, const float4x4& value) noexcept;
+			void uniformTexture(const GraphicsUniformSetPtr& uniform, const GraphicsTexturePtr& texture) noexcept;
+			void uniformBuffer(const GraphicsUniformSetPtr& uniform, const GraphicsDataPtr& data) noexcept;
+
+			// Replays the commands, dropping binds that would not change the state left by the previous command.
+			void execute(GraphicsContext& context) const noexcept;
+			static void execute(GraphicsContext& context, const GraphicsCommandList* lists, std::size_t count) noexcept;
+
+		private:
+			template<typename T>
+			void write(GraphicsCommandOp op, std::uint8_t flags, const T& payload) noexcept;
+
+		private:
+			std::size_t count_;
+			std::vector<std::uint8_t> stream_;
+		};
+	}
+}
+
+#endif
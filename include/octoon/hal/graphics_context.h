@@ -63,7 +63,7 @@ namespace octoon
 			virtual void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept = 0;
 			virtual void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept = 0;
 			virtual void discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags = GraphicsClearFlagBits::AllBit) noexcept = 0;
-			virtual void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept = 0;
+			virtual void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags = GraphicsClearFlagBits::ColorBit) noexcept = 0;
 			virtual void readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept = 0;
 			virtual void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept = 0;
 			virtual GraphicsFramebufferPtr getFramebuffer() const noexcept = 0;
@@ -73,6 +73,14 @@ namespace octoon
 			virtual void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept = 0;
 			virtual void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept = 0;
 
+			// GPU timestamps are written into numbered queries and read back a few frames later.
+			virtual void writeTimestamp(std::uint32_t i) noexcept = 0;
+			virtual bool getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept = 0;
+
+			// Bytes of uniform data uploaded since renderBegin, that is during the current frame.
+			// Backends that do not track uploads report zero.
+			virtual std::uint64_t getUniformBytes() const noexcept = 0;
+
 			virtual void present() noexcept = 0;
 
 		private:
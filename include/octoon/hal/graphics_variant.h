@@ -16,6 +16,9 @@ namespace octoon
 			void setType(GraphicsUniformType type) noexcept;
 			GraphicsUniformType getType() const noexcept;
 
+			// Increased whenever a write actually changes the value, so backends can skip redundant uploads.
+			std::uint32_t getVersion() const noexcept;
+
 			void uniform1b(bool value) noexcept;
 			void uniform1i(std::int32_t i1) noexcept;
 			void uniform2i(const int2& value) noexcept;
@@ -152,6 +155,7 @@ namespace octoon
 			} _value;
 
 			GraphicsUniformType _type;
+			std::uint32_t _version;
 		};
 	}
 }
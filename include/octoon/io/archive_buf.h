@@ -1,8 +1,11 @@
 #ifndef OCTOON_ARCHIVEBUF_H_
 #define OCTOON_ARCHIVEBUF_H_
 
-#include <list>
+#include <deque>
+#include <vector>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <stdexcept>
 #include <octoon/math/math.h>
@@ -13,8 +16,16 @@ namespace octoon
 {
 	namespace io
 	{
+		/*
+		* Tree of archive values. Strings are stored inline and arrays keep their children in
+		* one contiguous vector. Object members live in a deque, so a reference returned by
+		* `operator[]` or `at` stays valid while siblings are added, and objects with more than
+		* a few members are also indexed by a hash of their keys.
+		*/
 		class OCTOON_EXPORT archivebuf final
 		{
+			struct object_storage;
+
 		public:
 			using boolean_t = bool;
 			using number_integer_t = std::int32_t;
@@ -25,9 +36,9 @@ namespace octoon
 			using number_float4_t = math::detail::Vector4<number_float_t>;
 			using number_quaternion_t = math::detail::Quaternion<number_float_t>;
 			using string_t = std::string;
-			using object_t = archivebuf;;
+			using object_t = archivebuf;
 			using array_t = std::vector<archivebuf>;
-			using map_t = std::list<std::pair<std::string, object_t>>;
+			using map_t = std::deque<std::pair<string_t, object_t>>;
 			using iterator = map_t::iterator;
 			using reverse_iterator = map_t::reverse_iterator;
 			using const_iterator = map_t::const_iterator;
@@ -39,9 +50,9 @@ namespace octoon
 				number_integer_t,
 				number_unsigned_t,
 				number_float_t,
-				std::unique_ptr<string_t>,
+				string_t,
 				std::unique_ptr<array_t>,
-				std::unique_ptr<map_t>
+				std::unique_ptr<object_storage>
 			>;
 
 			static const archivebuf& nil;
@@ -127,6 +138,7 @@ namespace octoon
 			void push_back(const string_t& key, const number_float_t& value);
 			void push_back(const string_t& key, const string_t& value);
 			void push_back(const string_t& key, const string_t::value_type* value);
+			void push_back(std::string_view key, archivebuf&& value);
 			void push_back(archivebuf&& value);
 
 			iterator begin() noexcept;
@@ -148,6 +160,7 @@ namespace octoon
 			const archivebuf& back() const noexcept;
 
 			void emplace(type_t type) noexcept;
+			void reserve(std::size_t n) noexcept(false);
 			void clear() noexcept;
 
 			std::size_t size() const noexcept;
@@ -481,7 +494,7 @@ namespace octoon
 				if (this->type() != type)
 					throw std::runtime_error(string_t("type must be ") + type_name(type) + " but is " + this->type_name());
 
-				return *std::get<type>(_data);
+				return const_cast<string_t&>(std::get<type>(_data));
 			}
 
 			template<type_t type, typename = std::enable_if_t<type == type_t::array, int>>
@@ -498,9 +511,27 @@ namespace octoon
 			{
 				if (this->type() != type)
 					throw std::runtime_error(string_t("type must be ") + type_name(type) + " but is " + this->type_name());
-				return std::get<type>(_data)->front().second;
+				return std::get<type>(_data)->members.front().second;
 			}
 
+		private:
+			// Members are found by a scan up to this many, and through the index past it. Reserving
+			// more than this up front starts the index right away, presized for the members to come.
+			static constexpr std::size_t index_threshold = 8;
+
+			struct object_storage final
+			{
+				map_t members;
+				std::unordered_map<std::string_view, std::size_t> index; // views of the keys in `members`
+				bool indexed = false;
+			};
+
+			static void build_index(object_storage& data, std::size_t n);
+
+		private:
+			archivebuf* find(std::string_view key) const noexcept;
+			archivebuf& insert(std::string_view key, archivebuf&& value);
+
 		private:
 			archivebuf(const archivebuf& value);
 			archivebuf& operator=(const archivebuf& value);
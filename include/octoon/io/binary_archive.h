@@ -0,0 +1,66 @@
+#ifndef OCTOON_BINARY_ARCHIVE_H_
+#define OCTOON_BINARY_ARCHIVE_H_
+
+#include <octoon/io/iarchive.h>
+#include <octoon/io/oarchive.h>
+#include <octoon/io/iostream.h>
+
+namespace octoon
+{
+	namespace io
+	{
+		/*
+		* Compact binary form of an `archivebuf` tree. The file starts with a table of
+		* the distinct object keys, followed by the nodes in depth-first order; objects
+		* refer to their keys by index, and arrays and objects store their child count
+		* up front so the reader can size each container once.
+		*/
+		class OCTOON_EXPORT BinaryArchiveReader final : public iarchive
+		{
+		public:
+			BinaryArchiveReader() noexcept;
+			BinaryArchiveReader(istream& stream) except;
+			BinaryArchiveReader(const std::string& path) except;
+			~BinaryArchiveReader() noexcept;
+
+			BinaryArchiveReader& open(istream& stream, const ios_base::open_mode mode = ios_base::in) except;
+			BinaryArchiveReader& open(const std::string& path) except;
+
+			bool is_open() const noexcept;
+
+			void close() noexcept;
+
+			static bool accept(istream& stream) noexcept;
+
+		private:
+			BinaryArchiveReader(const BinaryArchiveReader&) noexcept = delete;
+			BinaryArchiveReader& operator=(const BinaryArchiveReader&) noexcept = delete;
+
+		private:
+			archivebuf _archive;
+		};
+
+		class OCTOON_EXPORT BinaryArchiveWrite final : public oarchive
+		{
+		public:
+			BinaryArchiveWrite() noexcept;
+			~BinaryArchiveWrite() noexcept;
+
+			BinaryArchiveWrite& save(ostream& stream, const ios_base::open_mode mode = ios_base::out) except;
+			BinaryArchiveWrite& save(const std::string& path) except;
+
+			void close() noexcept;
+
+			bool is_open() const noexcept;
+
+		private:
+			BinaryArchiveWrite(const BinaryArchiveWrite&) noexcept = delete;
+			BinaryArchiveWrite& operator=(const BinaryArchiveWrite&) noexcept = delete;
+
+		private:
+			archivebuf _archive;
+		};
+	}
+}
+
+#endif
@@ -34,6 +34,8 @@ namespace octoon
 
 			streamsize size() const noexcept;
 
+			const char* data() const noexcept override;
+
 			int flush() noexcept;
 
 		private:
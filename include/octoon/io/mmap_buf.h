@@ -0,0 +1,61 @@
+#ifndef OCTOON_IO_MMAP_BUF_H_
+#define OCTOON_IO_MMAP_BUF_H_
+
+#include <string>
+#include <octoon/io/stream_buf.h>
+
+namespace octoon
+{
+	namespace io
+	{
+		/*
+		* Read-only stream buffer backed by a memory-mapped file. The whole file is
+		* exposed through `data()`, so binary loaders can parse it in place without
+		* copying through `read`.
+		*/
+		class OCTOON_EXPORT mmapbuf final : public stream_buf
+		{
+		public:
+			mmapbuf() noexcept;
+			mmapbuf(mmapbuf&& move) noexcept;
+			~mmapbuf() noexcept;
+
+			mmapbuf& operator=(mmapbuf&& move) noexcept;
+
+			bool is_open() const noexcept;
+
+			bool open(const char* filename, ios_base::openmode mode = ios_base::in) noexcept;
+			bool open(const wchar_t* filename, ios_base::openmode mode = ios_base::in) noexcept;
+			bool open(const std::string& filename, ios_base::openmode mode = ios_base::in) noexcept;
+			bool open(const std::wstring& filename, ios_base::openmode mode = ios_base::in) noexcept;
+
+			bool close() noexcept;
+
+			streamsize read(char* str, std::streamsize cnt) noexcept;
+			streamsize write(const char* str, std::streamsize cnt) noexcept;
+
+			streamoff seekg(ios_base::off_type pos, ios_base::seekdir dir) noexcept;
+			streamoff tellg() noexcept;
+
+			streamsize size() const noexcept;
+
+			const char* data() const noexcept override;
+
+			int flush() noexcept;
+
+		private:
+			bool map(void* handle) noexcept;
+
+		private:
+			mmapbuf(const mmapbuf&) = delete;
+			mmapbuf& operator=(const mmapbuf&) = delete;
+
+		private:
+			const char* data_;
+			std::size_t pos_;
+			std::size_t size_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef OCTOON_IO_MMAP_STREAM_H_
+#define OCTOON_IO_MMAP_STREAM_H_
+
+#include <octoon/io/mmap_buf.h>
+#include <octoon/io/istream.h>
+
+namespace octoon
+{
+	namespace io
+	{
+		class OCTOON_EXPORT immapstream final : public istream
+		{
+		public:
+			immapstream() noexcept;
+			immapstream(const char* path, const ios_base::open_mode mode = ios_base::in) noexcept;
+			immapstream(const wchar_t* path, const ios_base::open_mode mode = ios_base::in) noexcept;
+			immapstream(const std::string& path, const ios_base::open_mode mode = ios_base::in) noexcept;
+			immapstream(const std::wstring& path, const ios_base::open_mode mode = ios_base::in) noexcept;
+			~immapstream() noexcept;
+
+			immapstream& open(const char* path, const ios_base::open_mode mode = ios_base::in) noexcept;
+			immapstream& open(const wchar_t* path, const ios_base::open_mode mode = ios_base::in) noexcept;
+			immapstream& open(const std::string& path, const ios_base::open_mode mode = ios_base::in) noexcept;
+			immapstream& open(const std::wstring& path, const ios_base::open_mode mode = ios_base::in) noexcept;
+
+			immapstream& close() noexcept;
+
+			bool is_open() const noexcept;
+
+			const char* data() const noexcept;
+
+		private:
+			immapstream(const immapstream&) = delete;
+			immapstream& operator=(const immapstream&) = delete;
+
+		private:
+			mmapbuf file_;
+		};
+	}
+}
+
+#endif
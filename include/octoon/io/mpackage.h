@@ -0,0 +1,40 @@
+#ifndef OCTOON_IO_MPACKAGE_H_
+#define OCTOON_IO_MPACKAGE_H_
+
+#include <octoon/io/ioserver.h>
+
+namespace octoon
+{
+	namespace io
+	{
+		/*
+		* Local directory mapped to a virtual directory, with every file opened as a
+		* read-only memory mapping. Streams returned by `open` expose the whole file
+		* as a contiguous span through `stream_buf::data()`.
+		*
+		* **NOTE** Memory-mapped packages are always read-only. Any non-read options
+		* set true will lead to rejection.
+		*/
+		class OCTOON_EXPORT mpackage final : public package
+		{
+		public:
+			mpackage(const char* base_dir) noexcept;
+			mpackage(std::string&& base_dir) noexcept;
+			mpackage(const std::string& base_dir) noexcept;
+			~mpackage() noexcept = default;
+
+			std::unique_ptr<stream_buf> open(const Orl& orl, const ios_base::open_mode mode) override;
+
+			bool remove(const Orl& orl, ios_base::file_type type = ios_base::file) override;
+			ios_base::file_type exists(const Orl& orl) override;
+
+		private:
+			std::string make_path(const Orl& orl) const;
+
+		private:
+			std::string base_dir_;
+		};
+	}
+}
+
+#endif
@@ -24,6 +24,14 @@ namespace octoon
 
 			virtual streamsize size() const noexcept = 0;
 
+			/*
+			* Returns a pointer to the whole contents when the buffer is backed by
+			* contiguous memory (e.g. `membuf`, `mmapbuf`), `nullptr` otherwise.
+			* Empty contents give an empty string rather than `nullptr`.
+			* Binary loaders may parse directly from it instead of calling `read`.
+			*/
+			virtual const char* data() const noexcept;
+
 			virtual bool is_open() const noexcept = 0;
 
 			virtual int flush() noexcept = 0;
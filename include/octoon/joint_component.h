@@ -18,6 +18,10 @@ namespace octoon
 
 		virtual std::shared_ptr<RigidbodyComponent> getTarget() = 0;
 		virtual void setTarget(std::shared_ptr<RigidbodyComponent>) = 0;
+
+	protected:
+		// Joints must not be modified while an asynchronous physics step is running.
+		void waitSimulate() noexcept;
 	};
 }
 
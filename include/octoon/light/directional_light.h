@@ -8,6 +8,9 @@ namespace octoon
 	class OCTOON_EXPORT DirectionalLight final : public Light
 	{
 		OctoonDeclareSubClass(DirectionalLight, Light)
+	public:
+		static constexpr std::uint32_t MAX_SHADOW_CASCADES = 4;
+
 	public:
 		DirectionalLight() noexcept;
 		virtual ~DirectionalLight() noexcept;
@@ -24,6 +27,14 @@ namespace octoon
 		void setShadowMapSize(const math::uint2& size) noexcept;
 		const math::uint2& getShadowMapSize() const noexcept;
 
+		// Each cascade gets a tile of the shadow map size, the tiles share one atlas.
+		void setShadowCascades(std::uint32_t count) noexcept;
+		std::uint32_t getShadowCascades() const noexcept;
+
+		// Distance from the view camera past which nothing receives a shadow.
+		void setShadowDistance(float distance) noexcept;
+		float getShadowDistance() const noexcept;
+
 		void setCamera(const std::shared_ptr<Camera>& camera) noexcept;
 		const std::shared_ptr<Camera>& getCamera() const noexcept;
 
@@ -32,6 +43,8 @@ namespace octoon
 	private:
 		void onMoveAfter() noexcept override;
 
+		void setupShadowAtlas() noexcept;
+
 	private:
 		DirectionalLight(const DirectionalLight&) noexcept = delete;
 		DirectionalLight& operator=(const DirectionalLight&) noexcept = delete;
@@ -41,7 +54,9 @@ namespace octoon
 
 		float shadowBias_;
 		float shadowRadius_;
+		float shadowDistance_;
 		math::uint2 shadowSize_;
+		std::uint32_t shadowCascades_;
 
 		std::shared_ptr<Camera> shadowCamera_;
 	};
@@ -12,6 +12,7 @@ namespace octoon
 		Light() noexcept;
 		virtual ~Light() noexcept;
 
+		// A range of zero, the default, leaves the light without distance falloff.
 		void setRange(float range) noexcept;
 		void setIntensity(float intensity) noexcept;
 		void setColor(const math::float3& color) noexcept;
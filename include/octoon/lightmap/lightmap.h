@@ -4,23 +4,39 @@
 #include <octoon/geometry/geometry.h>
 #include <octoon/light/directional_light.h>
 #include <octoon/light/environment_light.h>
+#include <octoon/lightmap/lightmap_bvh.h>
 
 namespace octoon::bake
 {
-	struct Patch
+	/*
+	* The patches of one mip level, a texel of the lightmap each. Every attribute has its own array,
+	* split by component for positions and normals, so the bake loops read four patches at a time.
+	* `area` is the surface that falls in the texel, from every triangle touching it.
+	*/
+	struct Patches
 	{
-		std::size_t texelIndex;
+		std::vector<std::uint32_t> texelIndex;
+		std::vector<float> area;
 
-		float area;
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> positionZ;
 
-		math::float3 normal;
-		math::float3 position;
-		math::float3 color;
-		math::float3 emissive;
+		std::vector<float> normalX;
+		std::vector<float> normalY;
+		std::vector<float> normalZ;
 
-		math::float3 v1;
-		math::float3 v2;
-		math::float3 v3;
+		std::vector<math::float3> color;
+		std::vector<math::float3> emissive;
+
+		std::size_t size() const noexcept { return texelIndex.size(); }
+		bool empty() const noexcept { return texelIndex.empty(); }
+
+		math::float3 position(std::size_t i) const noexcept { return math::float3(positionX[i], positionY[i], positionZ[i]); }
+		math::float3 normal(std::size_t i) const noexcept { return math::float3(normalX[i], normalY[i], normalZ[i]); }
+
+		void clear() noexcept;
+		void append(const Patches& other) noexcept;
 	};
 
 	class Lightmap final
@@ -40,41 +56,65 @@ namespace octoon::bake
 		void computeDirectLight(const DirectionalLight& light);
 		void computeIndirectLightBounce(const Camera& camera);
 
+		// Seconds the indirect solver may spend refining links before it settles for the coarser ones.
+		void setTimeBudget(float seconds) noexcept;
+		float getTimeBudget() const noexcept;
+
+		// Error a single link may make in the radiosity it carries, relative to the mean radiosity of the scene, before it is refined.
+		void setRefineThreshold(float threshold) noexcept;
+		float getRefineThreshold() const noexcept;
+
+		void setIndirectBounces(std::uint32_t bounces) noexcept;
+		std::uint32_t getIndirectBounces() const noexcept;
+
 		void setGeometry(const Geometry& geometry) noexcept;
-		void trySamplingConservativeTriangleRasterizerPatch(std::uint32_t mipmap, const math::float3& p1, const math::float3& p2, const math::float3& p3, const math::float2& tc1, const math::float2& tc2, const math::float2& tc3, const math::float3& n1, const math::float3& n2, const math::float3& n3, const math::float3& color) noexcept;
 
 	private:
-		bool trySamplingConservativeTriangleRasterizerPosition(std::uint32_t mipmap, Patch& patch);
-		bool isConservativeTriangleRasterizerFinished();
-		void moveToNextConservativeTriangleRasterizerPosition();
+		struct Triangle
+		{
+			math::float3 p[3];
+			math::float2 uv[3];
+			math::float3 color;
+		};
+
+		void rasterizePatches(std::uint32_t level, const std::vector<Triangle>& triangles) noexcept;
+
+		void buildClusters() noexcept;
+		void refineLinks() noexcept;
 
 	private:
-		struct
+		/*
+		* A node of the binary tree the indirect solver builds over the finest patches. `normal` is
+		* the area weighted mean of the patch normals, shorter than one when they disagree. Inner
+		* nodes hold their children at `left` and `left + 1`, and the patches in `first` to
+		* `first + count` of `clusterPatches_`, so one node contains another when its range does.
+		*/
+		struct Cluster
 		{
-			struct
-			{
-				float areaP;
-				float areaUV;
-
-				math::float3 p[3];
-				math::float2 uv[3];
-				math::float3 color;
-			} triangle;
-
-			struct
-			{
-				int minx, miny;
-				int maxx, maxy;
-				int x, y;
-			} rasterizer;
-
-			struct
-			{
-				math::float3 position;
-				math::float3 direction;
-				math::float3 up;
-			} sample;
-		} meshPosition;
+			math::float3 position;
+			math::float3 normal;
+			float area;
+			float radius;
+			float brightness;
+
+			std::uint32_t left;
+			std::uint32_t first;
+			std::uint32_t count;
+		};
+
+		// Side in texels of the square tiles the rasterizer bins triangles into, one task each.
+		static constexpr std::uint32_t TILE_SIZE = 32;
+
+		static constexpr std::uint32_t VISIBILITY_SAMPLES = 4;
+		static constexpr float SHADOW_REFINE_THRESHOLD = 0.01f;
+
+		// Light gathered by `receiver` from `emitter`, with the visibility already in `factor`.
+		struct Link
+		{
+			std::uint32_t receiver;
+			std::uint32_t emitter;
+			float factor;
+		};
 
 		struct
 		{
@@ -87,10 +127,19 @@ namespace octoon::bake
 
 		std::uint32_t mipLevel_;
 
-		std::vector<std::vector<bool>> usedTexels;
-		std::vector<std::vector<Patch>> patches_;
+		std::vector<Patches> patches_;
 		std::vector<std::vector<math::float3>> directLightBuffer_;
 		std::vector<math::float3> frontBuffer_;
+
+		LightmapBVH bvh_;
+
+		float timeBudget_;
+		float refineThreshold_;
+		std::uint32_t indirectBounces_;
+
+		std::vector<Cluster> clusters_;
+		std::vector<std::uint32_t> clusterPatches_;
+		std::vector<Link> links_;
 	};
 }
 
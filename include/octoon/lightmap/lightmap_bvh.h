@@ -0,0 +1,62 @@
+#ifndef OCTOON_LIGHTMAP_BVH_H_
+#define OCTOON_LIGHTMAP_BVH_H_
+
+#include <octoon/mesh/mesh.h>
+
+namespace octoon::bake
+{
+	/*
+	* A bounding volume hierarchy over the triangles of a mesh, built with a binned surface area
+	* heuristic. The baker only asks whether a segment is blocked, so triangles are two-sided and
+	* the traversal stops at the first hit. Queries are read-only and safe from several threads.
+	*/
+	class LightmapBVH final
+	{
+	public:
+		LightmapBVH() noexcept;
+		~LightmapBVH() noexcept;
+
+		void build(const Mesh& mesh) noexcept;
+		void clear() noexcept;
+
+		bool empty() const noexcept;
+		std::size_t getNumTriangles() const noexcept;
+
+		// Whether a triangle lies on the ray from `origin` along the unit `direction` closer than `maxDistance`.
+		bool occluded(const math::float3& origin, const math::float3& direction, float maxDistance) const noexcept;
+
+		// Four rays sharing one direction, like the shadow rays of a directional light, traced together.
+		// Only the lanes set in `mask` are traced, the result has the bits of the ones that are blocked.
+		std::uint32_t occluded4(const float originX[4], const float originY[4], const float originZ[4], const math::float3& direction, float maxDistance, std::uint32_t mask) const noexcept;
+
+	private:
+		struct Node
+		{
+			math::float3 min;
+			std::uint32_t offset; // first triangle of a leaf, or the second child of an inner node
+			math::float3 max;
+			std::uint32_t count; // zero for inner nodes, whose first child follows them
+		};
+
+		struct Triangle
+		{
+			math::float3 v0;
+			math::float3 e1;
+			math::float3 e2;
+		};
+
+		static constexpr std::uint32_t MAX_LEAF_TRIANGLES = 4;
+		static constexpr std::uint32_t NUM_BINS = 12;
+		static constexpr std::uint32_t MAX_DEPTH = 64;
+
+	private:
+		LightmapBVH(const LightmapBVH&) = delete;
+		LightmapBVH& operator=(const LightmapBVH&) = delete;
+
+	private:
+		std::vector<Node> nodes_;
+		std::vector<Triangle> triangles_;
+	};
+}
+
+#endif
@@ -149,6 +149,8 @@ namespace octoon
 		void setDirty(bool dirty) noexcept;
 		bool isDirty() const noexcept;
 
+		std::uint64_t getGeneration() const noexcept;
+
 		const std::vector<MaterialParam>& getMaterialParams() const noexcept;
 
 		std::size_t hash() const noexcept;
@@ -159,6 +161,7 @@ namespace octoon
 		std::string name_;
 
 		bool dirty_;
+		std::uint64_t generation_;
 
 		bool _enableScissorTest;
 		bool _enableSrgb;
@@ -0,0 +1,187 @@
+#ifndef OCTOON_MATH_SIMD_H_
+#define OCTOON_MATH_SIMD_H_
+
+#include <octoon/math/mat3.h>
+#include <octoon/math/mat4.h>
+#include <octoon/math/quat.h>
+#include <octoon/runtime/platform.h>
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define OCTOON_MATH_SIMD
+#endif
+
+namespace octoon
+{
+	namespace math
+	{
+		/*
+		* SSE versions of the hot float operations. They read and write the usual types, so
+		* nothing changes in memory, and they add in the same order as the scalar operators,
+		* which keeps every result bit-identical to them. Without SSE2 they fall back to those
+		* operators.
+		*/
+		namespace simd
+		{
+#if defined(OCTOON_MATH_SIMD)
+			namespace detail
+			{
+				inline __m128 load(const float3& v) noexcept
+				{
+					return _mm_set_ps(0.0f, v.z, v.y, v.x);
+				}
+
+				inline float3 store(__m128 v) noexcept
+				{
+					alignas(16) float out[4];
+					_mm_store_ps(out, v);
+					return float3(out[0], out[1], out[2]);
+				}
+
+				inline __m128 column(const float4x4& m, int i) noexcept
+				{
+					return _mm_loadu_ps(m.ptr() + i * 4);
+				}
+
+				// a * v.x + b * v.y + c * v.z + d * v.w
+				inline __m128 combine(__m128 a, __m128 b, __m128 c, __m128 d, __m128 v) noexcept
+				{
+					__m128 r = _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(b, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+					r = _mm_add_ps(r, _mm_mul_ps(c, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+					return _mm_add_ps(r, _mm_mul_ps(d, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+				}
+
+				// a * v.x + b * v.y + c * v.z
+				inline __m128 combine(__m128 a, __m128 b, __m128 c, __m128 v) noexcept
+				{
+					__m128 r = _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(b, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+					return _mm_add_ps(r, _mm_mul_ps(c, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+				}
+			}
+
+			// m1 * m2
+			inline float4x4 multiply(const float4x4& m1, const float4x4& m2) noexcept
+			{
+				__m128 a = detail::column(m1, 0);
+				__m128 b = detail::column(m1, 1);
+				__m128 c = detail::column(m1, 2);
+				__m128 d = detail::column(m1, 3);
+
+				float4x4 out;
+				_mm_storeu_ps(out.ptr() + 0, detail::combine(a, b, c, d, detail::column(m2, 0)));
+				_mm_storeu_ps(out.ptr() + 4, detail::combine(a, b, c, d, detail::column(m2, 1)));
+				_mm_storeu_ps(out.ptr() + 8, detail::combine(a, b, c, d, detail::column(m2, 2)));
+				_mm_storeu_ps(out.ptr() + 12, detail::combine(a, b, c, d, detail::column(m2, 3)));
+				return out;
+			}
+
+			// math::transformMultiply, both matrices are affine.
+			inline float4x4 transformMultiply(const float4x4& m1, const float4x4& m2) noexcept
+			{
+				const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+				__m128 a = _mm_and_ps(detail::column(m1, 0), mask);
+				__m128 b = _mm_and_ps(detail::column(m1, 1), mask);
+				__m128 c = _mm_and_ps(detail::column(m1, 2), mask);
+				__m128 d = _mm_or_ps(_mm_and_ps(detail::column(m1, 3), mask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+
+				float4x4 out;
+				// The masked w lanes would come out as -0 where the scalar version writes 0.
+				_mm_storeu_ps(out.ptr() + 0, _mm_and_ps(detail::combine(a, b, c, detail::column(m2, 0)), mask));
+				_mm_storeu_ps(out.ptr() + 4, _mm_and_ps(detail::combine(a, b, c, detail::column(m2, 1)), mask));
+				_mm_storeu_ps(out.ptr() + 8, _mm_and_ps(detail::combine(a, b, c, detail::column(m2, 2)), mask));
+				_mm_storeu_ps(out.ptr() + 12, _mm_add_ps(detail::combine(a, b, c, detail::column(m2, 3)), d));
+				return out;
+			}
+
+			// m * v
+			inline float4 transform(const float4x4& m, const float4& v) noexcept
+			{
+				float4 out;
+				_mm_storeu_ps(out.ptr(), detail::combine(detail::column(m, 0), detail::column(m, 1), detail::column(m, 2), detail::column(m, 3), _mm_loadu_ps(v.ptr())));
+				return out;
+			}
+
+			// m * v, with the perspective divide.
+			inline float3 transformPoint(const float4x4& m, const float3& v) noexcept
+			{
+				__m128 p = detail::combine(detail::column(m, 0), detail::column(m, 1), detail::column(m, 2), detail::load(v));
+				p = _mm_add_ps(p, detail::column(m, 3));
+				__m128 w = _mm_div_ps(_mm_set1_ps(1.0f), _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)));
+				return detail::store(_mm_mul_ps(p, w));
+			}
+
+			// (float3x3)m * v
+			inline float3 transformNormal(const float4x4& m, const float3& v) noexcept
+			{
+				return detail::store(detail::combine(detail::column(m, 0), detail::column(m, 1), detail::column(m, 2), detail::load(v)));
+			}
+
+			// math::rotate
+			inline float3 rotate(const Quaternion& q, const float3& v) noexcept
+			{
+				__m128 qv = _mm_loadu_ps(&q.x);
+				__m128 vv = detail::load(v);
+				vv = _mm_add_ps(vv, vv);
+
+				__m128 qw = _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 3, 3, 3));
+				__m128 w2 = _mm_sub_ps(_mm_mul_ps(qw, qw), _mm_set1_ps(0.5f));
+
+				__m128 dot = _mm_mul_ps(qv, vv);
+				dot = _mm_add_ps(_mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 1, 1, 1))), _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 2, 2, 2)));
+				dot = _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(0, 0, 0, 0));
+
+				__m128 cross = _mm_sub_ps(
+					_mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(vv, vv, _MM_SHUFFLE(3, 1, 0, 2))),
+					_mm_mul_ps(_mm_shuffle_ps(qv, qv, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(vv, vv, _MM_SHUFFLE(3, 0, 2, 1))));
+
+				__m128 r = _mm_add_ps(_mm_mul_ps(vv, w2), _mm_mul_ps(cross, qw));
+				return detail::store(_mm_add_ps(r, _mm_mul_ps(qv, dot)));
+			}
+#else
+			inline float4x4 multiply(const float4x4& m1, const float4x4& m2) noexcept
+			{
+				return m1 * m2;
+			}
+
+			inline float4x4 transformMultiply(const float4x4& m1, const float4x4& m2) noexcept
+			{
+				return math::transformMultiply(m1, m2);
+			}
+
+			inline float4 transform(const float4x4& m, const float4& v) noexcept
+			{
+				return m * v;
+			}
+
+			inline float3 transformPoint(const float4x4& m, const float3& v) noexcept
+			{
+				return m * v;
+			}
+
+			inline float3 transformNormal(const float4x4& m, const float3& v) noexcept
+			{
+				return (float3x3)m * v;
+			}
+
+			inline float3 rotate(const Quaternion& q, const float3& v) noexcept
+			{
+				return math::rotate(q, v);
+			}
+#endif
+
+			// Batch versions of the above. `out` may be `in`, it may not overlap it otherwise.
+			OCTOON_EXPORT void transformPoints(const float4x4& m, const float3* in, float3* out, std::size_t count) noexcept;
+			OCTOON_EXPORT void transformNormals(const float4x4& m, const float3* in, float3* out, std::size_t count) noexcept;
+			OCTOON_EXPORT void rotate(const Quaternion& q, const float3* in, float3* out, std::size_t count) noexcept;
+
+			// out[i] = m1[i] * m2[i], any of the arrays may be the same one.
+			OCTOON_EXPORT void multiply(const float4x4* m1, const float4x4* m2, float4x4* out, std::size_t count) noexcept;
+			OCTOON_EXPORT void transformMultiply(const float4x4* m1, const float4x4* m2, float4x4* out, std::size_t count) noexcept;
+		}
+	}
+}
+
+#endif
@@ -93,6 +93,8 @@ namespace octoon
 		void setDirty(bool dirty) noexcept;
 		bool isDirty() const noexcept;
 
+		std::uint64_t getGeneration() const noexcept;
+
 		bool raycast(const math::Raycast& ray, MeshHit& hit) noexcept;
 		bool raycastAll(const math::Raycast& ray, std::vector<MeshHit>& hits) noexcept;
 
@@ -102,6 +104,7 @@ namespace octoon
 	private:
 		std::string _name;
 		bool _dirty;
+		std::uint64_t _generation;
 
 		math::float3s _vertices;
 		math::float3s _normals;
@@ -26,6 +26,9 @@ namespace octoon
 		virtual void setGlobalIllumination(bool enable) noexcept;
 		virtual bool getGlobalIllumination() const noexcept;
 
+		virtual void setStatic(bool enable) noexcept;
+		virtual bool getStatic() const noexcept;
+
 		virtual void uploadMeshData(const MeshPtr& mesh) noexcept;
 		virtual void uploadMaterialData(const Materials& material) noexcept;
 
@@ -49,6 +52,7 @@ namespace octoon
 	private:
 		bool visible_;
 		bool globalIllumination_;
+		bool static_;
 
 		std::int32_t renderOrder_;
 		std::shared_ptr<Geometry> geometry_;
@@ -0,0 +1,95 @@
+#ifndef OCTOON_MODEL_GLYPH_CACHE_H_
+#define OCTOON_MODEL_GLYPH_CACHE_H_
+
+#include <octoon/model/contour_group.h>
+#include <octoon/model/path_group.h>
+#include <octoon/model/font.h>
+#include <octoon/mesh/mesh.h>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace octoon::font
+{
+	/*
+	* Glyphs of one font at one pixel size. FreeType is asked for each glyph once, its outline is
+	* kept in pixels at the origin, and the contours and tessellated meshes made from it are kept
+	* as well, so a text only has to place the cached pieces side by side.
+	*/
+	class OCTOON_EXPORT GlyphCache final
+	{
+	public:
+		struct Glyph
+		{
+			float advance;
+
+			math::float3s points;
+			std::vector<char> tags;
+			std::vector<std::uint16_t> contours; // index of the last point of each contour
+		};
+
+		// A glyph in the distance field atlas, `rect` in texels, `offset` from the pen to its lower left corner.
+		struct DistanceGlyph
+		{
+			float advance;
+
+			math::uint4 rect;
+			math::float2 offset;
+		};
+
+		// Texels a distance field reaches outside of the glyph, it is also the padding around it in the atlas.
+		static constexpr std::uint32_t DISTANCE_SPREAD = 4;
+		static constexpr std::uint32_t DISTANCE_ATLAS_WIDTH = 512;
+
+		GlyphCache(const std::shared_ptr<Font>& font, std::uint16_t pixelsSize) noexcept;
+		~GlyphCache() noexcept;
+
+		const std::shared_ptr<Font>& getFont() const noexcept;
+		std::uint16_t getPixelsSize() const noexcept;
+
+		const Glyph& getGlyph(wchar_t ch) noexcept(false);
+
+		PathGroupPtr getPaths(wchar_t ch) noexcept(false);
+		ContourGroupPtr getContours(wchar_t ch, std::uint16_t bezierSteps) noexcept(false);
+		std::shared_ptr<const Mesh> getMesh(wchar_t ch, std::uint16_t bezierSteps, float thickness, bool hollow) noexcept(false);
+
+		// Signed distance fields of the glyphs in a single channel atlas, 128 on the outline, rows from the top.
+		// The atlas grows downwards as glyphs are added, `getDistanceAtlasGeneration` changes whenever it does.
+		const DistanceGlyph& getDistanceGlyph(wchar_t ch) noexcept(false);
+		const std::vector<std::uint8_t>& getDistanceAtlas() const noexcept;
+		std::uint32_t getDistanceAtlasWidth() const noexcept;
+		std::uint32_t getDistanceAtlasHeight() const noexcept;
+		std::uint64_t getDistanceAtlasGeneration() const noexcept;
+
+		void clear() noexcept;
+
+	private:
+		const Glyph& loadGlyph(wchar_t ch) noexcept(false);
+
+	private:
+		GlyphCache(const GlyphCache&) = delete;
+		GlyphCache& operator=(const GlyphCache&) = delete;
+
+	private:
+		std::shared_ptr<Font> font_;
+		std::uint16_t pixelSize_;
+
+		std::recursive_mutex mutex_;
+
+		std::unordered_map<wchar_t, Glyph> glyphs_;
+		std::unordered_map<wchar_t, PathGroupPtr> paths_;
+		std::map<std::pair<wchar_t, std::uint16_t>, ContourGroupPtr> contours_;
+		std::map<std::tuple<wchar_t, std::uint16_t, float, bool>, std::shared_ptr<const Mesh>> meshes_;
+
+		std::unordered_map<wchar_t, DistanceGlyph> distanceGlyphs_;
+		std::vector<std::uint8_t> distanceAtlas_;
+		std::uint32_t distanceAtlasHeight_;
+		std::uint64_t distanceAtlasGeneration_;
+		math::uint2 shelfCursor_;
+		std::uint32_t shelfHeight_;
+	};
+}
+
+#endif
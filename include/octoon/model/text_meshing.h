@@ -4,6 +4,7 @@
 #include <octoon/model/path_group.h>
 #include <octoon/model/contour_group.h>
 #include <octoon/model/font.h>
+#include <octoon/model/glyph_cache.h>
 
 namespace octoon::font
 {
@@ -31,6 +32,9 @@ namespace octoon::font
 		void setPixelsSize(std::uint16_t pixelsSize) noexcept;
 		std::uint16_t getPixelsSize() const noexcept;
 
+		// Shared with clones, replaced when the font or the size changes.
+		const std::shared_ptr<GlyphCache>& getGlyphCache() const noexcept;
+
 		virtual std::shared_ptr<TextMeshing> clone() const noexcept;
 
 	private:
@@ -40,6 +44,7 @@ namespace octoon::font
 	private:
 		std::shared_ptr<Font> font_;
 		std::uint16_t pixelSize_;
+		std::shared_ptr<GlyphCache> glyphCache_;
 	};
 
 	OCTOON_EXPORT PathGroups makeTextPaths(const std::wstring& string, const TextMeshing& params) noexcept(false);
@@ -48,8 +53,12 @@ namespace octoon::font
 	OCTOON_EXPORT ContourGroups makeTextContours(const PathGroups& paths, std::uint16_t bezierSteps = 8) noexcept(false);
 	OCTOON_EXPORT ContourGroups makeTextContours(const std::wstring& string, const TextMeshing& params, std::uint16_t bezierSteps = 8, TextAlign align = TextAlign::Left) noexcept(false);
 
-	OCTOON_EXPORT Mesh makeText(const std::wstring& string, const TextMeshing& params, float thickness = 1.0f, std::uint16_t bezierSteps = 8) noexcept(false);
+	OCTOON_EXPORT Mesh makeText(const std::wstring& string, const TextMeshing& params, float thickness = 1.0f, std::uint16_t bezierSteps = 8, TextAlign align = TextAlign::Left) noexcept(false);
 	OCTOON_EXPORT Mesh makeTextWireframe(const std::wstring& string, const TextMeshing& params, float thickness = 1.0f, std::uint16_t bezierSteps = 8) noexcept(false);
+
+	// Flat text as one quad per glyph, textured with the distance field atlas of params.getGlyphCache().
+	// The texcoords depend on the atlas height, so the mesh is rebuilt when its generation changes.
+	OCTOON_EXPORT Mesh makeTextQuads(const std::wstring& string, const TextMeshing& params, TextAlign align = TextAlign::Left) noexcept(false);
 }
 
 #endif
\ No newline at end of file
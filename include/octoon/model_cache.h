@@ -0,0 +1,44 @@
+#ifndef OCTOON_MODEL_CACHE_H_
+#define OCTOON_MODEL_CACHE_H_
+
+#include <octoon/model/model.h>
+
+namespace octoon
+{
+	/*
+	* Versioned binary ("cooked") form of a `Model`, keyed by a hash of the source
+	* file contents. Vertex streams, index buffers, bones, IK chains, morphs,
+	* physics bodies and material references are stored in page-aligned sections,
+	* so a cooked file can be memory-mapped and copied straight into `Mesh` arrays.
+	*
+	* The cache is disabled until `setCacheDirectory` is given an existing
+	* directory; any other path disables it again and returns false. Importers
+	* consult it through `load` and populate it with `save`, and only models whose
+	* textures all loaded are saved, so a missing texture is retried next time.
+	* Textures under `rootPath`, the directory of the source file, are stored
+	* relative to it, so a copy of the file elsewhere loads its own textures.
+	*/
+	class OCTOON_EXPORT ModelCache final
+	{
+	public:
+		static constexpr std::uint32_t version = 2;
+
+		static bool setCacheDirectory(std::string_view path) noexcept;
+		static const std::string& getCacheDirectory() noexcept;
+
+		static bool isEnabled() noexcept;
+
+		static std::uint64_t hash(const char* data, std::size_t size) noexcept;
+
+		static bool load(std::uint64_t hash, std::string_view rootPath, Model& model) noexcept(false);
+		static bool save(std::uint64_t hash, std::string_view rootPath, const Model& model) noexcept(false);
+
+		static bool load(std::string_view filepath, std::uint64_t hash, std::string_view rootPath, Model& model) noexcept(false);
+		static bool save(std::string_view filepath, std::uint64_t hash, std::string_view rootPath, const Model& model) noexcept(false);
+
+	private:
+		static std::string makePath(std::uint64_t hash) noexcept;
+	};
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include <octoon/audio_feature.h>
 
 #include <octoon/io/fstream.h>
+#include <octoon/io/mmap_stream.h>
 
 #include <octoon/model/model.h>
 #include <octoon/model/text_meshing.h>
@@ -39,6 +39,11 @@ namespace octoon
 
 		virtual void simulate(float time) = 0;
 
+		// Split form of simulate(): beginSimulate hands the step to a worker thread and returns at once,
+		// endSimulate blocks until that step has completed. Bodies must not be read or modified in between.
+		virtual void beginSimulate(float time) = 0;
+		virtual void endSimulate() = 0;
+
 		virtual void fetchResults() = 0;
 
 	private:
@@ -4,6 +4,8 @@
 #include <octoon/game_feature.h>
 #include <octoon/physics/physics_context.h>
 
+#include <unordered_map>
+
 namespace octoon
 {
 	class OCTOON_EXPORT PhysicsFeature final : public GameFeature
@@ -16,10 +18,29 @@ namespace octoon
 		void setEnableSimulate(bool simulate) noexcept;
 		bool getEnableSimulate() const noexcept;
 
+		// When enabled, the fixed step runs on a worker thread from onFrameBegin until it is fetched in onFrame,
+		// overlapping the game update. Disabled by default to keep playback deterministic.
+		void setEnableAsyncSimulate(bool enable) noexcept;
+		bool getEnableAsyncSimulate() const noexcept;
+
+		// When enabled, rigidbodies blend between the last two fetched states using getInterpolationFactor.
+		void setEnableInterpolation(bool enable) noexcept;
+		bool getEnableInterpolation() const noexcept;
+
+		float getInterpolationFactor() const noexcept;
+		std::uint64_t getSimulateCount() const noexcept;
+
 		void setGravity(const math::float3& gravity) noexcept;
 		const math::float3& getGravity() const noexcept;
 
 		void simulate() noexcept;
+		void fetchResults() noexcept;
+
+		// Blocks until a running asynchronous step has finished, without dispatching its results.
+		void waitSimulate() noexcept;
+
+		// Moves a kinematic body without waiting for a running step, the pose is applied once it has finished.
+		void setKinematicPose(const std::shared_ptr<PhysicsRigidbody>& rigidbody, const math::float3& position, const math::Quaternion& rotation) noexcept;
 
 	public:
 		void onActivate() except override;
@@ -31,12 +52,15 @@ namespace octoon
 		void onFrame() except;
 		void onFrameEnd() noexcept override;
 
-		void onFixedUpdate(const std::any& data) noexcept;
+		void onFixedUpdate(float timeInterval) noexcept;
 
 	public:
 		std::shared_ptr<PhysicsContext> getContext();
 		std::shared_ptr<PhysicsScene> getScene();
 
+	private:
+		void applyPendingPoses() noexcept;
+
 	private:
 		PhysicsFeature(const PhysicsFeature&) = delete;
 		PhysicsFeature& operator=(const PhysicsFeature&) = delete;
@@ -44,12 +68,26 @@ namespace octoon
 	private:
 		bool forceSimulate_;
 		bool enableSimulate_;
+		bool enableAsyncSimulate_;
+		bool enableInterpolation_;
+		bool simulating_;
+
+		std::uint64_t simulateCount_;
 
 		int maxSubSteps_;
 		math::float3 gravity_;
 
 		std::shared_ptr<PhysicsContext> physicsContext;
 		std::shared_ptr<PhysicsScene> physicsScene;
+
+		struct PendingPose
+		{
+			std::shared_ptr<PhysicsRigidbody> rigidbody;
+			math::float3 position;
+			math::Quaternion rotation;
+		};
+
+		std::unordered_map<const PhysicsRigidbody*, PendingPose> pendingPoses_;
 	};
 }
 
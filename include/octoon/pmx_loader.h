@@ -442,6 +442,7 @@ namespace octoon
 		bool doCanRead(const char* type) const noexcept;
 
 		bool doLoad(std::string_view filepath, PMX& pmx) noexcept;
+		bool doLoad(const char* data, std::size_t size, PMX& pmx) noexcept;
 		bool doLoad(std::string_view filepath, Model& model) noexcept;
 
 		bool doSave(io::ostream& stream, const PMX& pmx) noexcept;
@@ -71,6 +71,7 @@ namespace octoon
         void onDetachComponent(const GameComponentPtr& component) noexcept;
 
 		void onFetchResult() noexcept override;
+		void onLateUpdate() noexcept override;
 
 		void onLayerChangeAfter() noexcept;
 		void onMoveAfter() noexcept;
@@ -78,6 +79,9 @@ namespace octoon
 	private:
 		void initializeRigidbody(class ColliderComponent& collder) noexcept;
 
+		// Bodies must not be modified while an asynchronous physics step is running.
+		void waitSimulate() noexcept;
+
 	private:
         bool isKinematic_;
 		bool enableCCD_;
@@ -98,6 +102,10 @@ namespace octoon
 		math::float3 position_;
 		math::Quaternion rotation_;
 
+		math::float3 lastPosition_;
+		math::Quaternion lastRotation_;
+		std::uint64_t fetchCount_;
+
 		math::float3 center_;
 		math::Quaternion quaternion_;
 
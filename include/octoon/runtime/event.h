@@ -0,0 +1,259 @@
+#ifndef OCTOON_EVENT_H_
+#define OCTOON_EVENT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		// FNV-1a of the name, a constant for names known at compile time.
+		constexpr std::uint64_t makeEventId(std::string_view name) noexcept
+		{
+			std::uint64_t hash = 14695981039346656037ull;
+			for (auto ch : name)
+			{
+				hash ^= static_cast<std::uint8_t>(ch);
+				hash *= 1099511628211ull;
+			}
+
+			return hash;
+		}
+
+		// An event id together with the type of its payload, `void` for events without one.
+		template<typename T>
+		struct Event
+		{
+			using value_type = T;
+
+			constexpr explicit Event(std::string_view name) noexcept
+				: id(makeEventId(name))
+			{
+			}
+
+			std::uint64_t id;
+		};
+
+		/*
+		* Listeners are kept in one array sorted by event id and called through plain function
+		* pointers, so sending an event is a binary search and a few indirect calls, without string
+		* lookups or allocations. Listeners added or removed by a handler take effect once the
+		* outermost dispatch returns. Events given to `post` are queued with a copy of their payload
+		* until `flush` sends them in order. Like the objects that own it, it is not thread-safe.
+		*/
+		class EventDispatcher final
+		{
+		public:
+			EventDispatcher() noexcept
+				: dispatching_(0)
+				, flushing_(false)
+				, dirty_(false)
+			{
+			}
+
+			template<auto Fn, typename T, typename C>
+			void addListener(const Event<T>& event, C* object) noexcept
+			{
+				Listener listener{ event.id, object, &invoke<Fn, T, C> };
+
+				if (dispatching_ > 0)
+				{
+					pending_.push_back(listener);
+					dirty_ = true;
+				}
+				else
+				{
+					this->insert(listener);
+				}
+			}
+
+			template<auto Fn, typename T, typename C>
+			void removeListener(const Event<T>& event, C* object) noexcept
+			{
+				Listener listener{ event.id, object, &invoke<Fn, T, C> };
+
+				pending_.erase(std::remove(pending_.begin(), pending_.end(), listener), pending_.end());
+
+				auto end = this->upperBound(event.id);
+				auto it = std::find(this->lowerBound(event.id), end, listener);
+				if (it != end)
+				{
+					if (dispatching_ > 0)
+					{
+						it->object = nullptr;
+						dirty_ = true;
+					}
+					else
+					{
+						listeners_.erase(it);
+					}
+				}
+			}
+
+			template<typename T>
+			void dispatch(const Event<T>& event, const T& data) noexcept
+			{
+				this->dispatch(event.id, &data);
+			}
+
+			void dispatch(const Event<void>& event) noexcept
+			{
+				this->dispatch(event.id, nullptr);
+			}
+
+			template<typename T>
+			void post(const Event<T>& event, const T& data) noexcept
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "posted payloads are copied as bytes");
+
+				auto offset = (payloads_.size() + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+				payloads_.resize(offset + sizeof(T));
+				std::memcpy(payloads_.data() + offset, &data, sizeof(T));
+
+				posted_.push_back(Posted{ event.id, offset, true });
+			}
+
+			void post(const Event<void>& event) noexcept
+			{
+				posted_.push_back(Posted{ event.id, 0, false });
+			}
+
+			// Sends the queued events, the ones their handlers post wait for the next flush.
+			void flush() noexcept
+			{
+				if (flushing_)
+					return;
+
+				flushing_ = true;
+
+				posted_.swap(flushingPosted_);
+				payloads_.swap(flushingPayloads_);
+
+				for (auto& it : flushingPosted_)
+					this->dispatch(it.id, it.hasData ? flushingPayloads_.data() + it.offset : nullptr);
+
+				flushingPosted_.clear();
+				flushingPayloads_.clear();
+
+				flushing_ = false;
+			}
+
+			void clear() noexcept
+			{
+				if (dispatching_ > 0)
+				{
+					for (auto& it : listeners_)
+						it.object = nullptr;
+					dirty_ = true;
+				}
+				else
+				{
+					listeners_.clear();
+				}
+
+				pending_.clear();
+				posted_.clear();
+				payloads_.clear();
+			}
+
+		private:
+			using Thunk = void(*)(void* object, const void* data);
+
+			struct Listener
+			{
+				std::uint64_t id;
+				void* object;
+				Thunk thunk;
+
+				bool operator==(const Listener& other) const noexcept
+				{
+					return id == other.id && object == other.object && thunk == other.thunk;
+				}
+			};
+
+			struct Posted
+			{
+				std::uint64_t id;
+				std::size_t offset;
+				bool hasData;
+			};
+
+			template<auto Fn, typename T, typename C>
+			static void invoke(void* object, const void* data) noexcept
+			{
+				if constexpr (std::is_void<T>::value)
+					(static_cast<C*>(object)->*Fn)();
+				else
+					(static_cast<C*>(object)->*Fn)(*static_cast<const T*>(data));
+			}
+
+			std::vector<Listener>::iterator lowerBound(std::uint64_t id) noexcept
+			{
+				return std::lower_bound(listeners_.begin(), listeners_.end(), id, [](const Listener& a, std::uint64_t b) { return a.id < b; });
+			}
+
+			std::vector<Listener>::iterator upperBound(std::uint64_t id) noexcept
+			{
+				return std::upper_bound(listeners_.begin(), listeners_.end(), id, [](std::uint64_t a, const Listener& b) { return a < b.id; });
+			}
+
+			void insert(const Listener& listener) noexcept
+			{
+				auto end = this->upperBound(listener.id);
+				if (std::find(this->lowerBound(listener.id), end, listener) == end)
+					listeners_.insert(end, listener);
+			}
+
+			void dispatch(std::uint64_t id, const void* data) noexcept
+			{
+				auto begin = this->lowerBound(id) - listeners_.begin();
+				auto end = this->upperBound(id) - listeners_.begin();
+
+				dispatching_++;
+
+				for (auto i = begin; i < end; i++)
+				{
+					auto& listener = listeners_[i];
+					if (listener.object)
+						listener.thunk(listener.object, data);
+				}
+
+				if (--dispatching_ == 0 && dirty_)
+				{
+					listeners_.erase(std::remove_if(listeners_.begin(), listeners_.end(), [](const Listener& it) { return !it.object; }), listeners_.end());
+
+					for (auto& it : pending_)
+						this->insert(it);
+
+					pending_.clear();
+					dirty_ = false;
+				}
+			}
+
+		private:
+			EventDispatcher(const EventDispatcher&) = delete;
+			EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+		private:
+			std::uint32_t dispatching_;
+			bool flushing_;
+			bool dirty_;
+
+			std::vector<Listener> listeners_;
+			std::vector<Listener> pending_;
+
+			std::vector<Posted> posted_;
+			std::vector<Posted> flushingPosted_;
+			std::vector<std::uint8_t> payloads_;
+			std::vector<std::uint8_t> flushingPayloads_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef OCTOON_PROFILER_H_
+#define OCTOON_PROFILER_H_
+
+#include <octoon/runtime/platform.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		struct ProfileEvent
+		{
+			const char* name;
+			std::uint64_t begin;
+			std::uint64_t end;
+			std::uint32_t depth;
+			std::uint32_t thread;
+		};
+
+		/*
+		* Hierarchical frame profiler. Scopes are written to per-thread ring buffers without
+		* locking and gathered by `endFrame`, which keeps a short history for the overlay and
+		* the Chrome trace export. Names must outlive the profiler, so pass string literals or
+		* RTTI names. Times are nanoseconds since the profiler was first used.
+		*/
+		class OCTOON_EXPORT Profiler final
+		{
+		public:
+			static constexpr std::uint32_t GPU_THREAD = 0xFFFFFFFF;
+
+			static void setEnable(bool enable) noexcept;
+			static bool getEnable() noexcept;
+
+			static std::uint64_t now() noexcept;
+
+			static void beginScope(const char* name) noexcept;
+			static void endScope() noexcept;
+
+			// Adds an event measured elsewhere, such as a GPU timestamp pair.
+			static void addEvent(const char* name, std::uint32_t thread, std::uint64_t begin, std::uint64_t end, std::uint32_t depth) noexcept;
+
+			static void beginFrame() noexcept;
+			static void endFrame() noexcept;
+
+			static void setHistoryLength(std::size_t frames) noexcept;
+			static std::size_t getHistoryLength() noexcept;
+
+			static std::vector<ProfileEvent> getFrameEvents() noexcept;
+			static std::uint64_t getFrameTime() noexcept;
+
+			static bool saveChromeTrace(const std::string& path) noexcept;
+
+		private:
+			Profiler() = delete;
+		};
+
+		class ProfileScope final
+		{
+		public:
+			ProfileScope(const char* name) noexcept
+				: enable_(Profiler::getEnable())
+			{
+				if (enable_)
+					Profiler::beginScope(name);
+			}
+
+			~ProfileScope() noexcept
+			{
+				if (enable_)
+					Profiler::endScope();
+			}
+
+		private:
+			ProfileScope(const ProfileScope&) = delete;
+			ProfileScope& operator=(const ProfileScope&) = delete;
+
+		private:
+			bool enable_;
+		};
+	}
+}
+
+#define OCTOON_PROFILE_CONCAT_(a, b) a##b
+#define OCTOON_PROFILE_CONCAT(a, b) OCTOON_PROFILE_CONCAT_(a, b)
+#define OCTOON_PROFILE_SCOPE(name) octoon::runtime::ProfileScope OCTOON_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef OCTOON_RTTI_H_
 #define OCTOON_RTTI_H_
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -32,9 +33,16 @@ namespace octoon
 			bool isDerivedFrom(std::string_view name) const noexcept;
 
 		private:
+			friend class RttiFactory;
+
 			std::string name_;
 			const Rtti* parent_;
 			RttiConstruct construct_;
+
+			// Pre-order index of the type and of its last descendant, assigned by `RttiFactory::open`.
+			// Zero until then, in which case subtype tests walk the parent chain instead.
+			std::uint32_t first_;
+			std::uint32_t last_;
 		};
 	}
 }
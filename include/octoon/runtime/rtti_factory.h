@@ -1,7 +1,8 @@
 #ifndef OCTOON_RTTI_FACTORY_H_
 #define OCTOON_RTTI_FACTORY_H_
 
-#include <map>
+#include <string_view>
+#include <unordered_map>
 
 #include <octoon/runtime/rtti.h>
 #include <octoon/runtime/rtti_interface.h>
@@ -17,6 +18,7 @@ namespace octoon
 			RttiFactory() = default;
 			~RttiFactory() = default;
 
+			// Indexes the registered types by name and numbers the hierarchy for `Rtti::isDerivedFrom`.
 			bool open() noexcept;
 
 			bool add(Rtti* rtti) noexcept;
@@ -42,7 +44,7 @@ namespace octoon
 
 		private:
 			std::vector<Rtti*> rttis_;
-			std::map<std::string, Rtti*, std::less<>> rttiLists_;
+			std::unordered_map<std::string_view, Rtti*> rttiLists_;
 		};
 
 		namespace rtti
@@ -8,6 +8,13 @@ namespace octoon
 	class OCTOON_EXPORT SkinnedComponent : public GameComponent
 	{
 		OctoonDeclareSubInterface(SkinnedComponent, GameComponent)
+	public:
+		// Sent to the object whenever a pose, morph or texture control changes.
+		static constexpr runtime::Event<void> AnimationUpdateEvent{ "octoon:animation:update" };
+
+		// The control value of the components whose name matches the one of an animation curve.
+		static constexpr runtime::Event<float> makeControlEvent(std::string_view name) noexcept { return runtime::Event<float>(name); }
+
 	public:
 		SkinnedComponent() noexcept;
 		virtual ~SkinnedComponent() noexcept;
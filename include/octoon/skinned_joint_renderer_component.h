@@ -29,7 +29,7 @@ namespace octoon
 
 		void onFixedUpdate() noexcept override;
 
-		void onAnimationUpdate(const std::any& data) noexcept;
+		void onAnimationUpdate() noexcept;
 
 		void onPreRender(const Camera& camera) noexcept override;
 
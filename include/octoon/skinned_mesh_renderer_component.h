@@ -47,7 +47,7 @@ namespace octoon
 		void onDeactivate() noexcept override;
 
 		void onFixedUpdate() noexcept override;
-		void onAnimationUpdate(const std::any& mesh) noexcept;
+		void onAnimationUpdate() noexcept;
 
 		void onAttachComponent(const GameComponentPtr& component) noexcept override;
 		void onDetachComponent(const GameComponentPtr& component) noexcept override;
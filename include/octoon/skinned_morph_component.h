@@ -29,7 +29,7 @@ namespace octoon
 		void onActivate() noexcept override;
 		void onDeactivate() noexcept override;
 
-		void onAnimationUpdate(const std::any& mesh) noexcept;
+		void onAnimationUpdate(float value) noexcept;
 		void onTargetReplace(std::string_view name) noexcept override;
 
 	private:
@@ -47,6 +47,7 @@ namespace octoon
 		MeshPtr mesh_;
 		font::TextAlign align_;
 		std::shared_ptr<font::TextMeshing> meshing_;
+		std::shared_ptr<font::TextMeshing> defaultMeshing_;
 	};
 }
 
@@ -9,6 +9,10 @@ namespace octoon
 	class OCTOON_EXPORT TimerFeature final : public GameFeature
 	{
 		OctoonDeclareSubClass(TimerFeature, GameFeature)
+	public:
+		// Sent once per fixed step with the step length, by as many steps as the last frame took.
+		static constexpr runtime::Event<float> FixedUpdateEvent{ "feature:timer:fixed" };
+
 	public:
 		TimerFeature() noexcept;
 		~TimerFeature() noexcept;
@@ -24,6 +28,7 @@ namespace octoon
 		float frameTime() const noexcept;
 
 		float delta() const noexcept;
+		float fixedAlpha() const noexcept;
 
 		float elapsed() const noexcept;
 		float elapsedMax() const noexcept;
@@ -0,0 +1,81 @@
+#ifndef OCTOON_VIDEO_LIGHT_CLUSTERS_H_
+#define OCTOON_VIDEO_LIGHT_CLUSTERS_H_
+
+#include <octoon/video/rendering_data.h>
+
+namespace octoon
+{
+	/*
+	* Froxel light assignment for the forward renderer. The view frustum is split into
+	* screen tiles and exponential depth slices, and each cluster records which point and
+	* spot lights reach it. Both tables have fixed sizes matching the uniform blocks the
+	* shaders declare, so the program does not depend on how many lights the scene holds.
+	*/
+	class OCTOON_EXPORT LightClusters final
+	{
+	public:
+		static constexpr std::uint32_t TILES_X = 16;
+		static constexpr std::uint32_t TILES_Y = 8;
+		static constexpr std::uint32_t SLICES = 24;
+		static constexpr std::uint32_t NUM_CLUSTERS = TILES_X * TILES_Y * SLICES;
+
+		// Capacity of each light block, 128 * 80 bytes stays within the 16KB every GL 3.3 device supports.
+		static constexpr std::uint32_t MAX_LIGHTS = 128;
+		static constexpr std::uint32_t MAX_INDICES = 16384;
+
+		// std140 image of the `LightClusters` block. A record packs the offset of the cluster in the
+		// index list in 16 bits, then its point light count and spot light count in 8 bits each.
+		// `params.zw` count the global point and spot lights stored at the head of the index list.
+		struct Grid
+		{
+			math::float4 params;
+			std::uint32_t records[NUM_CLUSTERS];
+		};
+
+		LightClusters() noexcept;
+
+		// Lights are in view space and reach as far as their `distance`. Lights without one are global,
+		// they are listed once and shaded in every cluster rather than linked to each of them.
+		void build(const math::float4x4& projection, const math::float4x4& projectionInverse, float znear, float zfar, const std::vector<RenderingData::PointLight>& pointLights, const std::vector<RenderingData::SpotLight>& spotLights) noexcept;
+
+		const Grid& getGrid() const noexcept;
+
+		// One byte per light, the index list block reads four per component.
+		const std::uint8_t* getIndices() const noexcept;
+		std::size_t getNumIndices() const noexcept;
+
+	private:
+		struct Bound
+		{
+			math::float3 min;
+			math::float3 max;
+		};
+
+		void updateBounds(const math::float4x4& projection, const math::float4x4& projectionInverse, float znear, float zfar) noexcept;
+		void assign(const math::float3& position, float radius, std::uint32_t light, std::uint32_t type) noexcept;
+
+	private:
+		LightClusters(const LightClusters&) = delete;
+		LightClusters& operator=(const LightClusters&) = delete;
+
+	private:
+		math::float4x4 projection_;
+		float znear_;
+		float zfar_;
+		float forward_;
+
+		Grid grid_;
+		std::vector<Bound> bounds_;
+
+		std::vector<std::uint8_t> indices_;
+		std::vector<std::uint32_t> counts_[2];
+		std::vector<std::uint32_t> links_;
+		std::vector<std::uint32_t> numLinks_[2];
+		std::vector<std::uint32_t> globals_[2];
+
+		std::size_t numDropped_;
+		std::size_t numPromoted_;
+	};
+}
+
+#endif
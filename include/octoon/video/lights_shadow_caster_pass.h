@@ -2,14 +2,68 @@
 #define OCTOON_LIGHTS_SHADOW_CASTER_PASS_H_
 
 #include <octoon/video/scriptable_render_pass.h>
+#include <octoon/camera/ortho_camera.h>
+
+#include <unordered_map>
 
 namespace octoon
 {
 	class LightsShadowCasterPass : public ScriptableRenderPass
 	{
 	public:
+		LightsShadowCasterPass() noexcept;
+
 		void Execute(ScriptableRenderContext& context, const RenderingData& renderingData) noexcept(false) override;
+
+	private:
+		// One render into a shadow map, either the whole map or one cascade tile of an atlas.
+		struct ShadowView
+		{
+			math::float4x4 viewProjection;
+			math::float4 viewport;
+			const Camera* camera;
+			const RenderingData::ShadowCascade* cascade;
+		};
+
+		struct ShadowCaster
+		{
+			std::uint32_t view;
+			Geometry* geometry;
+			std::uint64_t generation;
+			std::uint64_t meshGeneration;
+		};
+
+		// Depth of the casters that stood still when it was drawn. As long as none of them
+		// moves and the views stay the same, only the other casters are drawn over a copy of
+		// it, and a light whose casters did not change at all is not drawn.
+		struct ShadowCache
+		{
+			hal::GraphicsFramebufferPtr target;
+			std::vector<math::float4x4> views;
+			std::vector<ShadowCaster> statics;
+			std::vector<ShadowCaster> dynamics;
+
+			hal::GraphicsTexturePtr colorTexture;
+			hal::GraphicsTexturePtr depthTexture;
+			hal::GraphicsFramebufferPtr framebuffer;
+		};
+
+		void renderShadow(ScriptableRenderContext& context, const RenderingData& renderingData, const Light& light, const Camera& camera, const std::vector<ShadowView>& views) noexcept;
+		void drawCasters(ScriptableRenderContext& context, const RenderingData& renderingData, const std::vector<ShadowView>& views, const std::vector<ShadowCaster>& casters) noexcept;
+
+		bool setupCache(ScriptableRenderContext& context, ShadowCache& cache, const hal::GraphicsFramebufferPtr& target) noexcept;
+
+		static bool intersects(const ShadowView& view, const Light& light, const Geometry& geometry) noexcept;
+
+	private:
+		OrthographicCamera cascadeCamera_;
+
+		std::uint64_t generation_;
+		std::vector<ShadowView> views_;
+		std::vector<ShadowCaster> casters_;
+		std::vector<Geometry*> geometries_;
+		std::unordered_map<const Light*, ShadowCache> caches_;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,46 @@
+#ifndef OCTOON_RENDER_JOURNAL_H_
+#define OCTOON_RENDER_JOURNAL_H_
+
+#include <octoon/runtime/platform.h>
+#include <cstdint>
+#include <vector>
+
+namespace octoon
+{
+	class Mesh;
+	class Material;
+	class RenderObject;
+
+	/*
+	* Process-wide log of the render resources that changed since the last frame.
+	* Every `setDirty(true)` stamps the object with a new generation and queues it
+	* once per frame, so scene compilation only visits what was actually touched.
+	* The queues are emptied by `Renderer::endFrameRendering`.
+	*/
+	class OCTOON_EXPORT RenderJournal final
+	{
+	public:
+		static std::uint64_t getGeneration() noexcept;
+		static std::uint64_t getFrameGeneration() noexcept;
+
+		static std::uint64_t record(Mesh* mesh, std::uint64_t generation) noexcept;
+		static std::uint64_t record(Material* material, std::uint64_t generation) noexcept;
+		static std::uint64_t record(RenderObject* object, std::uint64_t generation) noexcept;
+
+		static void erase(Mesh* mesh, std::uint64_t generation) noexcept;
+		static void erase(Material* material, std::uint64_t generation) noexcept;
+		static void erase(RenderObject* object, std::uint64_t generation) noexcept;
+
+		static std::vector<Mesh*> getMeshes() noexcept;
+		static std::vector<Material*> getMaterials() noexcept;
+		static std::vector<RenderObject*> getRenderObjects() noexcept;
+
+		static bool empty() noexcept;
+		static void clear() noexcept;
+
+	private:
+		RenderJournal() = delete;
+	};
+}
+
+#endif
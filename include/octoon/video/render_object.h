@@ -41,6 +41,8 @@ namespace octoon
 		void setDirty(bool dirty) noexcept;
 		bool isDirty() const noexcept;
 
+		std::uint64_t getGeneration() const noexcept;
+
 		void setOwnerListener(RenderListener* listener) noexcept;
 		RenderListener* getOwnerListener() noexcept;
 
@@ -67,6 +69,7 @@ namespace octoon
 	private:
 		bool visible_;
 		bool dirty_;
+		std::uint64_t generation_;
 
 		std::uint8_t layer_;
 		std::int32_t order_;
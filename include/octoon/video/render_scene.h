@@ -37,6 +37,9 @@ namespace octoon
 		void sortCameras() noexcept;
 		void sortGeometries() noexcept;
 
+		// Bumped whenever an object is added or removed, or the GI mode changes.
+		std::uint64_t getGeneration() const noexcept;
+
 	private:
 		RenderScene(const RenderScene&) = delete;
 		RenderScene& operator=(const RenderScene&) = delete;
@@ -44,6 +47,8 @@ namespace octoon
 	private:
 		bool enableGlobalIllumination_;
 
+		std::uint64_t generation_;
+
 		Camera* mainCamera_;
 
 		std::vector<Light*> lights_;
@@ -16,10 +16,14 @@
 
 #include <octoon/lightmap/lightmap.h>
 
+#include <functional>
 #include <unordered_map>
 
 namespace octoon
 {
+	// Receives an output read back by the path tracer, rows are tightly packed and start at the bottom.
+	using ReadbackCallback = std::function<void(const void* data, std::uint32_t width, std::uint32_t height)>;
+
 	class OCTOON_EXPORT Renderer final
 	{
 		OctoonDeclareSingleton(Renderer)
@@ -36,6 +40,16 @@ namespace octoon
 		void setMaxBounces(std::uint32_t num_bounces);
 		std::uint32_t getMaxBounces() const;
 
+		// Path tracing settings: milliseconds of tiles per frame (0 renders a full pass),
+		// and the relative error at which pixels stop sampling (0 disables adaptive sampling).
+		void setFrameBudget(float milliseconds);
+		float getFrameBudget() const;
+
+		void setConvergenceThreshold(float threshold);
+		float getConvergenceThreshold() const;
+
+		bool isConverged() const;
+
 		void setOverrideMaterial(const std::shared_ptr<Material>& material) noexcept;
 		const std::shared_ptr<Material>& getOverrideMaterial() const noexcept;
 
@@ -43,6 +57,14 @@ namespace octoon
 		void readAlbedoBuffer(math::float3 data[]);
 		void readNormalBuffer(math::float3 data[]);
 
+		// Copies an output into a pixel buffer and calls back on a worker thread once the GPU is done,
+		// usually a frame later, so the copy overlaps with rendering. The format picks the layout the
+		// data is converted to (R32G32B32, R32G32B32A32, R8G8B8 or R8G8B8A8), `data` is only valid
+		// during the callback. Returns false if the format is not supported.
+		bool readColorBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+		bool readAlbedoBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+		bool readNormalBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const noexcept;
 
 		const std::shared_ptr<ScriptableRenderContext>& getScriptableRenderContext() const noexcept;
@@ -67,6 +89,9 @@ namespace octoon
 		std::uint32_t numBounces_;
 		std::uint32_t width_, height_;
 
+		float frameBudget_;
+		float convergenceThreshold_;
+
 		std::shared_ptr<ScriptableRenderContext> context_;
 
 		std::unique_ptr<class RtxManager> rtxManager_;
@@ -2,7 +2,7 @@
 #define OCTOON_VIDEO_FORWARD_SCENE_H_
 
 #include <octoon/camera/camera.h>
-#include <octoon/light/light.h>
+#include <octoon/light/directional_light.h>
 #include <octoon/geometry/geometry.h>
 #include <octoon/video/collector.h>
 
@@ -28,20 +28,22 @@ namespace octoon
 			math::float4 halfHeight;
 		};
 
+		// Point and spot lights mirror the std140 layout of the light blocks in the shaders.
 		struct SpotLight
 		{
-			math::float4 position;
-			math::float4 direction;
-			math::float4 color;
+			math::float3 position;
 			float distance;
+			math::float3 direction;
 			float decay;
+			math::float3 color;
 			float coneCos;
 			float penumbraCos;
 
 			int shadow;
+			math::float2 shadowMapSize;
 			float shadowBias;
 			float shadowRadius;
-			math::float2 shadowMapSize;
+			float padding[2];
 		};
 
 		struct EnvironmentLight
@@ -53,15 +55,16 @@ namespace octoon
 
 		struct PointLight
 		{
-			math::float4 position;
-			math::float4 color;
+			math::float3 position;
 			float distance;
+			math::float3 color;
 			float decay;
 
 			int shadow;
 			float shadowBias;
-			float shadowRadius;
 			math::float2 shadowMapSize;
+			float shadowRadius;
+			float padding[3];
 		};
 
 		struct DirectionalLight
@@ -74,6 +77,25 @@ namespace octoon
 			math::float2 shadowMapSize;
 		};
 
+		// One tile of a directional light's shadow atlas. The shadow matrix takes view space
+		// positions of the main camera straight to atlas coordinates.
+		struct ShadowCascade
+		{
+			math::float4 ortho;
+			float znear;
+			float zfar;
+			math::float4 viewport;
+			math::float4x4 viewProjection;
+			math::float4x4 shadowMatrix;
+		};
+
+		struct DirectionalShadow
+		{
+			Light* light;
+			std::uint32_t numCascades;
+			ShadowCascade cascades[octoon::DirectionalLight::MAX_SHADOW_CASCADES];
+		};
+
 		void reset() noexcept;
 
 		const Camera* camera;
@@ -99,16 +121,27 @@ namespace octoon
 		std::vector<hal::GraphicsTexturePtr> directionalShadows;
 		std::vector<hal::GraphicsTexturePtr> environmentShadows;
 
-		std::vector<math::float4x4> directionalShadowMatrix;
+		std::vector<DirectionalShadow> directionalShadowCascades;
+
+		// std140 image of the `DirectionalShadows` block, matrices per light and cascade followed
+		// by the far end of each cascade per light.
+		std::vector<math::float4x4> directionalShadowMatrices;
+		std::vector<math::float4> directionalShadowSplits;
 
 		hal::GraphicsDataPtr spotLightBuffer;
 		hal::GraphicsDataPtr pointLightBuffer;
 		hal::GraphicsDataPtr rectangleLightBuffer;
 		hal::GraphicsDataPtr directionLightBuffer;
+		hal::GraphicsDataPtr directionalShadowBuffer;
+		hal::GraphicsDataPtr clusterBuffer;
+		hal::GraphicsDataPtr clusterIndexBuffer;
 
 		std::vector<Light*> lights;
 		std::vector<Geometry*> geometries;
 
+		// `geometries` with the static ones merged into batches, drawn by the camera passes.
+		std::vector<Geometry*> batchedGeometries;
+
 		std::unique_ptr<Bundle> material_bundle;
 		std::unique_ptr<Bundle> volume_bundle;
 		std::unique_ptr<Bundle> texture_bundle;
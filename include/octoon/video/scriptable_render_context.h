@@ -2,10 +2,13 @@
 #define OCTOON_SCRIPTABLE_RENDER_CONTEXT_H_
 
 #include <octoon/hal/graphics_context.h>
+#include <octoon/hal/graphics_command.h>
 #include <octoon/mesh/mesh.h>
 #include <octoon/video/collector.h>
+#include <octoon/video/light_clusters.h>
 #include <octoon/video/render_scene.h>
 #include <octoon/video/rendering_data.h>
+#include <octoon/video/static_batcher.h>
 
 #include <unordered_map>
 
@@ -67,7 +70,7 @@ namespace octoon
 		void configureTarget(const hal::GraphicsFramebufferPtr& target) noexcept;
 		void configureClear(hal::GraphicsClearFlags flags, const math::float4& color, float depth, std::int32_t stencil) noexcept;
 		void discardFramebuffer(const hal::GraphicsFramebufferPtr& src, hal::GraphicsClearFlags flags = hal::GraphicsClearFlagBits::AllBit) noexcept;
-		void blitFramebuffer(const hal::GraphicsFramebufferPtr& src, const math::float4& v1, const hal::GraphicsFramebufferPtr& dest, const math::float4& v2) noexcept;
+		void blitFramebuffer(const hal::GraphicsFramebufferPtr& src, const math::float4& v1, const hal::GraphicsFramebufferPtr& dest, const math::float4& v2, hal::GraphicsClearFlags flags = hal::GraphicsClearFlagBits::ColorBit) noexcept;
 		void readFramebuffer(std::uint32_t i, const hal::GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
 		void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const hal::GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
 		hal::GraphicsFramebufferPtr getFramebuffer() const noexcept;
@@ -83,24 +86,64 @@ namespace octoon
 
 		void setMaterial(const std::shared_ptr<Material>& material, const Camera& camera, const Geometry& geometry);
 
+		// Profiled sections, timed on the CPU and with GPU timestamps. The GPU results are read back
+		// by resolveSamples a few frames later, once the device has finished with them.
+		void beginSample(const char* name) noexcept;
+		void endSample() noexcept;
+		void resolveSamples() noexcept;
+
 		void cleanCache() noexcept;
 		void compileScene(const std::shared_ptr<RenderScene>& scene) noexcept;
 		RenderingData& getRenderingData() const noexcept(false);
 
 	private:
+		void collectMaterials(const std::shared_ptr<RenderScene>& scene) noexcept;
+
+		void setMaterial(hal::GraphicsCommandList& commands, const std::shared_ptr<Material>& material, const Camera& camera, const Geometry& geometry) const;
+		void drawMesh(hal::GraphicsCommandList& commands, const std::shared_ptr<Mesh>& mesh, std::size_t subset) const;
+		void drawRenderers(hal::GraphicsCommandList& commands, const Geometry& geometry, const Camera& camera, const std::shared_ptr<Material>& overrideMaterial) const noexcept;
+		void drawBatch(hal::GraphicsCommandList& commands, const Geometry& geometry, const Camera& camera, const std::shared_ptr<Material>& overrideMaterial) const noexcept;
+
 		void updateCamera(const std::shared_ptr<RenderScene>& scene, class RenderingData& out, bool force = false);
 		void updateLights(const std::shared_ptr<RenderScene>& scene, class RenderingData& out, bool force = false);
 		void updateMaterials(const std::shared_ptr<RenderScene>& scene, class RenderingData& out, bool force = false);
 		void updateShapes(const std::shared_ptr<RenderScene>& scene, class RenderingData& out, bool force = false);
 
+		void updateMaterials(class RenderingData& out, const std::vector<Material*>& materials);
+		void updateShapes(const std::shared_ptr<RenderScene>& scene, class RenderingData& out, const std::vector<Geometry*>& geometries, const std::vector<Mesh*>& meshes);
+		void updateBatches(class RenderingData& out);
+
 	private:
 		Collector materialCollector;
 
+		const RenderScene* compiledScene_;
+		std::uint64_t compiledGeneration_;
+
 		hal::GraphicsContextPtr context_;
 		std::unique_ptr<class RenderingData> renderingData_;
 
+		LightClusters lightClusters_;
+		StaticBatcher staticBatcher_;
+
 		std::unordered_map<void*, std::shared_ptr<class ScriptableRenderBuffer>> buffers_;
 		std::unordered_map<void*, std::shared_ptr<class ScriptableRenderMaterial>> materials_;
+
+		hal::GraphicsCommandList commandList_;
+		std::vector<hal::GraphicsCommandList> commandLists_;
+
+		struct Sample
+		{
+			const char* name;
+			std::uint32_t depth;
+			std::uint64_t time;
+		};
+
+		static constexpr std::uint32_t MAX_SAMPLES = 64;
+		static constexpr std::uint32_t SAMPLE_FRAMES = 3;
+
+		std::uint32_t sampleFrame_;
+		std::vector<Sample> samples_[SAMPLE_FRAMES];
+		std::vector<std::int32_t> sampleStack_;
 	};
 }
 
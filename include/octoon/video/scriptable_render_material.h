@@ -4,6 +4,7 @@
 #include <octoon/camera/camera.h>
 #include <octoon/geometry/geometry.h>
 #include <octoon/material/material.h>
+#include <octoon/hal/graphics_command.h>
 #include <octoon/video/scriptable_render_context.h>
 
 namespace octoon
@@ -19,10 +20,11 @@ namespace octoon
 		const hal::GraphicsPipelinePtr& getPipeline() const noexcept;
 		const hal::GraphicsDescriptorSetPtr& getDescriptorSet() const noexcept;
 
-		void update(const RenderingData& context, const Camera& camera, const Geometry& geometry) noexcept;
+		// Records the uniforms of one draw, safe to call from several threads for different geometries.
+		void update(hal::GraphicsCommandList& commands, const RenderingData& context, const Camera& camera, const Geometry& geometry) const noexcept;
 
 	private:
-		void updateParameters(bool force = false) noexcept;
+		void updateParameters(hal::GraphicsCommandList& commands, bool force = false) const noexcept;
 		void updateMaterial(ScriptableRenderContext& context, const MaterialPtr& material, const RenderingData& scene) noexcept(false);
 
 		void setupProgram(ScriptableRenderContext& context, const MaterialPtr& material, const RenderingData& scene);
@@ -45,8 +47,11 @@ namespace octoon
 
 		hal::GraphicsUniformSetPtr ambientLightColor_;
 		hal::GraphicsUniformSetPtr directionalLights_;
+		hal::GraphicsUniformSetPtr directionalShadows_;
 		hal::GraphicsUniformSetPtr pointLights_;
 		hal::GraphicsUniformSetPtr spotLights_;
+		hal::GraphicsUniformSetPtr lightClusters_;
+		hal::GraphicsUniformSetPtr lightClusterIndices_;
 		hal::GraphicsUniformSetPtr rectAreaLights_;
 		hal::GraphicsUniformSetPtr hemisphereLights_;
 		hal::GraphicsUniformSetPtr flipEnvMap_;
@@ -62,7 +67,6 @@ namespace octoon
 		hal::GraphicsUniformSetPtr projectionMatrix_;
 
 		std::vector<hal::GraphicsUniformSetPtr> directionalShadowMaps_;
-		std::vector<hal::GraphicsUniformSetPtr> directionalShadowMatrixs_;
 	};
 }
 
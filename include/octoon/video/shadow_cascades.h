@@ -0,0 +1,26 @@
+#ifndef OCTOON_VIDEO_SHADOW_CASCADES_H_
+#define OCTOON_VIDEO_SHADOW_CASCADES_H_
+
+#include <octoon/video/rendering_data.h>
+
+namespace octoon
+{
+	/*
+	* Cascade fitting for directional light shadows. The view frustum is cut into slices and
+	* each slice gets an orthographic projection around its bounding sphere, so a cascade keeps
+	* its size while the camera turns and its origin moves in whole texels while the camera
+	* moves, which keeps the shadow edges from shimmering.
+	*/
+	class OCTOON_EXPORT ShadowCascades final
+	{
+	public:
+		// Blends logarithmic and uniform splits of [znear, zfar], `lambda` is the weight of the first.
+		static void split(float znear, float zfar, std::uint32_t count, float lambda, float splits[]) noexcept;
+
+		// Fits the slice [zmin, zmax] of the camera frustum. Casters up to `casterDistance` in
+		// front of the slice along the light are kept, and `viewport` is the tile of the atlas.
+		static void fit(const Camera& camera, float zmin, float zmax, const math::float4x4& lightView, float casterDistance, const math::float4& viewport, const math::uint2& atlasSize, RenderingData::ShadowCascade& cascade) noexcept;
+	};
+}
+
+#endif
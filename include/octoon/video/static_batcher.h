@@ -0,0 +1,84 @@
+#ifndef OCTOON_VIDEO_STATIC_BATCHER_H_
+#define OCTOON_VIDEO_STATIC_BATCHER_H_
+
+#include <octoon/geometry/geometry.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace octoon
+{
+	/*
+	* Merges static geometries into a few large ones for the camera passes. Geometries that
+	* share a layer, render order and shadow flags are baked to world space with
+	* Mesh::mergeMeshes, then the opaque subsets of the merged mesh are reordered so the ones
+	* that use the same material are next to each other in the index buffer, while blended
+	* subsets keep their order. Each subset keeps its own bounds, so a batch can still be
+	* culled per original subset.
+	*/
+	class OCTOON_EXPORT StaticBatcher final
+	{
+	public:
+		// A group with more vertices is split, so one change does not rebuild too much.
+		static constexpr std::size_t MAX_VERTICES = 1 << 18;
+
+		StaticBatcher() noexcept;
+
+		// Regroups the static geometries and rebuilds the batches whose members changed.
+		void update(const std::vector<Geometry*>& geometries) noexcept;
+
+		// `geometries` from the last update, the static ones replaced by their batches.
+		const std::vector<Geometry*>& getGeometries() const noexcept;
+
+		// Batches built by the last update, and the meshes of the ones it dropped or rebuilt. The
+		// batches are not part of the scene, whoever uploads them also marks them clean.
+		const std::vector<Geometry*>& getRebuiltGeometries() const noexcept;
+		const std::vector<Mesh*>& getRetiredMeshes() const noexcept;
+
+		bool isBatch(const Geometry* geometry) const noexcept;
+		bool contains(const Geometry* geometry) const noexcept;
+		bool contains(const Mesh* mesh) const noexcept;
+
+		void clear() noexcept;
+
+	private:
+		struct Member
+		{
+			Geometry* geometry;
+			std::uint64_t generation;
+			std::uint64_t meshGeneration;
+
+			bool operator==(const Member& other) const noexcept
+			{
+				return geometry == other.geometry && generation == other.generation && meshGeneration == other.meshGeneration;
+			}
+		};
+
+		struct Batch
+		{
+			std::uint64_t key;
+			std::vector<Member> members;
+			std::shared_ptr<Geometry> geometry;
+		};
+
+		static std::uint64_t makeKey(const Geometry& geometry) noexcept;
+
+		bool build(Batch& batch) noexcept;
+
+	private:
+		StaticBatcher(const StaticBatcher&) = delete;
+		StaticBatcher& operator=(const StaticBatcher&) = delete;
+
+	private:
+		std::vector<Batch> batches_;
+		std::vector<Geometry*> geometries_;
+		std::vector<Geometry*> rebuilt_;
+		std::vector<Mesh*> retired_;
+
+		std::unordered_set<const Geometry*> members_;
+		std::unordered_set<const Mesh*> meshes_;
+		std::unordered_set<const Geometry*> batchGeometries_;
+	};
+}
+
+#endif
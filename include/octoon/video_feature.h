@@ -39,6 +39,10 @@ namespace octoon
 		void readAlbedoBuffer(math::float3 data[]);
 		void readNormalBuffer(math::float3 data[]);
 
+		bool readColorBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+		bool readAlbedoBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+		bool readNormalBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+
 		void setFramebufferScale(std::uint32_t w, std::uint32_t h) noexcept;
 		void getFramebufferScale(std::uint32_t& w, std::uint32_t& h) noexcept;
 
@@ -702,6 +702,108 @@ KERNEL void AccumulateSingleSample(
     }
 }
 
+// Builds the ray domain of a tile from the pixels that have not converged yet
+KERNEL void GenerateTileDomain_Masked(
+    int output_width,
+    int offset_x,
+    int offset_y,
+    int width,
+    int height,
+    GLOBAL int const* restrict mask,
+    GLOBAL int* restrict indices,
+    GLOBAL int* restrict count
+)
+{
+    int global_id = get_global_id(0);
+
+    if (global_id < width * height)
+    {
+        int idx = (offset_y + global_id / width) * output_width + offset_x + global_id % width;
+
+        if (!mask[idx])
+        {
+            indices[atomic_inc(count)] = idx;
+        }
+    }
+}
+
+// Adds one sample per pixel and keeps the luminance moments used to estimate the variance
+KERNEL void AccumulateAdaptiveSample(
+    GLOBAL float4 const* restrict src_sample_data,
+    GLOBAL int const* restrict scatter_indices,
+    GLOBAL int const* restrict num_elements,
+    GLOBAL float4* restrict dst_accumulation_data,
+    GLOBAL float2* restrict dst_moments
+)
+{
+    int global_id = get_global_id(0);
+
+    if (global_id < *num_elements)
+    {
+        int idx = scatter_indices[global_id];
+        float4 sample = src_sample_data[global_id];
+        float lum = luminance(sample.xyz);
+        dst_accumulation_data[idx] += sample;
+        dst_moments[idx] += make_float2(lum, lum * lum);
+    }
+}
+
+// Marks the pixels whose relative standard error is below the threshold, and the tiles that still have work
+KERNEL void EstimateConvergence(
+    GLOBAL float4 const* restrict accumulation_data,
+    GLOBAL float2 const* restrict moments,
+    int width,
+    int height,
+    int tile_size,
+    int min_samples,
+    float threshold,
+    GLOBAL int* restrict mask,
+    GLOBAL int* restrict tile_active,
+    int has_sample_count,
+    GLOBAL float4* restrict sample_count,
+    int has_convergence,
+    GLOBAL float4* restrict convergence
+)
+{
+    int global_id = get_global_id(0);
+
+    if (global_id < width * height)
+    {
+        float n = accumulation_data[global_id].w;
+        float2 m = moments[global_id];
+
+        float error = MAXFLOAT;
+        if (n > 1.f)
+        {
+            float mean = m.x / n;
+            float variance = max(m.y / n - mean * mean, 0.f) * n / (n - 1.f);
+            error = native_sqrt(variance / n) / max(mean, 1e-3f);
+        }
+
+        int converged = (n >= min_samples) && (error < threshold);
+        mask[global_id] = converged;
+
+        if (!converged)
+        {
+            int num_tiles_x = (width + tile_size - 1) / tile_size;
+            int x = global_id % width;
+            int y = global_id / width;
+            tile_active[(y / tile_size) * num_tiles_x + x / tile_size] = 1;
+        }
+
+        if (has_sample_count)
+        {
+            sample_count[global_id] = make_float4(n, n, n, 1.f);
+        }
+
+        if (has_convergence)
+        {
+            float e = min(error, 1.f);
+            convergence[global_id] = make_float4(e, e, e, 1.f);
+        }
+    }
+}
+
 INLINE void group_reduce_add(__local float* lds, int size, int lid)
 {
     for (int offset = (size >> 1); offset > 0; offset >>= 1)
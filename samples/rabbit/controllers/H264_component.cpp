@@ -1,5 +1,6 @@
 #include "h264_component.h"
 #include "rabbit_behaviour.h"
+#include <octoon/game_base_features.h>
 
 extern "C"
 {
@@ -8,6 +9,7 @@ extern "C"
 
 #include <x264.h>
 #include <fstream>
+#include <sstream>
 #include <filesystem>
 
 namespace rabbit
@@ -38,6 +40,13 @@ namespace rabbit
 	{
 		return this->getModel()->enable;
 	}
+
+	FramePipelineStatistics
+	H264Component::getStatistics() const noexcept
+	{
+		return this->pipeline_.getStatistics();
+	}
+
 	void
 	H264Component::onEnable() noexcept
 	{
@@ -48,40 +57,23 @@ namespace rabbit
 	{
 		if (this->ostream_)
 		{
-			int iFrameSize = 0;
-			int iNal = 0;
-			x264_nal_t* pNals = NULL;
+			pipeline_.close();
 
-			int frame_size = x264_encoder_encode(encoder_, &pNals, &iNal, frame_, encoded_frame_);
-			if (frame_size > 0 && iNal > 0)
+			auto feature = this->getFeature<octoon::GameBaseFeature>();
+			if (feature)
 			{
-				for (int i = 0; i < iNal; ++i)
-				{
-					std::int32_t i_num_nal_h = 0;
-
-					if (pNals[i].i_payload > 4)
-					{
-						while (i_num_nal_h < 5 && pNals[i].p_payload[i_num_nal_h] == 0)
-							i_num_nal_h++;
-
-						static char nal_head_s[3] = { 0, 0, 0 };
-
-						if (i_num_nal_h < 3)
-						{
-							ostream_->write(nal_head_s, 3 - i_num_nal_h);
-							iFrameSize += (3 - i_num_nal_h);
-						}
-					}
-
-					ostream_->write((char*)pNals[i].p_payload, pNals[i].i_payload);
-
-					iFrameSize += pNals[i].i_payload;
-				}
+				std::ostringstream statistics;
+				statistics << "H264 pipeline statistics:" << std::endl << this->getStatistics();
+				feature->log(statistics.str());
 			}
 
+			while (x264_encoder_delayed_frames(encoder_) > 0)
+				this->encode(nullptr);
+
 			x264_encoder_close(encoder_);
-			x264_picture_clean(frame_);
-			x264_picture_clean(encoded_frame_);
+
+			delete frame_;
+			delete encoded_frame_;
 
 			this->ostream_.reset();
 
@@ -200,7 +192,6 @@ namespace rabbit
 		auto& context = this->getContext();
 		this->width_ = context->profile->canvasModule->width;
 		this->height_ = context->profile->canvasModule->height;
-		this->buf_ = std::make_unique<std::uint8_t[]>(this->width_ * this->height_ * 3);
 		this->filepath_ = filepath;
 		this->ostream_ = std::make_shared<std::ofstream>(this->filepath_ + ".tmp", std::ios_base::binary);
 		if (!this->ostream_->good())
@@ -226,7 +217,7 @@ namespace rabbit
 		encode_param_.i_log_level = X264_LOG_NONE;
 		encode_param_.i_width = this->width_;
 		encode_param_.i_height = this->height_;
-		encode_param_.i_threads = 1;
+		encode_param_.i_threads = X264_THREADS_AUTO;
 		encode_param_.i_fps_num = context->profile->playerModule->recordFps;
 		encode_param_.i_fps_den = 1;
 		encode_param_.analyse.b_psnr = 1;
@@ -247,7 +238,15 @@ namespace rabbit
 		frame_ = new x264_picture_t;
 
 		x264_picture_init(encoded_frame_);
-		x264_picture_alloc(frame_, X264_CSP_I420, this->width_, this->height_);
+		x264_picture_init(frame_);
+
+		frame_->img.i_csp = X264_CSP_I420;
+		frame_->img.i_plane = 3;
+		frame_->img.i_stride[0] = this->width_;
+		frame_->img.i_stride[1] = this->width_ / 2;
+		frame_->img.i_stride[2] = this->width_ / 2;
+
+		pipeline_.open(this->width_, this->height_, 4, [this](std::uint8_t* yuv) { this->encode(yuv); });
 
 		return this->ostream_->good();
 	}
@@ -258,79 +257,49 @@ namespace rabbit
 		if (ostream_)
 		{
 			auto& context = this->getContext();
-
-			auto output = context->profile->canvasModule->outputBuffer.data();
-			this->convert((float*)output, this->width_, this->height_, this->buf_.get());
-
-			std::uint8_t* yuv[3];
-			yuv[0] = this->buf_.get();
-			yuv[1] = this->buf_.get() + this->width_ * this->height_;
-			yuv[2] = this->buf_.get() + this->width_ * this->height_ * 5 / 4;
-
-			int y_size = this->width_ * this->height_;
-			memcpy(frame_->img.plane[0] + 0, yuv[0], y_size);
-			memcpy(frame_->img.plane[0] + y_size, yuv[1], y_size / 4);
-			memcpy(frame_->img.plane[0] + y_size * 5 / 4, yuv[2], y_size / 4);
-
-			int iFrameSize = 0;
-			int iNal = 0;
-			x264_nal_t* pNals = NULL;
-
-			int frame_size = x264_encoder_encode(encoder_, &pNals, &iNal, frame_, encoded_frame_);
-			if (frame_size > 0 && iNal > 0)
-			{
-				for (int i = 0; i < iNal; ++i)
-				{
-					std::int32_t i_num_nal_h = 0;
-
-					if (pNals[i].i_payload > 4)
-					{
-						while (i_num_nal_h < 5 && pNals[i].p_payload[i_num_nal_h] == 0)
-							i_num_nal_h++;
-
-						static char nal_head_s[3] = { 0, 0, 0 };
-
-						if (i_num_nal_h < 3)
-						{
-							ostream_->write(nal_head_s, 3 - i_num_nal_h);
-							iFrameSize += (3 - i_num_nal_h);
-						}
-					}
-
-					ostream_->write((char*)pNals[i].p_payload, pNals[i].i_payload);
-
-					iFrameSize += pNals[i].i_payload;
-				}
-			}
+			pipeline_.push(context->profile->canvasModule->outputBuffer.data());
 		}
 	}
 
 	void
-	H264Component::convert(float* rgb, int w, int h, std::uint8_t* yuvBuf) noexcept
+	H264Component::encode(std::uint8_t* yuv) noexcept
 	{
-		auto ptrY = yuvBuf;
-		auto ptrU = ptrY + this->width_ * this->height_;
-		auto ptrV = ptrU + this->width_ * this->height_ / 4;
+		if (yuv)
+		{
+			frame_->img.plane[0] = yuv;
+			frame_->img.plane[1] = yuv + this->width_ * this->height_;
+			frame_->img.plane[2] = yuv + this->width_ * this->height_ * 5 / 4;
+		}
+
+		int iFrameSize = 0;
+		int iNal = 0;
+		x264_nal_t* pNals = NULL;
 
-		for (int j = 0; j < h; j++)
+		// A null frame flushes the frames the encoder threads still hold.
+		int frame_size = x264_encoder_encode(encoder_, &pNals, &iNal, yuv ? frame_ : nullptr, encoded_frame_);
+		if (frame_size > 0 && iNal > 0)
 		{
-			for (int i = 0; i < w; i++)
+			for (int i = 0; i < iNal; ++i)
 			{
-				auto data = rgb + ((h - j - 1) * w + i) * 3;
-				std::int32_t r = (std::int32_t)(data[0] * 255.0f);
-				std::int32_t g = (std::int32_t)(data[1] * 255.0f);
-				std::int32_t b = (std::int32_t)(data[2] * 255.0f);
+				std::int32_t i_num_nal_h = 0;
 
-				auto y = (std::uint8_t)std::clamp(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16, 0, 255);
-				auto u = (std::uint8_t)std::clamp(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128, 0, 255);
-				auto v = (std::uint8_t)std::clamp(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128, 0, 255);
+				if (pNals[i].i_payload > 4)
+				{
+					while (i_num_nal_h < 5 && pNals[i].p_payload[i_num_nal_h] == 0)
+						i_num_nal_h++;
+
+					static char nal_head_s[3] = { 0, 0, 0 };
+
+					if (i_num_nal_h < 3)
+					{
+						ostream_->write(nal_head_s, 3 - i_num_nal_h);
+						iFrameSize += (3 - i_num_nal_h);
+					}
+				}
 
-				*(ptrY++) = y;
+				ostream_->write((char*)pNals[i].p_payload, pNals[i].i_payload);
 
-				if (j % 2 == 0 && i % 2 == 0)
-					*(ptrU++) = u;
-				else if (i % 2 == 0)
-					*(ptrV++) = v;
+				iFrameSize += pNals[i].i_payload;
 			}
 		}
 	}
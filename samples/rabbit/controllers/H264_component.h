@@ -3,6 +3,7 @@
 
 #include "module/h265_module.h"
 #include "rabbit_component.h"
+#include "utils/frame_pipeline.h"
 
 struct x264_t;
 struct x264_picture_t;
@@ -19,6 +20,9 @@ namespace rabbit
 
 		bool record(std::string_view filepath) noexcept(false);
 
+		// Frames, throughput and waiting time of each export stage for the current or last recording.
+		FramePipelineStatistics getStatistics() const noexcept;
+
 		virtual const std::type_info& type_info() const noexcept
 		{
 			return typeid(H264Component);
@@ -31,7 +35,7 @@ namespace rabbit
 		void onPostProcess() noexcept(false) override;
 
 	private:
-		void convert(float* rgb, int w, int h, std::uint8_t* yuvBuf) noexcept;
+		void encode(std::uint8_t* yuv) noexcept;
 
 	private:
 		H264Component(const H264Component&) = delete;
@@ -45,9 +49,7 @@ namespace rabbit
 		x264_picture_t* frame_;
 		x264_picture_t* encoded_frame_;
 
-		std::unique_ptr<char[]> enc_;
-		std::unique_ptr<char[]> scratch_;
-		std::unique_ptr<std::uint8_t[]> buf_;
+		FramePipeline pipeline_;
 
 		std::string filepath_;
 		std::shared_ptr<std::ostream> ostream_;
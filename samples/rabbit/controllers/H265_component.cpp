@@ -1,5 +1,6 @@
 #include "h265_component.h"
 #include "rabbit_behaviour.h"
+#include <octoon/game_base_features.h>
 
 extern "C"
 {
@@ -9,6 +10,7 @@ extern "C"
 #include <x264.h>
 #include <x265.h>
 #include <fstream>
+#include <sstream>
 #include <filesystem>
 
 namespace rabbit
@@ -17,6 +19,7 @@ namespace rabbit
 		: encoder_(nullptr)
 		, picture_(nullptr)
 		, param_(nullptr)
+		, encodeFailed_(false)
 	{
 	}
 
@@ -39,6 +42,13 @@ namespace rabbit
 	{
 		return this->getModel()->enable;
 	}
+
+	FramePipelineStatistics
+	H265Component::getStatistics() const noexcept
+	{
+		return this->pipeline_.getStatistics();
+	}
+
 	void
 	H265Component::onEnable() noexcept
 	{
@@ -49,6 +59,16 @@ namespace rabbit
 	{
 		if (this->ostream_)
 		{
+			pipeline_.close();
+
+			auto feature = this->getFeature<octoon::GameBaseFeature>();
+			if (feature)
+			{
+				std::ostringstream statistics;
+				statistics << "H265 pipeline statistics:" << std::endl << this->getStatistics();
+				feature->log(statistics.str());
+			}
+
 			x265_nal* nals = nullptr;
 			std::uint32_t inal = 0;
 
@@ -84,8 +104,6 @@ namespace rabbit
 				auto outFilename = filepath_;
 				if (avformat_alloc_output_context2(&outputFormat, NULL, NULL, outFilename.c_str()) < 0)
 				{
-					printf("Could not deduce output format from file extension: using MPEG.\n");
-
 					if (avformat_alloc_output_context2(&outputFormat, NULL, "mpeg", outFilename.c_str()) < 0)
 						throw std::runtime_error("Could not create output context\n");
 				}
@@ -203,7 +221,6 @@ namespace rabbit
 		auto& context = this->getContext();
 		this->width_ = context->profile->canvasModule->width;
 		this->height_ = context->profile->canvasModule->height;
-		this->buf_ = std::make_unique<std::uint8_t[]>(this->width_ * this->height_ * 3);
 		this->filepath_ = filepath;
 		this->ostream_ = std::make_shared<std::ofstream>(this->filepath_ + ".h265", std::ios_base::binary);
 		if (!this->ostream_->good())
@@ -234,14 +251,16 @@ namespace rabbit
 			throw std::runtime_error("x265_picture_alloc() failed");
 
 		x265_picture_init(param_, picture_);
-		picture_->planes[0] = this->buf_.get();
-		picture_->planes[1] = this->buf_.get() + param_->sourceWidth * param_->sourceHeight;
-		picture_->planes[2] = this->buf_.get() + param_->sourceWidth * param_->sourceHeight * 5 / 4;
 		picture_->stride[0] = param_->sourceWidth;
 		picture_->stride[1] = param_->sourceWidth / 2;
 		picture_->stride[2] = param_->sourceWidth / 2;
 		picture_->height = param_->sourceHeight;
 
+		this->encodeFailed_ = false;
+
+		// x265 runs its own frame and worker threads, the pipeline keeps conversion off the render thread.
+		pipeline_.open(this->width_, this->height_, 4, [this](std::uint8_t* yuv) { this->encode(yuv); });
+
 		return this->ostream_->good();
 	}
 
@@ -250,49 +269,31 @@ namespace rabbit
 	{
 		if (ostream_)
 		{
-			auto& context = this->getContext();
-
-			auto output = context->profile->canvasModule->outputBuffer.data();
-			this->convert((float*)output, context->profile->canvasModule->width, context->profile->canvasModule->height, this->buf_.get());
-
-			x265_nal* nals = nullptr;
-			std::uint32_t inal = 0;
-			auto result = x265_encoder_encode(encoder_, &nals, &inal, picture_, nullptr);
-			if (result < 0)
+			// Frames are encoded on the pipeline thread, its failure is raised with the next frame.
+			if (this->encodeFailed_)
 				throw std::runtime_error("x265_encoder_encode() failed");
 
-			for (std::uint32_t j = 0;j < inal; j++)
-				ostream_->write((char*)nals[j].payload, nals[j].sizeBytes);
+			auto& context = this->getContext();
+			pipeline_.push(context->profile->canvasModule->outputBuffer.data());
 		}
 	}
 
 	void
-	H265Component::convert(float* rgb, int w, int h, std::uint8_t* yuvBuf) noexcept
+	H265Component::encode(std::uint8_t* yuv) noexcept
 	{
-		auto ptrY = yuvBuf;
-		auto ptrU = ptrY + this->width_ * this->height_;
-		auto ptrV = ptrU + this->width_ * this->height_ / 4;
+		picture_->planes[0] = yuv;
+		picture_->planes[1] = yuv + this->width_ * this->height_;
+		picture_->planes[2] = yuv + this->width_ * this->height_ * 5 / 4;
 
-		for (int j = 0; j < h; j++)
+		x265_nal* nals = nullptr;
+		std::uint32_t inal = 0;
+		if (x265_encoder_encode(encoder_, &nals, &inal, picture_, nullptr) < 0)
 		{
-			for (int i = 0; i < w; i++)
-			{
-				auto data = rgb + ((h - j - 1) * w + i) * 3;
-				std::int32_t r = (std::int32_t)(data[0] * 255.0f);
-				std::int32_t g = (std::int32_t)(data[1] * 255.0f);
-				std::int32_t b = (std::int32_t)(data[2] * 255.0f);
-
-				auto y = (std::uint8_t)std::clamp(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16, 0, 255);
-				auto u = (std::uint8_t)std::clamp(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128, 0, 255);
-				auto v = (std::uint8_t)std::clamp(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128, 0, 255);
-
-				*(ptrY++) = y;
-
-				if (j % 2 == 0 && i % 2 == 0)
-					*(ptrU++) = u;
-				else if (i % 2 == 0)
-					*(ptrV++) = v;
-			}
+			this->encodeFailed_ = true;
+			return;
 		}
+
+		for (std::uint32_t j = 0;j < inal; j++)
+			ostream_->write((char*)nals[j].payload, nals[j].sizeBytes);
 	}
 }
\ No newline at end of file
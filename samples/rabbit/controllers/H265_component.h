@@ -3,6 +3,9 @@
 
 #include "module/h265_module.h"
 #include "rabbit_component.h"
+#include "utils/frame_pipeline.h"
+
+#include <atomic>
 
 struct x265_param;
 struct x265_encoder;
@@ -20,6 +23,9 @@ namespace rabbit
 
 		bool record(std::string_view filepath) noexcept(false);
 
+		// Frames, throughput and waiting time of each export stage for the current or last recording.
+		FramePipelineStatistics getStatistics() const noexcept;
+
 		virtual const std::type_info& type_info() const noexcept
 		{
 			return typeid(H265Component);
@@ -32,7 +38,7 @@ namespace rabbit
 		void onPostProcess() noexcept(false) override;
 
 	private:
-		void convert(float* rgb, int w, int h, std::uint8_t* yuvBuf) noexcept;
+		void encode(std::uint8_t* yuv) noexcept;
 
 	private:
 		H265Component(const H265Component&) = delete;
@@ -46,9 +52,9 @@ namespace rabbit
 		x265_picture* picture_;
 		x265_encoder* encoder_;
 
-		std::unique_ptr<char[]> enc_;
-		std::unique_ptr<char[]> scratch_;
-		std::unique_ptr<std::uint8_t[]> buf_;
+		std::atomic<bool> encodeFailed_;
+
+		FramePipeline pipeline_;
 
 		std::string filepath_;
 		std::shared_ptr<std::ostream> ostream_;
@@ -2,12 +2,14 @@
 #include "../rabbit_profile.h"
 #include "../rabbit_behaviour.h"
 #include <octoon/ass_loader.h>
+#include <octoon/model_cache.h>
 #pragma warning(push)
 #pragma warning(disable:4245)
 #include "../libs/nativefiledialog/nfd.h"
 #pragma warning(pop)
 
 #include <fstream>
+#include <filesystem>
 #include <unordered_map>
 #include <omp.h>
 
@@ -484,6 +486,10 @@ namespace rabbit
 	void
 	EntitiesComponent::onEnable() noexcept
 	{
+		std::error_code ec;
+		std::filesystem::create_directories(this->getContext()->profile->fileModule->cachePath, ec);
+		octoon::ModelCache::setCacheDirectory(this->getContext()->profile->fileModule->cachePath);
+
 		auto mainLight = octoon::GameObject::create("DirectionalLight");
 		mainLight->addComponent<octoon::DirectionalLightComponent>();
 		mainLight->getComponent<octoon::DirectionalLightComponent>()->setIntensity(this->getContext()->profile->sunModule->intensity);
@@ -528,5 +534,6 @@ namespace rabbit
 	void
 	EntitiesComponent::onDisable() noexcept
 	{
+		octoon::ModelCache::setCacheDirectory(std::string_view());
 	}
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace rabbit
 	FileModule::reset() noexcept
 	{
 		this->PATHLIMIT = 4096;
+		this->cachePath = "../../system/cache";
 
 		this->projectExtensions = { "pmm" };
 		this->modelExtensions = { "pmx" };
@@ -26,10 +27,13 @@ namespace rabbit
 	void 
 	FileModule::load(octoon::runtime::json& reader) noexcept
 	{
+		if (reader.find("cachePath") != reader.end())
+			this->cachePath = reader["cachePath"].get<nlohmann::json::string_t>();
 	}
 
 	void 
 	FileModule::save(octoon::runtime::json& writer) noexcept
 	{
+		writer["cachePath"] = this->cachePath;
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <rabbit_model.h>
 #include <vector>
+#include <string>
 
 namespace rabbit
 {
@@ -24,6 +25,8 @@ namespace rabbit
 	public:
 		std::uint32_t PATHLIMIT;
 
+		std::string cachePath;
+
 		std::vector<const char*> projectExtensions;
 		std::vector<const char*> modelExtensions;
 		std::vector<const char*> imageExtensions;
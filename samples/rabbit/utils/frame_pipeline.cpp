@@ -0,0 +1,245 @@
+#include "frame_pipeline.h"
+#include <algorithm>
+#include <chrono>
+
+namespace rabbit
+{
+	namespace
+	{
+		double now() noexcept
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		std::uint8_t saturate(float value) noexcept
+		{
+			return (std::uint8_t)std::clamp(value + 0.5f, 0.0f, 255.0f);
+		}
+
+		void print(std::ostream& stream, const char* name, const FrameStageStatistics& stage)
+		{
+			stream << name << ": " << stage.frames << " frames, ";
+			stream << (stage.busy > 0 ? stage.frames / stage.busy : 0) << " fps, ";
+			stream << stage.wait << "s waiting" << std::endl;
+		}
+	}
+
+	std::ostream&
+	operator<<(std::ostream& stream, const FramePipelineStatistics& statistics)
+	{
+		print(stream, "submit", statistics.submit);
+		print(stream, "convert", statistics.convert);
+		print(stream, "encode", statistics.encode);
+		return stream;
+	}
+
+	FramePipeline::FramePipeline() noexcept
+		: width_(0)
+		, height_(0)
+		, convertQuit_(false)
+		, encodeQuit_(false)
+		, statistics_()
+	{
+	}
+
+	FramePipeline::~FramePipeline() noexcept
+	{
+		this->close();
+	}
+
+	void
+	FramePipeline::open(std::uint32_t width, std::uint32_t height, std::size_t depth, EncodeFunc encode) noexcept(false)
+	{
+		this->close();
+
+		width_ = width;
+		height_ = height;
+		encode_ = std::move(encode);
+		convertQuit_ = false;
+		encodeQuit_ = false;
+		statistics_ = FramePipelineStatistics();
+
+		frames_.resize(std::max<std::size_t>(depth, 1));
+
+		for (std::size_t i = 0; i < frames_.size(); i++)
+		{
+			frames_[i].rgb.resize(width * height);
+			frames_[i].yuv.resize(width * height * 3 / 2);
+			free_.push_back(i);
+		}
+
+		convertThread_ = std::thread(&FramePipeline::convertThread, this);
+		encodeThread_ = std::thread(&FramePipeline::encodeThread, this);
+	}
+
+	void
+	FramePipeline::close() noexcept
+	{
+		if (convertThread_.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				convertQuit_ = true;
+			}
+
+			convertReady_.notify_one();
+			convertThread_.join();
+		}
+
+		if (encodeThread_.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				encodeQuit_ = true;
+			}
+
+			encodeReady_.notify_one();
+			encodeThread_.join();
+		}
+
+		frames_.clear();
+		free_.clear();
+		converting_.clear();
+		encoding_.clear();
+		encode_ = nullptr;
+	}
+
+	bool
+	FramePipeline::isOpen() const noexcept
+	{
+		return encodeThread_.joinable();
+	}
+
+	void
+	FramePipeline::push(const octoon::math::float3* rgb) noexcept
+	{
+		auto begin = now();
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		freeReady_.wait(lock, [this]() { return !free_.empty(); });
+
+		auto index = free_.front();
+		free_.pop_front();
+
+		auto start = now();
+
+		lock.unlock();
+		std::copy(rgb, rgb + width_ * height_, frames_[index].rgb.begin());
+		lock.lock();
+
+		statistics_.submit.frames++;
+		statistics_.submit.wait += start - begin;
+		statistics_.submit.busy += now() - start;
+
+		converting_.push_back(index);
+		convertReady_.notify_one();
+	}
+
+	FramePipelineStatistics
+	FramePipeline::getStatistics() const noexcept
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return statistics_;
+	}
+
+	void
+	FramePipeline::convertThread() noexcept
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		for (;;)
+		{
+			auto begin = now();
+
+			convertReady_.wait(lock, [this]() { return convertQuit_ || !converting_.empty(); });
+			if (converting_.empty())
+				break;
+
+			auto index = converting_.front();
+			converting_.pop_front();
+
+			auto start = now();
+
+			lock.unlock();
+			convert(frames_[index].rgb.data(), width_, height_, frames_[index].yuv.data());
+			lock.lock();
+
+			statistics_.convert.frames++;
+			statistics_.convert.wait += start - begin;
+			statistics_.convert.busy += now() - start;
+
+			encoding_.push_back(index);
+			encodeReady_.notify_one();
+		}
+	}
+
+	void
+	FramePipeline::encodeThread() noexcept
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		for (;;)
+		{
+			auto begin = now();
+
+			encodeReady_.wait(lock, [this]() { return encodeQuit_ || !encoding_.empty(); });
+			if (encoding_.empty())
+				break;
+
+			auto index = encoding_.front();
+			encoding_.pop_front();
+
+			auto start = now();
+
+			lock.unlock();
+			encode_(frames_[index].yuv.data());
+			lock.lock();
+
+			statistics_.encode.frames++;
+			statistics_.encode.wait += start - begin;
+			statistics_.encode.busy += now() - start;
+
+			free_.push_back(index);
+			freeReady_.notify_one();
+		}
+	}
+
+	void
+	FramePipeline::convert(const octoon::math::float3* rgb, std::uint32_t w, std::uint32_t h, std::uint8_t* yuv) noexcept
+	{
+		auto planeY = yuv;
+		auto planeU = planeY + w * h;
+		auto planeV = planeU + (w / 2) * (h / 2);
+
+		// BT.601 studio range, the same coefficients the components used per pixel before. Rows
+		// are processed in pairs of straight float loops the compiler can vectorize, and chroma
+		// is the average of each 2x2 block.
+#		pragma omp parallel for
+		for (std::int32_t j = 0; j < (std::int32_t)(h / 2); j++)
+		{
+			auto src0 = rgb + (h - j * 2 - 1) * w;
+			auto src1 = src0 - w;
+
+			auto dstY0 = planeY + j * 2 * w;
+			auto dstY1 = dstY0 + w;
+			auto dstU = planeU + j * (w / 2);
+			auto dstV = planeV + j * (w / 2);
+
+			for (std::uint32_t i = 0; i < w; i++)
+			{
+				dstY0[i] = saturate(16.0f + 65.742f * src0[i].x + 128.496f * src0[i].y + 24.902f * src0[i].z);
+				dstY1[i] = saturate(16.0f + 65.742f * src1[i].x + 128.496f * src1[i].y + 24.902f * src1[i].z);
+			}
+
+			for (std::uint32_t i = 0; i < w / 2; i++)
+			{
+				auto r = (src0[i * 2].x + src0[i * 2 + 1].x + src1[i * 2].x + src1[i * 2 + 1].x) * 0.25f;
+				auto g = (src0[i * 2].y + src0[i * 2 + 1].y + src1[i * 2].y + src1[i * 2 + 1].y) * 0.25f;
+				auto b = (src0[i * 2].z + src0[i * 2 + 1].z + src1[i * 2].z + src1[i * 2 + 1].z) * 0.25f;
+
+				dstU[i] = saturate(128.0f - 37.852f * r - 73.711f * g + 111.563f * b);
+				dstV[i] = saturate(128.0f + 111.563f * r - 93.633f * g - 17.930f * b);
+			}
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#ifndef RABBIT_FRAME_PIPELINE_H_
+#define RABBIT_FRAME_PIPELINE_H_
+
+#include <octoon/math/vector3.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace rabbit
+{
+	struct FrameStageStatistics
+	{
+		std::uint64_t frames;
+		double busy;
+		double wait;
+	};
+
+	// `wait` is back-pressure for the submit stage and idle time for the worker stages, all in seconds.
+	struct FramePipelineStatistics
+	{
+		FrameStageStatistics submit;
+		FrameStageStatistics convert;
+		FrameStageStatistics encode;
+	};
+
+	// Prints frames, throughput and waiting time of each stage.
+	std::ostream& operator<<(std::ostream& stream, const FramePipelineStatistics& statistics);
+
+	/*
+	* Export pipeline for recorded frames. The render thread copies each frame into a free slot,
+	* a convert thread turns it into I420 and an encode thread hands it to the encoder, which
+	* writes the bitstream. Slots are recycled, so at most `depth` frames are in flight and
+	* `push` blocks once the encoder falls behind.
+	*/
+	class FramePipeline final
+	{
+	public:
+		// Called on the encode thread in submission order with Y, U and V planes packed back to back.
+		using EncodeFunc = std::function<void(std::uint8_t* yuv)>;
+
+		FramePipeline() noexcept;
+		~FramePipeline() noexcept;
+
+		void open(std::uint32_t width, std::uint32_t height, std::size_t depth, EncodeFunc encode) noexcept(false);
+		void close() noexcept;
+
+		bool isOpen() const noexcept;
+
+		void push(const octoon::math::float3* rgb) noexcept;
+
+		FramePipelineStatistics getStatistics() const noexcept;
+
+		static void convert(const octoon::math::float3* rgb, std::uint32_t w, std::uint32_t h, std::uint8_t* yuv) noexcept;
+
+	private:
+		void convertThread() noexcept;
+		void encodeThread() noexcept;
+
+	private:
+		FramePipeline(const FramePipeline&) = delete;
+		FramePipeline& operator=(const FramePipeline&) = delete;
+
+	private:
+		struct Frame
+		{
+			std::vector<octoon::math::float3> rgb;
+			std::vector<std::uint8_t> yuv;
+		};
+
+		std::uint32_t width_;
+		std::uint32_t height_;
+
+		bool convertQuit_;
+		bool encodeQuit_;
+
+		EncodeFunc encode_;
+
+		std::vector<Frame> frames_;
+		std::deque<std::size_t> free_;
+		std::deque<std::size_t> converting_;
+		std::deque<std::size_t> encoding_;
+
+		mutable std::mutex mutex_;
+		std::condition_variable freeReady_;
+		std::condition_variable convertReady_;
+		std::condition_variable encodeReady_;
+
+		std::thread convertThread_;
+		std::thread encodeThread_;
+
+		FramePipelineStatistics statistics_;
+	};
+}
+
+#endif
@@ -5,8 +5,41 @@
 
 namespace octoon
 {
+	static std::size_t
+	flac_stream_read(void* data, void* ptr, std::size_t bytes)
+	{
+		assert(data != nullptr);
+
+		// An empty read leaves gcount() at the count of the previous one.
+		if (bytes == 0)
+			return 0;
+
+		auto input = static_cast<io::istream*>(data);
+		input->read((char*)ptr, bytes);
+		return input->gcount();
+	}
+
+	static drflac_bool32
+	flac_stream_seek(void* data, int offset, drflac_seek_origin origin)
+	{
+		assert(data != nullptr);
+
+		auto input = static_cast<io::istream*>(data);
+		input->seekg(offset, origin == drflac_seek_origin_start ? io::ios_base::beg : io::ios_base::cur);
+		return input->fail() ? DRFLAC_FALSE : DRFLAC_TRUE;
+	}
+
+	struct FlacStreamBuffer::Decoder
+	{
+		io::ifstream stream;
+		drflac* flac;
+	};
+
 	FlacStreamBuffer::FlacStreamBuffer() noexcept
-		: pos_(0)
+		: hz_(0)
+		, channels_(0)
+		, samples_(0)
+		, pos_(0)
 	{
 	}
 
@@ -24,60 +57,40 @@ namespace octoon
 	void
 	FlacStreamBuffer::open(const char* filepath) noexcept(false)
 	{
-		io::ifstream stream(filepath);
-		if (stream)
+		this->close();
+
+		auto decoder = std::make_unique<Decoder>();
+		if (decoder->stream.open(filepath))
 		{
-			auto size = stream.size();
-			auto buffer = std::make_unique<char[]>(size);
-			if (stream.read(buffer.get(), size))
-			{
-				drflac* flac = drflac_open_memory(buffer.get(), size, nullptr);
-				if (flac)
-				{
-					this->hz_ = flac->sampleRate;
-					this->channels_ = flac->channels;
-					this->samples_= flac->totalPCMFrameCount;
-					this->buffer_.resize(this->samples_ * this->channels_ * sizeof(drflac_int16));
-
-					drflac_read_pcm_frames_s16(flac, this->samples_, (drflac_int16*)buffer_.data());
-					drflac_close(flac);
-				}
-				else
-				{
-					throw std::runtime_error("Failed to read flac memory.");
-				}
-			}
+			decoder->flac = ::drflac_open(&flac_stream_read, &flac_stream_seek, &decoder->stream, nullptr);
+			if (!decoder->flac)
+				throw std::runtime_error("Failed to read flac stream.");
+
+			this->pos_ = 0;
+			this->hz_ = decoder->flac->sampleRate;
+			this->channels_ = decoder->flac->channels;
+			this->samples_ = decoder->flac->totalPCMFrameCount;
+			this->decoder_ = std::move(decoder);
 		}
 	}
 
 	io::streamsize
 	FlacStreamBuffer::read(char* str, std::streamsize cnt) noexcept
 	{
-		auto buf_size = buffer_.size();
-		std::size_t actual_copyable;
+		assert(this->is_open());
 
-		if (static_cast<std::streamsize>(buf_size - pos_) > cnt)
-		{
-			actual_copyable = cnt;
-			std::memcpy(str, buffer_.data() + pos_, actual_copyable);
-			pos_ += cnt;
-		}
-		else
-		{
-			actual_copyable = buf_size - pos_;
-			std::memcpy(str, buffer_.data() + pos_, actual_copyable);
-			pos_ = buf_size;
-		}
+		auto frameSize = this->channels_ * sizeof(std::int16_t);
+		auto frames = ::drflac_read_pcm_frames_s16(this->decoder_->flac, cnt / frameSize, (drflac_int16*)str);
 
-		return actual_copyable;
+		pos_ += frames * frameSize;
+		return frames * frameSize;
 	}
 
 	io::streamsize
 	FlacStreamBuffer::write(const char* str, std::streamsize cnt) noexcept
 	{
-		buffer_.reserve(pos_ + cnt);
-		std::memcpy(buffer_.data() + pos_, str, cnt);
-		return cnt;
+		assert(false);
+		return 0;
 	}
 
 	io::streamoff
@@ -102,7 +115,11 @@ namespace octoon
 		std::streamsize resultant = base + pos;
 		if (resultant >= 0u && resultant <= this->size())
 		{
-			pos_ = resultant;
+			auto frameSize = this->channels_ * sizeof(std::int16_t);
+			if (!::drflac_seek_to_pcm_frame(this->decoder_->flac, (resultant / frameSize)))
+				return false;
+
+			pos_ = resultant - resultant % frameSize;
 			return true;
 		}
 
@@ -119,13 +136,13 @@ namespace octoon
 	io::streamsize
 	FlacStreamBuffer::size() const noexcept
 	{
-		return this->buffer_.size();
+		return this->samples_ * this->channels_ * sizeof(std::int16_t);
 	}
 
 	bool
 	FlacStreamBuffer::is_open() const noexcept
 	{
-		return !this->buffer_.empty();
+		return this->decoder_ ? true : false;
 	}
 
 	int
@@ -137,8 +154,14 @@ namespace octoon
 	bool
 	FlacStreamBuffer::close() noexcept
 	{
-		this->buffer_.shrink_to_fit();
-		return true;
+		if (this->decoder_)
+		{
+			::drflac_close(this->decoder_->flac);
+			this->decoder_.reset();
+			return true;
+		}
+
+		return false;
 	}
 
 	std::uint16_t
@@ -5,8 +5,42 @@
 
 namespace octoon
 {
+	static std::size_t
+	mp3_stream_read(void* data, void* ptr, std::size_t bytes)
+	{
+		assert(data != nullptr);
+
+		// An empty read leaves gcount() at the count of the previous one.
+		if (bytes == 0)
+			return 0;
+
+		auto input = static_cast<io::istream*>(data);
+		input->read((char*)ptr, bytes);
+		return input->gcount();
+	}
+
+	static drmp3_bool32
+	mp3_stream_seek(void* data, int offset, drmp3_seek_origin origin)
+	{
+		assert(data != nullptr);
+
+		auto input = static_cast<io::istream*>(data);
+		input->seekg(offset, origin == drmp3_seek_origin_start ? io::ios_base::beg : io::ios_base::cur);
+		return input->fail() ? DRMP3_FALSE : DRMP3_TRUE;
+	}
+
+	struct Mp3StreamBuffer::Decoder
+	{
+		io::ifstream stream;
+		drmp3 mp3;
+		drmp3_seek_point seekPoints[256];
+	};
+
 	Mp3StreamBuffer::Mp3StreamBuffer() noexcept
-		: pos_(0)
+		: hz_(0)
+		, channels_(0)
+		, samples_(0)
+		, pos_(0)
 	{
 	}
 
@@ -24,60 +58,45 @@ namespace octoon
 	void
 	Mp3StreamBuffer::open(const char* filepath) noexcept(false)
 	{
-		io::ifstream stream(filepath);
-		if (stream)
+		this->close();
+
+		auto decoder = std::make_unique<Decoder>();
+		if (decoder->stream.open(filepath))
 		{
-			auto size = stream.size();
-			auto buffer = std::make_unique<char[]>(size);
-			if (stream.read(buffer.get(), size))
-			{
-				drmp3* mp3 = new drmp3;
-				if (drmp3_init_memory(mp3, buffer.get(), size, nullptr))
-				{
-					this->hz_ = mp3->sampleRate;
-					this->channels_ = mp3->channels;
-					this->samples_= drmp3_get_pcm_frame_count(mp3);
-					this->buffer_.resize(this->samples_ * this->channels_ * sizeof(drmp3_int16));
-
-					drmp3_read_pcm_frames_s16(mp3, this->samples_, (drmp3_int16*)buffer_.data());
-					drmp3_uninit(mp3);
-				}
-				else
-				{
-					throw std::runtime_error("Failed to read mp3 memory.");
-				}
-			}
+			if (!::drmp3_init(&decoder->mp3, &mp3_stream_read, &mp3_stream_seek, &decoder->stream, nullptr))
+				throw std::runtime_error("Failed to read mp3 stream.");
+
+			this->pos_ = 0;
+			this->hz_ = decoder->mp3.sampleRate;
+			this->channels_ = decoder->mp3.channels;
+			this->samples_ = ::drmp3_get_pcm_frame_count(&decoder->mp3);
+
+			// Without a seek table every seek decodes from the start of the file.
+			drmp3_uint32 count = sizeof(decoder->seekPoints) / sizeof(drmp3_seek_point);
+			if (::drmp3_calculate_seek_points(&decoder->mp3, &count, decoder->seekPoints))
+				::drmp3_bind_seek_table(&decoder->mp3, count, decoder->seekPoints);
+
+			this->decoder_ = std::move(decoder);
 		}
 	}
 
 	io::streamsize
 	Mp3StreamBuffer::read(char* str, std::streamsize cnt) noexcept
 	{
-		auto buf_size = buffer_.size();
-		std::size_t actual_copyable;
+		assert(this->is_open());
 
-		if (static_cast<std::streamsize>(buf_size - pos_) > cnt)
-		{
-			actual_copyable = cnt;
-			std::memcpy(str, buffer_.data() + pos_, actual_copyable);
-			pos_ += cnt;
-		}
-		else
-		{
-			actual_copyable = buf_size - pos_;
-			std::memcpy(str, buffer_.data() + pos_, actual_copyable);
-			pos_ = buf_size;
-		}
+		auto frameSize = this->channels_ * sizeof(std::int16_t);
+		auto frames = ::drmp3_read_pcm_frames_s16(&this->decoder_->mp3, cnt / frameSize, (drmp3_int16*)str);
 
-		return actual_copyable;
+		pos_ += frames * frameSize;
+		return frames * frameSize;
 	}
 
 	io::streamsize
 	Mp3StreamBuffer::write(const char* str, std::streamsize cnt) noexcept
 	{
-		buffer_.reserve(pos_ + cnt);
-		std::memcpy(buffer_.data() + pos_, str, cnt);
-		return cnt;
+		assert(false);
+		return 0;
 	}
 
 	io::streamoff
@@ -102,7 +121,11 @@ namespace octoon
 		std::streamsize resultant = base + pos;
 		if (resultant >= 0u && resultant <= this->size())
 		{
-			pos_ = resultant;
+			auto frameSize = this->channels_ * sizeof(std::int16_t);
+			if (!::drmp3_seek_to_pcm_frame(&this->decoder_->mp3, (resultant / frameSize)))
+				return false;
+
+			pos_ = resultant - resultant % frameSize;
 			return true;
 		}
 
@@ -119,13 +142,13 @@ namespace octoon
 	io::streamsize
 	Mp3StreamBuffer::size() const noexcept
 	{
-		return this->buffer_.size();
+		return this->samples_ * this->channels_ * sizeof(std::int16_t);
 	}
 
 	bool
 	Mp3StreamBuffer::is_open() const noexcept
 	{
-		return !this->buffer_.empty();
+		return this->decoder_ ? true : false;
 	}
 
 	int
@@ -137,8 +160,14 @@ namespace octoon
 	bool
 	Mp3StreamBuffer::close() noexcept
 	{
-		this->buffer_.shrink_to_fit();
-		return true;
+		if (this->decoder_)
+		{
+			::drmp3_uninit(&this->decoder_->mp3);
+			this->decoder_.reset();
+			return true;
+		}
+
+		return false;
 	}
 
 	std::uint32_t
@@ -169,8 +169,11 @@ namespace octoon
 		std::streamsize resultant = base + pos;
 		if (resultant >= 0u && resultant <= this->size())
 		{
-			::ov_pcm_seek(oggVorbisFile_, resultant);
-			pos_ = resultant;
+			auto frameSize = this->channels() * sizeof(std::int16_t);
+			if (::ov_pcm_seek(oggVorbisFile_, resultant / frameSize) != 0)
+				return false;
+
+			pos_ = resultant - resultant % frameSize;
 			return true;
 		}
 
@@ -181,7 +184,7 @@ namespace octoon
 	OggStreamBuffer::tellg() noexcept
 	{
 		assert(this->is_open());
-		return ::ov_pcm_tell(oggVorbisFile_);
+		return ::ov_pcm_tell(oggVorbisFile_) * this->channels() * sizeof(std::int16_t);
 	}
 
 	io::streamsize
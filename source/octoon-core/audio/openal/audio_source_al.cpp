@@ -5,15 +5,35 @@
 #include <AL/alext.h>
 #include <AL/efx.h>
 
+#include <chrono>
+
 namespace octoon
 {
+	static ALenum
+	toFormat(std::uint32_t channels, std::uint16_t bitsPerSample) noexcept
+	{
+		if (channels == 1)
+			return bitsPerSample == 8 ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
+		else if (channels == 2)
+			return bitsPerSample == 8 ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16;
+		else if (channels == 4)
+			return AL_FORMAT_QUAD16;
+		else if (channels == 6)
+			return AL_FORMAT_51CHN16;
+		return AL_NONE;
+	}
+
 	AudioSourceAL::AudioSourceAL() noexcept
 		: source_(AL_NONE)
 		, format_(AL_NONE)
 		, isPlaying_(false)
 		, isLoop_(false)
+		, cursor_(0)
+		, frameSize_(0)
+		, quit_(false)
 	{
 		buffer_ = 0;
+		std::fill(std::begin(streamBuffers_), std::end(streamBuffers_), AL_NONE);
 	}
 
 	AudioSourceAL::~AudioSourceAL() noexcept
@@ -36,6 +56,8 @@ namespace octoon
 	void
 	AudioSourceAL::close() noexcept
 	{
+		this->stopStream();
+
 		if (source_ != AL_NONE)
 		{
 			this->reset();
@@ -121,19 +143,13 @@ namespace octoon
 	void
 	AudioSourceAL::setAudioClip(const AudioClip& clip) noexcept
 	{
+		this->stopStream();
+
 		audioClip_ = clip;
 
 		if (audioClip_.length > 0)
 		{
-			format_ = AL_NONE;
-			if (audioClip_.channels == 1)
-				format_ = audioClip_.bitsPerSample == 8 ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
-			else if (audioClip_.channels == 2)
-				format_ = audioClip_.bitsPerSample == 8 ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16;
-			else if (audioClip_.channels == 4)
-				format_ = AL_FORMAT_QUAD16;
-			else if (audioClip_.channels == 6)
-				format_ = AL_FORMAT_51CHN16;
+			format_ = toFormat(audioClip_.channels, audioClip_.bitsPerSample);
 
 			::alBufferData(buffer_, format_, audioClip_.data.data(), (ALsizei)audioClip_.data.size(), audioClip_.freq);
 			::alSourceQueueBuffers(source_, 1, &buffer_);
@@ -151,6 +167,42 @@ namespace octoon
 		}
 	}
 
+	void
+	AudioSourceAL::setAudioReader(const std::shared_ptr<AudioReader>& reader) noexcept
+	{
+		assert(source_ != AL_NONE);
+
+		this->stopStream();
+
+		::alSourceStop(source_);
+		::alSourcei(source_, AL_BUFFER, AL_NONE);
+
+		audioClip_.data.clear();
+		audioClip_.samples = reader ? reader->samples() : 0;
+		audioClip_.channels = reader ? reader->channels() : 0;
+		audioClip_.freq = reader ? reader->frequency() : 0;
+		audioClip_.bitsPerSample = reader ? reader->bitsPerSample() : 0;
+		audioClip_.length = audioClip_.freq > 0 ? audioClip_.samples / float(audioClip_.freq) : 0.0f;
+
+		format_ = toFormat(audioClip_.channels, audioClip_.bitsPerSample);
+		if (format_ == AL_NONE || audioClip_.samples == 0)
+			return;
+
+		reader_ = reader;
+		frameSize_ = audioClip_.channels * audioClip_.bitsPerSample / 8;
+		staging_.resize(std::max<std::size_t>(audioClip_.freq / STREAM_BUFFERS_PER_SECOND, 1) * frameSize_);
+
+		::alGenBuffers(NUM_STREAM_BUFFERS, streamBuffers_);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			this->rewind(0);
+		}
+
+		quit_ = false;
+		thread_ = std::thread(&AudioSourceAL::streamThread, this);
+	}
+
 	void
 	AudioSourceAL::setMaxDistance(float maxdis) noexcept
 	{
@@ -261,44 +313,117 @@ namespace octoon
 		return audioClip_;
 	}
 
+	const std::shared_ptr<AudioReader>&
+	AudioSourceAL::getAudioReader() const noexcept
+	{
+		return reader_;
+	}
+
 	void
 	AudioSourceAL::play(bool loop) noexcept
 	{
 		assert(source_ != AL_NONE && buffer_ != AL_NONE && format_ != AL_NONE);
 
+		std::lock_guard<std::mutex> lock(mutex_);
+
 		isLoop_ = loop;
 
+		// A stream that played to the end starts over, like a clip does.
+		if (reader_ && queue_.empty())
+			this->rewind(0);
+
 		if (!this->isPlaying())
 		{
 			::alSourcePlay(source_);
 			isPlaying_ = true;
-		} 
+		}
+
+		wakeup_.notify_one();
 	}
 
 	void
 	AudioSourceAL::reset() noexcept
 	{
 		assert(source_ != AL_NONE);
-		alSourceStop(source_);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		isPlaying_ = false;
+
+		if (reader_)
+			this->rewind(0);
+		else
+			alSourceStop(source_);
 	}
 
 	void
 	AudioSourceAL::pause() noexcept
 	{
 		assert(source_ != AL_NONE);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		isPlaying_ = false;
 		alSourcePause(source_);
 	}
 
 	void
 	AudioSourceAL::setSampleOffset(std::int32_t offset) noexcept
 	{
-		alSourcei(source_, AL_SAMPLE_OFFSET, offset);
+		if (reader_)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			ALint state = AL_NONE;
+			alGetSourcei(source_, AL_SOURCE_STATE, &state);
+
+			this->rewind(std::max(offset, 0));
+
+			if (state == AL_PLAYING)
+				alSourcePlay(source_);
+		}
+		else
+		{
+			alSourcei(source_, AL_SAMPLE_OFFSET, offset);
+		}
 	}
 
 	std::int32_t
 	AudioSourceAL::getSampleOffset() const noexcept
 	{
 		ALint value;
+
+		if (reader_)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			// The offset counts from the first buffer still queued. A stopped source reports 0,
+			// having played every buffer it had processed.
+			ALint state = AL_NONE;
+			alGetSourcei(source_, AL_SOURCE_STATE, &state);
+			alGetSourcei(source_, state == AL_STOPPED ? AL_BUFFERS_PROCESSED : AL_SAMPLE_OFFSET, &value);
+
+			std::uint64_t offset = 0;
+			if (state == AL_STOPPED)
+			{
+				for (std::size_t i = 0; i < queue_.size() && i < static_cast<std::size_t>(value); i++)
+					offset += queue_[i].frames;
+			}
+			else
+			{
+				offset = value;
+			}
+
+			for (auto& it : queue_)
+			{
+				if (offset < it.frames)
+					return static_cast<std::int32_t>(it.start + offset);
+				offset -= it.frames;
+			}
+
+			return static_cast<std::int32_t>(cursor_);
+		}
+
 		alGetSourcei(source_, AL_SAMPLE_OFFSET, &value);
 		return value;
 	}
@@ -347,4 +472,119 @@ namespace octoon
 	{
 		return isLoop_;
 	}
+
+	void
+	AudioSourceAL::streamThread() noexcept
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		while (!quit_)
+		{
+			ALint processed = 0;
+			alGetSourcei(source_, AL_BUFFERS_PROCESSED, &processed);
+
+			for (; processed > 0; processed--)
+			{
+				ALuint buffer;
+				::alSourceUnqueueBuffers(source_, 1, &buffer);
+				queue_.pop_front();
+				idle_.push_back(buffer);
+			}
+
+			while (!idle_.empty() && this->fill(idle_.back()))
+				idle_.pop_back();
+
+			// The source stops by itself when the decoder falls behind, so it is started
+			// again as long as there is something left to play.
+			if (isPlaying_)
+			{
+				ALint state = AL_NONE;
+				alGetSourcei(source_, AL_SOURCE_STATE, &state);
+
+				if (state == AL_STOPPED)
+				{
+					if (queue_.empty())
+						isPlaying_ = false;
+					else
+						::alSourcePlay(source_);
+				}
+			}
+
+			wakeup_.wait_for(lock, std::chrono::milliseconds(1000 / STREAM_BUFFERS_PER_SECOND / 4));
+		}
+	}
+
+	void
+	AudioSourceAL::stopStream() noexcept
+	{
+		if (thread_.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				quit_ = true;
+			}
+
+			wakeup_.notify_one();
+			thread_.join();
+		}
+
+		if (streamBuffers_[0] != AL_NONE)
+		{
+			::alSourceStop(source_);
+			::alSourcei(source_, AL_BUFFER, AL_NONE);
+			::alDeleteBuffers(NUM_STREAM_BUFFERS, streamBuffers_);
+
+			std::fill(std::begin(streamBuffers_), std::end(streamBuffers_), AL_NONE);
+		}
+
+		queue_.clear();
+		idle_.clear();
+		staging_ = std::vector<char>();
+		reader_.reset();
+		isPlaying_ = false;
+	}
+
+	void
+	AudioSourceAL::rewind(std::uint64_t frame) noexcept
+	{
+		// AL_INITIAL rather than AL_STOPPED, so the buffers queued next count as pending.
+		::alSourceRewind(source_);
+		::alSourcei(source_, AL_BUFFER, AL_NONE);
+
+		queue_.clear();
+		idle_.assign(std::begin(streamBuffers_), std::end(streamBuffers_));
+
+		cursor_ = std::min(frame, audioClip_.samples);
+		reader_->seekg(cursor_ * frameSize_, io::ios_base::beg);
+
+		while (!idle_.empty() && this->fill(idle_.back()))
+			idle_.pop_back();
+	}
+
+	bool
+	AudioSourceAL::fill(std::uint32_t buffer) noexcept
+	{
+		reader_->read(staging_.data(), staging_.size());
+		auto bytes = reader_->gcount();
+
+		if (bytes < static_cast<io::streamsize>(frameSize_) && isLoop_ && cursor_ > 0)
+		{
+			cursor_ = 0;
+			reader_->seekg(0, io::ios_base::beg);
+			reader_->read(staging_.data(), staging_.size());
+			bytes = reader_->gcount();
+		}
+
+		auto frames = static_cast<std::uint64_t>(bytes / frameSize_);
+		if (frames == 0)
+			return false;
+
+		::alBufferData(buffer, format_, staging_.data(), static_cast<ALsizei>(frames * frameSize_), audioClip_.freq);
+		::alSourceQueueBuffers(source_, 1, &buffer);
+
+		queue_.push_back(StreamBuffer{ buffer, cursor_, frames });
+		cursor_ += frames;
+
+		return true;
+	}
 }
\ No newline at end of file
@@ -5,8 +5,41 @@
 
 namespace octoon
 {
+	static std::size_t
+	wav_stream_read(void* data, void* ptr, std::size_t bytes)
+	{
+		assert(data != nullptr);
+
+		// An empty read leaves gcount() at the count of the previous one.
+		if (bytes == 0)
+			return 0;
+
+		auto input = static_cast<io::istream*>(data);
+		input->read((char*)ptr, bytes);
+		return input->gcount();
+	}
+
+	static drwav_bool32
+	wav_stream_seek(void* data, int offset, drwav_seek_origin origin)
+	{
+		assert(data != nullptr);
+
+		auto input = static_cast<io::istream*>(data);
+		input->seekg(offset, origin == drwav_seek_origin_start ? io::ios_base::beg : io::ios_base::cur);
+		return input->fail() ? DRWAV_FALSE : DRWAV_TRUE;
+	}
+
+	struct WavStreamBuffer::Decoder
+	{
+		io::ifstream stream;
+		drwav wav;
+	};
+
 	WavStreamBuffer::WavStreamBuffer() noexcept
-		: pos_(0)
+		: hz_(0)
+		, channels_(0)
+		, samples_(0)
+		, pos_(0)
 	{
 	}
 
@@ -24,60 +57,39 @@ namespace octoon
 	void
 	WavStreamBuffer::open(const char* filepath) noexcept(false)
 	{
-		io::ifstream stream(filepath);
-		if (stream)
+		this->close();
+
+		auto decoder = std::make_unique<Decoder>();
+		if (decoder->stream.open(filepath))
 		{
-			auto size = stream.size();
-			auto buffer = std::make_unique<char[]>(size);
-			if (stream.read(buffer.get(), size))
-			{
-				drwav* wav = new drwav;
-				if (drwav_init_memory(wav, buffer.get(), size, nullptr))
-				{
-					this->hz_ = wav->sampleRate;
-					this->channels_ = wav->channels;
-					this->samples_= wav->totalPCMFrameCount;
-					this->buffer_.resize(this->samples_ * this->channels_ * sizeof(drwav_int16));
-
-					drwav_read_pcm_frames_s16(wav, this->samples_, (drwav_int16*)buffer_.data());
-					drwav_uninit(wav);
-				}
-				else
-				{
-					throw std::runtime_error("Failed to read wav memory.");
-				}
-			}
+			if (!::drwav_init(&decoder->wav, &wav_stream_read, &wav_stream_seek, &decoder->stream, nullptr))
+				throw std::runtime_error("Failed to read wav stream.");
+
+			this->pos_ = 0;
+			this->hz_ = decoder->wav.sampleRate;
+			this->channels_ = decoder->wav.channels;
+			this->samples_ = decoder->wav.totalPCMFrameCount;
+			this->decoder_ = std::move(decoder);
 		}
 	}
 
 	io::streamsize
 	WavStreamBuffer::read(char* str, std::streamsize cnt) noexcept
 	{
-		auto buf_size = buffer_.size();
-		std::size_t actual_copyable;
+		assert(this->is_open());
 
-		if (static_cast<std::streamsize>(buf_size - pos_) > cnt)
-		{
-			actual_copyable = cnt;
-			std::memcpy(str, buffer_.data() + pos_, actual_copyable);
-			pos_ += cnt;
-		}
-		else
-		{
-			actual_copyable = buf_size - pos_;
-			std::memcpy(str, buffer_.data() + pos_, actual_copyable);
-			pos_ = buf_size;
-		}
+		auto frameSize = this->channels_ * sizeof(std::int16_t);
+		auto frames = ::drwav_read_pcm_frames_s16(&this->decoder_->wav, cnt / frameSize, (drwav_int16*)str);
 
-		return actual_copyable;
+		pos_ += frames * frameSize;
+		return frames * frameSize;
 	}
 
 	io::streamsize
 	WavStreamBuffer::write(const char* str, std::streamsize cnt) noexcept
 	{
-		buffer_.reserve(pos_ + cnt);
-		std::memcpy(buffer_.data() + pos_, str, cnt);
-		return cnt;
+		assert(false);
+		return 0;
 	}
 
 	io::streamoff
@@ -102,7 +114,11 @@ namespace octoon
 		std::streamsize resultant = base + pos;
 		if (resultant >= 0u && resultant <= this->size())
 		{
-			pos_ = resultant;
+			auto frameSize = this->channels_ * sizeof(std::int16_t);
+			if (!::drwav_seek_to_pcm_frame(&this->decoder_->wav, (resultant / frameSize)))
+				return false;
+
+			pos_ = resultant - resultant % frameSize;
 			return true;
 		}
 
@@ -119,13 +135,13 @@ namespace octoon
 	io::streamsize
 	WavStreamBuffer::size() const noexcept
 	{
-		return this->buffer_.size();
+		return this->samples_ * this->channels_ * sizeof(std::int16_t);
 	}
 
 	bool
 	WavStreamBuffer::is_open() const noexcept
 	{
-		return !this->buffer_.empty();
+		return this->decoder_ ? true : false;
 	}
 
 	int
@@ -137,8 +153,14 @@ namespace octoon
 	bool
 	WavStreamBuffer::close() noexcept
 	{
-		this->buffer_.shrink_to_fit();
-		return true;
+		if (this->decoder_)
+		{
+			::drwav_uninit(&this->decoder_->wav);
+			this->decoder_.reset();
+			return true;
+		}
+
+		return false;
 	}
 
 	std::uint32_t
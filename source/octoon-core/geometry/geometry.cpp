@@ -8,6 +8,7 @@ namespace octoon
 		: isCastShadow_(true)
 		, isReceiveShadow_(true)
 		, isGlobalIllumination_(false)
+		, isStatic_(false)
 	{
 	}
 
@@ -54,12 +55,25 @@ namespace octoon
 		return this->isGlobalIllumination_;
 	}
 
+	void
+	Geometry::setStatic(bool enable) noexcept
+	{
+		this->setDirty(true);
+		this->isStatic_ = enable;
+	}
+
+	bool
+	Geometry::getStatic() const noexcept
+	{
+		return this->isStatic_;
+	}
+
 	void
 	Geometry::setMesh(std::shared_ptr<Mesh>&& mesh) noexcept
 	{
 		this->setDirty(true);
 		this->mesh_ = std::move(mesh);
-		this->setBoundingBox(mesh ? mesh->getBoundingBoxAll() : math::BoundingBox::Empty);
+		this->setBoundingBox(mesh_ ? mesh_->getBoundingBoxAll() : math::BoundingBox::Empty);
 	}
 
 	void
@@ -0,0 +1,63 @@
+#ifndef OCTOON_NULL_DEVICE_H_
+#define OCTOON_NULL_DEVICE_H_
+
+#include "null_types.h"
+#include <atomic>
+
+namespace octoon
+{
+	namespace hal
+	{
+		// Device without a GPU behind it; resources live in system memory and contexts record what they are asked to do.
+		class NullDevice final : public GraphicsDevice
+		{
+			OctoonDeclareSubClass(NullDevice, GraphicsDevice)
+		public:
+			NullDevice() noexcept;
+			virtual ~NullDevice() noexcept;
+
+			bool setup(const GraphicsDeviceDesc& desc) noexcept;
+			void close() noexcept;
+
+			GraphicsSwapchainPtr createSwapchain(const GraphicsSwapchainDesc& desc) noexcept override;
+			GraphicsContextPtr createDeviceContext(const GraphicsContextDesc& desc) noexcept override;
+			GraphicsInputLayoutPtr createInputLayout(const GraphicsInputLayoutDesc& desc) noexcept override;
+			GraphicsDataPtr createGraphicsData(const GraphicsDataDesc& desc) noexcept override;
+			GraphicsTexturePtr createTexture(const GraphicsTextureDesc& desc) noexcept override;
+			GraphicsSamplerPtr createSampler(const GraphicsSamplerDesc& desc) noexcept override;
+			GraphicsFramebufferPtr createFramebuffer(const GraphicsFramebufferDesc& desc) noexcept override;
+			GraphicsFramebufferLayoutPtr createFramebufferLayout(const GraphicsFramebufferLayoutDesc& desc) noexcept override;
+			GraphicsShaderPtr createShader(const GraphicsShaderDesc& desc) noexcept override;
+			GraphicsProgramPtr createProgram(const GraphicsProgramDesc& desc) noexcept override;
+			GraphicsStatePtr createRenderState(const GraphicsStateDesc& desc) noexcept override;
+			GraphicsPipelinePtr createRenderPipeline(const GraphicsPipelineDesc& desc) noexcept override;
+			GraphicsDescriptorSetPtr createDescriptorSet(const GraphicsDescriptorSetDesc& desc) noexcept override;
+			GraphicsDescriptorSetLayoutPtr createDescriptorSetLayout(const GraphicsDescriptorSetLayoutDesc& desc) noexcept override;
+			GraphicsDescriptorPoolPtr createDescriptorPool(const GraphicsDescriptorPoolDesc& desc) noexcept override;
+
+			void copyDescriptorSets(GraphicsDescriptorSetPtr& source, std::uint32_t descriptorCopyCount, const GraphicsDescriptorSetPtr descriptorCopies[]) noexcept override;
+
+			const GraphicsDeviceProperty& getDeviceProperty() const noexcept override;
+			const GraphicsDeviceDesc& getDeviceDesc() const noexcept override;
+
+			void addUpload(std::size_t bytes) noexcept;
+			std::uint32_t getUploadCount() const noexcept;
+			std::uint64_t getUploadBytes() const noexcept;
+
+			void message(const char* message, ...) noexcept;
+
+		private:
+			NullDevice(const NullDevice&) noexcept = delete;
+			NullDevice& operator=(const NullDevice&) noexcept = delete;
+
+		private:
+			GraphicsDeviceDesc _deviceDesc;
+			GraphicsDevicePropertyPtr _deviceProperty;
+
+			std::atomic<std::uint32_t> _uploadCount;
+			std::atomic<std::uint64_t> _uploadBytes;
+		};
+	}
+}
+
+#endif
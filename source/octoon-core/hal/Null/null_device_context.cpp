@@ -0,0 +1,450 @@
+#include "null_device_context.h"
+#include "null_device.h"
+#include <octoon/runtime/profiler.h>
+#include <algorithm>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullDeviceContext, GraphicsContext, "NullDeviceContext")
+
+		NullDeviceContext::NullDeviceContext() noexcept
+			: _capture(false)
+			, _indexType(GraphicsIndexType::UInt32)
+			, _indexOffset(0)
+			, _uploadCount(0)
+			, _uploadBytes(0)
+			, _statistics{}
+		{
+			std::fill(std::begin(_stencilCompareMask), std::end(_stencilCompareMask), 0xFFFFFFFF);
+			std::fill(std::begin(_stencilReference), std::end(_stencilReference), 0);
+			std::fill(std::begin(_stencilWriteMask), std::end(_stencilWriteMask), 0xFFFFFFFF);
+		}
+
+		NullDeviceContext::~NullDeviceContext() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDeviceContext::setup(const GraphicsContextDesc& desc) noexcept
+		{
+			auto& deviceProperties = this->getDevice()->getDeviceProperty().getDeviceProperties();
+
+			_swapchain = desc.getSwapchain();
+			_vertexBuffers.resize(deviceProperties.maxVertexInputBindings, VertexBuffer{ nullptr, 0 });
+			_viewports.resize(deviceProperties.maxViewports, float4(0, 0, 0, 0));
+			_scissors.resize(deviceProperties.maxViewports, uint4(0, 0, 0, 0));
+
+			return true;
+		}
+
+		void
+		NullDeviceContext::close() noexcept
+		{
+			_pipeline.reset();
+			_descriptorSet.reset();
+			_framebuffer.reset();
+			_indexBuffer.reset();
+			_swapchain.reset();
+			_vertexBuffers.clear();
+			_timestamps.clear();
+			_commands.clear();
+		}
+
+		void
+		NullDeviceContext::renderBegin() noexcept
+		{
+			auto device = this->getDevice()->downcast<NullDevice>();
+
+			_commands.clear();
+			_statistics = GraphicsFrameStatistics{};
+			_uploadCount = device->getUploadCount();
+			_uploadBytes = device->getUploadBytes();
+
+			this->record(GraphicsCommandOp::RenderBegin, this);
+		}
+
+		void
+		NullDeviceContext::renderEnd() noexcept
+		{
+			this->record(GraphicsCommandOp::RenderEnd, this);
+		}
+
+		void
+		NullDeviceContext::setViewport(std::uint32_t i, const float4& view) noexcept
+		{
+			assert(i < _viewports.size());
+
+			bool changed = _viewports[i] != view;
+			_viewports[i] = view;
+
+			this->recordState(GraphicsCommandOp::SetViewport, nullptr, changed, i, (std::uint32_t)view.left, (std::uint32_t)view.top, (std::uint32_t)view.width, (std::uint32_t)view.height);
+		}
+
+		const float4&
+		NullDeviceContext::getViewport(std::uint32_t i) const noexcept
+		{
+			assert(i < _viewports.size());
+			return _viewports[i];
+		}
+
+		void
+		NullDeviceContext::setScissor(std::uint32_t i, const uint4& scissor) noexcept
+		{
+			assert(i < _scissors.size());
+
+			bool changed = _scissors[i] != scissor;
+			_scissors[i] = scissor;
+
+			this->recordState(GraphicsCommandOp::SetScissor, nullptr, changed, i, scissor.x, scissor.y, scissor.z, scissor.w);
+		}
+
+		const uint4&
+		NullDeviceContext::getScissor(std::uint32_t i) const noexcept
+		{
+			assert(i < _scissors.size());
+			return _scissors[i];
+		}
+
+		void
+		NullDeviceContext::setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			bool changed = false;
+			if (face & GraphicsStencilFaceFlagBits::FrontBit) { changed |= _stencilCompareMask[0] != mask; _stencilCompareMask[0] = mask; }
+			if (face & GraphicsStencilFaceFlagBits::BackBit) { changed |= _stencilCompareMask[1] != mask; _stencilCompareMask[1] = mask; }
+
+			this->recordState(GraphicsCommandOp::SetStencilCompareMask, nullptr, changed, face, mask);
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilCompareMask(GraphicsStencilFaceFlags face) noexcept
+		{
+			assert(face == GraphicsStencilFaceFlagBits::FrontBit || face == GraphicsStencilFaceFlagBits::BackBit);
+			return face == GraphicsStencilFaceFlagBits::FrontBit ? _stencilCompareMask[0] : _stencilCompareMask[1];
+		}
+
+		void
+		NullDeviceContext::setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept
+		{
+			bool changed = false;
+			if (face & GraphicsStencilFaceFlagBits::FrontBit) { changed |= _stencilReference[0] != reference; _stencilReference[0] = reference; }
+			if (face & GraphicsStencilFaceFlagBits::BackBit) { changed |= _stencilReference[1] != reference; _stencilReference[1] = reference; }
+
+			this->recordState(GraphicsCommandOp::SetStencilReference, nullptr, changed, face, reference);
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilReference(GraphicsStencilFaceFlags face) noexcept
+		{
+			assert(face == GraphicsStencilFaceFlagBits::FrontBit || face == GraphicsStencilFaceFlagBits::BackBit);
+			return face == GraphicsStencilFaceFlagBits::FrontBit ? _stencilReference[0] : _stencilReference[1];
+		}
+
+		void
+		NullDeviceContext::setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			bool changed = false;
+			if (face & GraphicsStencilFaceFlagBits::FrontBit) { changed |= _stencilWriteMask[0] != mask; _stencilWriteMask[0] = mask; }
+			if (face & GraphicsStencilFaceFlagBits::BackBit) { changed |= _stencilWriteMask[1] != mask; _stencilWriteMask[1] = mask; }
+
+			this->recordState(GraphicsCommandOp::SetStencilWriteMask, nullptr, changed, face, mask);
+		}
+
+		std::uint32_t
+		NullDeviceContext::getStencilWriteMask(GraphicsStencilFaceFlags face) noexcept
+		{
+			assert(face == GraphicsStencilFaceFlagBits::FrontBit || face == GraphicsStencilFaceFlagBits::BackBit);
+			return face == GraphicsStencilFaceFlagBits::FrontBit ? _stencilWriteMask[0] : _stencilWriteMask[1];
+		}
+
+		void
+		NullDeviceContext::setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept
+		{
+			assert(pipeline);
+
+			bool changed = _pipeline != pipeline;
+			if (changed)
+				_statistics.pipelineChanges++;
+
+			_pipeline = pipeline;
+
+			this->recordState(GraphicsCommandOp::SetRenderPipeline, pipeline.get(), changed);
+		}
+
+		GraphicsPipelinePtr
+		NullDeviceContext::getRenderPipeline() const noexcept
+		{
+			return _pipeline;
+		}
+
+		void
+		NullDeviceContext::setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept
+		{
+			assert(descriptorSet);
+
+			bool changed = _descriptorSet != descriptorSet;
+			if (changed)
+				_statistics.descriptorSetChanges++;
+
+			_descriptorSet = descriptorSet;
+
+			this->recordState(GraphicsCommandOp::SetDescriptorSet, descriptorSet.get(), changed);
+		}
+
+		GraphicsDescriptorSetPtr
+		NullDeviceContext::getDescriptorSet() const noexcept
+		{
+			return _descriptorSet;
+		}
+
+		void
+		NullDeviceContext::setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept
+		{
+			assert(data);
+			assert(data->getDataDesc().getType() == GraphicsDataType::StorageVertexBuffer);
+			assert(i < _vertexBuffers.size());
+
+			bool changed = _vertexBuffers[i].data != data || _vertexBuffers[i].offset != offset;
+			if (changed)
+				_statistics.bufferChanges++;
+
+			_vertexBuffers[i].data = data;
+			_vertexBuffers[i].offset = offset;
+
+			this->recordState(GraphicsCommandOp::SetVertexBuffer, data.get(), changed, i, (std::uint32_t)offset);
+		}
+
+		GraphicsDataPtr
+		NullDeviceContext::getVertexBufferData(std::uint32_t i) const noexcept
+		{
+			assert(i < _vertexBuffers.size());
+			return _vertexBuffers[i].data;
+		}
+
+		void
+		NullDeviceContext::setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t offset, GraphicsIndexType indexType) noexcept
+		{
+			assert(data);
+			assert(data->getDataDesc().getType() == GraphicsDataType::StorageIndexBuffer);
+			assert(indexType == GraphicsIndexType::UInt16 || indexType == GraphicsIndexType::UInt32);
+
+			bool changed = _indexBuffer != data || _indexOffset != offset || _indexType != indexType;
+			if (changed)
+				_statistics.bufferChanges++;
+
+			_indexBuffer = data;
+			_indexOffset = offset;
+			_indexType = indexType;
+
+			this->recordState(GraphicsCommandOp::SetIndexBuffer, data.get(), changed, (std::uint32_t)offset, (std::uint32_t)indexType);
+		}
+
+		GraphicsDataPtr
+		NullDeviceContext::getIndexBufferData() const noexcept
+		{
+			return _indexBuffer;
+		}
+
+		void
+		NullDeviceContext::generateMipmap(const GraphicsTexturePtr& texture) noexcept
+		{
+			assert(texture);
+			this->record(GraphicsCommandOp::GenerateMipmap, texture.get());
+		}
+
+		void
+		NullDeviceContext::setFramebuffer(const GraphicsFramebufferPtr& target) noexcept
+		{
+			bool changed = _framebuffer != target;
+			if (changed)
+				_statistics.framebufferChanges++;
+
+			_framebuffer = target;
+
+			this->recordState(GraphicsCommandOp::SetFramebuffer, target.get(), changed);
+		}
+
+		void
+		NullDeviceContext::clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept
+		{
+			_statistics.clears++;
+			this->record(GraphicsCommandOp::ClearFramebuffer, _framebuffer.get(), i, flags, (std::uint32_t)stencil);
+		}
+
+		void
+		NullDeviceContext::discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags) noexcept
+		{
+			this->record(GraphicsCommandOp::DiscardFramebuffer, src.get(), flags);
+		}
+
+		void
+		NullDeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept
+		{
+			assert(src);
+			this->record(GraphicsCommandOp::BlitFramebuffer, src.get(), (std::uint32_t)v1.width, (std::uint32_t)v1.height, (std::uint32_t)v2.width, (std::uint32_t)v2.height);
+		}
+
+		void
+		NullDeviceContext::readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept
+		{
+			assert(texture);
+			this->record(GraphicsCommandOp::ReadFramebuffer, texture.get(), i, miplevel, width, height);
+		}
+
+		void
+		NullDeviceContext::readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept
+		{
+			assert(texture);
+			this->record(GraphicsCommandOp::ReadFramebuffer, texture.get(), i, miplevel, width, height, face);
+		}
+
+		GraphicsFramebufferPtr
+		NullDeviceContext::getFramebuffer() const noexcept
+		{
+			return _framebuffer;
+		}
+
+		void
+		NullDeviceContext::draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept
+		{
+			assert(_pipeline);
+			assert(numInstances > 0);
+
+			_statistics.drawCalls++;
+			_statistics.instances += numInstances;
+			_statistics.vertices += std::uint64_t(numVertices) * numInstances;
+
+			this->record(GraphicsCommandOp::Draw, _pipeline.get(), numVertices, numInstances, startVertice, startInstances);
+		}
+
+		void
+		NullDeviceContext::drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept
+		{
+			assert(_pipeline);
+			assert(_indexBuffer);
+			assert(numInstances > 0);
+
+			_statistics.drawCalls++;
+			_statistics.instances += numInstances;
+			_statistics.vertices += std::uint64_t(numIndices) * numInstances;
+
+			this->record(GraphicsCommandOp::DrawIndexed, _pipeline.get(), numIndices, numInstances, startIndice, startVertice, startInstances);
+		}
+
+		void
+		NullDeviceContext::drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
+		{
+			assert(_pipeline);
+			assert(data);
+
+			_statistics.drawCalls += drawCount;
+			this->record(GraphicsCommandOp::DrawIndirect, data.get(), (std::uint32_t)offset, drawCount, stride);
+		}
+
+		void
+		NullDeviceContext::drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
+		{
+			assert(_pipeline);
+			assert(_indexBuffer);
+			assert(data);
+
+			_statistics.drawCalls += drawCount;
+			this->record(GraphicsCommandOp::DrawIndexedIndirect, data.get(), (std::uint32_t)offset, drawCount, stride);
+		}
+
+		void
+		NullDeviceContext::writeTimestamp(std::uint32_t i) noexcept
+		{
+			// Nothing runs on a device, so the timestamps are taken from the CPU clock.
+			if (i >= _timestamps.size())
+				_timestamps.resize(i + 1, 0);
+			_timestamps[i] = runtime::Profiler::now();
+		}
+
+		bool
+		NullDeviceContext::getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept
+		{
+			if (i >= _timestamps.size())
+				return false;
+			nanoseconds = _timestamps[i];
+			return true;
+		}
+
+		std::uint64_t
+		NullDeviceContext::getUniformBytes() const noexcept
+		{
+			return 0;
+		}
+
+		void
+		NullDeviceContext::present() noexcept
+		{
+			this->record(GraphicsCommandOp::Present, _swapchain.get());
+		}
+
+		void
+		NullDeviceContext::setCommandCapture(bool enable) noexcept
+		{
+			_capture = enable;
+		}
+
+		bool
+		NullDeviceContext::getCommandCapture() const noexcept
+		{
+			return _capture;
+		}
+
+		const std::vector<GraphicsCommand>&
+		NullDeviceContext::getCommands() const noexcept
+		{
+			return _commands;
+		}
+
+		const GraphicsFrameStatistics&
+		NullDeviceContext::getFrameStatistics() const noexcept
+		{
+			auto device = _device.lock();
+			if (device)
+			{
+				auto nullDevice = device->downcast<NullDevice>();
+				_statistics.uploads = nullDevice->getUploadCount() - _uploadCount;
+				_statistics.uploadBytes = nullDevice->getUploadBytes() - _uploadBytes;
+			}
+
+			return _statistics;
+		}
+
+		void
+		NullDeviceContext::record(GraphicsCommandOp op, const void* object, std::uint32_t a0, std::uint32_t a1, std::uint32_t a2, std::uint32_t a3, std::uint32_t a4) noexcept
+		{
+			_statistics.commands++;
+
+			if (_capture)
+				_commands.push_back(GraphicsCommand{ op, object, { a0, a1, a2, a3, a4 } });
+		}
+
+		void
+		NullDeviceContext::recordState(GraphicsCommandOp op, const void* object, bool changed, std::uint32_t a0, std::uint32_t a1, std::uint32_t a2, std::uint32_t a3, std::uint32_t a4) noexcept
+		{
+			_statistics.stateChanges++;
+			if (!changed)
+				_statistics.redundantStateChanges++;
+
+			this->record(op, object, a0, a1, a2, a3, a4);
+		}
+
+		void
+		NullDeviceContext::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullDeviceContext::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,130 @@
+#ifndef OCTOON_NULL_DEVICE_CONTEXT_H_
+#define OCTOON_NULL_DEVICE_CONTEXT_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		// Replays nothing; every call is validated against the bound state, counted and, when capture is on, appended to the frame's command list.
+		class NullDeviceContext final : public GraphicsContext, public GraphicsCommandRecorder
+		{
+			OctoonDeclareSubClass(NullDeviceContext, GraphicsContext)
+		public:
+			NullDeviceContext() noexcept;
+			~NullDeviceContext() noexcept;
+
+			bool setup(const GraphicsContextDesc& desc) noexcept;
+			void close() noexcept;
+
+			void renderBegin() noexcept override;
+			void renderEnd() noexcept override;
+
+			void setViewport(std::uint32_t i, const float4& viewport) noexcept override;
+			const float4& getViewport(std::uint32_t i) const noexcept override;
+
+			void setScissor(std::uint32_t i, const uint4& scissor) noexcept override;
+			const uint4& getScissor(std::uint32_t i) const noexcept override;
+
+			void setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept override;
+			std::uint32_t getStencilCompareMask(GraphicsStencilFaceFlags face) noexcept override;
+
+			void setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept override;
+			std::uint32_t getStencilReference(GraphicsStencilFaceFlags face) noexcept override;
+
+			void setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept override;
+			std::uint32_t getStencilWriteMask(GraphicsStencilFaceFlags face) noexcept override;
+
+			void setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept override;
+			GraphicsPipelinePtr getRenderPipeline() const noexcept override;
+
+			void setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept override;
+			GraphicsDescriptorSetPtr getDescriptorSet() const noexcept override;
+
+			void setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept override;
+			GraphicsDataPtr getVertexBufferData(std::uint32_t i) const noexcept override;
+
+			void setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t offset, GraphicsIndexType indexType) noexcept override;
+			GraphicsDataPtr getIndexBufferData() const noexcept override;
+
+			void generateMipmap(const GraphicsTexturePtr& texture) noexcept override;
+
+			void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept override;
+			void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept override;
+			void discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags) noexcept override;
+			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept override;
+			void readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept override;
+			void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept override;
+			GraphicsFramebufferPtr getFramebuffer() const noexcept override;
+
+			void draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept override;
+			void drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept override;
+			void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept override;
+			void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept override;
+
+			void writeTimestamp(std::uint32_t i) noexcept override;
+			bool getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept override;
+
+			std::uint64_t getUniformBytes() const noexcept override;
+
+			void present() noexcept override;
+
+			void setCommandCapture(bool enable) noexcept override;
+			bool getCommandCapture() const noexcept override;
+
+			const std::vector<GraphicsCommand>& getCommands() const noexcept override;
+			const GraphicsFrameStatistics& getFrameStatistics() const noexcept override;
+
+		private:
+			void record(GraphicsCommandOp op, const void* object, std::uint32_t a0 = 0, std::uint32_t a1 = 0, std::uint32_t a2 = 0, std::uint32_t a3 = 0, std::uint32_t a4 = 0) noexcept;
+			void recordState(GraphicsCommandOp op, const void* object, bool changed, std::uint32_t a0 = 0, std::uint32_t a1 = 0, std::uint32_t a2 = 0, std::uint32_t a3 = 0, std::uint32_t a4 = 0) noexcept;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullDeviceContext(const NullDeviceContext&) noexcept = delete;
+			NullDeviceContext& operator=(const NullDeviceContext&) noexcept = delete;
+
+		private:
+			struct VertexBuffer
+			{
+				GraphicsDataPtr data;
+				std::intptr_t offset;
+			};
+
+			bool _capture;
+
+			std::vector<float4> _viewports;
+			std::vector<uint4> _scissors;
+			std::vector<VertexBuffer> _vertexBuffers;
+			std::vector<std::uint64_t> _timestamps;
+
+			std::uint32_t _stencilCompareMask[2];
+			std::uint32_t _stencilReference[2];
+			std::uint32_t _stencilWriteMask[2];
+
+			GraphicsIndexType _indexType;
+			std::intptr_t _indexOffset;
+
+			GraphicsPipelinePtr _pipeline;
+			GraphicsDescriptorSetPtr _descriptorSet;
+			GraphicsFramebufferPtr _framebuffer;
+			GraphicsDataPtr _indexBuffer;
+			GraphicsSwapchainPtr _swapchain;
+
+			std::uint32_t _uploadCount;
+			std::uint64_t _uploadBytes;
+
+			std::vector<GraphicsCommand> _commands;
+			mutable GraphicsFrameStatistics _statistics;
+
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "null_device_property.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		NullDeviceProperty::NullDeviceProperty() noexcept
+		{
+		}
+
+		NullDeviceProperty::~NullDeviceProperty() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullDeviceProperty::setup(const GraphicsDeviceDesc& deviceDesc) noexcept
+		{
+			// Advertise the limits of a typical desktop GL 4.5 driver so the renderer takes its regular paths.
+			_deviceProperties.maxImageDimension1D = 16384;
+			_deviceProperties.maxImageDimension2D = 16384;
+			_deviceProperties.maxImageDimension3D = 2048;
+			_deviceProperties.maxImageDimensionCube = 16384;
+			_deviceProperties.maxUniformBufferRange = 65536;
+			_deviceProperties.maxBoundDescriptorSets = 1;
+			_deviceProperties.maxPerStageDescriptorSamplers = 32;
+			_deviceProperties.maxPerStageDescriptorUniformBuffers = 14;
+			_deviceProperties.maxPerStageDescriptorSampledImages = 32;
+			_deviceProperties.maxDescriptorSetSamplers = 80;
+			_deviceProperties.maxDescriptorSetUniformBuffers = 84;
+			_deviceProperties.maxDescriptorSetSampledImages = 80;
+			_deviceProperties.maxVertexInputAttributes = 16;
+			_deviceProperties.maxVertexInputBindings = 16;
+			_deviceProperties.maxVertexInputAttributeOffset = 2047;
+			_deviceProperties.maxVertexInputBindingStride = 2048;
+			_deviceProperties.maxFragmentOutputAttachments = 8;
+			_deviceProperties.maxViewports = 16;
+			_deviceProperties.maxViewportDimensionsW = 16384;
+			_deviceProperties.maxViewportDimensionsH = 16384;
+			_deviceProperties.maxFramebufferWidth = 16384;
+			_deviceProperties.maxFramebufferHeight = 16384;
+			_deviceProperties.maxFramebufferLayers = 2048;
+			_deviceProperties.maxFramebufferColorAttachments = 8;
+			_deviceProperties.maxSamplerAnisotropy = 16.0f;
+
+			for (std::uint32_t i = (std::uint32_t)GraphicsFormat::R4G4UNormPack8; i <= (std::uint32_t)GraphicsFormat::ASTC12x12SRGBBlock; i++)
+			{
+				_deviceProperties.supportTextures.push_back((GraphicsFormat)i);
+				_deviceProperties.supportAttribute.push_back((GraphicsFormat)i);
+			}
+
+			for (std::uint32_t i = (std::uint32_t)GraphicsTextureDim::Texture2D; i <= (std::uint32_t)GraphicsTextureDim::CubeArray; i++)
+				_deviceProperties.supportTextureDims.push_back((GraphicsTextureDim)i);
+
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::VertexBit);
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::FragmentBit);
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::GeometryBit);
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::ComputeBit);
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::TessEvaluationBit);
+			_deviceProperties.supportShaders.push_back(GraphicsShaderStageFlagBits::TessControlBit);
+
+			return true;
+		}
+
+		void
+		NullDeviceProperty::close() noexcept
+		{
+		}
+
+		const GraphicsDeviceProperties&
+		NullDeviceProperty::getDeviceProperties() const noexcept
+		{
+			return _deviceProperties;
+		}
+	}
+}
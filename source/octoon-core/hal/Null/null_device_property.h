@@ -0,0 +1,31 @@
+#ifndef OCTOON_NULL_DEVICE_PROPERTY_H_
+#define OCTOON_NULL_DEVICE_PROPERTY_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullDeviceProperty final : public GraphicsDeviceProperty
+		{
+		public:
+			NullDeviceProperty() noexcept;
+			~NullDeviceProperty() noexcept;
+
+			bool setup(const GraphicsDeviceDesc& deviceDesc) noexcept;
+			void close() noexcept;
+
+			const GraphicsDeviceProperties& getDeviceProperties() const noexcept override;
+
+		private:
+			NullDeviceProperty(const NullDeviceProperty&) noexcept = delete;
+			NullDeviceProperty& operator=(const NullDeviceProperty&) noexcept = delete;
+
+		private:
+			GraphicsDeviceProperties _deviceProperties;
+		};
+	}
+}
+
+#endif
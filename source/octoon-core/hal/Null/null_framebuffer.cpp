@@ -0,0 +1,97 @@
+#include "null_framebuffer.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullFramebufferLayout, GraphicsFramebufferLayout, "NullFramebufferLayout")
+		OctoonImplementSubClass(NullFramebuffer, GraphicsFramebuffer, "NullFramebuffer")
+
+		NullFramebufferLayout::NullFramebufferLayout() noexcept
+		{
+		}
+
+		NullFramebufferLayout::~NullFramebufferLayout() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullFramebufferLayout::setup(const GraphicsFramebufferLayoutDesc& framebufferLayoutDesc) noexcept
+		{
+			_framebufferLayoutDesc = framebufferLayoutDesc;
+			return true;
+		}
+
+		void
+		NullFramebufferLayout::close() noexcept
+		{
+		}
+
+		const GraphicsFramebufferLayoutDesc&
+		NullFramebufferLayout::getFramebufferLayoutDesc() const noexcept
+		{
+			return _framebufferLayoutDesc;
+		}
+
+		void
+		NullFramebufferLayout::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullFramebufferLayout::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullFramebuffer::NullFramebuffer() noexcept
+		{
+		}
+
+		NullFramebuffer::~NullFramebuffer() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullFramebuffer::setup(const GraphicsFramebufferDesc& framebufferDesc) noexcept
+		{
+			assert(framebufferDesc.getFramebufferLayout());
+			assert(framebufferDesc.getWidth() > 0 && framebufferDesc.getHeight() > 0);
+
+			_framebufferDesc = framebufferDesc;
+			return true;
+		}
+
+		void
+		NullFramebuffer::close() noexcept
+		{
+		}
+
+		const std::uint64_t
+		NullFramebuffer::handle() const noexcept
+		{
+			return (std::uint64_t)this;
+		}
+
+		const GraphicsFramebufferDesc&
+		NullFramebuffer::getFramebufferDesc() const noexcept
+		{
+			return _framebufferDesc;
+		}
+
+		void
+		NullFramebuffer::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullFramebuffer::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef OCTOON_NULL_FRAMEBUFFER_H_
+#define OCTOON_NULL_FRAMEBUFFER_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullFramebufferLayout final : public GraphicsFramebufferLayout
+		{
+			OctoonDeclareSubClass(NullFramebufferLayout, GraphicsFramebufferLayout)
+		public:
+			NullFramebufferLayout() noexcept;
+			~NullFramebufferLayout() noexcept;
+
+			bool setup(const GraphicsFramebufferLayoutDesc& framebufferDesc) noexcept;
+			void close() noexcept;
+
+			const GraphicsFramebufferLayoutDesc& getFramebufferLayoutDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullFramebufferLayout(const NullFramebufferLayout&) noexcept = delete;
+			NullFramebufferLayout& operator=(const NullFramebufferLayout&) noexcept = delete;
+
+		private:
+			GraphicsDeviceWeakPtr _device;
+			GraphicsFramebufferLayoutDesc _framebufferLayoutDesc;
+		};
+
+		class NullFramebuffer final : public GraphicsFramebuffer
+		{
+			OctoonDeclareSubClass(NullFramebuffer, GraphicsFramebuffer)
+		public:
+			NullFramebuffer() noexcept;
+			~NullFramebuffer() noexcept;
+
+			bool setup(const GraphicsFramebufferDesc& framebufferDesc) noexcept;
+			void close() noexcept;
+
+			const std::uint64_t handle() const noexcept override;
+			const GraphicsFramebufferDesc& getFramebufferDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullFramebuffer(const NullFramebuffer&) noexcept = delete;
+			NullFramebuffer& operator=(const NullFramebuffer&) noexcept = delete;
+
+		private:
+			GraphicsDeviceWeakPtr _device;
+			GraphicsFramebufferDesc _framebufferDesc;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "null_graphics_data.h"
+#include "null_device.h"
+#include <cstring>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullGraphicsData, GraphicsData, "NullGraphicsData")
+
+		NullGraphicsData::NullGraphicsData() noexcept
+			: _mapCount(0)
+			, _mapped(false)
+		{
+		}
+
+		NullGraphicsData::~NullGraphicsData() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullGraphicsData::setup(const GraphicsDataDesc& desc) noexcept
+		{
+			assert(_buffer.empty());
+			assert(desc.getStreamSize() > 0);
+
+			_desc = desc;
+			_buffer.resize(desc.getStreamSize());
+
+			if (desc.getStream())
+			{
+				std::memcpy(_buffer.data(), desc.getStream(), desc.getStreamSize());
+				this->getDevice()->downcast<NullDevice>()->addUpload(desc.getStreamSize());
+			}
+
+			return true;
+		}
+
+		bool
+		NullGraphicsData::is_open() const noexcept
+		{
+			return !_buffer.empty();
+		}
+
+		void
+		NullGraphicsData::close() noexcept
+		{
+			if (_mapped)
+				this->unmap();
+
+			_buffer.clear();
+			_buffer.shrink_to_fit();
+		}
+
+		bool
+		NullGraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept
+		{
+			assert(data);
+			assert(!_mapped);
+
+			if (offset < 0 || count < 0 || std::size_t(offset + count) > _buffer.size())
+				return false;
+
+			_mapped = true;
+			_mapCount = (std::size_t)count;
+
+			*data = _buffer.data() + offset;
+			return true;
+		}
+
+		void
+		NullGraphicsData::unmap() noexcept
+		{
+			if (_mapped)
+			{
+				auto device = this->getDevice();
+				if (device && _desc.getUsage() & GraphicsUsageFlagBits::WriteBit)
+					device->downcast<NullDevice>()->addUpload(_mapCount);
+
+				_mapped = false;
+				_mapCount = 0;
+			}
+		}
+
+		const std::uint8_t*
+		NullGraphicsData::data() const noexcept
+		{
+			return _buffer.data();
+		}
+
+		const GraphicsDataDesc&
+		NullGraphicsData::getDataDesc() const noexcept
+		{
+			return _desc;
+		}
+
+		void
+		NullGraphicsData::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullGraphicsData::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#ifndef OCTOON_NULL_GRAPHICS_DATA_H_
+#define OCTOON_NULL_GRAPHICS_DATA_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullGraphicsData final : public GraphicsData
+		{
+			OctoonDeclareSubClass(NullGraphicsData, GraphicsData)
+		public:
+			NullGraphicsData() noexcept;
+			virtual ~NullGraphicsData() noexcept;
+
+			bool setup(const GraphicsDataDesc& desc) noexcept;
+			void close() noexcept;
+
+			bool is_open() const noexcept;
+
+			bool map(std::ptrdiff_t begin, std::ptrdiff_t count, void** data) noexcept;
+			void unmap() noexcept;
+
+			const std::uint8_t* data() const noexcept;
+
+			const GraphicsDataDesc& getDataDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullGraphicsData(const NullGraphicsData&) noexcept = delete;
+			NullGraphicsData& operator=(const NullGraphicsData&) noexcept = delete;
+
+		private:
+			std::vector<std::uint8_t> _buffer;
+			std::size_t _mapCount;
+			bool _mapped;
+			GraphicsDataDesc _desc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
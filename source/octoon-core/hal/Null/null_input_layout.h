@@ -0,0 +1,38 @@
+#ifndef OCTOON_NULL_INPUT_LAYOUT_H_
+#define OCTOON_NULL_INPUT_LAYOUT_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullInputLayout final : public GraphicsInputLayout
+		{
+			OctoonDeclareSubClass(NullInputLayout, GraphicsInputLayout)
+		public:
+			NullInputLayout() noexcept;
+			~NullInputLayout() noexcept;
+
+			bool setup(const GraphicsInputLayoutDesc& desc) noexcept;
+			void close() noexcept;
+
+			const GraphicsInputLayoutDesc& getInputLayoutDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullInputLayout(const NullInputLayout&) noexcept = delete;
+			NullInputLayout& operator=(const NullInputLayout&) noexcept = delete;
+
+		private:
+			GraphicsInputLayoutDesc _desc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
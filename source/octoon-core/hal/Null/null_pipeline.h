@@ -0,0 +1,38 @@
+#ifndef OCTOON_NULL_PIPELINE_H_
+#define OCTOON_NULL_PIPELINE_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullPipeline final : public GraphicsPipeline
+		{
+			OctoonDeclareSubClass(NullPipeline, GraphicsPipeline)
+		public:
+			NullPipeline() noexcept;
+			~NullPipeline() noexcept;
+
+			bool setup(const GraphicsPipelineDesc& desc) noexcept;
+			void close() noexcept;
+
+			const GraphicsPipelineDesc& getPipelineDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullPipeline(const NullPipeline&) noexcept = delete;
+			NullPipeline& operator=(const NullPipeline&) noexcept = delete;
+
+		private:
+			GraphicsPipelineDesc _desc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
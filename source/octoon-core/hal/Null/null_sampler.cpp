@@ -0,0 +1,48 @@
+#include "null_sampler.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullSampler, GraphicsSampler, "NullSampler")
+
+		NullSampler::NullSampler() noexcept
+		{
+		}
+
+		NullSampler::~NullSampler() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullSampler::setup(const GraphicsSamplerDesc& desc) noexcept
+		{
+			_desc = desc;
+			return true;
+		}
+
+		void
+		NullSampler::close() noexcept
+		{
+		}
+
+		const GraphicsSamplerDesc&
+		NullSampler::getSamplerDesc() const noexcept
+		{
+			return _desc;
+		}
+
+		void
+		NullSampler::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullSampler::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#ifndef OCTOON_NULL_SAMPLER_H_
+#define OCTOON_NULL_SAMPLER_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullSampler final : public GraphicsSampler
+		{
+			OctoonDeclareSubClass(NullSampler, GraphicsSampler)
+		public:
+			NullSampler() noexcept;
+			~NullSampler() noexcept;
+
+			bool setup(const GraphicsSamplerDesc& desc) noexcept;
+			void close() noexcept;
+
+			const GraphicsSamplerDesc& getSamplerDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullSampler(const NullSampler&) noexcept = delete;
+			NullSampler& operator=(const NullSampler&) noexcept = delete;
+
+		private:
+			GraphicsSamplerDesc _desc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
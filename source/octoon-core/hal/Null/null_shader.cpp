@@ -0,0 +1,434 @@
+#include "null_shader.h"
+#include "null_device.h"
+#include <algorithm>
+#include <regex>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullShader, GraphicsShader, "NullShader")
+		OctoonImplementSubClass(NullProgram, GraphicsProgram, "NullProgram")
+		OctoonImplementSubClass(NullGraphicsAttribute, GraphicsAttribute, "NullGraphicsAttribute")
+		OctoonImplementSubClass(NullGraphicsUniform, GraphicsUniform, "NullGraphicsUniform")
+
+		NullGraphicsAttribute::NullGraphicsAttribute() noexcept
+			: _semanticIndex(0)
+			, _bindingPoint(0xFFFFFFFF)
+			, _type(GraphicsFormat::Undefined)
+		{
+		}
+
+		NullGraphicsAttribute::~NullGraphicsAttribute() noexcept
+		{
+		}
+
+		void
+		NullGraphicsAttribute::setSemantic(std::string_view semantic) noexcept
+		{
+			_semantic = semantic;
+		}
+
+		const std::string&
+		NullGraphicsAttribute::getSemantic() const noexcept
+		{
+			return _semantic;
+		}
+
+		void
+		NullGraphicsAttribute::setSemanticIndex(std::uint32_t index) noexcept
+		{
+			_semanticIndex = index;
+		}
+
+		std::uint32_t
+		NullGraphicsAttribute::getSemanticIndex() const noexcept
+		{
+			return _semanticIndex;
+		}
+
+		void
+		NullGraphicsAttribute::setType(GraphicsFormat type) noexcept
+		{
+			_type = type;
+		}
+
+		GraphicsFormat
+		NullGraphicsAttribute::getType() const noexcept
+		{
+			return _type;
+		}
+
+		void
+		NullGraphicsAttribute::setBindingPoint(std::uint32_t bindingPoint) noexcept
+		{
+			_bindingPoint = bindingPoint;
+		}
+
+		std::uint32_t
+		NullGraphicsAttribute::getBindingPoint() const noexcept
+		{
+			return _bindingPoint;
+		}
+
+		NullGraphicsUniform::NullGraphicsUniform() noexcept
+			: _offset(0)
+			, _bindingPoint(0xFFFFFFFF)
+			, _type(GraphicsUniformType::Null)
+			, _stageFlags(0)
+		{
+		}
+
+		NullGraphicsUniform::~NullGraphicsUniform() noexcept
+		{
+		}
+
+		void
+		NullGraphicsUniform::setName(std::string_view name) noexcept
+		{
+			_name = name;
+		}
+
+		const std::string&
+		NullGraphicsUniform::getName() const noexcept
+		{
+			return _name;
+		}
+
+		void
+		NullGraphicsUniform::setSamplerName(std::string_view name) noexcept
+		{
+			_samplerName = name;
+		}
+
+		const std::string&
+		NullGraphicsUniform::getSamplerName() const noexcept
+		{
+			return _samplerName;
+		}
+
+		void
+		NullGraphicsUniform::setType(GraphicsUniformType type) noexcept
+		{
+			_type = type;
+		}
+
+		GraphicsUniformType
+		NullGraphicsUniform::getType() const noexcept
+		{
+			return _type;
+		}
+
+		void
+		NullGraphicsUniform::setOffset(std::uint32_t offset) noexcept
+		{
+			_offset = offset;
+		}
+
+		std::uint32_t
+		NullGraphicsUniform::getOffset() const noexcept
+		{
+			return _offset;
+		}
+
+		void
+		NullGraphicsUniform::setBindingPoint(std::uint32_t bindingPoint) noexcept
+		{
+			_bindingPoint = bindingPoint;
+		}
+
+		std::uint32_t
+		NullGraphicsUniform::getBindingPoint() const noexcept
+		{
+			return _bindingPoint;
+		}
+
+		void
+		NullGraphicsUniform::setShaderStageFlags(GraphicsShaderStageFlags flags) noexcept
+		{
+			_stageFlags = flags;
+		}
+
+		GraphicsShaderStageFlags
+		NullGraphicsUniform::getShaderStageFlags() const noexcept
+		{
+			return _stageFlags;
+		}
+
+
+		NullShader::NullShader() noexcept
+		{
+		}
+
+		NullShader::~NullShader() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullShader::setup(const GraphicsShaderDesc& shaderDesc) noexcept
+		{
+			assert(!shaderDesc.getByteCodes().empty());
+
+			if (shaderDesc.getLanguage() != GraphicsShaderLang::GLSL)
+			{
+				this->getDevice()->downcast<NullDevice>()->message("Only glsl shaders can be reflected.");
+				return false;
+			}
+
+			_shaderDesc = shaderDesc;
+			return true;
+		}
+
+		void
+		NullShader::close() noexcept
+		{
+		}
+
+		const GraphicsShaderDesc&
+		NullShader::getShaderDesc() const noexcept
+		{
+			return _shaderDesc;
+		}
+
+		void
+		NullShader::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullShader::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+
+		NullProgram::NullProgram() noexcept
+			: _textureUnit(0)
+		{
+		}
+
+		NullProgram::~NullProgram() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullProgram::setup(const GraphicsProgramDesc& programDesc) noexcept
+		{
+			if (programDesc.getShaders().empty())
+				return false;
+
+			for (auto& shader : programDesc.getShaders())
+			{
+				auto& shaderDesc = shader->getShaderDesc();
+
+				static const std::regex comments(R"(//[^\n]*|/\*[\s\S]*?\*/)");
+				auto codes = std::regex_replace(shaderDesc.getByteCodes(), comments, " ");
+
+				if (shaderDesc.getStage() == GraphicsShaderStageFlagBits::VertexBit)
+					_initActiveAttribute(codes);
+
+				_initActiveUniform(codes, shaderDesc.getStage());
+			}
+
+			_programDesc = programDesc;
+			return true;
+		}
+
+		void
+		NullProgram::close() noexcept
+		{
+			_textureUnit = 0;
+			_activeParams.clear();
+			_activeAttributes.clear();
+		}
+
+		void
+		NullProgram::_initActiveAttribute(const std::string& codes) noexcept
+		{
+			static const std::regex declaration(R"((?:layout\s*\(\s*location\s*=\s*(\d+)\s*\)\s*)?\b(?:in|attribute)\s+(?:(?:lowp|mediump|highp)\s+)?(\w+)\s+(\w+)\s*;)");
+
+			std::uint32_t location = 0;
+
+			for (std::sregex_iterator it(codes.begin(), codes.end(), declaration), end; it != end; ++it)
+			{
+				auto& match = *it;
+				if (match[1].matched)
+					location = std::stoi(match[1].str());
+
+				std::string name = match[3].str();
+				std::string semantic = name;
+				std::uint32_t semanticIndex = 0;
+
+				auto digit = std::find_if_not(name.rbegin(), name.rend(), [](char ch) { return ch >= '0' && ch <= '9'; });
+				if (digit != name.rend() && digit != name.rbegin())
+				{
+					semantic = name.substr(0, name.rend() - digit);
+					semanticIndex = std::stoi(name.substr(name.rend() - digit));
+				}
+
+				std::size_t off = semantic.find_last_of('_');
+				if (off != std::string::npos)
+					semantic = semantic.substr(off + 1);
+
+				auto attrib = std::make_shared<NullGraphicsAttribute>();
+				attrib->setSemantic(semantic);
+				attrib->setSemanticIndex(semanticIndex);
+				attrib->setBindingPoint(location++);
+				attrib->setType(toGraphicsFormat(match[2].str()));
+
+				_activeAttributes.push_back(attrib);
+			}
+		}
+
+		void
+		NullProgram::_initActiveUniform(const std::string& codes, GraphicsShaderStageFlags stage) noexcept
+		{
+			static const std::regex declaration(R"(\buniform\s+(?:(?:lowp|mediump|highp)\s+)?(\w+)\s+(\w+)\s*(\[[^\]]*\])?\s*;)");
+
+			for (std::sregex_iterator it(codes.begin(), codes.end(), declaration), end; it != end; ++it)
+			{
+				auto& match = *it;
+
+				auto type = toGraphicsUniformType(match[1].str());
+				if (type == GraphicsUniformType::Null)
+					continue;
+
+				std::string name = match[2].str();
+				if (match[3].matched)
+					name += "[0]";
+
+				auto exists = std::find_if(_activeParams.begin(), _activeParams.end(), [&](const GraphicsParamPtr& param) { return param->getName() == name; });
+				if (exists != _activeParams.end())
+				{
+					auto uniform = (*exists)->downcast<NullGraphicsUniform>();
+					uniform->setShaderStageFlags(uniform->getShaderStageFlags() | stage);
+					continue;
+				}
+
+				auto uniform = std::make_shared<NullGraphicsUniform>();
+				uniform->setName(name);
+				uniform->setBindingPoint((std::uint32_t)_activeParams.size());
+				uniform->setType(type);
+				uniform->setShaderStageFlags(stage);
+
+				if (type == GraphicsUniformType::SamplerImage)
+				{
+					auto pos = name.find("_X_");
+					if (pos != std::string::npos)
+					{
+						uniform->setName(name.substr(0, pos));
+						uniform->setSamplerName(name.substr(pos + 3));
+					}
+
+					uniform->setBindingPoint(_textureUnit++);
+				}
+
+				_activeParams.push_back(uniform);
+			}
+		}
+
+		const GraphicsParams&
+		NullProgram::getActiveParams() const noexcept
+		{
+			return _activeParams;
+		}
+
+		const GraphicsAttributes&
+		NullProgram::getActiveAttributes() const noexcept
+		{
+			return _activeAttributes;
+		}
+
+		const GraphicsProgramDesc&
+		NullProgram::getProgramDesc() const noexcept
+		{
+			return _programDesc;
+		}
+
+		GraphicsFormat
+		NullProgram::toGraphicsFormat(std::string_view type) noexcept
+		{
+			if (type == "bool" || type == "uint")
+				return GraphicsFormat::R8UInt;
+			else if (type == "uvec2")
+				return GraphicsFormat::R8G8UInt;
+			else if (type == "uvec3")
+				return GraphicsFormat::R8G8B8UInt;
+			else if (type == "uvec4")
+				return GraphicsFormat::R8G8B8A8UInt;
+			else if (type == "int")
+				return GraphicsFormat::R8SInt;
+			else if (type == "ivec2")
+				return GraphicsFormat::R8G8SInt;
+			else if (type == "ivec3")
+				return GraphicsFormat::R8G8B8SInt;
+			else if (type == "ivec4")
+				return GraphicsFormat::R8G8B8A8SInt;
+			else if (type == "float")
+				return GraphicsFormat::R32SFloat;
+			else if (type == "vec2")
+				return GraphicsFormat::R32G32SFloat;
+			else if (type == "vec3")
+				return GraphicsFormat::R32G32B32SFloat;
+			else if (type == "vec4" || type == "mat2" || type == "mat3" || type == "mat4")
+				return GraphicsFormat::R32G32B32A32SFloat;
+			else
+				return GraphicsFormat::Undefined;
+		}
+
+		GraphicsUniformType
+		NullProgram::toGraphicsUniformType(std::string_view type) noexcept
+		{
+			if (type.find("sampler") != std::string_view::npos)
+				return GraphicsUniformType::SamplerImage;
+			else if (type == "bool")
+				return GraphicsUniformType::Boolean;
+			else if (type == "uint")
+				return GraphicsUniformType::UInt;
+			else if (type == "uvec2")
+				return GraphicsUniformType::UInt2;
+			else if (type == "uvec3")
+				return GraphicsUniformType::UInt3;
+			else if (type == "uvec4")
+				return GraphicsUniformType::UInt4;
+			else if (type == "int")
+				return GraphicsUniformType::Int;
+			else if (type == "ivec2")
+				return GraphicsUniformType::Int2;
+			else if (type == "ivec3")
+				return GraphicsUniformType::Int3;
+			else if (type == "ivec4")
+				return GraphicsUniformType::Int4;
+			else if (type == "float")
+				return GraphicsUniformType::Float;
+			else if (type == "vec2")
+				return GraphicsUniformType::Float2;
+			else if (type == "vec3")
+				return GraphicsUniformType::Float3;
+			else if (type == "vec4")
+				return GraphicsUniformType::Float4;
+			else if (type == "mat2")
+				return GraphicsUniformType::Float2x2;
+			else if (type == "mat3")
+				return GraphicsUniformType::Float3x3;
+			else if (type == "mat4")
+				return GraphicsUniformType::Float4x4;
+			else
+				return GraphicsUniformType::Null;
+		}
+
+		void
+		NullProgram::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullProgram::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#include "null_state.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullGraphicsState, GraphicsState, "NullGraphicsState")
+
+		NullGraphicsState::NullGraphicsState() noexcept
+		{
+		}
+
+		NullGraphicsState::~NullGraphicsState() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullGraphicsState::setup(const GraphicsStateDesc& desc) noexcept
+		{
+			_desc = desc;
+			return true;
+		}
+
+		void
+		NullGraphicsState::close() noexcept
+		{
+		}
+
+		const GraphicsStateDesc&
+		NullGraphicsState::getStateDesc() const noexcept
+		{
+			return _desc;
+		}
+
+		void
+		NullGraphicsState::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullGraphicsState::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
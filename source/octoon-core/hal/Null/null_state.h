@@ -0,0 +1,38 @@
+#ifndef OCTOON_NULL_STATE_H_
+#define OCTOON_NULL_STATE_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullGraphicsState final : public GraphicsState
+		{
+			OctoonDeclareSubClass(NullGraphicsState, GraphicsState)
+		public:
+			NullGraphicsState() noexcept;
+			~NullGraphicsState() noexcept;
+
+			bool setup(const GraphicsStateDesc& desc) noexcept;
+			void close() noexcept;
+
+			const GraphicsStateDesc& getStateDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullGraphicsState(const NullGraphicsState&) noexcept = delete;
+			NullGraphicsState& operator=(const NullGraphicsState&) noexcept = delete;
+
+		private:
+			GraphicsStateDesc _desc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
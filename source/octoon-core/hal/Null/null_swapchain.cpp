@@ -0,0 +1,74 @@
+#include "null_swapchain.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullSwapchain, GraphicsSwapchain, "NullSwapchain")
+
+		NullSwapchain::NullSwapchain() noexcept
+		{
+		}
+
+		NullSwapchain::~NullSwapchain() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullSwapchain::setup(const GraphicsSwapchainDesc& swapchainDesc) noexcept
+		{
+			_swapchainDesc = swapchainDesc;
+			return true;
+		}
+
+		void
+		NullSwapchain::close() noexcept
+		{
+		}
+
+		void
+		NullSwapchain::setSwapInterval(GraphicsSwapInterval interval) noexcept
+		{
+			_swapchainDesc.setSwapInterval(interval);
+		}
+
+		GraphicsSwapInterval
+		NullSwapchain::getSwapInterval() const noexcept
+		{
+			return _swapchainDesc.getSwapInterval();
+		}
+
+		void
+		NullSwapchain::setWindowResolution(std::uint32_t w, std::uint32_t h) noexcept
+		{
+			_swapchainDesc.setWidth(w);
+			_swapchainDesc.setHeight(h);
+		}
+
+		void
+		NullSwapchain::getWindowResolution(std::uint32_t& w, std::uint32_t& h) const noexcept
+		{
+			w = _swapchainDesc.getWidth();
+			h = _swapchainDesc.getHeight();
+		}
+
+		const GraphicsSwapchainDesc&
+		NullSwapchain::getGraphicsSwapchainDesc() const noexcept
+		{
+			return _swapchainDesc;
+		}
+
+		void
+		NullSwapchain::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullSwapchain::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
@@ -0,0 +1,122 @@
+#include "null_texture.h"
+#include "null_device.h"
+#include <cstring>
+
+namespace octoon
+{
+	namespace hal
+	{
+		OctoonImplementSubClass(NullTexture, GraphicsTexture, "NullTexture")
+
+		NullTexture::NullTexture() noexcept
+			: _pixelSize(0)
+			, _mapSize(0)
+			, _mapped(false)
+		{
+		}
+
+		NullTexture::~NullTexture() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		NullTexture::setup(const GraphicsTextureDesc& textureDesc) noexcept
+		{
+			assert(_levels.empty());
+			assert(textureDesc.getWidth() > 0 && textureDesc.getHeight() > 0);
+
+			_textureDesc = textureDesc;
+
+			// Compressed formats report no vertex size; assume one 32-bit texel so storage stays an upper bound.
+			_pixelSize = GraphicsVertexLayout::getVertexSize(textureDesc.getTexFormat());
+			if (_pixelSize == 0)
+				_pixelSize = 4;
+
+			_levels.resize(std::max<std::uint32_t>(1, textureDesc.getMipNums()));
+
+			auto& level = _levels.front();
+			level.resize(std::size_t(textureDesc.getWidth()) * textureDesc.getHeight() * std::max<std::uint32_t>(1, textureDesc.getDepth()) * std::max<std::uint32_t>(1, textureDesc.getLayerNums()) * _pixelSize);
+
+			if (textureDesc.getStream())
+			{
+				std::memcpy(level.data(), textureDesc.getStream(), std::min(level.size(), textureDesc.getStreamSize()));
+				this->getDevice()->downcast<NullDevice>()->addUpload(textureDesc.getStreamSize());
+			}
+
+			return true;
+		}
+
+		void
+		NullTexture::close() noexcept
+		{
+			if (_mapped)
+				this->unmap();
+
+			_levels.clear();
+		}
+
+		bool
+		NullTexture::map(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h, std::uint32_t mipLevel, void** data) noexcept
+		{
+			assert(data);
+			assert(!_mapped);
+
+			if (mipLevel >= _levels.size())
+				return false;
+
+			auto width = std::max(1u, _textureDesc.getWidth() >> mipLevel);
+			auto height = std::max(1u, _textureDesc.getHeight() >> mipLevel);
+			if (x + w > width || y + h > height)
+				return false;
+
+			auto& level = _levels[mipLevel];
+			if (level.empty())
+				level.resize(std::size_t(width) * height * _pixelSize);
+
+			_mapped = true;
+			_mapSize = std::size_t(w) * h * _pixelSize;
+
+			*data = level.data() + (std::size_t(y) * width + x) * _pixelSize;
+			return true;
+		}
+
+		void
+		NullTexture::unmap() noexcept
+		{
+			if (_mapped)
+			{
+				auto device = this->getDevice();
+				if (device && _textureDesc.getUsageFlagBits() & GraphicsUsageFlagBits::WriteBit)
+					device->downcast<NullDevice>()->addUpload(_mapSize);
+
+				_mapped = false;
+				_mapSize = 0;
+			}
+		}
+
+		const std::uint64_t
+		NullTexture::handle() const noexcept
+		{
+			return (std::uint64_t)this;
+		}
+
+		const GraphicsTextureDesc&
+		NullTexture::getTextureDesc() const noexcept
+		{
+			return _textureDesc;
+		}
+
+		void
+		NullTexture::setDevice(const GraphicsDevicePtr& device) noexcept
+		{
+			_device = device;
+		}
+
+		GraphicsDevicePtr
+		NullTexture::getDevice() noexcept
+		{
+			return _device.lock();
+		}
+	}
+}
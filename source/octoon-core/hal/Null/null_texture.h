@@ -0,0 +1,46 @@
+#ifndef OCTOON_NULL_TEXTURE_H_
+#define OCTOON_NULL_TEXTURE_H_
+
+#include "null_types.h"
+
+namespace octoon
+{
+	namespace hal
+	{
+		class NullTexture final : public GraphicsTexture
+		{
+			OctoonDeclareSubClass(NullTexture, GraphicsTexture)
+		public:
+			NullTexture() noexcept;
+			~NullTexture() noexcept;
+
+			bool setup(const GraphicsTextureDesc& textureDesc) noexcept;
+			void close() noexcept;
+
+			bool map(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h, std::uint32_t mipLevel, void** data) noexcept;
+			void unmap() noexcept;
+
+			const std::uint64_t handle() const noexcept override;
+			const GraphicsTextureDesc& getTextureDesc() const noexcept override;
+
+		private:
+			friend class NullDevice;
+			void setDevice(const GraphicsDevicePtr& device) noexcept;
+			GraphicsDevicePtr getDevice() noexcept override;
+
+		private:
+			NullTexture(const NullTexture&) noexcept = delete;
+			NullTexture& operator=(const NullTexture&) noexcept = delete;
+
+		private:
+			std::uint32_t _pixelSize;
+			std::size_t _mapSize;
+			bool _mapped;
+			std::vector<std::vector<std::uint8_t>> _levels;
+			GraphicsTextureDesc _textureDesc;
+			GraphicsDeviceWeakPtr _device;
+		};
+	}
+}
+
+#endif
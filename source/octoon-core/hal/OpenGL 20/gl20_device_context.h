@@ -52,7 +52,7 @@ namespace octoon
 			void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept override;
 			void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept override;
 			void discardFramebuffer(const GraphicsFramebufferPtr& src, std::uint32_t i) noexcept override;
-			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept override;
+			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept override;
 			void readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept override;
 			void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept override;
 			GraphicsFramebufferPtr getFramebuffer() const noexcept override;
@@ -62,6 +62,11 @@ namespace octoon
 			void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept override;
 			void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept override;
 
+			void writeTimestamp(std::uint32_t i) noexcept override;
+			bool getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept override;
+
+			std::uint64_t getUniformBytes() const noexcept override;
+
 			void present() noexcept override;
 
 			void startDebugControl() noexcept;
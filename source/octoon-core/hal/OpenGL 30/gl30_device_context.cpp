@@ -543,7 +543,7 @@ namespace octoon
 		}
 
 		void
-		GL30DeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept
+		GL30DeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept
 		{
 			assert(src);
 			assert(src->isInstanceOf<GL30Framebuffer>());
@@ -559,7 +559,15 @@ namespace octoon
 			glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
 			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
 
-			glBlitFramebuffer((GLint)v1.left, (GLint)v1.top, (GLint)v1.width, (GLint)v1.height, (GLint)v2.left, (GLint)v2.top, (GLint)v2.width, (GLint)v2.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			GLbitfield mask = 0;
+			if (flags & GraphicsClearFlagBits::ColorBit)
+				mask |= GL_COLOR_BUFFER_BIT;
+			if (flags & GraphicsClearFlagBits::DepthBit)
+				mask |= GL_DEPTH_BUFFER_BIT;
+			if (flags & GraphicsClearFlagBits::StencilBit)
+				mask |= GL_STENCIL_BUFFER_BIT;
+
+			glBlitFramebuffer((GLint)v1.left, (GLint)v1.top, (GLint)v1.width, (GLint)v1.height, (GLint)v2.left, (GLint)v2.top, (GLint)v2.width, (GLint)v2.height, mask, GL_NEAREST);
 
 			_framebuffer = nullptr;
 		}
@@ -746,6 +754,23 @@ namespace octoon
 		{
 		}
 
+		void
+		GL30DeviceContext::writeTimestamp(std::uint32_t i) noexcept
+		{
+		}
+
+		bool
+		GL30DeviceContext::getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept
+		{
+			return false;
+		}
+
+		std::uint64_t
+		GL30DeviceContext::getUniformBytes() const noexcept
+		{
+			return 0;
+		}
+
 		void
 		GL30DeviceContext::present() noexcept
 		{
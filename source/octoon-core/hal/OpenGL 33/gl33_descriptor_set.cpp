@@ -28,6 +28,12 @@ namespace octoon
 			return _param->getName();
 		}
 
+		std::uint32_t
+		GL33GraphicsUniformSet::getVersion() const noexcept
+		{
+			return _variant.getVersion();
+		}
+
 		void
 		GL33GraphicsUniformSet::uniform1b(bool value) noexcept
 		{
@@ -15,6 +15,7 @@ namespace octoon
 			virtual ~GL33GraphicsUniformSet() noexcept;
 
 			const std::string& getName() const noexcept;
+			std::uint32_t getVersion() const noexcept;
 
 			void uniform1b(bool value) noexcept override;
 			void uniform1i(std::int32_t i1) noexcept override;
@@ -83,6 +83,12 @@ namespace octoon
 				glDeleteVertexArrays(1, &_inputLayout);
 				_inputLayout = GL_NONE;
 			}
+
+			if (!_timestamps.empty())
+			{
+				glDeleteQueries((GLsizei)_timestamps.size(), _timestamps.data());
+				_timestamps.clear();
+			}
 		}
 
 		void
@@ -567,7 +573,7 @@ namespace octoon
 		}
 
 		void
-		GL33DeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept
+		GL33DeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept
 		{
 			assert(src);
 			assert(src->isInstanceOf<GL33Framebuffer>());
@@ -585,7 +591,15 @@ namespace octoon
 			glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
 			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
 
-			glBlitFramebuffer((GLint)v1.left, (GLint)v1.top, (GLint)v1.width, (GLint)v1.height, (GLint)v2.left, (GLint)v2.top, (GLint)v2.width, (GLint)v2.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			GLbitfield mask = 0;
+			if (flags & GraphicsClearFlagBits::ColorBit)
+				mask |= GL_COLOR_BUFFER_BIT;
+			if (flags & GraphicsClearFlagBits::DepthBit)
+				mask |= GL_DEPTH_BUFFER_BIT;
+			if (flags & GraphicsClearFlagBits::StencilBit)
+				mask |= GL_STENCIL_BUFFER_BIT;
+
+			glBlitFramebuffer((GLint)v1.left, (GLint)v1.top, (GLint)v1.width, (GLint)v1.height, (GLint)v2.left, (GLint)v2.top, (GLint)v2.width, (GLint)v2.height, mask, GL_NEAREST);
 
 			_framebuffer = nullptr;
 		}
@@ -815,6 +829,42 @@ namespace octoon
 			}
 		}
 
+		void
+		GL33DeviceContext::writeTimestamp(std::uint32_t i) noexcept
+		{
+			if (i >= _timestamps.size())
+			{
+				auto size = _timestamps.size();
+				_timestamps.resize(i + 1, GL_NONE);
+				glGenQueries((GLsizei)(_timestamps.size() - size), _timestamps.data() + size);
+			}
+
+			glQueryCounter(_timestamps[i], GL_TIMESTAMP);
+		}
+
+		bool
+		GL33DeviceContext::getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept
+		{
+			if (i >= _timestamps.size())
+				return false;
+
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(_timestamps[i], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+
+			GLuint64 result = 0;
+			glGetQueryObjectui64v(_timestamps[i], GL_QUERY_RESULT, &result);
+			nanoseconds = result;
+			return true;
+		}
+
+		std::uint64_t
+		GL33DeviceContext::getUniformBytes() const noexcept
+		{
+			return 0;
+		}
+
 		void
 		GL33DeviceContext::present() noexcept
 		{
@@ -52,7 +52,7 @@ namespace octoon
 			void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept;
 			void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept;
 			void discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags) noexcept;
-			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept;
+			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept;
 			void readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
 			void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
 			GraphicsFramebufferPtr getFramebuffer() const noexcept;
@@ -62,6 +62,11 @@ namespace octoon
 			void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
 			void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
 
+			void writeTimestamp(std::uint32_t i) noexcept;
+			bool getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept;
+
+			std::uint64_t getUniformBytes() const noexcept;
+
 			void present() noexcept;
 
 			void startDebugControl() noexcept;
@@ -90,6 +95,7 @@ namespace octoon
 
 			std::vector<float4> _viewports;
 			std::vector<uint4> _scissors;
+			std::vector<GLuint> _timestamps;
 			std::vector<GLenum> _attachments;
 
 			GLenum  _indexType;
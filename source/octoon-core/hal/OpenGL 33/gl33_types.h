@@ -2,6 +2,7 @@
 #define OCTOON_GL33_TYPES_H_
 
 #include "ogl_swapchain.h"
+#include <unordered_map>
 
 namespace octoon
 {
@@ -92,6 +93,15 @@ namespace octoon
 			GL45GraphicsDataPtr vbo;
 		};
 
+		struct GL45BindingCache
+		{
+			std::vector<GLuint> textures;
+			std::vector<GLuint> samplers;
+			std::vector<GLuint> uniformBuffers;
+			std::unordered_map<GLuint, const void*> programs;
+			std::uint64_t uniformBytes;
+		};
+
 		typedef std::vector<GL33VertexBuffer> GL33VertexBuffers;
 		typedef std::vector<GL45VertexBuffer> GL45VertexBuffers;
 
@@ -4,6 +4,7 @@
 #include "gl33_descriptor_set.h"
 #include "gl33_shader.h"
 #include "gl33_sampler.h"
+#include <limits>
 
 namespace octoon
 {
@@ -11,7 +12,23 @@ namespace octoon
 	{
 		OctoonImplementSubClass(GL45DescriptorSet, GraphicsDescriptorSet, "GL45DescriptorSet")
 
+		namespace
+		{
+			bool updateBinding(std::vector<GLuint>& units, GLuint unit, GLuint instance) noexcept
+			{
+				if (units.size() <= unit)
+					units.resize(unit + 1, GL_INVALID_INDEX);
+
+				if (units[unit] == instance)
+					return false;
+
+				units[unit] = instance;
+				return true;
+			}
+		}
+
 		GL45DescriptorSet::GL45DescriptorSet() noexcept
+			: _program(GL_NONE)
 		{
 		}
 
@@ -35,6 +52,7 @@ namespace octoon
 				_activeUniformSets.push_back(uniformSet);
 			}
 
+			_versions.resize(_activeUniformSets.size(), std::numeric_limits<std::uint32_t>::max());
 			_descriptorSetDesc = descriptorSetDesc;
 			return true;
 		}
@@ -43,152 +61,195 @@ namespace octoon
 		GL45DescriptorSet::close() noexcept
 		{
 			_activeUniformSets.clear();
+			_versions.clear();
+			_program = GL_NONE;
 		}
 
 		void
-		GL45DescriptorSet::apply(const GL33Program& shaderObject) noexcept
+		GL45DescriptorSet::apply(const GL33Program& shaderObject, GL45BindingCache& cache) noexcept
 		{
 			auto program = shaderObject.getInstanceID();
-			for (auto& it : _activeUniformSets)
+
+			// The values stored in the program are only ours if no other set was applied to it since.
+			auto& owner = cache.programs[program];
+			if (owner != this || _program != program)
 			{
+				std::fill(_versions.begin(), _versions.end(), std::numeric_limits<std::uint32_t>::max());
+				owner = this;
+				_program = program;
+			}
+
+			for (std::size_t i = 0; i < _activeUniformSets.size(); i++)
+			{
+				auto& it = _activeUniformSets[i];
 				auto type = it->getGraphicsParam()->getType();
 				auto location = it->getGraphicsParam()->getBindingPoint();
+
+				switch (type)
+				{
+				case GraphicsUniformType::Sampler:
+				{
+					auto instance = it->getTextureSampler()->downcast<GL33Sampler>()->getInstanceID();
+					if (updateBinding(cache.samplers, location, instance))
+						glBindSampler(location, instance);
+				}
+				continue;
+				case GraphicsUniformType::SamplerImage:
+				case GraphicsUniformType::CombinedImageSampler:
+				case GraphicsUniformType::StorageImage:
+				{
+					auto& texture = it->getTexture();
+					auto instance = texture ? texture->downcast<GL45Texture>()->getInstanceID() : GL_NONE;
+					if (updateBinding(cache.textures, location, instance))
+						glBindTextureUnit(location, instance);
+
+					auto& sampler = it->getTextureSampler();
+					if (texture && sampler)
+					{
+						auto samplerInstance = sampler->downcast<GL33Sampler>()->getInstanceID();
+						if (updateBinding(cache.samplers, location, samplerInstance))
+							glBindSampler(location, samplerInstance);
+					}
+				}
+				continue;
+				case GraphicsUniformType::UniformBuffer:
+				{
+					auto& buffer = it->getBuffer();
+					if (buffer)
+					{
+						auto instance = buffer->downcast<GL45GraphicsData>()->getInstanceID();
+						if (updateBinding(cache.uniformBuffers, location, instance))
+							glBindBufferBase(GL_UNIFORM_BUFFER, location, instance);
+					}
+				}
+				continue;
+				default:
+					break;
+				}
+
+				auto version = it->downcast<GL33GraphicsUniformSet>()->getVersion();
+				if (_versions[i] == version)
+					continue;
+
+				_versions[i] = version;
+
 				switch (type)
 				{
 				case GraphicsUniformType::Boolean:
 					glProgramUniform1i(program, location, it->getBool());
+					cache.uniformBytes += sizeof(GLint);
 					break;
 				case GraphicsUniformType::Int:
 					glProgramUniform1i(program, location, it->getInt());
+					cache.uniformBytes += sizeof(int1);
 					break;
 				case GraphicsUniformType::Int2:
 					glProgramUniform2iv(program, location, 1, (GLint*)it->getInt2().ptr());
+					cache.uniformBytes += sizeof(int2);
 					break;
 				case GraphicsUniformType::Int3:
 					glProgramUniform3iv(program, location, 1, (GLint*)it->getInt3().ptr());
+					cache.uniformBytes += sizeof(int3);
 					break;
 				case GraphicsUniformType::Int4:
 					glProgramUniform4iv(program, location, 1, (GLint*)it->getInt4().ptr());
+					cache.uniformBytes += sizeof(int4);
 					break;
 				case GraphicsUniformType::UInt:
 					glProgramUniform1ui(program, location, it->getUInt());
+					cache.uniformBytes += sizeof(uint1);
 					break;
 				case GraphicsUniformType::UInt2:
 					glProgramUniform2uiv(program, location, 1, (GLuint*)it->getUInt2().ptr());
+					cache.uniformBytes += sizeof(uint2);
 					break;
 				case GraphicsUniformType::UInt3:
 					glProgramUniform3uiv(program, location, 1, (GLuint*)it->getUInt3().ptr());
+					cache.uniformBytes += sizeof(uint3);
 					break;
 				case GraphicsUniformType::UInt4:
 					glProgramUniform4uiv(program, location, 1, (GLuint*)it->getUInt4().ptr());
+					cache.uniformBytes += sizeof(uint4);
 					break;
 				case GraphicsUniformType::Float:
 					glProgramUniform1f(program, location, it->getFloat());
+					cache.uniformBytes += sizeof(float1);
 					break;
 				case GraphicsUniformType::Float2:
 					glProgramUniform2fv(program, location, 1, it->getFloat2().ptr());
+					cache.uniformBytes += sizeof(float2);
 					break;
 				case GraphicsUniformType::Float3:
 					glProgramUniform3fv(program, location, 1, it->getFloat3().ptr());
+					cache.uniformBytes += sizeof(float3);
 					break;
 				case GraphicsUniformType::Float4:
 					glProgramUniform4fv(program, location, 1, it->getFloat4().ptr());
+					cache.uniformBytes += sizeof(float4);
 					break;
 				case GraphicsUniformType::Float3x3:
 					glProgramUniformMatrix3fv(program, location, 1, GL_FALSE, it->getFloat3x3().ptr());
+					cache.uniformBytes += sizeof(float3x3);
 					break;
 				case GraphicsUniformType::Float4x4:
 					glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, it->getFloat4x4().ptr());
+					cache.uniformBytes += sizeof(float4x4);
 					break;
 				case GraphicsUniformType::IntArray:
 					glProgramUniform1iv(program, location, static_cast<GLsizei>(it->getIntArray().size()), it->getIntArray().data());
+					cache.uniformBytes += it->getIntArray().size() * sizeof(int1);
 					break;
 				case GraphicsUniformType::Int2Array:
 					glProgramUniform2iv(program, location, static_cast<GLsizei>(it->getInt2Array().size()), (GLint*)it->getInt2Array().data());
+					cache.uniformBytes += it->getInt2Array().size() * sizeof(int2);
 					break;
 				case GraphicsUniformType::Int3Array:
 					glProgramUniform3iv(program, location, static_cast<GLsizei>(it->getInt3Array().size()), (GLint*)it->getInt3Array().data());
+					cache.uniformBytes += it->getInt3Array().size() * sizeof(int3);
 					break;
 				case GraphicsUniformType::Int4Array:
 					glProgramUniform4iv(program, location, static_cast<GLsizei>(it->getInt4Array().size()), (GLint*)it->getInt4Array().data());
+					cache.uniformBytes += it->getInt4Array().size() * sizeof(int4);
 					break;
 				case GraphicsUniformType::UIntArray:
 					glProgramUniform1uiv(program, location, static_cast<GLsizei>(it->getUIntArray().size()), it->getUIntArray().data());
+					cache.uniformBytes += it->getUIntArray().size() * sizeof(uint1);
 					break;
 				case GraphicsUniformType::UInt2Array:
 					glProgramUniform2uiv(program, location, static_cast<GLsizei>(it->getUInt2Array().size()), (GLuint*)it->getUInt2Array().data());
+					cache.uniformBytes += it->getUInt2Array().size() * sizeof(uint2);
 					break;
 				case GraphicsUniformType::UInt3Array:
 					glProgramUniform3uiv(program, location, static_cast<GLsizei>(it->getUInt3Array().size()), (GLuint*)it->getUInt3Array().data());
+					cache.uniformBytes += it->getUInt3Array().size() * sizeof(uint3);
 					break;
 				case GraphicsUniformType::UInt4Array:
 					glProgramUniform4uiv(program, location, static_cast<GLsizei>(it->getUInt4Array().size()), (GLuint*)it->getUInt4Array().data());
+					cache.uniformBytes += it->getUInt4Array().size() * sizeof(uint4);
 					break;
 				case GraphicsUniformType::FloatArray:
 					glProgramUniform1fv(program, location, static_cast<GLsizei>(it->getFloatArray().size()), (GLfloat*)it->getFloatArray().data());
+					cache.uniformBytes += it->getFloatArray().size() * sizeof(float1);
 					break;
 				case GraphicsUniformType::Float2Array:
 					glProgramUniform2fv(program, location, static_cast<GLsizei>(it->getFloat2Array().size()), (GLfloat*)it->getFloat2Array().data());
+					cache.uniformBytes += it->getFloat2Array().size() * sizeof(float2);
 					break;
 				case GraphicsUniformType::Float3Array:
 					glProgramUniform3fv(program, location, static_cast<GLsizei>(it->getFloat3Array().size()), (GLfloat*)it->getFloat3Array().data());
+					cache.uniformBytes += it->getFloat3Array().size() * sizeof(float3);
 					break;
 				case GraphicsUniformType::Float4Array:
 					glProgramUniform4fv(program, location, static_cast<GLsizei>(it->getFloat4Array().size()), (GLfloat*)it->getFloat4Array().data());
+					cache.uniformBytes += it->getFloat4Array().size() * sizeof(float4);
 					break;
 				case GraphicsUniformType::Float3x3Array:
 					glProgramUniformMatrix3fv(program, location, static_cast<GLsizei>(it->getFloat3x3Array().size()), GL_FALSE, (GLfloat*)it->getFloat3x3Array().data());
+					cache.uniformBytes += it->getFloat3x3Array().size() * sizeof(float3x3);
 					break;
 				case GraphicsUniformType::Float4x4Array:
 					glProgramUniformMatrix4fv(program, location, static_cast<GLsizei>(it->getFloat4x4Array().size()), GL_FALSE, (GLfloat*)it->getFloat4x4Array().data());
-					break;
-				case GraphicsUniformType::Sampler:
-					glBindSampler(location, it->getTextureSampler()->downcast<GL33Sampler>()->getInstanceID());
-					break;
-				case GraphicsUniformType::SamplerImage:
-				case GraphicsUniformType::CombinedImageSampler:
-				case GraphicsUniformType::StorageImage:
-				{
-					auto& texture = it->getTexture();
-					if (texture)
-					{
-						auto gltexture = texture->downcast<GL45Texture>();
-						glBindTextureUnit(location, gltexture->getInstanceID());
-
-						auto sampler = it->getTextureSampler();
-						if (sampler)
-						{
-							auto instance = sampler->downcast<GL33Sampler>()->getInstanceID();
-							glBindSampler(location, instance);
-						}
-					}
-					else
-					{
-						glBindTextureUnit(location, GL_NONE);
-					}
-				}
-				break;
-				case GraphicsUniformType::StorageTexelBuffer:
-					break;
-				case GraphicsUniformType::StorageBuffer:
-					break;
-				case GraphicsUniformType::StorageBufferDynamic:
-					break;
-				case GraphicsUniformType::UniformTexelBuffer:
-					break;
-				case GraphicsUniformType::UniformBuffer:
-				{
-					auto& buffer = it->getBuffer();
-					if (buffer)
-					{
-						auto ubo = buffer->downcast<GL45GraphicsData>();
-						glBindBufferBase(GL_UNIFORM_BUFFER, location, ubo->getInstanceID());
-					}
-				}
-				break;
-				case GraphicsUniformType::UniformBufferDynamic:
-					break;
-				case GraphicsUniformType::InputAttachment:
+					cache.uniformBytes += it->getFloat4x4Array().size() * sizeof(float4x4);
 					break;
 				default:
 					break;
@@ -17,7 +17,8 @@ namespace octoon
 			bool setup(const GraphicsDescriptorSetDesc& desc) noexcept;
 			void close() noexcept;
 
-			void apply(const GL33Program& shaderObject) noexcept;
+			// Uploads only the uniforms whose version changed since this set was last applied to the program.
+			void apply(const GL33Program& shaderObject, GL45BindingCache& cache) noexcept;
 
 			void copy(std::uint32_t descriptorCopyCount, const GraphicsDescriptorSetPtr descriptorCopies[]) noexcept;
 
@@ -34,7 +35,9 @@ namespace octoon
 			GL45DescriptorSet& operator=(const GL45DescriptorSet&) noexcept = delete;
 
 		private:
+			GLuint _program;
 			GraphicsUniformSets _activeUniformSets;
+			std::vector<std::uint32_t> _versions;
 			GraphicsDeviceWeakPtr _device;
 			GraphicsDescriptorSetDesc _descriptorSetDesc;
 		};
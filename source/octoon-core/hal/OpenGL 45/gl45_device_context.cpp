@@ -30,6 +30,8 @@ namespace octoon
 			, _needUpdateDescriptor(false)
 			, _needUpdateVertexBuffers(false)
 		{
+			_bindings.uniformBytes = 0;
+
 			_stateDefault = std::make_shared<GL33GraphicsState>();
 			_stateDefault->setup(GraphicsStateDesc());
 		}
@@ -75,11 +77,22 @@ namespace octoon
 			_glcontext.reset();
 			_vertexBuffers.clear();
 
+			_bindings.textures.clear();
+			_bindings.samplers.clear();
+			_bindings.uniformBuffers.clear();
+			_bindings.programs.clear();
+
 			if (_inputLayout != GL_NONE)
 			{
 				glDeleteVertexArrays(1, &_inputLayout);
 				_inputLayout = GL_NONE;
 			}
+
+			if (!_timestamps.empty())
+			{
+				glDeleteQueries((GLsizei)_timestamps.size(), _timestamps.data());
+				_timestamps.clear();
+			}
 		}
 
 		void
@@ -90,6 +103,12 @@ namespace octoon
 
 			this->setRenderPipeline(nullptr);
 			this->setIndexBufferData(nullptr);
+
+			// Units are rebound once a frame, in case a deleted object's name was reused.
+			_bindings.textures.clear();
+			_bindings.samplers.clear();
+			_bindings.uniformBuffers.clear();
+			_bindings.uniformBytes = 0;
 		}
 
 		void
@@ -526,7 +545,7 @@ namespace octoon
 		}
 
 		void
-		GL45DeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept
+		GL45DeviceContext::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept
 		{
 			assert(src);
 			assert(src->isInstanceOf<GL45Framebuffer>());
@@ -539,7 +558,15 @@ namespace octoon
 			auto readFramebuffer = this->_readFramebuffer->getInstanceID();
 			auto drawFramebuffer = this->_drawFramebuffer ? this->_drawFramebuffer->getInstanceID() : GL_NONE;
 
-			glBlitNamedFramebuffer(readFramebuffer, drawFramebuffer, (GLint)v1.left, (GLint)v1.top, (GLint)v1.width, (GLint)v1.height, (GLint)v2.left, (GLint)v2.top, (GLint)v2.width, (GLint)v2.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			GLbitfield mask = 0;
+			if (flags & GraphicsClearFlagBits::ColorBit)
+				mask |= GL_COLOR_BUFFER_BIT;
+			if (flags & GraphicsClearFlagBits::DepthBit)
+				mask |= GL_DEPTH_BUFFER_BIT;
+			if (flags & GraphicsClearFlagBits::StencilBit)
+				mask |= GL_STENCIL_BUFFER_BIT;
+
+			glBlitNamedFramebuffer(readFramebuffer, drawFramebuffer, (GLint)v1.left, (GLint)v1.top, (GLint)v1.width, (GLint)v1.height, (GLint)v2.left, (GLint)v2.top, (GLint)v2.width, (GLint)v2.height, mask, GL_NEAREST);
 		}
 
 		void
@@ -641,7 +668,7 @@ namespace octoon
 
 			if (_needUpdateDescriptor)
 			{
-				_descriptorSet->apply(*_program);
+				_descriptorSet->apply(*_program, _bindings);
 				_needUpdateDescriptor = false;
 			}
 
@@ -673,7 +700,7 @@ namespace octoon
 
 			if (_needUpdateDescriptor)
 			{
-				_descriptorSet->apply(*_program);
+				_descriptorSet->apply(*_program, _bindings);
 				_needUpdateDescriptor = false;
 			}
 
@@ -731,6 +758,36 @@ namespace octoon
 			}
 		}
 
+		void
+		GL45DeviceContext::writeTimestamp(std::uint32_t i) noexcept
+		{
+			if (i >= _timestamps.size())
+			{
+				auto size = _timestamps.size();
+				_timestamps.resize(i + 1, GL_NONE);
+				glGenQueries((GLsizei)(_timestamps.size() - size), _timestamps.data() + size);
+			}
+
+			glQueryCounter(_timestamps[i], GL_TIMESTAMP);
+		}
+
+		bool
+		GL45DeviceContext::getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept
+		{
+			if (i >= _timestamps.size())
+				return false;
+
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(_timestamps[i], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+
+			GLuint64 result = 0;
+			glGetQueryObjectui64v(_timestamps[i], GL_QUERY_RESULT, &result);
+			nanoseconds = result;
+			return true;
+		}
+
 		void
 		GL45DeviceContext::present() noexcept
 		{
@@ -988,6 +1045,12 @@ namespace octoon
 			std::cerr << "message : " << message << std::endl;
 		}
 
+		std::uint64_t
+		GL45DeviceContext::getUniformBytes() const noexcept
+		{
+			return _bindings.uniformBytes;
+		}
+
 		void
 		GL45DeviceContext::setDevice(const GraphicsDevicePtr& device) noexcept
 		{
@@ -52,7 +52,7 @@ namespace octoon
 			void setFramebuffer(const GraphicsFramebufferPtr& target) noexcept;
 			void clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept;
 			void discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags) noexcept;
-			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2) noexcept;
+			void blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept;
 			void readFramebuffer(std::uint32_t i, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
 			void readFramebufferToCube(std::uint32_t i, std::uint32_t face, const GraphicsTexturePtr& texture, std::uint32_t miplevel, std::uint32_t x, std::uint32_t y, std::uint32_t width, std::uint32_t height) noexcept;
 			GraphicsFramebufferPtr getFramebuffer() const noexcept;
@@ -65,8 +65,14 @@ namespace octoon
 			void startDebugControl() noexcept;
 			void stopDebugControl() noexcept;
 
+			void writeTimestamp(std::uint32_t i) noexcept;
+			bool getTimestamp(std::uint32_t i, std::uint64_t& nanoseconds) noexcept;
+
 			void present() noexcept;
 
+			// Bytes written through glProgramUniform* since renderBegin.
+			std::uint64_t getUniformBytes() const noexcept;
+
 		private:
 			bool checkSupport() noexcept;
 			bool initStateSystem() noexcept;
@@ -94,6 +100,7 @@ namespace octoon
 			GL45FramebufferPtr _readFramebuffer;
 			GL45DescriptorSetPtr _descriptorSet;
 			GL45VertexBuffers _vertexBuffers;
+			GL45BindingCache _bindings;
 			GL33GraphicsStatePtr _state;
 			GL33GraphicsStatePtr _stateDefault;
 
@@ -111,6 +118,7 @@ namespace octoon
 			std::vector<float4> _clearColor;
 			std::vector<float4> _viewports;
 			std::vector<uint4> _scissors;
+			std::vector<GLuint> _timestamps;
 
 			GraphicsDeviceWeakPtr _device;
 		};
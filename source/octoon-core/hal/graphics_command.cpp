@@ -0,0 +1,617 @@
+#include <octoon/hal/graphics_command.h>
+#include <octoon/hal/graphics_context.h>
+#include <octoon/hal/graphics_data.h>
+#include <octoon/hal/graphics_texture.h>
+#include <octoon/hal/graphics_pipeline.h>
+#include <octoon/hal/graphics_descriptor.h>
+#include <octoon/hal/graphics_framebuffer.h>
+#include <cassert>
+#include <cstring>
+
+namespace octoon
+{
+	namespace hal
+	{
+		namespace
+		{
+			struct CommandHeader
+			{
+				GraphicsCommandOp op;
+				std::uint8_t flags;
+				std::uint16_t size;
+			};
+
+			constexpr std::size_t COMMAND_ALIGNMENT = 8;
+			constexpr std::size_t MAX_CACHED_VIEWPORTS = 4;
+			constexpr std::size_t MAX_CACHED_VERTEX_BUFFERS = 8;
+
+			struct ViewportCommand { std::uint32_t i; float4 viewport; };
+			struct ScissorCommand { std::uint32_t i; uint4 scissor; };
+			struct StencilCommand { GraphicsStencilFaceFlags face; std::uint32_t value; };
+			struct ObjectCommand { const void* object; };
+			struct VertexBufferCommand { std::uint32_t i; const GraphicsData* data; std::intptr_t offset; };
+			struct IndexBufferCommand { const GraphicsData* data; std::intptr_t offset; GraphicsIndexType indexType; };
+			struct ClearCommand { std::uint32_t i; GraphicsClearFlags flags; float4 color; float depth; std::int32_t stencil; };
+			struct DiscardCommand { const GraphicsFramebuffer* framebuffer; GraphicsClearFlags flags; };
+			struct BlitCommand { const GraphicsFramebuffer* src; const GraphicsFramebuffer* dest; float4 v1; float4 v2; GraphicsClearFlags flags; };
+			struct DrawCommand { std::uint32_t count; std::uint32_t instances; std::uint32_t start; std::uint32_t startVertice; std::uint32_t startInstances; };
+			struct DrawIndirectCommand { const GraphicsData* data; std::size_t offset; std::uint32_t drawCount; std::uint32_t stride; };
+
+			template<typename T>
+			struct UniformCommand
+			{
+				GraphicsUniformSet* uniform;
+				T value;
+			};
+
+			struct ReplayState
+			{
+				bool hasPipeline = false;
+				bool hasDescriptorSet = false;
+				bool hasIndexBuffer = false;
+
+				const void* pipeline = nullptr;
+				const void* descriptorSet = nullptr;
+
+				IndexBufferCommand indexBuffer = {};
+
+				bool hasViewport[MAX_CACHED_VIEWPORTS] = {};
+				float4 viewports[MAX_CACHED_VIEWPORTS];
+
+				bool hasVertexBuffer[MAX_CACHED_VERTEX_BUFFERS] = {};
+				VertexBufferCommand vertexBuffers[MAX_CACHED_VERTEX_BUFFERS];
+
+				void invalidate() noexcept
+				{
+					hasPipeline = false;
+					hasDescriptorSet = false;
+					std::fill(std::begin(hasViewport), std::end(hasViewport), false);
+				}
+			};
+
+			template<typename T>
+			T read(const std::uint8_t* data) noexcept
+			{
+				T value;
+				std::memcpy(&value, data, sizeof(T));
+				return value;
+			}
+
+			template<typename T>
+			std::shared_ptr<T> share(const T* object) noexcept
+			{
+				if (object)
+					return std::shared_ptr<T>(const_cast<T*>(object)->shared_from_this(), const_cast<T*>(object));
+				return nullptr;
+			}
+
+			void
+			executeUniform(GraphicsUniformType type, const std::uint8_t* data) noexcept
+			{
+				switch (type)
+				{
+				case GraphicsUniformType::Boolean:
+				{
+					auto command = read<UniformCommand<bool>>(data);
+					command.uniform->uniform1b(command.value);
+				}
+				break;
+				case GraphicsUniformType::Int:
+				{
+					auto command = read<UniformCommand<std::int32_t>>(data);
+					command.uniform->uniform1i(command.value);
+				}
+				break;
+				case GraphicsUniformType::Int2:
+				{
+					auto command = read<UniformCommand<int2>>(data);
+					command.uniform->uniform2i(command.value);
+				}
+				break;
+				case GraphicsUniformType::Int3:
+				{
+					auto command = read<UniformCommand<int3>>(data);
+					command.uniform->uniform3i(command.value);
+				}
+				break;
+				case GraphicsUniformType::Int4:
+				{
+					auto command = read<UniformCommand<int4>>(data);
+					command.uniform->uniform4i(command.value);
+				}
+				break;
+				case GraphicsUniformType::Float:
+				{
+					auto command = read<UniformCommand<float>>(data);
+					command.uniform->uniform1f(command.value);
+				}
+				break;
+				case GraphicsUniformType::Float2:
+				{
+					auto command = read<UniformCommand<float2>>(data);
+					command.uniform->uniform2f(command.value);
+				}
+				break;
+				case GraphicsUniformType::Float3:
+				{
+					auto command = read<UniformCommand<float3>>(data);
+					command.uniform->uniform3f(command.value);
+				}
+				break;
+				case GraphicsUniformType::Float4:
+				{
+					auto command = read<UniformCommand<float4>>(data);
+					command.uniform->uniform4f(command.value);
+				}
+				break;
+				case GraphicsUniformType::Float3x3:
+				{
+					auto command = read<UniformCommand<float3x3>>(data);
+					command.uniform->uniform3fmat(command.value);
+				}
+				break;
+				case GraphicsUniformType::Float4x4:
+				{
+					auto command = read<UniformCommand<float4x4>>(data);
+					command.uniform->uniform4fmat(command.value);
+				}
+				break;
+				case GraphicsUniformType::SamplerImage:
+				{
+					auto command = read<UniformCommand<const GraphicsTexture*>>(data);
+					command.uniform->uniformTexture(share(command.value));
+				}
+				break;
+				case GraphicsUniformType::UniformBuffer:
+				{
+					auto command = read<UniformCommand<const GraphicsData*>>(data);
+					command.uniform->uniformBuffer(share(command.value));
+				}
+				break;
+				default:
+					assert(false);
+					break;
+				}
+			}
+
+			void
+			executeList(GraphicsContext& context, const std::vector<std::uint8_t>& stream, ReplayState& state) noexcept
+			{
+				auto it = stream.data();
+				auto end = stream.data() + stream.size();
+
+				while (it < end)
+				{
+					auto header = read<CommandHeader>(it);
+					auto data = it + sizeof(CommandHeader);
+
+					switch (header.op)
+					{
+					case GraphicsCommandOp::SetViewport:
+					{
+						auto command = read<ViewportCommand>(data);
+						if (command.i < MAX_CACHED_VIEWPORTS)
+						{
+							if (state.hasViewport[command.i] && state.viewports[command.i] == command.viewport)
+								break;
+
+							state.hasViewport[command.i] = true;
+							state.viewports[command.i] = command.viewport;
+						}
+
+						context.setViewport(command.i, command.viewport);
+					}
+					break;
+					case GraphicsCommandOp::SetScissor:
+					{
+						auto command = read<ScissorCommand>(data);
+						context.setScissor(command.i, command.scissor);
+					}
+					break;
+					case GraphicsCommandOp::SetStencilCompareMask:
+					{
+						auto command = read<StencilCommand>(data);
+						context.setStencilCompareMask(command.face, command.value);
+					}
+					break;
+					case GraphicsCommandOp::SetStencilReference:
+					{
+						auto command = read<StencilCommand>(data);
+						context.setStencilReference(command.face, command.value);
+					}
+					break;
+					case GraphicsCommandOp::SetStencilWriteMask:
+					{
+						auto command = read<StencilCommand>(data);
+						context.setStencilWriteMask(command.face, command.value);
+					}
+					break;
+					case GraphicsCommandOp::SetRenderPipeline:
+					{
+						auto command = read<ObjectCommand>(data);
+						if (state.hasPipeline && state.pipeline == command.object)
+							break;
+
+						state.hasPipeline = true;
+						state.pipeline = command.object;
+						state.hasDescriptorSet = false;
+
+						context.setRenderPipeline(share(static_cast<const GraphicsPipeline*>(command.object)));
+					}
+					break;
+					case GraphicsCommandOp::SetDescriptorSet:
+					{
+						auto command = read<ObjectCommand>(data);
+						if (state.hasDescriptorSet && state.descriptorSet == command.object)
+							break;
+
+						state.hasDescriptorSet = true;
+						state.descriptorSet = command.object;
+
+						context.setDescriptorSet(share(static_cast<const GraphicsDescriptorSet*>(command.object)));
+					}
+					break;
+					case GraphicsCommandOp::SetUniform:
+					{
+						// A changed uniform has to be flushed by the next bind, even when it names the same set.
+						state.hasDescriptorSet = false;
+						executeUniform((GraphicsUniformType)header.flags, data);
+					}
+					break;
+					case GraphicsCommandOp::SetVertexBuffer:
+					{
+						auto command = read<VertexBufferCommand>(data);
+						if (command.i < MAX_CACHED_VERTEX_BUFFERS)
+						{
+							auto& last = state.vertexBuffers[command.i];
+							if (state.hasVertexBuffer[command.i] && last.data == command.data && last.offset == command.offset)
+								break;
+
+							state.hasVertexBuffer[command.i] = true;
+							last = command;
+						}
+
+						context.setVertexBufferData(command.i, share(command.data), command.offset);
+					}
+					break;
+					case GraphicsCommandOp::SetIndexBuffer:
+					{
+						auto command = read<IndexBufferCommand>(data);
+						auto& last = state.indexBuffer;
+						if (state.hasIndexBuffer && last.data == command.data && last.offset == command.offset && last.indexType == command.indexType)
+							break;
+
+						state.hasIndexBuffer = true;
+						last = command;
+
+						context.setIndexBufferData(share(command.data), command.offset, command.indexType);
+					}
+					break;
+					case GraphicsCommandOp::SetFramebuffer:
+					{
+						// Binding a framebuffer resets the viewports and may unbind the pipeline.
+						auto command = read<ObjectCommand>(data);
+						context.setFramebuffer(share(static_cast<const GraphicsFramebuffer*>(command.object)));
+						state.invalidate();
+					}
+					break;
+					case GraphicsCommandOp::ClearFramebuffer:
+					{
+						auto command = read<ClearCommand>(data);
+						context.clearFramebuffer(command.i, command.flags, command.color, command.depth, command.stencil);
+					}
+					break;
+					case GraphicsCommandOp::DiscardFramebuffer:
+					{
+						auto command = read<DiscardCommand>(data);
+						context.discardFramebuffer(share(command.framebuffer), command.flags);
+					}
+					break;
+					case GraphicsCommandOp::BlitFramebuffer:
+					{
+						auto command = read<BlitCommand>(data);
+						context.blitFramebuffer(share(command.src), command.v1, share(command.dest), command.v2, command.flags);
+						state.invalidate();
+					}
+					break;
+					case GraphicsCommandOp::GenerateMipmap:
+					{
+						auto command = read<ObjectCommand>(data);
+						context.generateMipmap(share(static_cast<const GraphicsTexture*>(command.object)));
+					}
+					break;
+					case GraphicsCommandOp::Draw:
+					{
+						auto command = read<DrawCommand>(data);
+						context.draw(command.count, command.instances, command.start, command.startInstances);
+					}
+					break;
+					case GraphicsCommandOp::DrawIndexed:
+					{
+						auto command = read<DrawCommand>(data);
+						context.drawIndexed(command.count, command.instances, command.start, command.startVertice, command.startInstances);
+					}
+					break;
+					case GraphicsCommandOp::DrawIndirect:
+					{
+						auto command = read<DrawIndirectCommand>(data);
+						context.drawIndirect(share(command.data), command.offset, command.drawCount, command.stride);
+					}
+					break;
+					case GraphicsCommandOp::DrawIndexedIndirect:
+					{
+						auto command = read<DrawIndirectCommand>(data);
+						context.drawIndexedIndirect(share(command.data), command.offset, command.drawCount, command.stride);
+					}
+					break;
+					default:
+						assert(false);
+						break;
+					}
+
+					it = data + header.size;
+				}
+			}
+		}
+
+		GraphicsCommandList::GraphicsCommandList() noexcept
+			: count_(0)
+		{
+		}
+
+		GraphicsCommandList::~GraphicsCommandList() noexcept
+		{
+		}
+
+		void
+		GraphicsCommandList::clear() noexcept
+		{
+			count_ = 0;
+			stream_.clear();
+		}
+
+		bool
+		GraphicsCommandList::empty() const noexcept
+		{
+			return count_ == 0;
+		}
+
+		std::size_t
+		GraphicsCommandList::size() const noexcept
+		{
+			return count_;
+		}
+
+		template<typename T>
+		void
+		GraphicsCommandList::write(GraphicsCommandOp op, std::uint8_t flags, const T& payload) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			constexpr std::size_t size = (sizeof(CommandHeader) + sizeof(T) + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+			static_assert(size - sizeof(CommandHeader) <= UINT16_MAX);
+
+			CommandHeader header;
+			header.op = op;
+			header.flags = flags;
+			header.size = (std::uint16_t)(size - sizeof(CommandHeader));
+
+			auto offset = stream_.size();
+			stream_.resize(offset + size);
+
+			std::memcpy(stream_.data() + offset, &header, sizeof(header));
+			std::memcpy(stream_.data() + offset + sizeof(header), &payload, sizeof(T));
+
+			count_++;
+		}
+
+		void
+		GraphicsCommandList::setViewport(std::uint32_t i, const float4& viewport) noexcept
+		{
+			this->write(GraphicsCommandOp::SetViewport, 0, ViewportCommand{ i, viewport });
+		}
+
+		void
+		GraphicsCommandList::setScissor(std::uint32_t i, const uint4& scissor) noexcept
+		{
+			this->write(GraphicsCommandOp::SetScissor, 0, ScissorCommand{ i, scissor });
+		}
+
+		void
+		GraphicsCommandList::setStencilCompareMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			this->write(GraphicsCommandOp::SetStencilCompareMask, 0, StencilCommand{ face, mask });
+		}
+
+		void
+		GraphicsCommandList::setStencilReference(GraphicsStencilFaceFlags face, std::uint32_t reference) noexcept
+		{
+			this->write(GraphicsCommandOp::SetStencilReference, 0, StencilCommand{ face, reference });
+		}
+
+		void
+		GraphicsCommandList::setStencilWriteMask(GraphicsStencilFaceFlags face, std::uint32_t mask) noexcept
+		{
+			this->write(GraphicsCommandOp::SetStencilWriteMask, 0, StencilCommand{ face, mask });
+		}
+
+		void
+		GraphicsCommandList::setRenderPipeline(const GraphicsPipelinePtr& pipeline) noexcept
+		{
+			this->write(GraphicsCommandOp::SetRenderPipeline, 0, ObjectCommand{ pipeline.get() });
+		}
+
+		void
+		GraphicsCommandList::setDescriptorSet(const GraphicsDescriptorSetPtr& descriptorSet) noexcept
+		{
+			assert(descriptorSet);
+			this->write(GraphicsCommandOp::SetDescriptorSet, 0, ObjectCommand{ descriptorSet.get() });
+		}
+
+		void
+		GraphicsCommandList::setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& data, std::intptr_t offset) noexcept
+		{
+			assert(data);
+			this->write(GraphicsCommandOp::SetVertexBuffer, 0, VertexBufferCommand{ i, data.get(), offset });
+		}
+
+		void
+		GraphicsCommandList::setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t offset, GraphicsIndexType indexType) noexcept
+		{
+			assert(data);
+			this->write(GraphicsCommandOp::SetIndexBuffer, 0, IndexBufferCommand{ data.get(), offset, indexType });
+		}
+
+		void
+		GraphicsCommandList::generateMipmap(const GraphicsTexturePtr& texture) noexcept
+		{
+			assert(texture);
+			this->write(GraphicsCommandOp::GenerateMipmap, 0, ObjectCommand{ texture.get() });
+		}
+
+		void
+		GraphicsCommandList::setFramebuffer(const GraphicsFramebufferPtr& target) noexcept
+		{
+			this->write(GraphicsCommandOp::SetFramebuffer, 0, ObjectCommand{ target.get() });
+		}
+
+		void
+		GraphicsCommandList::clearFramebuffer(std::uint32_t i, GraphicsClearFlags flags, const float4& color, float depth, std::int32_t stencil) noexcept
+		{
+			this->write(GraphicsCommandOp::ClearFramebuffer, 0, ClearCommand{ i, flags, color, depth, stencil });
+		}
+
+		void
+		GraphicsCommandList::discardFramebuffer(const GraphicsFramebufferPtr& src, GraphicsClearFlags flags) noexcept
+		{
+			assert(src);
+			this->write(GraphicsCommandOp::DiscardFramebuffer, 0, DiscardCommand{ src.get(), flags });
+		}
+
+		void
+		GraphicsCommandList::blitFramebuffer(const GraphicsFramebufferPtr& src, const float4& v1, const GraphicsFramebufferPtr& dest, const float4& v2, GraphicsClearFlags flags) noexcept
+		{
+			assert(src);
+			this->write(GraphicsCommandOp::BlitFramebuffer, 0, BlitCommand{ src.get(), dest.get(), v1, v2, flags });
+		}
+
+		void
+		GraphicsCommandList::draw(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances) noexcept
+		{
+			this->write(GraphicsCommandOp::Draw, 0, DrawCommand{ numVertices, numInstances, startVertice, startVertice, startInstances });
+		}
+
+		void
+		GraphicsCommandList::drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances) noexcept
+		{
+			this->write(GraphicsCommandOp::DrawIndexed, 0, DrawCommand{ numIndices, numInstances, startIndice, startVertice, startInstances });
+		}
+
+		void
+		GraphicsCommandList::drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
+		{
+			assert(data);
+			this->write(GraphicsCommandOp::DrawIndirect, 0, DrawIndirectCommand{ data.get(), offset, drawCount, stride });
+		}
+
+		void
+		GraphicsCommandList::drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
+		{
+			assert(data);
+			this->write(GraphicsCommandOp::DrawIndexedIndirect, 0, DrawIndirectCommand{ data.get(), offset, drawCount, stride });
+		}
+
+		void
+		GraphicsCommandList::uniform1b(const GraphicsUniformSetPtr& uniform, bool value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Boolean, UniformCommand<bool>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform1i(const GraphicsUniformSetPtr& uniform, std::int32_t value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Int, UniformCommand<std::int32_t>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform2i(const GraphicsUniformSetPtr& uniform, const int2& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Int2, UniformCommand<int2>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform3i(const GraphicsUniformSetPtr& uniform, const int3& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Int3, UniformCommand<int3>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform4i(const GraphicsUniformSetPtr& uniform, const int4& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Int4, UniformCommand<int4>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform1f(const GraphicsUniformSetPtr& uniform, float value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Float, UniformCommand<float>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform2f(const GraphicsUniformSetPtr& uniform, const float2& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Float2, UniformCommand<float2>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform3f(const GraphicsUniformSetPtr& uniform, const float3& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Float3, UniformCommand<float3>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform4f(const GraphicsUniformSetPtr& uniform, const float4& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Float4, UniformCommand<float4>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform3fmat(const GraphicsUniformSetPtr& uniform, const float3x3& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Float3x3, UniformCommand<float3x3>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniform4fmat(const GraphicsUniformSetPtr& uniform, const float4x4& value) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::Float4x4, UniformCommand<float4x4>{ uniform.get(), value });
+		}
+
+		void
+		GraphicsCommandList::uniformTexture(const GraphicsUniformSetPtr& uniform, const GraphicsTexturePtr& texture) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::SamplerImage, UniformCommand<const GraphicsTexture*>{ uniform.get(), texture.get() });
+		}
+
+		void
+		GraphicsCommandList::uniformBuffer(const GraphicsUniformSetPtr& uniform, const GraphicsDataPtr& data) noexcept
+		{
+			this->write(GraphicsCommandOp::SetUniform, (std::uint8_t)GraphicsUniformType::UniformBuffer, UniformCommand<const GraphicsData*>{ uniform.get(), data.get() });
+		}
+
+		void
+		GraphicsCommandList::execute(GraphicsContext& context) const noexcept
+		{
+			ReplayState state;
+			executeList(context, stream_, state);
+		}
+
+		void
+		GraphicsCommandList::execute(GraphicsContext& context, const GraphicsCommandList* lists, std::size_t count) noexcept
+		{
+			ReplayState state;
+			for (std::size_t i = 0; i < count; i++)
+				executeList(context, lists[i].stream_, state);
+		}
+	}
+}
@@ -13,6 +13,9 @@
 #if defined(OCTOON_FEATURE_HAL_USE_OPENGL33)
 #	include "OpenGL 33/gl33_device.h"
 #endif
+#if defined(OCTOON_FEATURE_HAL_USE_NULL)
+#	include "Null/null_device.h"
+#endif
 #if defined(OCTOON_FEATURE_HAL_USE_VULKAN)
 #   include "Vulkan/vk_system.h"
 #	include "Vulkan/vk_device.h"
@@ -114,6 +117,19 @@ namespace octoon
 
 				return nullptr;
 	}
+#endif
+#if defined(OCTOON_FEATURE_HAL_USE_NULL)
+			if (deviceType == GraphicsDeviceType::Null)
+			{
+				auto device = std::make_shared<NullDevice>();
+				if (device->setup(deviceDesc))
+				{
+					_devices.push_back(device);
+					return device;
+				}
+
+				return nullptr;
+			}
 #endif
 			return nullptr;
 		}
@@ -5,8 +5,33 @@ namespace octoon
 {
 	namespace hal
 	{
+		namespace
+		{
+			template<typename T>
+			bool assign(T& dst, const T& src) noexcept
+			{
+				if (std::memcmp(&dst, &src, sizeof(T)) == 0)
+					return false;
+
+				std::memcpy(&dst, &src, sizeof(T));
+				return true;
+			}
+
+			template<typename T>
+			bool assign(std::vector<T>& dst, const T* src, std::size_t num) noexcept
+			{
+				if (dst.size() == num && std::memcmp(dst.data(), src, sizeof(T) * num) == 0)
+					return false;
+
+				dst.resize(num);
+				std::memcpy(dst.data(), src, sizeof(T) * num);
+				return true;
+			}
+		}
+
 		GraphicsVariant::GraphicsVariant() noexcept
 			: _type(GraphicsUniformType::Null)
+			, _version(0)
 		{
 			std::memset(&_value, 0, sizeof(_value));
 		}
@@ -187,6 +212,7 @@ namespace octoon
 				}
 
 				_type = type;
+				_version++;
 			}
 		}
 
@@ -196,475 +222,496 @@ namespace octoon
 			return _type;
 		}
 
+		std::uint32_t
+		GraphicsVariant::getVersion() const noexcept
+		{
+			return _version;
+		}
+
 		void
 		GraphicsVariant::uniform1b(bool b1) noexcept
 		{
 			assert(_type == GraphicsUniformType::Boolean);
-			_value.b = b1;
+			if (assign(_value.b, b1))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1i(std::int32_t i1) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int);
-			_value.i[0] = i1;
+			if (assign(_value.i[0], i1))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2i(const int2& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int2);
-			_value.i[0] = value.x;
-			_value.i[1] = value.y;
+			if (assign((int2&)_value.i, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2i(std::int32_t i1, std::int32_t i2) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int2);
-			_value.i[0] = i1;
-			_value.i[1] = i2;
+			if (assign((int2&)_value.i, int2(i1, i2)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3i(const int3& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int3);
-			_value.i[0] = value.x;
-			_value.i[1] = value.y;
-			_value.i[2] = value.z;
+			if (assign((int3&)_value.i, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3i(std::int32_t i1, std::int32_t i2, std::int32_t i3) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int3);
-			_value.i[0] = i1;
-			_value.i[1] = i2;
-			_value.i[2] = i3;
+			if (assign((int3&)_value.i, int3(i1, i2, i3)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4i(const int4& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int4);
-			_value.i[0] = value.x;
-			_value.i[1] = value.y;
-			_value.i[2] = value.z;
-			_value.i[3] = value.w;
+			if (assign((int4&)_value.i, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4i(std::int32_t i1, std::int32_t i2, std::int32_t i3, std::int32_t i4) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int4);
-			_value.i[0] = i1;
-			_value.i[1] = i2;
-			_value.i[2] = i3;
-			_value.i[3] = i4;
+			if (assign((int4&)_value.i, int4(i1, i2, i3, i4)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1ui(std::uint32_t ui1) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float);
-			_value.ui[0] = ui1;
+			if (assign(_value.ui[0], ui1))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2ui(const uint2& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt2);
-			_value.ui[0] = value.x;
-			_value.ui[1] = value.y;
+			if (assign((uint2&)_value.ui, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2ui(std::uint32_t ui1, std::uint32_t ui2) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2);
-			_value.ui[0] = ui1;
-			_value.ui[1] = ui2;
+			if (assign((uint2&)_value.ui, uint2(ui1, ui2)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3ui(const uint3& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt3);
-			_value.ui[0] = value.x;
-			_value.ui[1] = value.y;
-			_value.ui[2] = value.z;
+			if (assign((uint3&)_value.ui, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3ui(std::uint32_t ui1, std::uint32_t ui2, std::uint32_t ui3) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3);
-			_value.ui[0] = ui1;
-			_value.ui[1] = ui2;
-			_value.ui[2] = ui3;
+			if (assign((uint3&)_value.ui, uint3(ui1, ui2, ui3)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4ui(const uint4& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt4);
-			_value.ui[0] = value.x;
-			_value.ui[1] = value.y;
-			_value.ui[2] = value.z;
-			_value.ui[3] = value.w;
+			if (assign((uint4&)_value.ui, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4ui(std::uint32_t ui1, std::uint32_t ui2, std::uint32_t ui3, std::uint32_t ui4) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt4);
-			_value.ui[0] = ui1;
-			_value.ui[1] = ui2;
-			_value.ui[2] = ui3;
-			_value.ui[3] = ui4;
+			if (assign((uint4&)_value.ui, uint4(ui1, ui2, ui3, ui4)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1f(float f1) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float);
-			_value.f[0] = f1;
+			if (assign(_value.f[0], f1))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2f(const float2& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2);
-			_value.f[0] = value.x;
-			_value.f[1] = value.y;
+			if (assign((float2&)_value.f, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2f(float f1, float f2) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2);
-			_value.f[0] = f1;
-			_value.f[1] = f2;
+			if (assign((float2&)_value.f, float2(f1, f2)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3f(const float3& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3);
-			_value.f[0] = value.x;
-			_value.f[1] = value.y;
-			_value.f[2] = value.z;
+			if (assign((float3&)_value.f, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3f(float f1, float f2, float f3) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3);
-			_value.f[0] = f1;
-			_value.f[1] = f2;
-			_value.f[2] = f3;
+			if (assign((float3&)_value.f, float3(f1, f2, f3)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4f(const float4& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4);
-			_value.f[0] = value.x;
-			_value.f[1] = value.y;
-			_value.f[2] = value.z;
-			_value.f[3] = value.w;
+			if (assign((float4&)_value.f, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4f(float f1, float f2, float f3, float f4) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4);
-			_value.f[0] = f1;
-			_value.f[1] = f2;
-			_value.f[2] = f3;
-			_value.f[3] = f4;
+			if (assign((float4&)_value.f, float4(f1, f2, f3, f4)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2fmat(const float2x2& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2x2);
-			*_value.m2 = value;
+			if (assign(*_value.m2, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2fmat(const float* mat2) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2x2);
-			std::memcpy(_value.m2, mat2, sizeof(float2x2));
+			if (assign(*_value.m2, *reinterpret_cast<const float2x2*>(mat2)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3fmat(const float3x3& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3x3);
-			*_value.m3 = value;
+			if (assign(*_value.m3, value))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3fmat(const float* mat3) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3x3);
-			std::memcpy(_value.m3, mat3, sizeof(float3x3));
+			if (assign(*_value.m3, *reinterpret_cast<const float3x3*>(mat3)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4fmat(const float4x4& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4x4);
-			*_value.m4 = value;
+			if (assign(*_value.m4, value))
+				_version++;
 		}
 		void
 		GraphicsVariant::uniform4fmat(const float* mat4) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4x4);
-			std::memcpy(_value.m4, mat4, sizeof(float4x4));
+			if (assign(*_value.m4, *reinterpret_cast<const float4x4*>(mat4)))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1iv(const std::vector<int1>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::IntArray);
-			*_value.iarray = value;
+			if (assign(*_value.iarray, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1iv(std::size_t num, const std::int32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::IntArray);
-			_value.iarray->resize(num);
-			std::memcpy(_value.iarray->data(), str, sizeof(int1) * num);
+			if (assign(*_value.iarray, reinterpret_cast<const int1*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2iv(const std::vector<int2>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int2Array);
-			*_value.iarray2 = value;
+			if (assign(*_value.iarray2, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2iv(std::size_t num, const std::int32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int2Array);
-			_value.iarray2->resize(num);
-			std::memcpy(_value.iarray2->data(), str, sizeof(int2) * num);
+			if (assign(*_value.iarray2, reinterpret_cast<const int2*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3iv(const std::vector<int3>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int3Array);
-			*_value.iarray3 = value;
+			if (assign(*_value.iarray3, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3iv(std::size_t num, const std::int32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int2Array);
-			_value.iarray3->resize(num);
-			std::memcpy(_value.iarray3->data(), str, sizeof(int3) * num);
+			if (assign(*_value.iarray3, reinterpret_cast<const int3*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4iv(const std::vector<int4>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int4Array);
-			*_value.iarray4 = value;
+			if (assign(*_value.iarray4, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4iv(std::size_t num, const std::int32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::Int2Array);
-			_value.iarray4->resize(num);
-			std::memcpy(_value.iarray4->data(), str, sizeof(int4) * num);
+			if (assign(*_value.iarray4, reinterpret_cast<const int4*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1uiv(const std::vector<uint1>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::UIntArray);
-			*_value.uiarray = value;
+			if (assign(*_value.uiarray, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1uiv(std::size_t num, const std::uint32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::UIntArray);
-			_value.uiarray->resize(num);
-			std::memcpy(_value.uiarray->data(), str, sizeof(uint1) * num);
+			if (assign(*_value.uiarray, reinterpret_cast<const uint1*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2uiv(const std::vector<uint2>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt2Array);
-			*_value.uiarray2 = value;
+			if (assign(*_value.uiarray2, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2uiv(std::size_t num, const std::uint32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt2Array);
-			_value.uiarray2->resize(num);
-			std::memcpy(_value.uiarray2->data(), str, sizeof(uint2) * num);
+			if (assign(*_value.uiarray2, reinterpret_cast<const uint2*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3uiv(const std::vector<uint3>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt3Array);
-			*_value.uiarray3 = value;
+			if (assign(*_value.uiarray3, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3uiv(std::size_t num, const std::uint32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt3Array);
-			_value.uiarray3->resize(num);
-			std::memcpy(_value.uiarray3->data(), str, sizeof(uint3) * num);
+			if (assign(*_value.uiarray3, reinterpret_cast<const uint3*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4uiv(const std::vector<uint4>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt4Array);
-			*_value.uiarray4 = value;
+			if (assign(*_value.uiarray4, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4uiv(std::size_t num, const std::uint32_t* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::UInt4Array);
-			_value.uiarray4->resize(num);
-			std::memcpy(_value.uiarray4->data(), str, sizeof(uint4) * num);
+			if (assign(*_value.uiarray4, reinterpret_cast<const uint4*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1fv(const std::vector<float1>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::FloatArray);
-			*_value.farray = value;
+			if (assign(*_value.farray, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform1fv(std::size_t num, const float* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::FloatArray);
-			_value.farray->resize(num);
-			std::memcpy(_value.farray->data(), str, sizeof(float1) * num);
+			if (assign(*_value.farray, reinterpret_cast<const float1*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2fv(const std::vector<float2>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2Array);
-			*_value.farray2 = value;
+			if (assign(*_value.farray2, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2fv(std::size_t num, const float* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2Array);
-			_value.farray2->resize(num);
-			std::memcpy(_value.farray2->data(), str, sizeof(float2) * num);
+			if (assign(*_value.farray2, reinterpret_cast<const float2*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3fv(const std::vector<float3>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3Array);
-			*_value.farray3 = value;
+			if (assign(*_value.farray3, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3fv(std::size_t num, const float* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3Array);
-			_value.farray3->resize(num);
-			std::memcpy(_value.farray3->data(), str, sizeof(float3) * num);
+			if (assign(*_value.farray3, reinterpret_cast<const float3*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4fv(const std::vector<float4>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4Array);
-			*_value.farray4 = value;
+			if (assign(*_value.farray4, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4fv(std::size_t num, const float* str) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4Array);
-			_value.farray4->resize(num);
-			std::memcpy(_value.farray4->data(), str, sizeof(float4) * num);
+			if (assign(*_value.farray4, reinterpret_cast<const float4*>(str), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2fmatv(const std::vector<float2x2>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float2x2Array);
-			*_value.m2array = value;
+			if (assign(*_value.m2array, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform2fmatv(std::size_t num, const float* mat2) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4Array);
-			_value.m2array->resize(num);
-			std::memcpy(_value.m2array->data(), mat2, sizeof(float2x2) * num);
+			if (assign(*_value.m2array, reinterpret_cast<const float2x2*>(mat2), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3fmatv(const std::vector<float3x3>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float3x3Array);
-			*_value.m3array = value;
+			if (assign(*_value.m3array, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform3fmatv(std::size_t num, const float* mat3) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4Array);
-			_value.m3array->resize(num);
-			std::memcpy(_value.m3array->data(), mat3, sizeof(float3x3) * num);
+			if (assign(*_value.m3array, reinterpret_cast<const float3x3*>(mat3), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4fmatv(const std::vector<float4x4>& value) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4x4Array);
-			*_value.m4array = value;
+			if (assign(*_value.m4array, value.data(), value.size()))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniform4fmatv(std::size_t num, const float* mat4) noexcept
 		{
 			assert(_type == GraphicsUniformType::Float4Array);
-			_value.m4array->resize(num);
-			std::memcpy(_value.m4array->data(), mat4, sizeof(float4x4) * num);
+			if (assign(*_value.m4array, reinterpret_cast<const float4x4*>(mat4), num))
+				_version++;
 		}
 
 		void
 		GraphicsVariant::uniformTexture(GraphicsTexturePtr texture, GraphicsSamplerPtr sampler) noexcept
 		{
 			assert(_type == GraphicsUniformType::StorageImage || _type == GraphicsUniformType::CombinedImageSampler || _type == GraphicsUniformType::SamplerImage);
-			_value.texture->image = texture;
-			_value.texture->sampler = sampler;
+			if (_value.texture->image != texture || _value.texture->sampler != sampler)
+			{
+				_value.texture->image = texture;
+				_value.texture->sampler = sampler;
+				_version++;
+			}
 		}
 
 		void
 		GraphicsVariant::uniformBuffer(GraphicsDataPtr ubo) noexcept
 		{
 			assert(_type == GraphicsUniformType::UniformBuffer);
-			*_value.ubo = ubo;
+			if (*_value.ubo != ubo)
+			{
+				*_value.ubo = ubo;
+				_version++;
+			}
 		}
 
 		bool
@@ -1,4 +1,5 @@
 #include <octoon/io/archive_buf.h>
+#include <algorithm>
 
 namespace octoon
 {
@@ -37,17 +38,17 @@ namespace octoon
 		}
 
 		archivebuf::archivebuf(string_t&& value)
-			: _data(std::make_unique<string_t>(std::move(value)))
+			: _data(std::in_place_index<type_t::string>, std::move(value))
 		{
 		}
 
 		archivebuf::archivebuf(const string_t& value)
-			: _data(std::make_unique<string_t>(value))
+			: _data(std::in_place_index<type_t::string>, value)
 		{
 		}
 
 		archivebuf::archivebuf(const string_t::value_type* value)
-			: _data(std::make_unique<string_t>(value))
+			: _data(std::in_place_index<type_t::string>, value)
 		{
 		}
 
@@ -64,18 +65,15 @@ namespace octoon
 		archivebuf::at(const string_t& key)
 		{
 			if (this->is_null())
-				_data.emplace<std::unique_ptr<map_t>>(std::make_unique<map_t>());
+				this->emplace(archivebuf::type_t::object);
 
 			if (this->is_object())
 			{
-				auto& data = std::get<archivebuf::type_t::object>(_data);
-
-				for (auto& it : *data)
-					if (it.first == key)
-						return it.second;
+				auto it = this->find(key);
+				if (it)
+					return *it;
 
-				data->push_back(std::make_pair(key, archivebuf::null));
-				return data->back().second;
+				return this->insert(key, archivebuf());
 			}
 			else
 			{
@@ -87,18 +85,15 @@ namespace octoon
 		archivebuf::at(const string_t::value_type* key)
 		{
 			if (this->is_null())
-				_data.emplace<std::unique_ptr<map_t>>(std::make_unique<map_t>());
+				this->emplace(archivebuf::type_t::object);
 
 			if (this->is_object())
 			{
-				auto& data = std::get<archivebuf::type_t::object>(_data);
+				auto it = this->find(key);
+				if (it)
+					return *it;
 
-				for (auto& it : *data)
-					if (it.first == key)
-						return it.second;
-
-				data->push_back(std::make_pair(key, archivebuf::null));
-				return data->back().second;
+				return this->insert(key, archivebuf());
 			}
 			else
 			{
@@ -127,11 +122,9 @@ namespace octoon
 		{
 			if (this->is_object())
 			{
-				auto& data = std::get<archivebuf::type_t::object>(_data);
-
-				for (auto& it : *data)
-					if (it.first == key)
-						return it.second;
+				auto it = this->find(key);
+				if (it)
+					return *it;
 
 				return archivebuf::nil;
 			}
@@ -146,11 +139,9 @@ namespace octoon
 		{
 			if (this->is_object())
 			{
-				auto& data = std::get<archivebuf::type_t::object>(_data);
-
-				for (auto& it : *data)
-					if (it.first == key)
-						return it.second;
+				auto it = this->find(key);
+				if (it)
+					return *it;
 
 				return archivebuf::nil;
 			}
@@ -182,8 +173,7 @@ namespace octoon
 			if (this->is_null())
 				this->emplace(archivebuf::type_t::object);
 
-			auto& data = std::get<archivebuf::type_t::object>(_data);
-			data->push_back(std::make_pair(key, value));
+			this->insert(key, archivebuf(value));
 		}
 
 		void
@@ -192,8 +182,7 @@ namespace octoon
 			if (this->is_null())
 				this->emplace(archivebuf::type_t::object);
 
-			auto& data = std::get<archivebuf::type_t::object>(_data);
-			data->push_back(std::make_pair(key, value));
+			this->insert(key, archivebuf(value));
 		}
 
 		void
@@ -202,8 +191,7 @@ namespace octoon
 			if (this->is_null())
 				this->emplace(archivebuf::type_t::object);
 
-			auto& data = std::get<archivebuf::type_t::object>(_data);
-			data->push_back(std::make_pair(key, value));
+			this->insert(key, archivebuf(value));
 		}
 
 		void
@@ -212,8 +200,7 @@ namespace octoon
 			if (this->is_null())
 				this->emplace(archivebuf::type_t::object);
 
-			auto& data = std::get<archivebuf::type_t::object>(_data);
-			data->push_back(std::make_pair(key, value));
+			this->insert(key, archivebuf(value));
 		}
 
 		void
@@ -222,8 +209,7 @@ namespace octoon
 			if (this->is_null())
 				this->emplace(archivebuf::type_t::object);
 
-			auto& data = std::get<archivebuf::type_t::object>(_data);
-			data->push_back(std::make_pair(key, value));
+			this->insert(key, archivebuf(value));
 		}
 
 		void
@@ -232,8 +218,16 @@ namespace octoon
 			if (this->is_null())
 				this->emplace(archivebuf::type_t::object);
 
-			auto& data = std::get<archivebuf::type_t::object>(_data);
-			data->push_back(std::make_pair(key, value));
+			this->insert(key, archivebuf(value));
+		}
+
+		void
+		archivebuf::push_back(std::string_view key, archivebuf&& value)
+		{
+			if (this->is_null())
+				this->emplace(archivebuf::type_t::object);
+
+			this->insert(key, std::move(value));
 		}
 
 		void
@@ -253,7 +247,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->begin();
+					return std::get<archivebuf::type_t::object>(_data)->members.begin();
 				break;
 			default:
 				break;
@@ -269,7 +263,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->end();
+					return std::get<archivebuf::type_t::object>(_data)->members.end();
 				break;
 			default:
 				break;
@@ -285,7 +279,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->begin();
+					return std::get<archivebuf::type_t::object>(_data)->members.begin();
 				break;
 			default:
 				break;
@@ -301,7 +295,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->end();
+					return std::get<archivebuf::type_t::object>(_data)->members.end();
 				break;
 			default:
 				break;
@@ -317,7 +311,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->rbegin();
+					return std::get<archivebuf::type_t::object>(_data)->members.rbegin();
 				break;
 			default:
 				break;
@@ -333,7 +327,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->rend();
+					return std::get<archivebuf::type_t::object>(_data)->members.rend();
 				break;
 			default:
 				break;
@@ -349,7 +343,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->rbegin();
+					return std::get<archivebuf::type_t::object>(_data)->members.rbegin();
 				break;
 			default:
 				break;
@@ -365,7 +359,7 @@ namespace octoon
 			{
 			case archivebuf::type_t::object:
 				if (std::get<archivebuf::type_t::object>(_data))
-					return std::get<archivebuf::type_t::object>(_data)->rend();
+					return std::get<archivebuf::type_t::object>(_data)->members.rend();
 				break;
 			default:
 				break;
@@ -378,28 +372,28 @@ namespace octoon
 		archivebuf::front() noexcept
 		{
 			assert(this->type() == archivebuf::type_t::object);
-			return std::get<archivebuf::type_t::object>(_data)->front().second;
+			return std::get<archivebuf::type_t::object>(_data)->members.front().second;
 		}
 
 		const archivebuf&
 		archivebuf::front() const noexcept
 		{
 			assert(this->type() == archivebuf::type_t::object);
-			return std::get<archivebuf::type_t::object>(_data)->front().second;
+			return std::get<archivebuf::type_t::object>(_data)->members.front().second;
 		}
 
 		archivebuf&
 		archivebuf::back() noexcept
 		{
 			assert(this->type() == archivebuf::type_t::object);
-			return std::get<archivebuf::type_t::object>(_data)->back().second;
+			return std::get<archivebuf::type_t::object>(_data)->members.back().second;
 		}
 
 		const archivebuf&
 		archivebuf::back() const noexcept
 		{
 			assert(this->type() == archivebuf::type_t::object);
-			return std::get<archivebuf::type_t::object>(_data)->back().second;
+			return std::get<archivebuf::type_t::object>(_data)->members.back().second;
 		}
 
 		archivebuf::type_t
@@ -509,19 +503,28 @@ namespace octoon
 				_data.emplace<number_float_t>(number_float_t(0.0f));
 				break;
 			case archivebuf::type_t::string:
-				_data.emplace<std::unique_ptr<string_t>>(std::make_unique<string_t>());
+				_data.emplace<type_t::string>();
 				break;
 			case archivebuf::type_t::array:
 				_data.emplace<std::unique_ptr<array_t>>(std::make_unique<array_t>());
 				break;
 			case archivebuf::type_t::object:
-				_data.emplace<std::unique_ptr<map_t>>(std::make_unique<map_t>());
+				_data.emplace<std::unique_ptr<object_storage>>(std::make_unique<object_storage>());
 				break;
 			default:
 				break;
 			}
 		}
 
+		void
+		archivebuf::reserve(std::size_t n) noexcept(false)
+		{
+			if (this->is_array())
+				std::get<archivebuf::type_t::array>(_data)->reserve(n);
+			else if (this->is_object() && n > index_threshold)
+				this->build_index(*std::get<archivebuf::type_t::object>(_data), n);
+		}
+
 		void
 		archivebuf::clear() noexcept
 		{
@@ -571,14 +574,14 @@ namespace octoon
 		archivebuf&
 		archivebuf::operator=(string_t&& value)
 		{
-			_data = std::make_unique<string_t>(std::move(value));
+			_data.emplace<type_t::string>(std::move(value));
 			return *this;
 		}
 
 		archivebuf&
 		archivebuf::operator=(const string_t& value)
 		{
-			_data = std::make_unique<string_t>(value);
+			_data.emplace<type_t::string>(value);
 			return *this;
 		}
 
@@ -593,18 +596,15 @@ namespace octoon
 		archivebuf::operator[](const char* key)
 		{
 			if (this->is_null())
-				_data.emplace<std::unique_ptr<map_t>>(std::make_unique<map_t>());
+				this->emplace(archivebuf::type_t::object);
 
 			if (this->is_object())
 			{
-				auto& data = std::get<archivebuf::type_t::object>(_data);
-
-				for (auto& it : *data)
-					if (it.first == key)
-						return it.second;
+				auto it = this->find(key);
+				if (it)
+					return *it;
 
-				data->push_back(std::make_pair(key, archivebuf::null));
-				return data->back().second;
+				return this->insert(key, archivebuf());
 			}
 			else
 			{
@@ -616,18 +616,15 @@ namespace octoon
 		archivebuf::operator[](const string_t& key)
 		{
 			if (this->is_null())
-				_data.emplace<std::unique_ptr<map_t>>(std::make_unique<map_t>());
+				this->emplace(archivebuf::type_t::object);
 
 			if (this->is_object())
 			{
-				auto& data = std::get<archivebuf::type_t::object>(_data);
-
-				for (auto& it : *data)
-					if (it.first == key)
-						return it.second;
+				auto it = this->find(key);
+				if (it)
+					return *it;
 
-				data->push_back(std::make_pair(key, null));
-				return data->back().second;
+				return this->insert(key, archivebuf());
 			}
 			else
 			{
@@ -681,5 +678,59 @@ namespace octoon
 		archivebuf::unlock() noexcept
 		{
 		}
+	
+		archivebuf*
+		archivebuf::find(std::string_view key) const noexcept
+		{
+			auto& data = std::get<archivebuf::type_t::object>(_data);
+
+			if (!data->indexed)
+			{
+				for (auto& it : data->members)
+				{
+					if (it.first == key)
+						return &it.second;
+				}
+
+				return nullptr;
+			}
+
+			auto it = data->index.find(key);
+			if (it != data->index.end())
+				return &data->members[it->second].second;
+
+			return nullptr;
+		}
+
+		archivebuf&
+		archivebuf::insert(std::string_view key, archivebuf&& value)
+		{
+			auto& data = std::get<archivebuf::type_t::object>(_data);
+			auto& members = data->members;
+
+			members.emplace_back(string_t(key), std::move(value));
+
+			// Duplicate keys keep resolving to their first member, as with the scan.
+			if (data->indexed)
+				data->index.emplace(members.back().first, members.size() - 1);
+			else if (members.size() > index_threshold)
+				this->build_index(*data, members.size());
+
+			return members.back().second;
+		}
+
+		void
+		archivebuf::build_index(object_storage& data, std::size_t n)
+		{
+			data.index.reserve(std::max(n, data.members.size()));
+
+			if (!data.indexed)
+			{
+				for (std::size_t i = 0; i < data.members.size(); i++)
+					data.index.emplace(data.members[i].first, i);
+
+				data.indexed = true;
+			}
+		}
 	}
-}
\ No newline at end of file
+}
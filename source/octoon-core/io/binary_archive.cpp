@@ -0,0 +1,422 @@
+#include <octoon/io/binary_archive.h>
+#include <octoon/io/fstream.h>
+#include <octoon/io/mmap_stream.h>
+#include <unordered_map>
+#include <cstring>
+
+namespace octoon
+{
+	namespace io
+	{
+		namespace
+		{
+			constexpr char BINARY_ARCHIVE_MAGIC[4] = { 'O', 'C', 'A', 'R' };
+			constexpr std::uint32_t BINARY_ARCHIVE_VERSION = 1;
+			constexpr std::uint32_t BINARY_ARCHIVE_MAX_DEPTH = 256;
+
+			class BinaryArchiveParser final
+			{
+			public:
+				BinaryArchiveParser(const char* data, std::size_t size) noexcept
+					: ptr_(data)
+					, end_(data + size)
+				{
+				}
+
+				template<typename T>
+				T read() except
+				{
+					T value;
+					if (std::size_t(end_ - ptr_) < sizeof(T))
+						throw std::runtime_error("unexpected end of binary archive");
+					std::memcpy(&value, ptr_, sizeof(T));
+					ptr_ += sizeof(T);
+					return value;
+				}
+
+				std::string_view readString() except
+				{
+					auto length = this->read<std::uint32_t>();
+					if (std::size_t(end_ - ptr_) < length)
+						throw std::runtime_error("unexpected end of binary archive");
+
+					std::string_view str(ptr_, length);
+					ptr_ += length;
+					return str;
+				}
+
+				// Every entry takes at least `size` bytes, so a count the rest of the data cannot hold is corrupt.
+				std::uint32_t readCount(std::size_t size) except
+				{
+					auto count = this->read<std::uint32_t>();
+					if (std::size_t(end_ - ptr_) / size < count)
+						throw std::runtime_error("invalid count in binary archive");
+					return count;
+				}
+
+				void readKeys() except
+				{
+					auto count = this->readCount(sizeof(std::uint32_t));
+					keys_.reserve(count);
+
+					for (std::uint32_t i = 0; i < count; i++)
+						keys_.push_back(this->readString());
+				}
+
+				void readNode(archivebuf& node, std::uint32_t depth = 0) except
+				{
+					if (depth >= BINARY_ARCHIVE_MAX_DEPTH)
+						throw std::runtime_error("binary archive nested too deeply");
+
+					auto type = (archivebuf::type_t)this->read<std::uint8_t>();
+
+					switch (type)
+					{
+					case archivebuf::type_t::null:
+						node.clear();
+						break;
+					case archivebuf::type_t::boolean:
+						node = this->read<std::uint8_t>() ? true : false;
+						break;
+					case archivebuf::type_t::number_integer:
+						node = this->read<archivebuf::number_integer_t>();
+						break;
+					case archivebuf::type_t::number_unsigned:
+						node = this->read<archivebuf::number_unsigned_t>();
+						break;
+					case archivebuf::type_t::number_float:
+						node = this->read<archivebuf::number_float_t>();
+						break;
+					case archivebuf::type_t::string:
+						node = archivebuf::string_t(this->readString());
+						break;
+					case archivebuf::type_t::array:
+					{
+						auto count = this->readCount(sizeof(std::uint8_t));
+
+						node.emplace(archivebuf::type_t::array);
+						node.reserve(count);
+
+						for (std::uint32_t i = 0; i < count; i++)
+						{
+							archivebuf child;
+							this->readNode(child, depth + 1);
+							node.push_back(std::move(child));
+						}
+					}
+					break;
+					case archivebuf::type_t::object:
+					{
+						auto count = this->readCount(sizeof(std::uint32_t) + sizeof(std::uint8_t));
+
+						node.emplace(archivebuf::type_t::object);
+						node.reserve(count);
+
+						for (std::uint32_t i = 0; i < count; i++)
+						{
+							auto key = this->read<std::uint32_t>();
+							if (key >= keys_.size())
+								throw std::runtime_error("invalid key index in binary archive");
+
+							archivebuf child;
+							this->readNode(child, depth + 1);
+							node.push_back(keys_[key], std::move(child));
+						}
+					}
+					break;
+					default:
+						throw std::runtime_error("invalid node type in binary archive");
+					}
+				}
+
+			private:
+				const char* ptr_;
+				const char* end_;
+
+				std::vector<std::string_view> keys_;
+			};
+
+			class BinaryArchiveComposer final
+			{
+			public:
+				template<typename T>
+				void write(const T& value)
+				{
+					auto offset = data_.size();
+					data_.resize(offset + sizeof(T));
+					std::memcpy(data_.data() + offset, &value, sizeof(T));
+				}
+
+				void writeString(std::string_view str)
+				{
+					this->write((std::uint32_t)str.size());
+					data_.insert(data_.end(), str.begin(), str.end());
+				}
+
+				void collectKeys(const archivebuf& node)
+				{
+					if (node.is_object())
+					{
+						for (auto& it : node)
+						{
+							if (indices_.emplace(it.first, (std::uint32_t)keys_.size()).second)
+								keys_.push_back(it.first);
+
+							this->collectKeys(it.second);
+						}
+					}
+					else if (node.is_array())
+					{
+						for (auto& it : node.get<archivebuf::array_t>())
+							this->collectKeys(it);
+					}
+				}
+
+				void writeKeys()
+				{
+					this->write((std::uint32_t)keys_.size());
+
+					for (auto& key : keys_)
+						this->writeString(key);
+				}
+
+				void writeNode(const archivebuf& node)
+				{
+					this->write((std::uint8_t)node.type());
+
+					switch (node.type())
+					{
+					case archivebuf::type_t::boolean:
+						this->write((std::uint8_t)node.get<archivebuf::boolean_t>());
+						break;
+					case archivebuf::type_t::number_integer:
+						this->write(node.get<archivebuf::number_integer_t>());
+						break;
+					case archivebuf::type_t::number_unsigned:
+						this->write(node.get<archivebuf::number_unsigned_t>());
+						break;
+					case archivebuf::type_t::number_float:
+						this->write(node.get<archivebuf::number_float_t>());
+						break;
+					case archivebuf::type_t::string:
+						this->writeString(node.get<archivebuf::string_t>());
+						break;
+					case archivebuf::type_t::array:
+					{
+						auto& array = node.get<archivebuf::array_t>();
+						this->write((std::uint32_t)array.size());
+
+						for (auto& it : array)
+							this->writeNode(it);
+					}
+					break;
+					case archivebuf::type_t::object:
+					{
+						this->write((std::uint32_t)std::distance(node.begin(), node.end()));
+
+						for (auto& it : node)
+						{
+							this->write(indices_[it.first]);
+							this->writeNode(it.second);
+						}
+					}
+					break;
+					default:
+						break;
+					}
+				}
+
+				const std::vector<char>& data() const noexcept
+				{
+					return data_;
+				}
+
+			private:
+				std::vector<char> data_;
+				std::vector<std::string_view> keys_;
+				std::unordered_map<std::string_view, std::uint32_t> indices_;
+			};
+		}
+
+		BinaryArchiveReader::BinaryArchiveReader() noexcept
+			: iarchive(&_archive)
+		{
+		}
+
+		BinaryArchiveReader::BinaryArchiveReader(istream& stream) except
+			: iarchive(&_archive)
+		{
+			this->open(stream);
+		}
+
+		BinaryArchiveReader::BinaryArchiveReader(const std::string& path) except
+			: iarchive(&_archive)
+		{
+			this->open(path);
+		}
+
+		BinaryArchiveReader::~BinaryArchiveReader() noexcept
+		{
+			this->close();
+		}
+
+		BinaryArchiveReader&
+		BinaryArchiveReader::open(istream& stream, const ios_base::open_mode mode) except
+		{
+			try
+			{
+				auto length = stream.size();
+				if (length < (streamsize)(sizeof(BINARY_ARCHIVE_MAGIC) + sizeof(BINARY_ARCHIVE_VERSION)))
+				{
+					this->setstate(ios_base::failbit);
+					return *this;
+				}
+
+				// Parse in place when the stream is backed by memory, e.g. an immapstream.
+				std::vector<char> buffer;
+				const char* data = stream.rdbuf() ? stream.rdbuf()->data() : nullptr;
+
+				if (!data)
+				{
+					buffer.resize((std::size_t)length);
+
+					if (!stream.read(buffer.data(), (std::streamsize)length))
+					{
+						this->setstate(ios_base::failbit);
+						return *this;
+					}
+
+					data = buffer.data();
+				}
+
+				BinaryArchiveParser parser(data, (std::size_t)length);
+
+				if (std::memcmp(data, BINARY_ARCHIVE_MAGIC, sizeof(BINARY_ARCHIVE_MAGIC)) != 0)
+					throw std::runtime_error("invalid binary archive");
+
+				parser.read<std::uint32_t>();
+
+				if (parser.read<std::uint32_t>() != BINARY_ARCHIVE_VERSION)
+					throw std::runtime_error("unsupported binary archive version");
+
+				parser.readKeys();
+				parser.readNode(_archive);
+
+				this->clear(ios_base::goodbit, mode);
+				return *this;
+			}
+			catch (const std::exception& e)
+			{
+				this->setstate(ios_base::failbit);
+				throw std::runtime_error(e.what());
+			}
+		}
+
+		BinaryArchiveReader&
+		BinaryArchiveReader::open(const std::string& path) except
+		{
+			immapstream stream;
+			if (stream.open(path))
+				return this->open(stream);
+			else
+			{
+				this->setstate(ios_base::failbit);
+				return *this;
+			}
+		}
+
+		bool
+		BinaryArchiveReader::accept(istream& stream) noexcept
+		{
+			char magic[sizeof(BINARY_ARCHIVE_MAGIC)];
+
+			if (stream.size() < (streamsize)sizeof(magic))
+				return false;
+
+			auto pos = stream.tellg();
+			if (!stream.read(magic, sizeof(magic)))
+				return false;
+
+			stream.seekg(pos, ios_base::beg);
+
+			return std::memcmp(magic, BINARY_ARCHIVE_MAGIC, sizeof(magic)) == 0;
+		}
+
+		bool
+		BinaryArchiveReader::is_open() const noexcept
+		{
+			return _archive.size();
+		}
+
+		void
+		BinaryArchiveReader::close() noexcept
+		{
+			_archive.clear();
+		}
+
+		BinaryArchiveWrite::BinaryArchiveWrite() noexcept
+			: oarchive(&_archive)
+		{
+		}
+
+		BinaryArchiveWrite::~BinaryArchiveWrite() noexcept
+		{
+			this->close();
+		}
+
+		BinaryArchiveWrite&
+		BinaryArchiveWrite::save(ostream& stream, const ios_base::open_mode mode) except
+		{
+			try
+			{
+				BinaryArchiveComposer composer;
+				composer.write(BINARY_ARCHIVE_MAGIC);
+				composer.write(BINARY_ARCHIVE_VERSION);
+				composer.collectKeys(_archive);
+				composer.writeKeys();
+				composer.writeNode(_archive);
+
+				auto& data = composer.data();
+				if (!stream.write(data.data(), (std::streamsize)data.size()))
+				{
+					this->setstate(ios_base::failbit);
+					return *this;
+				}
+
+				ios_base::clear(ios_base::goodbit, mode);
+				return *this;
+			}
+			catch (const std::exception& e)
+			{
+				this->setstate(ios_base::failbit);
+				throw std::runtime_error(e.what());
+			}
+		}
+
+		BinaryArchiveWrite&
+		BinaryArchiveWrite::save(const std::string& path) except
+		{
+			// Plain `out` does not create missing files, `in | out` does; `trunc` drops any older, longer archive.
+			ofstream stream;
+			if (stream.open(path, ios_base::in | ios_base::out | ios_base::trunc))
+				return this->save(stream);
+			else
+			{
+				this->setstate(ios_base::failbit);
+				return *this;
+			}
+		}
+
+		void
+		BinaryArchiveWrite::close() noexcept
+		{
+			_archive.clear();
+		}
+
+		bool
+		BinaryArchiveWrite::is_open() const noexcept
+		{
+			return _archive.size();
+		}
+	}
+}
@@ -132,6 +132,12 @@ namespace octoon
 			return buffer_.size();
 		}
 
+		const char*
+		membuf::data() const noexcept
+		{
+			return buffer_.empty() ? "" : (const char*)buffer_.data();
+		}
+
 		int
 		membuf::flush() noexcept
 		{
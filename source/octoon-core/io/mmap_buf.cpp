@@ -0,0 +1,274 @@
+#include <octoon/io/mmap_buf.h>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#if defined(__WINDOWS__)
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+namespace octoon
+{
+	namespace io
+	{
+		mmapbuf::mmapbuf() noexcept
+			: data_(nullptr)
+			, pos_(0)
+			, size_(0)
+		{
+		}
+
+		mmapbuf::mmapbuf(mmapbuf&& move) noexcept
+			: data_(move.data_)
+			, pos_(move.pos_)
+			, size_(move.size_)
+		{
+			move.data_ = nullptr;
+			move.pos_ = 0;
+			move.size_ = 0;
+		}
+
+		mmapbuf::~mmapbuf() noexcept
+		{
+			this->close();
+		}
+
+		mmapbuf&
+		mmapbuf::operator=(mmapbuf&& move) noexcept
+		{
+			if (this != &move)
+			{
+				this->close();
+
+				data_ = move.data_;
+				pos_ = move.pos_;
+				size_ = move.size_;
+
+				move.data_ = nullptr;
+				move.pos_ = 0;
+				move.size_ = 0;
+			}
+
+			return *this;
+		}
+
+		bool
+		mmapbuf::is_open() const noexcept
+		{
+			return data_ != nullptr;
+		}
+
+		bool
+		mmapbuf::open(const char* filename, ios_base::openmode mode) noexcept
+		{
+			if (mode & (ios_base::out | ios_base::app | ios_base::trunc))
+				return false;
+
+			this->close();
+
+#if defined(__WINDOWS__)
+			auto handle = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (handle == INVALID_HANDLE_VALUE)
+				return false;
+
+			auto result = this->map(handle);
+			::CloseHandle(handle);
+			return result;
+#else
+			int fd = ::open(filename, O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			auto result = this->map(&fd);
+			::close(fd);
+			return result;
+#endif
+		}
+
+		bool
+		mmapbuf::open(const wchar_t* filename, ios_base::openmode mode) noexcept
+		{
+#if defined(__WINDOWS__)
+			if (mode & (ios_base::out | ios_base::app | ios_base::trunc))
+				return false;
+
+			this->close();
+
+			auto handle = ::CreateFileW(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (handle == INVALID_HANDLE_VALUE)
+				return false;
+
+			auto result = this->map(handle);
+			::CloseHandle(handle);
+			return result;
+#else
+			char fn[ios_base::PATHLIMIT];
+			if (::wcstombs(fn, filename, ios_base::PATHLIMIT) == (std::size_t)-1)
+				return false;
+
+			return this->open(fn, mode);
+#endif
+		}
+
+		bool
+		mmapbuf::open(const std::string& filename, ios_base::openmode mode) noexcept
+		{
+			return this->open(filename.c_str(), mode);
+		}
+
+		bool
+		mmapbuf::open(const std::wstring& filename, ios_base::openmode mode) noexcept
+		{
+			return this->open(filename.c_str(), mode);
+		}
+
+		bool
+		mmapbuf::map(void* handle) noexcept
+		{
+#if defined(__WINDOWS__)
+			LARGE_INTEGER length;
+			if (!::GetFileSizeEx((HANDLE)handle, &length))
+				return false;
+
+			// Mapping an empty file is an error on Windows, but an empty buffer is still a valid stream.
+			if (length.QuadPart == 0)
+			{
+				size_ = 0;
+				data_ = "";
+				return true;
+			}
+
+			auto mapping = ::CreateFileMappingA((HANDLE)handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping)
+				return false;
+
+			auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			::CloseHandle(mapping);
+			if (!view)
+				return false;
+
+			data_ = (const char*)view;
+			size_ = (std::size_t)length.QuadPart;
+			pos_ = 0;
+			return true;
+#else
+			int fd = *(int*)handle;
+
+			struct stat st;
+			if (::fstat(fd, &st) != 0)
+				return false;
+
+			if (st.st_size == 0)
+			{
+				size_ = 0;
+				data_ = "";
+				return true;
+			}
+
+			auto view = ::mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (view == MAP_FAILED)
+				return false;
+
+#	if defined(POSIX_MADV_SEQUENTIAL)
+			::posix_madvise(view, (std::size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+#	endif
+
+			data_ = (const char*)view;
+			size_ = (std::size_t)st.st_size;
+			pos_ = 0;
+			return true;
+#endif
+		}
+
+		bool
+		mmapbuf::close() noexcept
+		{
+			if (data_ && size_ > 0)
+			{
+#if defined(__WINDOWS__)
+				::UnmapViewOfFile(data_);
+#else
+				::munmap((void*)data_, size_);
+#endif
+			}
+
+			data_ = nullptr;
+			pos_ = 0;
+			size_ = 0;
+			return true;
+		}
+
+		streamsize
+		mmapbuf::read(char* str, std::streamsize cnt) noexcept
+		{
+			if (pos_ >= size_ || cnt <= 0)
+				return 0;
+
+			std::size_t count = std::min<std::size_t>(cnt, size_ - pos_);
+			std::memcpy(str, data_ + pos_, count);
+			pos_ += count;
+
+			return count;
+		}
+
+		streamsize
+		mmapbuf::write(const char*, std::streamsize) noexcept
+		{
+			return 0;
+		}
+
+		streamoff
+		mmapbuf::seekg(ios_base::off_type pos, ios_base::seekdir dir) noexcept
+		{
+			streamoff base = 0;
+			switch (dir)
+			{
+			case ios_base::beg:
+				base = 0;
+				break;
+			case ios_base::cur:
+				base = pos_;
+				break;
+			case ios_base::end:
+				base = size_;
+				break;
+			}
+
+			streamoff resultant = base + pos;
+			if (resultant < 0 || resultant > (streamoff)size_)
+				return ios_base::_BADOFF;
+
+			pos_ = (std::size_t)resultant;
+			return resultant;
+		}
+
+		streamoff
+		mmapbuf::tellg() noexcept
+		{
+			return pos_;
+		}
+
+		streamsize
+		mmapbuf::size() const noexcept
+		{
+			return size_;
+		}
+
+		const char*
+		mmapbuf::data() const noexcept
+		{
+			return data_;
+		}
+
+		int
+		mmapbuf::flush() noexcept
+		{
+			return 0;
+		}
+	}
+}
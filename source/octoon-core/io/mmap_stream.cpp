@@ -0,0 +1,108 @@
+#include <octoon/io/mmap_stream.h>
+
+namespace octoon
+{
+	namespace io
+	{
+		immapstream::immapstream() noexcept
+			: istream(&file_)
+		{
+		}
+
+		immapstream::immapstream(const char* path, const ios_base::open_mode mode) noexcept
+			: istream(&file_)
+		{
+			this->open(path, mode);
+		}
+
+		immapstream::immapstream(const wchar_t* path, const ios_base::open_mode mode) noexcept
+			: istream(&file_)
+		{
+			this->open(path, mode);
+		}
+
+		immapstream::immapstream(const std::string& path, const ios_base::open_mode mode) noexcept
+			: istream(&file_)
+		{
+			this->open(path, mode);
+		}
+
+		immapstream::immapstream(const std::wstring& path, const ios_base::open_mode mode) noexcept
+			: istream(&file_)
+		{
+			this->open(path, mode);
+		}
+
+		immapstream::~immapstream() noexcept
+		{
+			this->close();
+		}
+
+		bool
+		immapstream::is_open() const noexcept
+		{
+			return file_.is_open();
+		}
+
+		const char*
+		immapstream::data() const noexcept
+		{
+			return file_.data();
+		}
+
+		immapstream&
+		immapstream::open(const char* path, const ios_base::open_mode mode) noexcept
+		{
+			const isentry ok(this);
+			if (ok)
+			{
+				if (!file_.open(path, mode))
+					this->setstate(ios_base::failbit, mode);
+				else
+					this->clear(ios_base::goodbit, mode);
+			}
+
+			return (*this);
+		}
+
+		immapstream&
+		immapstream::open(const wchar_t* path, const ios_base::open_mode mode) noexcept
+		{
+			const isentry ok(this);
+			if (ok)
+			{
+				if (!file_.open(path, mode))
+					this->setstate(ios_base::failbit, mode);
+				else
+					this->clear(ios_base::goodbit, mode);
+			}
+
+			return (*this);
+		}
+
+		immapstream&
+		immapstream::open(const std::string& path, const ios_base::open_mode mode) noexcept
+		{
+			return this->open(path.c_str(), mode);
+		}
+
+		immapstream&
+		immapstream::open(const std::wstring& path, const ios_base::open_mode mode) noexcept
+		{
+			return this->open(path.c_str(), mode);
+		}
+
+		immapstream&
+		immapstream::close() noexcept
+		{
+			const isentry ok(this);
+			if (ok)
+			{
+				if (!file_.close())
+					this->setstate(failbit);
+			}
+
+			return (*this);
+		}
+	}
+}
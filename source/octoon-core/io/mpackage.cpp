@@ -0,0 +1,76 @@
+#include <octoon/io/mpackage.h>
+#include <octoon/io/mmap_buf.h>
+
+#include <sys/stat.h>
+
+#if !defined(S_ISDIR)
+#	define S_ISDIR(mode) (((mode) & S_IFMT) == S_IFDIR)
+#endif
+
+#if !defined(S_ISREG)
+#	define S_ISREG(mode) (((mode) & S_IFMT) == S_IFREG)
+#endif
+
+namespace octoon
+{
+	namespace io
+	{
+		mpackage::mpackage(const char* base_dir) noexcept
+			: base_dir_(base_dir)
+		{
+		}
+
+		mpackage::mpackage(std::string&& base_dir) noexcept
+			: base_dir_(std::move(base_dir))
+		{
+		}
+
+		mpackage::mpackage(const std::string& base_dir) noexcept
+			: base_dir_(base_dir)
+		{
+		}
+
+		std::unique_ptr<stream_buf>
+		mpackage::open(const Orl& orl, const ios_base::open_mode opts)
+		{
+			auto file = std::make_unique<mmapbuf>();
+
+			if (file->open(make_path(orl), opts))
+				return file;
+			else
+				return nullptr;
+		}
+
+		bool
+		mpackage::remove(const Orl&, ios_base::file_type)
+		{
+			return false;
+		}
+
+		ios_base::file_type
+		mpackage::exists(const Orl& orl)
+		{
+			struct stat st;
+			if (::stat(make_path(orl).c_str(), &st) != 0)
+				return ios_base::none;
+
+			if (S_ISDIR(st.st_mode))
+				return ios_base::directory;
+			else if (S_ISREG(st.st_mode))
+				return ios_base::file;
+			else
+				return ios_base::none;
+		}
+
+		std::string
+		mpackage::make_path(const Orl& orl) const
+		{
+			std::string rv;
+			rv.reserve(base_dir_.size() + orl.path().size());
+			rv.append(base_dir_);
+			rv.append(orl.path());
+
+			return rv;
+		}
+	}
+}
@@ -4,6 +4,12 @@ namespace octoon
 {
 	namespace io
 	{
+		const char*
+		stream_buf::data() const noexcept
+		{
+			return nullptr;
+		}
+
 		void
 		stream_buf::lock() noexcept
 		{
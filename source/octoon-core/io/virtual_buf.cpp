@@ -99,6 +99,12 @@ namespace octoon
 			return buf_ ? buf_->size() : 0;
 		}
 
+		const char*
+		virtual_buf::data() const noexcept
+		{
+			return buf_ ? buf_->data() : nullptr;
+		}
+
 		int
 		virtual_buf::flush() noexcept
 		{
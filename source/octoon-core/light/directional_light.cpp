@@ -1,5 +1,6 @@
 #include <octoon/light/directional_light.h>
 #include <octoon/camera/ortho_camera.h>
+#include <algorithm>
 
 namespace octoon
 {
@@ -8,8 +9,10 @@ namespace octoon
 	DirectionalLight::DirectionalLight() noexcept
 		: shadowBias_(0.0f)
 		, shadowRadius_(1.0f)
+		, shadowDistance_(100.0f)
 		, shadowEnable_(false)
 		, shadowSize_(512, 512)
+		, shadowCascades_(MAX_SHADOW_CASCADES)
 	{
 		this->shadowCamera_ = std::make_shared<OrthographicCamera>(-20.0f, 20.0f, -20.0f, 20.0f, 0.01f, 1000.f);
 		this->shadowCamera_->setOwnerListener(this);
@@ -24,10 +27,9 @@ namespace octoon
 	{
 		if (this->shadowEnable_ != enable)
 		{
-			if (this->shadowCamera_ && enable)
-				this->shadowCamera_->setupFramebuffers(shadowSize_.x, shadowSize_.y, 0, hal::GraphicsFormat::R8G8B8A8UNorm, hal::GraphicsFormat::D32_SFLOAT);
-			this->setDirty(true);
 			this->shadowEnable_ = enable;
+			this->setupShadowAtlas();
+			this->setDirty(true);
 		}
 	}
 
@@ -68,9 +70,9 @@ namespace octoon
 	{
 		if (this->shadowSize_ != size)
 		{
-			if (this->shadowCamera_ && this->shadowEnable_)
-				this->shadowCamera_->setupFramebuffers(size.x, size.y, 0, hal::GraphicsFormat::R8G8B8A8UNorm, hal::GraphicsFormat::D32_SFLOAT);
 			this->shadowSize_ = size;
+			this->setupShadowAtlas();
+			this->setDirty(true);
 		}
 	}
 
@@ -80,6 +82,37 @@ namespace octoon
 		return this->shadowSize_;
 	}
 
+	void
+	DirectionalLight::setShadowCascades(std::uint32_t count) noexcept
+	{
+		count = std::clamp<std::uint32_t>(count, 1, MAX_SHADOW_CASCADES);
+		if (this->shadowCascades_ != count)
+		{
+			this->shadowCascades_ = count;
+			this->setupShadowAtlas();
+			this->setDirty(true);
+		}
+	}
+
+	std::uint32_t
+	DirectionalLight::getShadowCascades() const noexcept
+	{
+		return this->shadowCascades_;
+	}
+
+	void
+	DirectionalLight::setShadowDistance(float distance) noexcept
+	{
+		this->setDirty(true);
+		shadowDistance_ = distance;
+	}
+
+	float
+	DirectionalLight::getShadowDistance() const noexcept
+	{
+		return shadowDistance_;
+	}
+
 	void
 	DirectionalLight::setCamera(const std::shared_ptr<Camera>& camera) noexcept
 	{
@@ -99,6 +132,8 @@ namespace octoon
 		auto light = std::make_shared<DirectionalLight>();
 		light->setShadowBias(this->getShadowBias());
 		light->setShadowRadius(this->getShadowRadius());
+		light->setShadowDistance(this->getShadowDistance());
+		light->setShadowCascades(this->getShadowCascades());
 		return light;
 	}
 
@@ -109,4 +144,16 @@ namespace octoon
 			this->shadowCamera_->setTransform(this->getTransform(), this->getTransformInverse());
 		Light::onMoveAfter();
 	}
+
+	void
+	DirectionalLight::setupShadowAtlas() noexcept
+	{
+		// Cascades are laid out left to right, then bottom to top.
+		if (this->shadowCamera_ && this->shadowEnable_)
+		{
+			auto columns = shadowCascades_ > 1 ? 2 : 1;
+			auto rows = shadowCascades_ > 2 ? 2 : 1;
+			this->shadowCamera_->setupFramebuffers(shadowSize_.x * columns, shadowSize_.y * rows, 0, hal::GraphicsFormat::R8G8B8A8UNorm, hal::GraphicsFormat::D32_SFLOAT);
+		}
+	}
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace octoon
 
 	Light::Light() noexcept
 		: lightIntensity_(1.0f)
-		, lightRange_(10.0f)
+		, lightRange_(0.0f)
 		, lightColor_(math::float3::One)
 	{
 	}
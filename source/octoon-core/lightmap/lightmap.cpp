@@ -1,6 +1,11 @@
 #include <octoon/lightmap/lightmap.h>
 #include <octoon/lightmap/lightmap_pack.h>
 #include <octoon/camera/camera.h>
+#include <octoon/math/simd.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
 
 namespace octoon::bake
 {
@@ -56,8 +61,46 @@ namespace octoon::bake
 		return nRes;
 	}
 
+	float luminance(const math::float3& color)
+	{
+		return color.x * 0.2126f + color.y * 0.7152f + color.z * 0.0722f;
+	}
+
+	void
+	Patches::clear() noexcept
+	{
+		texelIndex.clear();
+		area.clear();
+		positionX.clear();
+		positionY.clear();
+		positionZ.clear();
+		normalX.clear();
+		normalY.clear();
+		normalZ.clear();
+		color.clear();
+		emissive.clear();
+	}
+
+	void
+	Patches::append(const Patches& other) noexcept
+	{
+		texelIndex.insert(texelIndex.end(), other.texelIndex.begin(), other.texelIndex.end());
+		area.insert(area.end(), other.area.begin(), other.area.end());
+		positionX.insert(positionX.end(), other.positionX.begin(), other.positionX.end());
+		positionY.insert(positionY.end(), other.positionY.begin(), other.positionY.end());
+		positionZ.insert(positionZ.end(), other.positionZ.begin(), other.positionZ.end());
+		normalX.insert(normalX.end(), other.normalX.begin(), other.normalX.end());
+		normalY.insert(normalY.end(), other.normalY.begin(), other.normalY.end());
+		normalZ.insert(normalZ.end(), other.normalZ.begin(), other.normalZ.end());
+		color.insert(color.end(), other.color.begin(), other.color.end());
+		emissive.insert(emissive.end(), other.emissive.begin(), other.emissive.end());
+	}
+
 	Lightmap::Lightmap() noexcept
 		: mipLevel_(5)
+		, timeBudget_(10.0f)
+		, refineThreshold_(1e-2f)
+		, indirectBounces_(1)
 	{
 		this->lightmap.width = 128;
 		this->lightmap.height = 128;
@@ -65,12 +108,10 @@ namespace octoon::bake
 		this->frontBuffer_.resize(this->lightmap.width * this->lightmap.height * 4);
 
 		this->patches_.resize(this->mipLevel_);
-		this->usedTexels.resize(this->mipLevel_);
 		this->directLightBuffer_.resize(this->mipLevel_);
 
 		for (std::uint8_t i = 0; i < mipLevel_; i++)
 		{
-			this->usedTexels[i].resize((this->lightmap.width >> i) * (this->lightmap.height >> i));
 			this->directLightBuffer_[i].resize((this->lightmap.width >> i)* (this->lightmap.height >> i));
 		}
 	}
@@ -103,24 +144,20 @@ namespace octoon::bake
 #if 0
 		for (std::uint8_t level = 0; level < this->mipLevel_; level++)
 		{
-			auto columns = patches_[level].size();
-			for (std::int32_t i = 0; i < columns; ++i)
-			{
-				auto& sourcePatch = this->patches_[level][i];
-				this->directLightBuffer_[level][sourcePatch.texelIndex] += sourcePatch.emissive;
-			}
+			auto& patches = this->patches_[level];
+			for (std::size_t i = 0; i < patches.size(); ++i)
+				this->directLightBuffer_[level][patches.texelIndex[i]] += patches.emissive[i];
 		}
 #endif
 
 		this->computeIndirectLightBounce(camera);
 
 #if 0
-		auto columns = patches_[0].size();
-		for (std::int32_t i = 0; i < columns; ++i)
+		auto& patches = this->patches_[0];
+		for (std::size_t i = 0; i < patches.size(); ++i)
 		{
-			auto& sourcePatch = this->patches_[0][i];
-			if (math::any(sourcePatch.emissive))
-				this->lightmap.data[sourcePatch.texelIndex] += math::PI;
+			if (math::any(patches.emissive[i]))
+				this->lightmap.data[patches.texelIndex[i]] += math::PI;
 		}
 #endif
 		/*for (std::size_t y = 0; y < this->lightmap.height * 2; y++)
@@ -170,23 +207,68 @@ namespace octoon::bake
 		{
 			std::memset(this->directLightBuffer_[level].data(), 0, this->directLightBuffer_[level].size() * sizeof(math::float3));
 
-			auto columns = patches_[level].size();
+			auto& patches = this->patches_[level];
+			auto& buffer = this->directLightBuffer_[level];
+
+			auto batches = static_cast<std::int32_t>((patches.size() + 3) / 4);
 
-#		pragma omp parallel for
-			for (std::int32_t i = 0; i < columns; ++i)
+			// Four patches at a time, their shadow rays share the light direction and go through the BVH as one packet.
+#			pragma omp parallel for schedule(dynamic, 64)
+			for (std::int32_t batch = 0; batch < batches; ++batch)
 			{
-				auto& sourcePatch = this->patches_[level][i];
+				auto first = static_cast<std::size_t>(batch) * 4;
+				auto count = std::min<std::size_t>(4, patches.size() - first);
 
-				math::Raycast ray;
-				ray.origin = sourcePatch.position + lightDir * 0.01f;
-				ray.normal = lightDir;
+				alignas(16) float nl[4] = {};
+				alignas(16) float originX[4] = {};
+				alignas(16) float originY[4] = {};
+				alignas(16) float originZ[4] = {};
 
-				auto nl = std::max(math::dot(lightDir, sourcePatch.normal), 0.0f);
-				if (nl > 0.0f)
+				std::uint32_t mask = 0;
+
+#if defined(OCTOON_MATH_SIMD)
+				if (count == 4)
+				{
+					__m128 lx = _mm_set1_ps(lightDir.x);
+					__m128 ly = _mm_set1_ps(lightDir.y);
+					__m128 lz = _mm_set1_ps(lightDir.z);
+					__m128 bias = _mm_set1_ps(0.01f);
+
+					__m128 dot = _mm_mul_ps(_mm_loadu_ps(patches.normalX.data() + first), lx);
+					dot = _mm_add_ps(dot, _mm_mul_ps(_mm_loadu_ps(patches.normalY.data() + first), ly));
+					dot = _mm_add_ps(dot, _mm_mul_ps(_mm_loadu_ps(patches.normalZ.data() + first), lz));
+
+					_mm_store_ps(nl, _mm_max_ps(dot, _mm_setzero_ps()));
+					mask = static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpgt_ps(dot, _mm_setzero_ps())));
+
+					_mm_store_ps(originX, _mm_add_ps(_mm_loadu_ps(patches.positionX.data() + first), _mm_mul_ps(lx, bias)));
+					_mm_store_ps(originY, _mm_add_ps(_mm_loadu_ps(patches.positionY.data() + first), _mm_mul_ps(ly, bias)));
+					_mm_store_ps(originZ, _mm_add_ps(_mm_loadu_ps(patches.positionZ.data() + first), _mm_mul_ps(lz, bias)));
+				}
+				else
+#endif
 				{
-					MeshHit hit;
-					if (!this->mesh_->raycast(ray, hit))
-						this->directLightBuffer_[level][sourcePatch.texelIndex] += lightColor * sourcePatch.color * nl;
+					for (std::size_t i = 0; i < count; i++)
+					{
+						nl[i] = std::max(math::dot(lightDir, patches.normal(first + i)), 0.0f);
+						if (nl[i] > 0.0f)
+							mask |= 1u << i;
+
+						originX[i] = patches.positionX[first + i] + lightDir.x * 0.01f;
+						originY[i] = patches.positionY[first + i] + lightDir.y * 0.01f;
+						originZ[i] = patches.positionZ[first + i] + lightDir.z * 0.01f;
+					}
+				}
+
+				if (mask == 0)
+					continue;
+
+				auto lit = mask & ~this->bvh_.occluded4(originX, originY, originZ, lightDir, std::numeric_limits<float>::infinity(), mask);
+
+				for (std::size_t i = 0; i < count; i++)
+				{
+					if (lit & (1u << i))
+						buffer[patches.texelIndex[first + i]] = lightColor * patches.color[first + i] * nl[i];
 				}
 			}
 		}
@@ -197,227 +279,632 @@ namespace octoon::bake
 	{
 		std::memset(this->lightmap.data.data(), 0, this->lightmap.data.size() * sizeof(math::float3));
 
-		auto columns = patches_[0].size();
+		if (this->clusters_.empty())
+			return;
 
-#		pragma omp parallel for
-		for (std::int32_t i = 0; i < columns; ++i)
-		{
-			auto& sourcePatch = this->patches_[0][i];
+		this->refineLinks();
+
+		auto& patches = this->patches_[0];
+		auto& directLight = this->directLightBuffer_[0];
+
+		auto numClusters = this->clusters_.size();
 
-			auto& destPaths = this->patches_[4];
-			auto& destDirectLightBuffer = this->directLightBuffer_[4];
+		// Links are sorted by receiver, each cluster gathers from its own range of them.
+		std::vector<std::uint32_t> linkOffsets(numClusters + 1, 0);
+		for (auto& link : this->links_)
+			linkOffsets[link.receiver + 1]++;
+		for (std::size_t i = 0; i < numClusters; i++)
+			linkOffsets[i + 1] += linkOffsets[i];
 
-			auto destColumns = destPaths.size();
+		std::vector<math::float3> radiosity(patches.size());
+		for (std::size_t i = 0; i < patches.size(); i++)
+			radiosity[i] = directLight[patches.texelIndex[i]];
 
-			math::float3 value = math::float3::Zero;
-			for (std::size_t j = 0; j < destColumns; ++j)
+		std::vector<math::float3> irradiance(patches.size(), math::float3::Zero);
+		std::vector<math::float3> clusterRadiosity(numClusters);
+		std::vector<math::float3> clusterGathered(numClusters);
+
+		for (std::uint32_t bounce = 0; bounce < this->indirectBounces_; bounce++)
+		{
+			// Pull the radiosity of the patches up to the clusters holding them.
+			for (std::size_t i = numClusters; i-- > 0;)
 			{
-				auto& destPatch = destPaths[j];
-				auto L = destPatch.position - sourcePatch.position;
-				auto distance2 = math::length2(L);
-				if (distance2 > 0)
+				auto& cluster = this->clusters_[i];
+				if (cluster.count == 1)
+					clusterRadiosity[i] = radiosity[this->clusterPatches_[cluster.first]];
+				else
 				{
-					auto distance = std::sqrt(distance2);
-					L /= distance;
+					auto& left = this->clusters_[cluster.left];
+					auto& right = this->clusters_[cluster.left + 1];
+					clusterRadiosity[i] = (clusterRadiosity[cluster.left] * left.area + clusterRadiosity[cluster.left + 1] * right.area) / std::max(cluster.area, 1e-12f);
+				}
+			}
 
-					auto cosi = math::dot(sourcePatch.normal, L);
-					auto cosj = -math::dot(destPatch.normal, L);
-					
-					auto factor = cosi * cosj;
-					if (factor > 1e-4f)
-					{
-						MeshHit hit;
-						math::Raycast ray;
-						ray.origin = sourcePatch.position + sourcePatch.normal * 0.01f;
-						ray.normal = L;
-						ray.maxDistance = distance - 0.1f;
-
-						if (!this->mesh_->raycast(ray, hit))
-							value += destDirectLightBuffer[destPatch.texelIndex] * (factor * destPatch.area / std::max(1.0f, distance2) / math::PI);
-					}
+			auto numGathers = static_cast<std::int32_t>(numClusters);
+
+#			pragma omp parallel for
+			for (std::int32_t i = 0; i < numGathers; ++i)
+			{
+				math::float3 value = math::float3::Zero;
+				for (auto j = linkOffsets[i]; j < linkOffsets[i + 1]; j++)
+					value += clusterRadiosity[this->links_[j].emitter] * this->links_[j].factor;
+
+				clusterGathered[i] = value;
+			}
+
+			// Push what each cluster gathered down to the patches it holds.
+			for (std::size_t i = 0; i < numClusters; i++)
+			{
+				auto& cluster = this->clusters_[i];
+				if (cluster.count == 1)
+					irradiance[this->clusterPatches_[cluster.first]] = clusterGathered[i];
+				else
+				{
+					clusterGathered[cluster.left] += clusterGathered[i];
+					clusterGathered[cluster.left + 1] += clusterGathered[i];
 				}
 			}
 
-			this->lightmap.data[sourcePatch.texelIndex] = value;
+			for (std::size_t i = 0; i < patches.size(); i++)
+				radiosity[i] = directLight[patches.texelIndex[i]] + patches.color[i] * irradiance[i];
 		}
+
+		for (std::size_t i = 0; i < patches.size(); i++)
+			this->lightmap.data[patches.texelIndex[i]] = irradiance[i];
 	}
 
 	void
-	Lightmap::setGeometry(const Geometry& geometry) noexcept
+	Lightmap::setTimeBudget(float seconds) noexcept
 	{
-		mesh_ = geometry.getMesh();
-
-		auto& vertices = mesh_->getVertexArray();
-		auto& normals = mesh_->getNormalArray();
-		auto& texcoords = mesh_->getTexcoordArray(1);
+		this->timeBudget_ = seconds;
+	}
 
-		if (!texcoords.empty())
-		{
-			for (std::uint32_t level = 0; level < this->mipLevel_; level++)
-			{
-				for (std::size_t i = 0; i < mesh_->getNumSubsets(); i++)
-				{
-					auto& indices = mesh_->getIndicesArray(i);
-					auto& material = geometry.getMaterial(i);
+	float
+	Lightmap::getTimeBudget() const noexcept
+	{
+		return this->timeBudget_;
+	}
 
-					for (std::size_t j = 0; j < indices.size(); j += 3)
-					{
-						auto i1 = indices[j];
-						auto i2 = indices[j + 1];
-						auto i3 = indices[j + 2];
+	void
+	Lightmap::setRefineThreshold(float threshold) noexcept
+	{
+		this->refineThreshold_ = threshold;
+	}
 
-						auto& v1 = vertices[i1];
-						auto& v2 = vertices[i2];
-						auto& v3 = vertices[i3];
+	float
+	Lightmap::getRefineThreshold() const noexcept
+	{
+		return this->refineThreshold_;
+	}
 
-						math::float3 diffuse;
-						if (material->get("diffuse", diffuse))
-							this->trySamplingConservativeTriangleRasterizerPatch(level, v1, v2, v3, texcoords[i1], texcoords[i2], texcoords[i3], normals[i1], normals[i2], normals[i3], diffuse);
-					}
-				}
-			}
-		}
+	void
+	Lightmap::setIndirectBounces(std::uint32_t bounces) noexcept
+	{
+		this->indirectBounces_ = bounces;
 	}
 
-	bool
-	Lightmap::isConservativeTriangleRasterizerFinished()
+	std::uint32_t
+	Lightmap::getIndirectBounces() const noexcept
 	{
-		return this->meshPosition.rasterizer.y >= this->meshPosition.rasterizer.maxy;
+		return this->indirectBounces_;
 	}
 
 	void
-	Lightmap::moveToNextConservativeTriangleRasterizerPosition()
+	Lightmap::buildClusters() noexcept
 	{
-		this->meshPosition.rasterizer.x += 1;
+		auto& patches = this->patches_[0];
+
+		this->links_.clear();
+		this->clusters_.clear();
+		this->clusterPatches_.resize(patches.size());
+
+		if (patches.empty())
+			return;
+
+		std::iota(this->clusterPatches_.begin(), this->clusterPatches_.end(), 0);
 
-		while (this->meshPosition.rasterizer.x >= this->meshPosition.rasterizer.maxx)
+		// Breadth first with a median split along the longest side, so children always follow their parent.
+		this->clusters_.reserve(patches.size() * 2 - 1);
+		this->clusters_.push_back(Cluster{ math::float3::Zero, math::float3::Zero, 0, 0, 0, 0, 0, static_cast<std::uint32_t>(patches.size()) });
+
+		for (std::size_t i = 0; i < this->clusters_.size(); i++)
 		{
-			this->meshPosition.rasterizer.x = this->meshPosition.rasterizer.minx;
-			this->meshPosition.rasterizer.y += 1;
+			auto first = this->clusters_[i].first;
+			auto count = this->clusters_[i].count;
+
+			auto min = math::float3(std::numeric_limits<float>::max());
+			auto max = math::float3(-std::numeric_limits<float>::max());
+
+			float area = 0;
+			math::float3 position = math::float3::Zero;
+			math::float3 normal = math::float3::Zero;
+
+			for (auto j = first; j < first + count; j++)
+			{
+				auto patch = this->clusterPatches_[j];
+				auto patchPosition = patches.position(patch);
+				min = math::min(min, patchPosition);
+				max = math::max(max, patchPosition);
+				area += patches.area[patch];
+				position += patchPosition * patches.area[patch];
+				normal += patches.normal(patch) * patches.area[patch];
+			}
+
+			position = area > 0 ? position / area : (min + max) * 0.5f;
+			normal = area > 0 ? normal / area : math::float3::Zero;
 
-			if (this->isConservativeTriangleRasterizerFinished())
-				break;
+			float radius = 0;
+			for (auto j = first; j < first + count; j++)
+			{
+				auto patch = this->clusterPatches_[j];
+				radius = std::max(radius, math::length(patches.position(patch) - position) + std::sqrt(patches.area[patch] / math::PI));
+			}
+
+			auto& cluster = this->clusters_[i];
+			cluster.position = position;
+			cluster.normal = normal;
+			cluster.area = area;
+			cluster.radius = radius;
+
+			if (count > 1)
+			{
+				auto extent = max - min;
+				std::uint8_t axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+				auto& coordinate = axis == 0 ? patches.positionX : (axis == 1 ? patches.positionY : patches.positionZ);
+
+				auto begin = this->clusterPatches_.begin() + first;
+				std::nth_element(begin, begin + count / 2, begin + count, [&](std::uint32_t a, std::uint32_t b)
+				{
+					return coordinate[a] < coordinate[b];
+				});
+
+				cluster.left = static_cast<std::uint32_t>(this->clusters_.size());
+
+				this->clusters_.push_back(Cluster{ math::float3::Zero, math::float3::Zero, 0, 0, 0, 0, first, count / 2 });
+				this->clusters_.push_back(Cluster{ math::float3::Zero, math::float3::Zero, 0, 0, 0, 0, first + count / 2, count - count / 2 });
+			}
 		}
 	}
 
-	bool
-	Lightmap::trySamplingConservativeTriangleRasterizerPosition(std::uint32_t level, Patch& patch)
+	void
+	Lightmap::refineLinks() noexcept
 	{
-		if (isConservativeTriangleRasterizerFinished())
-			return false;
-
-		math::float2 pixel[16];
-		pixel[0] = math::float2((float)this->meshPosition.rasterizer.x, (float)this->meshPosition.rasterizer.y);
-		pixel[1] = math::float2((float)this->meshPosition.rasterizer.x + 1, (float)this->meshPosition.rasterizer.y);
-		pixel[2] = math::float2((float)this->meshPosition.rasterizer.x + 1, (float)this->meshPosition.rasterizer.y + 1);
-		pixel[3] = math::float2((float)this->meshPosition.rasterizer.x, (float)this->meshPosition.rasterizer.y + 1);
-
-		math::float2 res[16];
-		int count = convexClip(pixel, 4, this->meshPosition.triangle.uv, 3, res);
-		if (count > 0)
+		auto& patches = this->patches_[0];
+		auto& directLight = this->directLightBuffer_[0];
+
+		this->links_.clear();
+
+		float totalArea = 0;
+		float totalAlbedo = 0;
+		float totalPower = 0;
+
+		for (std::size_t i = 0; i < patches.size(); i++)
+		{
+			totalArea += patches.area[i];
+			totalAlbedo += luminance(patches.color[i]) * patches.area[i];
+			totalPower += luminance(directLight[patches.texelIndex[i]]) * patches.area[i];
+		}
+
+		if (totalPower <= 0 || totalArea <= 0)
+			return;
+
+		// Brightest patch of each cluster, raised by what later bounces are expected to add.
+		auto ambient = this->indirectBounces_ > 1 ? totalAlbedo / totalArea * totalPower / totalArea : 0.0f;
+
+		for (std::size_t i = this->clusters_.size(); i-- > 0;)
+		{
+			auto& cluster = this->clusters_[i];
+			if (cluster.count == 1)
+				cluster.brightness = luminance(directLight[patches.texelIndex[this->clusterPatches_[cluster.first]]]) + ambient;
+			else
+				cluster.brightness = std::max(this->clusters_[cluster.left].brightness, this->clusters_[cluster.left + 1].brightness);
+		}
+
+		auto contains = [](const Cluster& a, const Cluster& b)
+		{
+			return b.first >= a.first && b.first + b.count <= a.first + a.count;
+		};
+
+		// Upper bound of the cosine over a cluster, exact for flat ones.
+		auto cosine = [](const Cluster& cluster, const math::float3& direction)
+		{
+			return math::length2(cluster.normal) > 0.98f ? std::max(math::dot(cluster.normal, direction), 0.0f) : 1.0f;
+		};
+
+		struct Candidate
 		{
-			math::float2 centroid = res[0];
-			float rectArea = res[count - 1].x * res[0].y - res[count - 1].y * res[0].x;
-			for (int i = 1; i < count; i++)
+			std::uint32_t receiver;
+			std::uint32_t emitter;
+			float error;
+
+			bool operator<(const Candidate& other) const noexcept
 			{
-				centroid = centroid + res[i];
-				rectArea += res[i - 1].x * res[i].y - res[i - 1].y * res[i].x;
+				return error < other.error;
 			}
+		};
+
+		auto estimate = [&](std::uint32_t receiver, std::uint32_t emitter)
+		{
+			auto& r = this->clusters_[receiver];
+			auto& e = this->clusters_[emitter];
+
+			if (contains(r, e) || contains(e, r))
+				return Candidate{ receiver, emitter, std::numeric_limits<float>::infinity() };
+
+			auto L = e.position - r.position;
+			auto distance2 = math::length2(L);
+			auto distance = std::sqrt(distance2);
+
+			// Too close for the centers to stand for the whole clusters.
+			if (distance < r.radius + e.radius && (r.count > 1 || e.count > 1))
+				return Candidate{ receiver, emitter, std::numeric_limits<float>::infinity() };
+
+			L /= std::max(distance, 1e-12f);
 
-			if (std::abs(rectArea) > 0.0f)
+			// The larger of the two form factors bounds the error of the radiosity moved along the link.
+			auto factor = cosine(r, L) * cosine(e, -L) * std::max(r.area, e.area) / std::max(1.0f, distance2) / math::PI;
+			return Candidate{ receiver, emitter, factor * e.brightness };
+		};
+
+		auto epsilon = this->refineThreshold_ * totalPower / totalArea;
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(this->timeBudget_));
+		auto expired = false;
+
+		std::vector<Candidate> candidates;
+		std::vector<float> errors;
+
+		auto accept = [&](const Candidate& candidate)
+		{
+			auto& r = this->clusters_[candidate.receiver];
+			auto& e = this->clusters_[candidate.emitter];
+
+			auto L = e.position - r.position;
+			auto distance2 = math::length2(L);
+			L /= std::sqrt(distance2);
+
+			auto factor = std::max(math::dot(r.normal, L), 0.0f) * std::max(-math::dot(e.normal, L), 0.0f) * e.area / std::max(1.0f, distance2) / math::PI;
+			if (factor > 0.0f)
 			{
-				math::float2 uv = math::barycentric(this->meshPosition.triangle.uv[0], this->meshPosition.triangle.uv[1], this->meshPosition.triangle.uv[2], centroid / (float)count);
-				if (math::isfinite(uv))
-				{
-					auto& p0 = this->meshPosition.triangle.p[0];
-					auto& p1 = this->meshPosition.triangle.p[1];
-					auto& p2 = this->meshPosition.triangle.p[2];
+				this->links_.push_back(Link{ candidate.receiver, candidate.emitter, factor });
+				errors.push_back(candidate.error);
+			}
+		};
+
+		// Links that are good enough are taken at once, only the ones to refine wait in the heap.
+		auto consider = [&](const Candidate& candidate)
+		{
+			auto& r = this->clusters_[candidate.receiver];
+			auto& e = this->clusters_[candidate.emitter];
+
+			auto leaves = r.count == 1 && e.count == 1;
+			if (contains(r, e) || contains(e, r))
+			{
+				if (leaves)
+					return;
+			}
+			else if (candidate.error <= epsilon || leaves)
+			{
+				accept(candidate);
+				return;
+			}
+
+			candidates.push_back(candidate);
+			std::push_heap(candidates.begin(), candidates.end());
+		};
+
+		auto split = [&](std::uint32_t receiver, std::uint32_t emitter)
+		{
+			auto& r = this->clusters_[receiver];
+			auto& e = this->clusters_[emitter];
 
-					math::float3 v1 = p1 - p0;
-					math::float3 v2 = p2 - p0;
+			bool splitReceiver;
+			if (contains(r, e) || contains(e, r))
+				splitReceiver = contains(r, e);
+			else
+				splitReceiver = e.count == 1 || (r.count > 1 && r.area >= e.area);
+
+			for (std::uint32_t i = 0; i < 2; i++)
+			{
+				if (splitReceiver)
+					consider(estimate(r.left + i, emitter));
+				else
+					consider(estimate(receiver, e.left + i));
+			}
+		};
 
-					this->meshPosition.sample.position = p0 + (v2 * uv.x) + (v1 * uv.y);
-					this->meshPosition.sample.direction = math::normalize(math::cross(v1, v2));
+		auto bias = this->clusters_[0].radius * 1e-4f;
+		std::size_t checked = 0;
 
-					if (math::isfinite(this->meshPosition.sample.position) &&
-						math::isfinite(this->meshPosition.sample.direction) &&
-						math::length2(this->meshPosition.sample.direction) > 0.5f)
+		consider(Candidate{ 0, 0, std::numeric_limits<float>::infinity() });
+
+		while (!candidates.empty() || checked < this->links_.size())
+		{
+			// Refine the links carrying the most light first, once the time is up the rest are kept as they are.
+			for (std::size_t iteration = 0; !candidates.empty(); iteration++)
+			{
+				if (!expired && (iteration & 1023) == 0)
+					expired = std::chrono::steady_clock::now() > deadline;
+
+				std::pop_heap(candidates.begin(), candidates.end());
+				auto candidate = candidates.back();
+				candidates.pop_back();
+
+				auto& r = this->clusters_[candidate.receiver];
+				auto& e = this->clusters_[candidate.emitter];
+
+				if (expired && !contains(r, e) && !contains(e, r))
+					accept(candidate);
+				else
+					split(candidate.receiver, candidate.emitter);
+			}
+
+			auto numLinks = this->links_.size();
+			auto first = static_cast<std::int32_t>(checked);
+			auto last = static_cast<std::int32_t>(numLinks);
+
+			// Visibility between a few pairs of patches picked across the two clusters.
+#			pragma omp parallel for
+			for (std::int32_t i = first; i < last; ++i)
+			{
+				auto& link = this->links_[i];
+				auto& r = this->clusters_[link.receiver];
+				auto& e = this->clusters_[link.emitter];
+
+				std::uint32_t samples = (r.count == 1 && e.count == 1) ? 1 : VISIBILITY_SAMPLES;
+				std::uint32_t visible = 0;
+
+				for (std::uint32_t k = 0; k < samples; k++)
+				{
+					auto source = this->clusterPatches_[r.first + (2 * k + 1) * r.count / (2 * samples)];
+					auto dest = this->clusterPatches_[e.first + (2 * ((k + samples / 2) % samples) + 1) * e.count / (2 * samples)];
+
+					auto sourcePosition = patches.position(source);
+					auto sourceNormal = patches.normal(source);
+					auto destPosition = patches.position(dest);
+					auto destNormal = patches.normal(dest);
+
+					auto L = destPosition - sourcePosition;
+					auto distance = math::length(L);
+					if (distance <= bias * 4)
 					{
-						patch.texelIndex = this->meshPosition.rasterizer.y * (this->lightmap.width >> level) + this->meshPosition.rasterizer.x;
-						patch.area = this->meshPosition.triangle.areaP * rectArea / this->meshPosition.triangle.areaUV;
-						patch.v1 = this->meshPosition.triangle.p[0];
-						patch.v2 = this->meshPosition.triangle.p[1];
-						patch.v3 = this->meshPosition.triangle.p[2];
-						patch.position = this->meshPosition.sample.position;
-						patch.normal = this->meshPosition.sample.direction;
-						patch.color = this->meshPosition.triangle.color;
-						if (this->meshPosition.triangle.color.y > (this->meshPosition.triangle.color.x + this->meshPosition.triangle.color.z))
-							patch.emissive = this->meshPosition.triangle.color;
-						else
-							patch.emissive = math::float3::Zero;
-
-						return true;
+						visible++;
+						continue;
 					}
+
+					L /= distance;
+
+					auto origin = sourcePosition + sourceNormal * (math::dot(sourceNormal, L) < 0 ? -bias : bias);
+					auto target = destPosition + destNormal * (math::dot(destNormal, L) > 0 ? -bias : bias);
+
+					auto ray = target - origin;
+					auto length = math::length(ray);
+
+					if (!this->bvh_.occluded(origin, ray / length, length))
+						visible++;
+				}
+
+				link.factor *= float(visible) / samples;
+
+				// Partly hidden clusters are split again, so shadow edges end up between patches instead of spread over them.
+				if (visible > 0 && visible < samples && !expired && errors[i] > epsilon * SHADOW_REFINE_THRESHOLD)
+					link.factor = -1.0f;
+			}
+
+			for (auto i = checked; i < numLinks; i++)
+			{
+				if (this->links_[i].factor < 0.0f)
+				{
+					split(this->links_[i].receiver, this->links_[i].emitter);
+					this->links_[i].factor = 0.0f;
 				}
 			}
+
+			checked = numLinks;
 		}
 
-		return false;
+		this->links_.erase(std::remove_if(this->links_.begin(), this->links_.end(), [](const Link& link) { return link.factor <= 0.0f; }), this->links_.end());
+
+		std::sort(this->links_.begin(), this->links_.end(), [](const Link& a, const Link& b)
+		{
+			return a.receiver < b.receiver;
+		});
 	}
 
 	void
-	Lightmap::trySamplingConservativeTriangleRasterizerPatch(std::uint32_t level, const math::float3 &p1, const math::float3 &p2, const math::float3 &p3, const math::float2 &tc1, const math::float2 &tc2, const math::float2 &tc3, const math::float3 &n1, const math::float3 &n2, const math::float3 &n3, const math::float3& color) noexcept
+	Lightmap::setGeometry(const Geometry& geometry) noexcept
 	{
-		this->meshPosition.triangle.p[0] = p1;
-		this->meshPosition.triangle.p[1] = p2;
-		this->meshPosition.triangle.p[2] = p3;
-		this->meshPosition.triangle.areaP = math::surfaceArea(math::Triangle(p1, p2, p3)) * 0.5f;
-
-		auto scale = math::float2(float(this->lightmap.width >> level), float(this->lightmap.height >> level));
-		this->meshPosition.triangle.uv[0] = tc1 * scale;
-		this->meshPosition.triangle.uv[1] = tc2 * scale;
-		this->meshPosition.triangle.uv[2] = tc3 * scale;
-		this->meshPosition.triangle.areaUV = math::surfaceArea(math::Triangle(
-			math::float3(this->meshPosition.triangle.uv[0], 0),
-			math::float3(this->meshPosition.triangle.uv[1], 0),
-			math::float3(this->meshPosition.triangle.uv[2], 0))) * 0.5f;
-
-		math::Box2 box;
-		box.encapsulate(this->meshPosition.triangle.uv[0]);
-		box.encapsulate(this->meshPosition.triangle.uv[1]);
-		box.encapsulate(this->meshPosition.triangle.uv[2]);
-
-		this->meshPosition.triangle.color = color;
-
-		auto min = math::floor(box.min);
-		auto max = math::ceil(box.max);
-
-		this->meshPosition.rasterizer.minx = math::max(int(min.x) - 1, 0);
-		this->meshPosition.rasterizer.miny = math::max(int(min.y) - 1, 0);
-		this->meshPosition.rasterizer.maxx = math::min(int(max.x) + 1, this->lightmap.width >> level);
-		this->meshPosition.rasterizer.maxy = math::min(int(max.y) + 1, this->lightmap.height >> level);
-
-		this->meshPosition.rasterizer.x = this->meshPosition.rasterizer.minx;
-		this->meshPosition.rasterizer.y = this->meshPosition.rasterizer.miny;
-
-		if (this->meshPosition.rasterizer.x <= this->meshPosition.rasterizer.maxx &&
-			this->meshPosition.rasterizer.y <= this->meshPosition.rasterizer.maxy)
+		mesh_ = geometry.getMesh();
+
+		for (auto& patches : this->patches_)
+			patches.clear();
+
+		auto& vertices = mesh_->getVertexArray();
+		auto& texcoords = mesh_->getTexcoordArray(1);
+
+		if (!texcoords.empty())
 		{
-			while (!isConservativeTriangleRasterizerFinished())
+			std::vector<Triangle> triangles;
+
+			for (std::size_t i = 0; i < mesh_->getNumSubsets(); i++)
 			{
-				Patch patch;
+				math::float3 diffuse;
+				if (!geometry.getMaterial(i)->get("diffuse", diffuse))
+					continue;
+
+				auto& indices = mesh_->getIndicesArray(i);
 
-				if (trySamplingConservativeTriangleRasterizerPosition(level, patch))
+				for (std::size_t j = 0; j + 2 < indices.size(); j += 3)
 				{
-					if (!usedTexels[level][patch.texelIndex])
+					Triangle triangle;
+
+					for (std::size_t k = 0; k < 3; k++)
 					{
-						this->patches_[level].push_back(patch);
-						usedTexels[level][patch.texelIndex] = true;
+						triangle.p[k] = vertices[indices[j + k]];
+						triangle.uv[k] = texcoords[indices[j + k]];
 					}
+
+					triangle.color = diffuse;
+					triangles.push_back(triangle);
 				}
+			}
+
+			for (std::uint32_t level = 0; level < this->mipLevel_; level++)
+				this->rasterizePatches(level, triangles);
+		}
+
+		this->bvh_.build(*mesh_);
+		this->buildClusters();
+	}
+
+	void
+	Lightmap::rasterizePatches(std::uint32_t level, const std::vector<Triangle>& triangles) noexcept
+	{
+		auto width = static_cast<std::uint32_t>(this->lightmap.width >> level);
+		auto height = static_cast<std::uint32_t>(this->lightmap.height >> level);
+		auto scale = math::float2(float(width), float(height));
+
+		auto tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+		auto tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+		// Conservative texel bounds of every triangle, each one listed in the tiles it overlaps.
+		std::vector<math::int4> bounds(triangles.size());
+		std::vector<std::vector<std::uint32_t>> bins(tilesX * tilesY);
+
+		for (std::size_t i = 0; i < triangles.size(); i++)
+		{
+			math::Box2 box;
+			for (std::size_t k = 0; k < 3; k++)
+				box.encapsulate(triangles[i].uv[k] * scale);
+
+			auto min = math::floor(box.min);
+			auto max = math::ceil(box.max);
+
+			if (!math::isfinite(min) || !math::isfinite(max))
+				continue;
+
+			auto& rect = bounds[i];
+			rect.x = static_cast<std::int32_t>(std::clamp(min.x - 1.0f, 0.0f, float(width)));
+			rect.y = static_cast<std::int32_t>(std::clamp(min.y - 1.0f, 0.0f, float(height)));
+			rect.z = static_cast<std::int32_t>(std::clamp(max.x + 1.0f, 0.0f, float(width)));
+			rect.w = static_cast<std::int32_t>(std::clamp(max.y + 1.0f, 0.0f, float(height)));
 
-				moveToNextConservativeTriangleRasterizerPosition();
+			if (rect.x >= rect.z || rect.y >= rect.w)
+				continue;
+
+			for (std::uint32_t ty = rect.y / TILE_SIZE; ty <= (rect.w - 1) / TILE_SIZE; ty++)
+			{
+				for (std::uint32_t tx = rect.x / TILE_SIZE; tx <= (rect.z - 1) / TILE_SIZE; tx++)
+					bins[ty * tilesX + tx].push_back(static_cast<std::uint32_t>(i));
 			}
 		}
+
+		// Tiles own disjoint texels, so they are rasterized in parallel and joined back in tile order.
+		std::vector<Patches> tiles(bins.size());
+
+#		pragma omp parallel for schedule(dynamic)
+		for (std::int32_t tile = 0; tile < static_cast<std::int32_t>(bins.size()); ++tile)
+		{
+			auto tileX = (tile % tilesX) * TILE_SIZE;
+			auto tileY = (tile / tilesX) * TILE_SIZE;
+			auto tileW = std::min(TILE_SIZE, width - tileX);
+			auto tileH = std::min(TILE_SIZE, height - tileY);
+
+			auto& patches = tiles[tile];
+			std::vector<std::int32_t> used(tileW * tileH, -1);
+
+			for (auto index : bins[tile])
+			{
+				auto& triangle = triangles[index];
+				auto& rect = bounds[index];
+
+				math::float2 uv[3];
+				for (std::size_t k = 0; k < 3; k++)
+					uv[k] = triangle.uv[k] * scale;
+
+				auto areaP = math::surfaceArea(math::Triangle(triangle.p[0], triangle.p[1], triangle.p[2]));
+				auto areaUV = math::surfaceArea(math::Triangle(math::float3(uv[0], 0), math::float3(uv[1], 0), math::float3(uv[2], 0)));
+
+				auto v1 = triangle.p[1] - triangle.p[0];
+				auto v2 = triangle.p[2] - triangle.p[0];
+				auto normal = math::normalize(math::cross(v1, v2));
+
+				if (!math::isfinite(normal) || math::length2(normal) <= 0.5f || areaUV <= 0.0f)
+					continue;
+
+				auto emissive = triangle.color.y > (triangle.color.x + triangle.color.z) ? triangle.color : math::float3::Zero;
+
+				auto minx = std::max<std::uint32_t>(rect.x, tileX);
+				auto miny = std::max<std::uint32_t>(rect.y, tileY);
+				auto maxx = std::min<std::uint32_t>(rect.z, tileX + tileW);
+				auto maxy = std::min<std::uint32_t>(rect.w, tileY + tileH);
+
+				for (auto y = miny; y < maxy; y++)
+				{
+					for (auto x = minx; x < maxx; x++)
+					{
+						math::float2 pixel[16];
+						pixel[0] = math::float2((float)x, (float)y);
+						pixel[1] = math::float2((float)x + 1, (float)y);
+						pixel[2] = math::float2((float)x + 1, (float)y + 1);
+						pixel[3] = math::float2((float)x, (float)y + 1);
+
+						math::float2 res[16];
+						int count = convexClip(pixel, 4, uv, 3, res);
+						if (count <= 0)
+							continue;
+
+						math::float2 centroid = res[0];
+						float rectArea = res[count - 1].x * res[0].y - res[count - 1].y * res[0].x;
+						for (int i = 1; i < count; i++)
+						{
+							centroid = centroid + res[i];
+							rectArea += res[i - 1].x * res[i].y - res[i - 1].y * res[i].x;
+						}
+
+						rectArea = std::abs(rectArea) * 0.5f;
+						if (rectArea <= 0.0f)
+							continue;
+
+						auto area = areaP * rectArea / areaUV;
+
+						// A texel covered by several triangles keeps the first one's sample and the area of all of them.
+						auto& slot = used[(y - tileY) * tileW + (x - tileX)];
+						if (slot >= 0)
+						{
+							patches.area[slot] += area;
+							continue;
+						}
+
+						math::float2 st = math::barycentric(uv[0], uv[1], uv[2], centroid / (float)count);
+						if (!math::isfinite(st))
+							continue;
+
+						auto position = triangle.p[0] + (v2 * st.x) + (v1 * st.y);
+						if (!math::isfinite(position))
+							continue;
+
+						slot = static_cast<std::int32_t>(patches.size());
+
+						patches.texelIndex.push_back(y * width + x);
+						patches.area.push_back(area);
+						patches.positionX.push_back(position.x);
+						patches.positionY.push_back(position.y);
+						patches.positionZ.push_back(position.z);
+						patches.normalX.push_back(normal.x);
+						patches.normalY.push_back(normal.y);
+						patches.normalZ.push_back(normal.z);
+						patches.color.push_back(triangle.color);
+						patches.emissive.push_back(emissive);
+					}
+				}
+			}
+		}
+
+		auto& patches = this->patches_[level];
+		patches.clear();
+
+		for (auto& tile : tiles)
+			patches.append(tile);
 	}
-}
\ No newline at end of file
+}
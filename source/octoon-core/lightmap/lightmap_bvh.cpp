@@ -0,0 +1,434 @@
+#include <octoon/lightmap/lightmap_bvh.h>
+#include <octoon/math/simd.h>
+#include <algorithm>
+#include <limits>
+
+namespace octoon::bake
+{
+	namespace
+	{
+		float halfArea(const math::float3& min, const math::float3& max) noexcept
+		{
+			auto d = max - min;
+			return d.x * d.y + d.y * d.z + d.z * d.x;
+		}
+	}
+
+	LightmapBVH::LightmapBVH() noexcept
+	{
+	}
+
+	LightmapBVH::~LightmapBVH() noexcept
+	{
+	}
+
+	void
+	LightmapBVH::build(const Mesh& mesh) noexcept
+	{
+		this->clear();
+
+		auto& vertices = mesh.getVertexArray();
+
+		std::vector<math::float3> corners;
+		if (mesh.getNumSubsets() == 0)
+		{
+			corners.assign(vertices.begin(), vertices.begin() + vertices.size() / 3 * 3);
+		}
+		else
+		{
+			for (std::size_t i = 0; i < mesh.getNumSubsets(); i++)
+			{
+				auto& indices = mesh.getIndicesArray(i);
+				for (std::size_t j = 0; j + 2 < indices.size(); j += 3)
+				{
+					corners.push_back(vertices[indices[j]]);
+					corners.push_back(vertices[indices[j + 1]]);
+					corners.push_back(vertices[indices[j + 2]]);
+				}
+			}
+		}
+
+		auto numTriangles = corners.size() / 3;
+		if (numTriangles == 0)
+			return;
+
+		std::vector<math::float3> boundsMin(numTriangles);
+		std::vector<math::float3> boundsMax(numTriangles);
+		std::vector<math::float3> centers(numTriangles);
+		std::vector<std::uint32_t> order(numTriangles);
+
+		for (std::size_t i = 0; i < numTriangles; i++)
+		{
+			auto& a = corners[i * 3];
+			auto& b = corners[i * 3 + 1];
+			auto& c = corners[i * 3 + 2];
+
+			boundsMin[i] = math::min(a, math::min(b, c));
+			boundsMax[i] = math::max(a, math::max(b, c));
+			centers[i] = (boundsMin[i] + boundsMax[i]) * 0.5f;
+			order[i] = static_cast<std::uint32_t>(i);
+		}
+
+		struct Task
+		{
+			std::uint32_t begin;
+			std::uint32_t end;
+			std::uint32_t parent; // inner node whose second child this is, or ~0
+			std::uint32_t depth;
+		};
+
+		std::vector<Task> tasks;
+		tasks.push_back(Task{ 0, static_cast<std::uint32_t>(numTriangles), ~0u, 0 });
+
+		this->nodes_.reserve(numTriangles * 2 / MAX_LEAF_TRIANGLES + 1);
+
+		// Depth first, so the first child of a node is always the one stored right after it.
+		while (!tasks.empty())
+		{
+			auto task = tasks.back();
+			tasks.pop_back();
+
+			auto index = static_cast<std::uint32_t>(this->nodes_.size());
+			if (task.parent != ~0u)
+				this->nodes_[task.parent].offset = index;
+
+			Node node;
+			node.min = math::float3(std::numeric_limits<float>::max());
+			node.max = math::float3(-std::numeric_limits<float>::max());
+
+			auto centerMin = node.min;
+			auto centerMax = node.max;
+
+			for (auto i = task.begin; i < task.end; i++)
+			{
+				node.min = math::min(node.min, boundsMin[order[i]]);
+				node.max = math::max(node.max, boundsMax[order[i]]);
+				centerMin = math::min(centerMin, centers[order[i]]);
+				centerMax = math::max(centerMax, centers[order[i]]);
+			}
+
+			auto count = task.end - task.begin;
+			auto mid = task.begin;
+
+			if (count > MAX_LEAF_TRIANGLES && task.depth < MAX_DEPTH)
+			{
+				float bestCost = std::numeric_limits<float>::max();
+				std::uint8_t bestAxis = 0;
+				std::uint32_t bestSplit = 0;
+
+				for (std::uint8_t axis = 0; axis < 3; axis++)
+				{
+					auto extent = centerMax[axis] - centerMin[axis];
+					if (extent <= 0.0f)
+						continue;
+
+					math::float3 binMin[NUM_BINS];
+					math::float3 binMax[NUM_BINS];
+					std::uint32_t binCount[NUM_BINS] = {};
+
+					for (std::uint32_t b = 0; b < NUM_BINS; b++)
+					{
+						binMin[b] = math::float3(std::numeric_limits<float>::max());
+						binMax[b] = math::float3(-std::numeric_limits<float>::max());
+					}
+
+					auto scale = NUM_BINS / extent;
+					for (auto i = task.begin; i < task.end; i++)
+					{
+						auto t = order[i];
+						auto b = std::min(static_cast<std::uint32_t>((centers[t][axis] - centerMin[axis]) * scale), NUM_BINS - 1);
+						binMin[b] = math::min(binMin[b], boundsMin[t]);
+						binMax[b] = math::max(binMax[b], boundsMax[t]);
+						binCount[b]++;
+					}
+
+					float rightArea[NUM_BINS];
+					std::uint32_t rightCount[NUM_BINS];
+
+					auto accumMin = math::float3(std::numeric_limits<float>::max());
+					auto accumMax = math::float3(-std::numeric_limits<float>::max());
+					std::uint32_t accumCount = 0;
+
+					for (auto b = NUM_BINS - 1; b > 0; b--)
+					{
+						accumMin = math::min(accumMin, binMin[b]);
+						accumMax = math::max(accumMax, binMax[b]);
+						accumCount += binCount[b];
+						rightArea[b] = accumCount ? halfArea(accumMin, accumMax) : 0.0f;
+						rightCount[b] = accumCount;
+					}
+
+					accumMin = math::float3(std::numeric_limits<float>::max());
+					accumMax = math::float3(-std::numeric_limits<float>::max());
+					accumCount = 0;
+
+					for (std::uint32_t b = 0; b < NUM_BINS - 1; b++)
+					{
+						accumMin = math::min(accumMin, binMin[b]);
+						accumMax = math::max(accumMax, binMax[b]);
+						accumCount += binCount[b];
+
+						if (accumCount == 0 || rightCount[b + 1] == 0)
+							continue;
+
+						auto cost = halfArea(accumMin, accumMax) * accumCount + rightArea[b + 1] * rightCount[b + 1];
+						if (cost < bestCost)
+						{
+							bestCost = cost;
+							bestAxis = axis;
+							bestSplit = b + 1;
+						}
+					}
+				}
+
+				if (bestSplit > 0)
+				{
+					auto extent = centerMax[bestAxis] - centerMin[bestAxis];
+					auto scale = NUM_BINS / extent;
+
+					auto it = std::partition(order.begin() + task.begin, order.begin() + task.end, [&](std::uint32_t t)
+					{
+						return std::min(static_cast<std::uint32_t>((centers[t][bestAxis] - centerMin[bestAxis]) * scale), NUM_BINS - 1) < bestSplit;
+					});
+
+					mid = static_cast<std::uint32_t>(it - order.begin());
+				}
+				else
+				{
+					// Every center is at the same place, any split is as good as another.
+					mid = task.begin + count / 2;
+				}
+			}
+
+			if (mid == task.begin || mid == task.end)
+			{
+				node.offset = static_cast<std::uint32_t>(this->triangles_.size());
+				node.count = count;
+
+				for (auto i = task.begin; i < task.end; i++)
+				{
+					auto t = order[i] * 3;
+					this->triangles_.push_back(Triangle{ corners[t], corners[t + 1] - corners[t], corners[t + 2] - corners[t] });
+				}
+
+				this->nodes_.push_back(node);
+			}
+			else
+			{
+				node.offset = 0;
+				node.count = 0;
+
+				this->nodes_.push_back(node);
+
+				tasks.push_back(Task{ mid, task.end, index, task.depth + 1 });
+				tasks.push_back(Task{ task.begin, mid, ~0u, task.depth + 1 });
+			}
+		}
+	}
+
+	void
+	LightmapBVH::clear() noexcept
+	{
+		this->nodes_.clear();
+		this->triangles_.clear();
+	}
+
+	bool
+	LightmapBVH::empty() const noexcept
+	{
+		return this->nodes_.empty();
+	}
+
+	std::size_t
+	LightmapBVH::getNumTriangles() const noexcept
+	{
+		return this->triangles_.size();
+	}
+
+	bool
+	LightmapBVH::occluded(const math::float3& origin, const math::float3& direction, float maxDistance) const noexcept
+	{
+		if (this->nodes_.empty() || !(maxDistance > 0.0f))
+			return false;
+
+		math::float3 invDirection;
+		for (std::uint8_t i = 0; i < 3; i++)
+			invDirection[i] = direction[i] != 0.0f ? 1.0f / direction[i] : std::numeric_limits<float>::max();
+
+		std::uint32_t stack[MAX_DEPTH];
+		std::uint32_t depth = 0;
+		std::uint32_t index = 0;
+
+		for (;;)
+		{
+			auto& node = this->nodes_[index];
+
+			auto t1 = (node.min - origin) * invDirection;
+			auto t2 = (node.max - origin) * invDirection;
+			auto tmin = math::min(t1, t2);
+			auto tmax = math::max(t1, t2);
+
+			auto enter = std::max(std::max(tmin.x, tmin.y), std::max(tmin.z, 0.0f));
+			auto exit = std::min(std::min(tmax.x, tmax.y), std::min(tmax.z, maxDistance));
+
+			if (enter <= exit)
+			{
+				if (node.count == 0)
+				{
+					stack[depth++] = node.offset;
+					index++;
+					continue;
+				}
+
+				for (std::uint32_t i = 0; i < node.count; i++)
+				{
+					// Moller-Trumbore, accepting hits on either side of the triangle.
+					auto& triangle = this->triangles_[node.offset + i];
+
+					auto p = math::cross(direction, triangle.e2);
+					auto det = math::dot(triangle.e1, p);
+					if (std::abs(det) < 1e-12f)
+						continue;
+
+					auto invDet = 1.0f / det;
+					auto s = origin - triangle.v0;
+					auto u = math::dot(s, p) * invDet;
+					if (u < 0.0f || u > 1.0f)
+						continue;
+
+					auto q = math::cross(s, triangle.e1);
+					auto v = math::dot(direction, q) * invDet;
+					if (v < 0.0f || u + v > 1.0f)
+						continue;
+
+					auto t = math::dot(triangle.e2, q) * invDet;
+					if (t > 0.0f && t < maxDistance)
+						return true;
+				}
+			}
+
+			if (depth == 0)
+				break;
+
+			index = stack[--depth];
+		}
+
+		return false;
+	}
+
+	std::uint32_t
+	LightmapBVH::occluded4(const float originX[4], const float originY[4], const float originZ[4], const math::float3& direction, float maxDistance, std::uint32_t mask) const noexcept
+	{
+		if (this->nodes_.empty() || !(maxDistance > 0.0f))
+			return 0;
+
+#if defined(OCTOON_MATH_SIMD)
+		math::float3 invDirection;
+		for (std::uint8_t i = 0; i < 3; i++)
+			invDirection[i] = direction[i] != 0.0f ? 1.0f / direction[i] : std::numeric_limits<float>::max();
+
+		const __m128 ox = _mm_loadu_ps(originX);
+		const __m128 oy = _mm_loadu_ps(originY);
+		const __m128 oz = _mm_loadu_ps(originZ);
+
+		const __m128 idx = _mm_set1_ps(invDirection.x);
+		const __m128 idy = _mm_set1_ps(invDirection.y);
+		const __m128 idz = _mm_set1_ps(invDirection.z);
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 maxT = _mm_set1_ps(maxDistance);
+
+		std::uint32_t active = mask & 0xF;
+		std::uint32_t blocked = 0;
+
+		std::uint32_t stack[MAX_DEPTH];
+		std::uint32_t depth = 0;
+		std::uint32_t index = 0;
+
+		for (;;)
+		{
+			auto& node = this->nodes_[index];
+
+			__m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.x), ox), idx);
+			__m128 tx2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.x), ox), idx);
+			__m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.y), oy), idy);
+			__m128 ty2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.y), oy), idy);
+			__m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min.z), oz), idz);
+			__m128 tz2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max.z), oz), idz);
+
+			__m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)), _mm_max_ps(_mm_min_ps(tz1, tz2), zero));
+			__m128 exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)), _mm_min_ps(_mm_max_ps(tz1, tz2), maxT));
+
+			if (static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(enter, exit))) & active)
+			{
+				if (node.count == 0)
+				{
+					stack[depth++] = node.offset;
+					index++;
+					continue;
+				}
+
+				for (std::uint32_t i = 0; i < node.count && active; i++)
+				{
+					// The edge terms that only depend on the direction are the same for every lane.
+					auto& triangle = this->triangles_[node.offset + i];
+
+					auto p = math::cross(direction, triangle.e2);
+					auto det = math::dot(triangle.e1, p);
+					if (std::abs(det) < 1e-12f)
+						continue;
+
+					__m128 invDet = _mm_set1_ps(1.0f / det);
+
+					__m128 sx = _mm_sub_ps(ox, _mm_set1_ps(triangle.v0.x));
+					__m128 sy = _mm_sub_ps(oy, _mm_set1_ps(triangle.v0.y));
+					__m128 sz = _mm_sub_ps(oz, _mm_set1_ps(triangle.v0.z));
+
+					__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, _mm_set1_ps(p.x)), _mm_mul_ps(sy, _mm_set1_ps(p.y))), _mm_mul_ps(sz, _mm_set1_ps(p.z))), invDet);
+
+					// q = s x e1
+					__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, _mm_set1_ps(triangle.e1.z)), _mm_mul_ps(sz, _mm_set1_ps(triangle.e1.y)));
+					__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, _mm_set1_ps(triangle.e1.x)), _mm_mul_ps(sx, _mm_set1_ps(triangle.e1.z)));
+					__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, _mm_set1_ps(triangle.e1.y)), _mm_mul_ps(sy, _mm_set1_ps(triangle.e1.x)));
+
+					__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, _mm_set1_ps(direction.x)), _mm_mul_ps(qy, _mm_set1_ps(direction.y))), _mm_mul_ps(qz, _mm_set1_ps(direction.z))), invDet);
+					__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, _mm_set1_ps(triangle.e2.x)), _mm_mul_ps(qy, _mm_set1_ps(triangle.e2.y))), _mm_mul_ps(qz, _mm_set1_ps(triangle.e2.z))), invDet);
+
+					__m128 hit = _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one));
+					hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+					hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+					hit = _mm_and_ps(hit, _mm_cmpgt_ps(t, zero));
+					hit = _mm_and_ps(hit, _mm_cmplt_ps(t, maxT));
+
+					auto lanes = static_cast<std::uint32_t>(_mm_movemask_ps(hit)) & active;
+					blocked |= lanes;
+					active &= ~lanes;
+				}
+
+				if (!active)
+					break;
+			}
+
+			if (depth == 0)
+				break;
+
+			index = stack[--depth];
+		}
+
+		return blocked;
+#else
+		std::uint32_t blocked = 0;
+		for (std::uint32_t i = 0; i < 4; i++)
+		{
+			if (mask & (1u << i))
+			{
+				if (this->occluded(math::float3(originX[i], originY[i], originZ[i]), direction, maxDistance))
+					blocked |= 1u << i;
+			}
+		}
+
+		return blocked;
+#endif
+	}
+}
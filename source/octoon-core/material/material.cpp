@@ -1,4 +1,5 @@
 #include <octoon/material/material.h>
+#include <octoon/video/render_journal.h>
 #include <octoon/hal/graphics_texture.h>
 #include <functional>
 
@@ -43,6 +44,7 @@ namespace octoon
 		, _stencilBackZFail(hal::GraphicsStencilOp::Keep)
 		, _stencilBackPass(hal::GraphicsStencilOp::Keep)
 		, dirty_(true)
+		, generation_(0)
 	{
 	}
 
@@ -60,6 +62,8 @@ namespace octoon
 
 	Material::~Material() noexcept
 	{
+		RenderJournal::erase(this, generation_);
+
 		for (auto& it : _properties)
 		{
 			if (it.data)
@@ -516,6 +520,9 @@ namespace octoon
 	void
 	Material::setDirty(bool dirty) noexcept
 	{
+		if (dirty)
+			this->generation_ = RenderJournal::record(this, this->generation_);
+
 		this->dirty_ = dirty;
 	}
 
@@ -525,6 +532,12 @@ namespace octoon
 		return this->dirty_;
 	}
 
+	std::uint64_t
+	Material::getGeneration() const noexcept
+	{
+		return this->generation_;
+	}
+
 	const std::vector<MaterialParam>&
 	Material::getMaterialParams() const noexcept
 	{
@@ -0,0 +1,157 @@
+#include <octoon/math/simd.h>
+
+namespace octoon
+{
+	namespace math
+	{
+		namespace simd
+		{
+#if defined(OCTOON_MATH_SIMD)
+			namespace
+			{
+				// Four packed float3 (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) to one register per component.
+				inline void
+				load4(const float3* in, __m128& x, __m128& y, __m128& z) noexcept
+				{
+					auto p = in->ptr();
+					__m128 p0 = _mm_loadu_ps(p + 0);
+					__m128 p1 = _mm_loadu_ps(p + 4);
+					__m128 p2 = _mm_loadu_ps(p + 8);
+
+					x = _mm_shuffle_ps(_mm_shuffle_ps(p0, p0, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+					y = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+					z = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+				}
+
+				inline void
+				store4(float3* out, __m128 x, __m128 y, __m128 z) noexcept
+				{
+					__m128 lo = _mm_unpacklo_ps(x, y);
+					__m128 hi = _mm_unpackhi_ps(x, y);
+
+					auto p = out->ptr();
+					_mm_storeu_ps(p + 0, _mm_shuffle_ps(lo, _mm_shuffle_ps(z, lo, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+					_mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(lo, z, _MM_SHUFFLE(1, 1, 3, 3)), hi, _MM_SHUFFLE(1, 0, 2, 0)));
+					_mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, hi, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(hi, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+				}
+
+				inline __m128
+				dot3(const float* m, __m128 x, __m128 y, __m128 z) noexcept
+				{
+					__m128 r = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[0])), _mm_mul_ps(y, _mm_set1_ps(m[4])));
+					return _mm_add_ps(r, _mm_mul_ps(z, _mm_set1_ps(m[8])));
+				}
+			}
+
+			void
+			transformPoints(const float4x4& m, const float3* in, float3* out, std::size_t count) noexcept
+			{
+				auto p = m.ptr();
+				const __m128 one = _mm_set1_ps(1.0f);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128 x, y, z;
+					load4(in + i, x, y, z);
+
+					__m128 w = _mm_div_ps(one, _mm_add_ps(dot3(p + 3, x, y, z), _mm_set1_ps(p[15])));
+					__m128 rx = _mm_mul_ps(_mm_add_ps(dot3(p + 0, x, y, z), _mm_set1_ps(p[12])), w);
+					__m128 ry = _mm_mul_ps(_mm_add_ps(dot3(p + 1, x, y, z), _mm_set1_ps(p[13])), w);
+					__m128 rz = _mm_mul_ps(_mm_add_ps(dot3(p + 2, x, y, z), _mm_set1_ps(p[14])), w);
+
+					store4(out + i, rx, ry, rz);
+				}
+
+				for (; i < count; i++)
+					out[i] = transformPoint(m, in[i]);
+			}
+
+			void
+			transformNormals(const float4x4& m, const float3* in, float3* out, std::size_t count) noexcept
+			{
+				auto p = m.ptr();
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128 x, y, z;
+					load4(in + i, x, y, z);
+					store4(out + i, dot3(p + 0, x, y, z), dot3(p + 1, x, y, z), dot3(p + 2, x, y, z));
+				}
+
+				for (; i < count; i++)
+					out[i] = transformNormal(m, in[i]);
+			}
+
+			void
+			rotate(const Quaternion& q, const float3* in, float3* out, std::size_t count) noexcept
+			{
+				const __m128 qx = _mm_set1_ps(q.x);
+				const __m128 qy = _mm_set1_ps(q.y);
+				const __m128 qz = _mm_set1_ps(q.z);
+				const __m128 qw = _mm_set1_ps(q.w);
+				const __m128 w2 = _mm_set1_ps(q.w * q.w - 0.5f);
+
+				std::size_t i = 0;
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128 x, y, z;
+					load4(in + i, x, y, z);
+
+					x = _mm_add_ps(x, x);
+					y = _mm_add_ps(y, y);
+					z = _mm_add_ps(z, z);
+
+					__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, x), _mm_mul_ps(qy, y)), _mm_mul_ps(qz, z));
+
+					__m128 rx = _mm_add_ps(_mm_mul_ps(x, w2), _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)), qw));
+					__m128 ry = _mm_add_ps(_mm_mul_ps(y, w2), _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)), qw));
+					__m128 rz = _mm_add_ps(_mm_mul_ps(z, w2), _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)), qw));
+
+					store4(out + i, _mm_add_ps(rx, _mm_mul_ps(qx, dot)), _mm_add_ps(ry, _mm_mul_ps(qy, dot)), _mm_add_ps(rz, _mm_mul_ps(qz, dot)));
+				}
+
+				for (; i < count; i++)
+					out[i] = rotate(q, in[i]);
+			}
+#else
+			void
+			transformPoints(const float4x4& m, const float3* in, float3* out, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; i++)
+					out[i] = m * in[i];
+			}
+
+			void
+			transformNormals(const float4x4& m, const float3* in, float3* out, std::size_t count) noexcept
+			{
+				auto normalMatrix = (float3x3)m;
+				for (std::size_t i = 0; i < count; i++)
+					out[i] = normalMatrix * in[i];
+			}
+
+			void
+			rotate(const Quaternion& q, const float3* in, float3* out, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; i++)
+					out[i] = math::rotate(q, in[i]);
+			}
+#endif
+
+			void
+			multiply(const float4x4* m1, const float4x4* m2, float4x4* out, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; i++)
+					out[i] = multiply(m1[i], m2[i]);
+			}
+
+			void
+			transformMultiply(const float4x4* m1, const float4x4* m2, float4x4* out, std::size_t count) noexcept
+			{
+				for (std::size_t i = 0; i < count; i++)
+					out[i] = transformMultiply(m1[i], m2[i]);
+			}
+		}
+	}
+}
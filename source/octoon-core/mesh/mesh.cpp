@@ -1,8 +1,11 @@
 #include <octoon/mesh/mesh.h>
+#include <octoon/math/simd.h>
+#include <octoon/video/render_journal.h>
 #include <octoon/lightmap/lightmap_pack.h>
 
 #include <map>
 #include <cstring>
+#include <algorithm>
 
 using namespace octoon::math;
 
@@ -12,11 +15,13 @@ namespace octoon
 
 	Mesh::Mesh() noexcept
 		: _dirty(true)
+		, _generation(0)
 	{
 	}
 
 	Mesh::~Mesh() noexcept
 	{
+		RenderJournal::erase(this, _generation);
 	}
 
 	void
@@ -279,6 +284,9 @@ namespace octoon
 	void
 	Mesh::setDirty(bool dirty) noexcept
 	{
+		if (dirty)
+			this->_generation = RenderJournal::record(this, this->_generation);
+
 		this->_dirty = dirty;
 	}
 
@@ -288,6 +296,12 @@ namespace octoon
 		return this->_dirty;
 	}
 
+	std::uint64_t
+	Mesh::getGeneration() const noexcept
+	{
+		return this->_generation;
+	}
+
 	bool
 	Mesh::raycast(const math::Raycast& ray, MeshHit& hit) noexcept
 	{
@@ -460,91 +474,128 @@ namespace octoon
 	bool
 	Mesh::mergeMeshes(const CombineMesh instances[], std::size_t numInstance, bool merge) noexcept
 	{
-		this->clear();
+		std::size_t numVertices = 0;
+		std::size_t numSubsets = 0;
 
-		std::size_t maxIndices = 0;
-		std::size_t maxVertices = 0;
-
-		bool hasVertices = false;
 		bool hasNormal = false;
+		bool hasColor = false;
 		bool hasTangent = false;
 		bool hasTexcoord[TEXTURE_ARRAY_COUNT] = { false };
-		bool hasIndices = false;
 		bool hasWeight = false;
 
 		for (std::size_t i = 0; i < numInstance; i++)
 		{
-			auto mesh = instances[i].getMesh();
+			auto& mesh = instances[i].getMesh();
 			if (!mesh)
 				continue;
 
-			maxVertices += mesh->getNumVertices();
+			numVertices += mesh->getNumVertices();
+			numSubsets += mesh->getNumSubsets();
 
-			hasVertices |= !mesh->getVertexArray().empty();
-			hasNormal |= !mesh->getNormalArray().empty();
-			hasTangent |= !mesh->getTangentArray().empty();
-			hasIndices |= !mesh->getIndicesArray().empty();
-			hasWeight |= !mesh->getWeightArray().empty();
+			hasNormal |= !mesh->_normals.empty();
+			hasColor |= !mesh->_colors.empty();
+			hasTangent |= !mesh->_tangents.empty();
+			hasWeight |= !mesh->_weights.empty();
 
 			for (std::uint8_t j = 0; j < TEXTURE_ARRAY_COUNT; j++)
-				hasTexcoord[j] |= !mesh->getTexcoordArray().empty();
+				hasTexcoord[j] |= !mesh->_texcoords[j].empty();
 		}
 
+		// Every mesh needs the attributes any of them has, or the merged arrays would not line up.
 		for (std::size_t i = 0; i < numInstance; i++)
 		{
-			auto mesh = instances[i].getMesh();
+			auto& mesh = instances[i].getMesh();
 			if (!mesh)
 				continue;
 
-			if (hasVertices) if (mesh->getVertexArray().empty()) return false;
-			if (hasNormal)  if (mesh->getNormalArray().empty()) return false;
-			if (hasTangent) if (mesh->getTangentArray().empty()) return false;
-			if (hasIndices) if (mesh->getIndicesArray().empty()) return false;
-			if (hasWeight) if (mesh->getWeightArray().empty()) return false;
+			auto count = mesh->getNumVertices();
+			if (hasNormal && mesh->_normals.size() != count) return false;
+			if (hasColor && mesh->_colors.size() != count) return false;
+			if (hasTangent && mesh->_tangents.size() != count) return false;
+			if (hasWeight && mesh->_weights.size() != count) return false;
 
 			for (std::uint8_t j = 0; j < TEXTURE_ARRAY_COUNT; j++)
 			{
-				if (hasTexcoord[j])
-				{
-					if (mesh->getTexcoordArray(j).empty())
-						return false;
-				}
+				if (hasTexcoord[j] && mesh->_texcoords[j].size() != count)
+					return false;
 			}
 		}
 
-		if (hasVertices) this->_vertices.resize(maxVertices);
-		if (hasNormal)   this->_normals.resize(maxVertices);
-		if (hasTangent)  this->_tangents.resize(maxVertices);
-		if (hasWeight)   this->_weights.resize(maxVertices);
-		if (hasIndices)  this->_indices.resize(maxIndices);
+		_vertices.resize(numVertices);
+		_normals.resize(hasNormal ? numVertices : 0);
+		_colors.resize(hasColor ? numVertices : 0);
+		_tangents.resize(hasTangent ? numVertices : 0);
+		_weights.resize(hasWeight ? numVertices : 0);
+		_bindposes.clear();
+		_bones.clear();
 
 		for (std::uint8_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
-		{
-			if (hasTexcoord[i])
-				this->_texcoords[i].resize(maxVertices);
-		}
+			_texcoords[i].resize(hasTexcoord[i] ? numVertices : 0);
+
+		_indices.clear();
+		_indices.resize(merge ? std::min<std::size_t>(numSubsets, 1) : numSubsets);
+		_boundingBoxs.clear();
 
 		std::size_t offsetVertices = 0;
+		std::size_t offsetSubsets = 0;
 
 		for (std::size_t i = 0; i < numInstance; i++)
 		{
-			auto mesh = instances[i].getMesh();
+			auto& mesh = instances[i].getMesh();
 			if (!mesh)
 				continue;
 
-			if (hasVertices) std::memcpy(&_vertices[offsetVertices], mesh->_vertices.data(), mesh->_vertices.size());
-			if (hasNormal)   std::memcpy(&_normals[offsetVertices], mesh->_normals.data(), mesh->_normals.size());
-			if (hasTangent)  std::memcpy(&_tangents[offsetVertices], mesh->_tangents.data(), mesh->_tangents.size());
-			if (hasWeight)   std::memcpy(&_weights[offsetVertices], mesh->_weights.data(), mesh->_weights.size());
-			if (hasIndices)  std::memcpy(&_indices[offsetVertices], mesh->_indices.data(), mesh->_indices.size());
+			auto& transform = instances[i].getTransform();
+			auto count = mesh->getNumVertices();
+
+			simd::transformPoints(transform, mesh->_vertices.data(), _vertices.data() + offsetVertices, count);
+
+			if (hasNormal)
+			{
+				simd::transformNormals(transform, mesh->_normals.data(), _normals.data() + offsetVertices, count);
+				for (std::size_t j = offsetVertices; j < offsetVertices + count; j++)
+					_normals[j] = math::normalize(_normals[j]);
+			}
+
+			if (hasTangent)
+			{
+				auto normalMatrix = (float3x3)transform;
+				for (std::size_t j = 0; j < count; j++)
+				{
+					auto& tangent = mesh->_tangents[j];
+					_tangents[offsetVertices + j] = float4(math::normalize(normalMatrix * tangent.xyz()), tangent.w);
+				}
+			}
+
+			if (hasColor) std::copy(mesh->_colors.begin(), mesh->_colors.end(), _colors.begin() + offsetVertices);
+			if (hasWeight) std::copy(mesh->_weights.begin(), mesh->_weights.end(), _weights.begin() + offsetVertices);
 
 			for (std::uint8_t j = 0; j < TEXTURE_ARRAY_COUNT; j++)
 			{
 				if (hasTexcoord[j])
-					std::memcpy(&_texcoords[j][offsetVertices], mesh->_texcoords[j].data(), mesh->_texcoords[j].size());
+					std::copy(mesh->_texcoords[j].begin(), mesh->_texcoords[j].end(), _texcoords[j].begin() + offsetVertices);
+			}
+
+			// A mirroring transform turns the triangles inside out, swapping two corners restores the winding.
+			auto mirrored = math::determinant((float3x3)transform) < 0.0f;
+
+			for (auto& subset : mesh->_indices)
+			{
+				auto& indices = _indices[merge ? 0 : offsetSubsets++];
+				auto first = indices.size();
+
+				indices.resize(first + subset.size());
+				for (std::size_t j = 0; j < subset.size(); j++)
+					indices[first + j] = subset[j] + static_cast<std::uint32_t>(offsetVertices);
+
+				if (mirrored)
+				{
+					for (std::size_t j = first; j + 2 < indices.size(); j += 3)
+						std::swap(indices[j + 1], indices[j + 2]);
+				}
 			}
 
-			offsetVertices += mesh->getNumVertices();
+			offsetVertices += count;
 		}
 
 		this->computeBoundingBox();
@@ -922,7 +973,7 @@ namespace octoon
 	Mesh::computeBoundingBox() noexcept
 	{
 		_boundingBox.reset();
-		_boundingBoxs.resize(_indices.size());
+		_boundingBoxs.assign(_indices.size(), math::BoundingBox::Empty);
 
 		if (_indices.empty())
 		{
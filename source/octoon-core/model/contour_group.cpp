@@ -166,8 +166,8 @@ namespace octoon
 
 		for (auto& group : groups)
 		{
-			mesh.mergeMeshes(makeMesh(group->getContours(), thickness));
-			if (!hollow) mesh.mergeMeshes(ShapeMesh(group->getContours(), thickness));
+			mesh.mergeMeshes(makeMesh(group->getContours(), thickness), true);
+			if (!hollow) mesh.mergeMeshes(ShapeMesh(group->getContours(), thickness), true);
 		}
 		return mesh;
 	}
@@ -0,0 +1,419 @@
+#include <octoon/model/glyph_cache.h>
+#include <octoon/model/contour.h>
+#include <octoon/model/path.h>
+#include <octoon/runtime/except.h>
+
+#include <ft2build.h>
+#include <freetype/ftglyph.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace octoon::font
+{
+	namespace
+	{
+		void addEdges(Path& path, const math::float3* contour, const char* tags, std::size_t n) noexcept
+		{
+			math::float3 prev;
+			math::float3 cur = contour[(n - 1) % n];
+			math::float3 next = contour[0];
+
+			for (std::size_t i = 0; i < n; i++)
+			{
+				prev = cur;
+				cur = next;
+				next = contour[(i + 1) % n];
+
+				switch (FT_CURVE_TAG(tags[i]))
+				{
+				case FT_Curve_Tag_On:
+					path.addEdge(cur);
+					break;
+				case FT_Curve_Tag_Cubic:
+					path.addEdge(prev, cur, next, contour[(i + 2) % n]);
+					break;
+				case FT_Curve_Tag_Conic:
+				{
+					math::float3 prev2 = prev, next2 = next;
+
+					if (FT_CURVE_TAG(tags[(i + 1) % n]) == FT_Curve_Tag_Conic)
+						next2 = (cur + next) * 0.5f;
+
+					if (FT_CURVE_TAG(tags[(i - 1 + n) % n]) == FT_Curve_Tag_Conic)
+						prev2 = (cur + prev) * 0.5f;
+
+					path.addEdge(prev2, cur, next2);
+				}
+				break;
+				}
+			}
+		}
+
+		void addPoints(Contour& contours, const math::float3* contour, const char* tags, std::size_t n, std::uint16_t bezierSteps) noexcept
+		{
+			math::float3 prev;
+			math::float3 cur = contour[(n - 1) % n];
+			math::float3 next = contour[0];
+
+			for (std::size_t i = 0; i < n; i++)
+			{
+				prev = cur;
+				cur = next;
+				next = contour[(i + 1) % n];
+
+				switch (FT_CURVE_TAG(tags[i]))
+				{
+				case FT_Curve_Tag_On:
+					contours.addPoints(cur);
+					break;
+				case FT_Curve_Tag_Cubic:
+					contours.addPoints(prev, cur, next, contour[(i + 2) % n], bezierSteps);
+					break;
+				case FT_Curve_Tag_Conic:
+				{
+					math::float3 prev2 = prev, next2 = next;
+
+					if (FT_CURVE_TAG(tags[(i + 1) % n]) == FT_Curve_Tag_Conic)
+						next2 = (cur + next) * 0.5f;
+
+					if (FT_CURVE_TAG(tags[(i - 1 + n) % n]) == FT_Curve_Tag_Conic)
+						prev2 = (cur + prev) * 0.5f;
+
+					contours.addPoints(prev2, cur, next2, bezierSteps);
+				}
+				break;
+				}
+			}
+		}
+
+		// Squared distance to the nearest zero of `f` along one line (Felzenszwalb and Huttenlocher).
+		void distance1D(const float* f, float* d, std::int32_t* v, float* z, std::int32_t n) noexcept
+		{
+			constexpr float inf = std::numeric_limits<float>::max();
+
+			std::int32_t k = 0;
+			v[0] = 0;
+			z[0] = -inf;
+			z[1] = inf;
+
+			for (std::int32_t q = 1; q < n; q++)
+			{
+				float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+				while (s <= z[k])
+				{
+					k--;
+					s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+				}
+
+				k++;
+				v[k] = q;
+				z[k] = s;
+				z[k + 1] = inf;
+			}
+
+			k = 0;
+			for (std::int32_t q = 0; q < n; q++)
+			{
+				while (z[k + 1] < q)
+					k++;
+				d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+			}
+		}
+
+		// Squared distance of every texel to the nearest one that is set in `mask`.
+		void distance2D(const std::vector<bool>& mask, std::int32_t width, std::int32_t height, std::vector<float>& out) noexcept
+		{
+			constexpr float inf = 1e20f;
+
+			std::int32_t n = std::max(width, height);
+			std::vector<float> f(n), d(n), z(n + 1);
+			std::vector<std::int32_t> v(n);
+
+			out.resize(width * height);
+			for (std::int32_t i = 0; i < width * height; i++)
+				out[i] = mask[i] ? 0.0f : inf;
+
+			for (std::int32_t x = 0; x < width; x++)
+			{
+				for (std::int32_t y = 0; y < height; y++)
+					f[y] = out[y * width + x];
+
+				distance1D(f.data(), d.data(), v.data(), z.data(), height);
+
+				for (std::int32_t y = 0; y < height; y++)
+					out[y * width + x] = d[y];
+			}
+
+			for (std::int32_t y = 0; y < height; y++)
+			{
+				std::copy_n(out.data() + y * width, width, f.data());
+				distance1D(f.data(), d.data(), v.data(), z.data(), width);
+				std::copy_n(d.data(), width, out.data() + y * width);
+			}
+		}
+	}
+
+	GlyphCache::GlyphCache(const std::shared_ptr<Font>& font, std::uint16_t pixelsSize) noexcept
+		: font_(font)
+		, pixelSize_(pixelsSize)
+		, distanceAtlasHeight_(0)
+		, distanceAtlasGeneration_(0)
+		, shelfCursor_(0, 0)
+		, shelfHeight_(0)
+	{
+	}
+
+	GlyphCache::~GlyphCache() noexcept
+	{
+	}
+
+	const std::shared_ptr<Font>&
+	GlyphCache::getFont() const noexcept
+	{
+		return font_;
+	}
+
+	std::uint16_t
+	GlyphCache::getPixelsSize() const noexcept
+	{
+		return pixelSize_;
+	}
+
+	const GlyphCache::Glyph&
+	GlyphCache::getGlyph(wchar_t ch) noexcept(false)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+		auto it = glyphs_.find(ch);
+		if (it != glyphs_.end())
+			return it->second;
+
+		return this->loadGlyph(ch);
+	}
+
+	PathGroupPtr
+	GlyphCache::getPaths(wchar_t ch) noexcept(false)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+		auto it = paths_.find(ch);
+		if (it != paths_.end())
+			return it->second;
+
+		auto& glyph = this->getGlyph(ch);
+
+		Paths paths(glyph.contours.size());
+
+		for (std::size_t startIndex = 0, i = 0; i < glyph.contours.size(); i++)
+		{
+			paths[i] = std::make_shared<Path>();
+			addEdges(*paths[i], &glyph.points[startIndex], &glyph.tags[startIndex], (glyph.contours[i] - startIndex) + 1);
+			startIndex = glyph.contours[i] + 1;
+		}
+
+		return paths_[ch] = std::make_shared<PathGroup>(std::move(paths));
+	}
+
+	ContourGroupPtr
+	GlyphCache::getContours(wchar_t ch, std::uint16_t bezierSteps) noexcept(false)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+		auto key = std::make_pair(ch, bezierSteps);
+		auto it = contours_.find(key);
+		if (it != contours_.end())
+			return it->second;
+
+		auto& glyph = this->getGlyph(ch);
+
+		Contours contours(glyph.contours.size());
+
+		for (std::size_t startIndex = 0, i = 0; i < glyph.contours.size(); i++)
+		{
+			contours[i] = std::make_shared<Contour>();
+			addPoints(*contours[i], &glyph.points[startIndex], &glyph.tags[startIndex], (glyph.contours[i] - startIndex) + 1, bezierSteps);
+			startIndex = glyph.contours[i] + 1;
+		}
+
+		return contours_[key] = std::make_shared<ContourGroup>(std::move(contours));
+	}
+
+	std::shared_ptr<const Mesh>
+	GlyphCache::getMesh(wchar_t ch, std::uint16_t bezierSteps, float thickness, bool hollow) noexcept(false)
+	{
+		// The tessellator keeps its output in a global, so this also stays locked while it runs.
+		std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+		auto key = std::make_tuple(ch, bezierSteps, thickness, hollow);
+		auto it = meshes_.find(key);
+		if (it != meshes_.end())
+			return it->second;
+
+		auto mesh = std::make_shared<Mesh>(makeMesh(ContourGroups{ this->getContours(ch, bezierSteps) }, thickness, hollow));
+		return meshes_[key] = std::move(mesh);
+	}
+
+	const GlyphCache::DistanceGlyph&
+	GlyphCache::getDistanceGlyph(wchar_t ch) noexcept(false)
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+		auto it = distanceGlyphs_.find(ch);
+		if (it != distanceGlyphs_.end())
+			return it->second;
+
+		FT_Face face = (FT_Face)font_->getFont();
+
+		if (::FT_Set_Pixel_Sizes(face, pixelSize_, pixelSize_))
+			throw runtime::runtime_error::create("FT_Set_Char_Size() failed (there is probably a problem with your font size", 3);
+
+		if (::FT_Load_Glyph(face, ::FT_Get_Char_Index(face, ch), FT_LOAD_RENDER))
+			throw runtime::runtime_error::create("FT_Load_Glyph failed.");
+
+		auto& bitmap = face->glyph->bitmap;
+
+		DistanceGlyph glyph;
+		glyph.advance = face->glyph->advance.x / 64.0f;
+		glyph.rect = math::uint4::Zero;
+		glyph.offset = math::float2::Zero;
+
+		if (bitmap.width == 0 || bitmap.rows == 0)
+			return distanceGlyphs_[ch] = glyph;
+
+		std::int32_t width = bitmap.width + DISTANCE_SPREAD * 2;
+		std::int32_t height = bitmap.rows + DISTANCE_SPREAD * 2;
+
+		if (width > (std::int32_t)DISTANCE_ATLAS_WIDTH)
+			throw runtime::runtime_error::create("The glyph is too large for the distance field atlas.");
+
+		std::vector<bool> inside(width * height, false);
+		std::vector<bool> outside(width * height, true);
+
+		for (std::uint32_t y = 0; y < bitmap.rows; y++)
+		{
+			for (std::uint32_t x = 0; x < bitmap.width; x++)
+			{
+				auto index = (y + DISTANCE_SPREAD) * width + x + DISTANCE_SPREAD;
+				inside[index] = bitmap.buffer[y * bitmap.pitch + x] >= 128;
+				outside[index] = !inside[index];
+			}
+		}
+
+		std::vector<float> distanceIn, distanceOut;
+		distance2D(inside, width, height, distanceOut);
+		distance2D(outside, width, height, distanceIn);
+
+		if (shelfCursor_.x + width > DISTANCE_ATLAS_WIDTH)
+		{
+			shelfCursor_ = math::uint2(0, shelfCursor_.y + shelfHeight_);
+			shelfHeight_ = 0;
+		}
+
+		if (shelfCursor_.y + height > distanceAtlasHeight_)
+		{
+			// The width never changes, so the rows that are already there stay where they are.
+			distanceAtlasHeight_ = std::max<std::uint32_t>(distanceAtlasHeight_ * 2, 64);
+			while (shelfCursor_.y + height > distanceAtlasHeight_)
+				distanceAtlasHeight_ *= 2;
+
+			distanceAtlas_.resize(DISTANCE_ATLAS_WIDTH * distanceAtlasHeight_, 0);
+		}
+
+		for (std::int32_t y = 0; y < height; y++)
+		{
+			auto row = distanceAtlas_.data() + (shelfCursor_.y + y) * DISTANCE_ATLAS_WIDTH + shelfCursor_.x;
+
+			for (std::int32_t x = 0; x < width; x++)
+			{
+				float distance = std::sqrt(distanceIn[y * width + x]) - std::sqrt(distanceOut[y * width + x]);
+				row[x] = (std::uint8_t)std::clamp(128.0f + distance * (127.0f / DISTANCE_SPREAD), 0.0f, 255.0f);
+			}
+		}
+
+		glyph.rect = math::uint4(shelfCursor_.x, shelfCursor_.y, width, height);
+		glyph.offset.x = (float)face->glyph->bitmap_left - DISTANCE_SPREAD;
+		glyph.offset.y = (float)face->glyph->bitmap_top - (float)bitmap.rows - DISTANCE_SPREAD;
+
+		shelfCursor_.x += width;
+		shelfHeight_ = std::max<std::uint32_t>(shelfHeight_, height);
+		distanceAtlasGeneration_++;
+
+		return distanceGlyphs_[ch] = glyph;
+	}
+
+	const std::vector<std::uint8_t>&
+	GlyphCache::getDistanceAtlas() const noexcept
+	{
+		return distanceAtlas_;
+	}
+
+	std::uint32_t
+	GlyphCache::getDistanceAtlasWidth() const noexcept
+	{
+		return DISTANCE_ATLAS_WIDTH;
+	}
+
+	std::uint32_t
+	GlyphCache::getDistanceAtlasHeight() const noexcept
+	{
+		return distanceAtlasHeight_;
+	}
+
+	std::uint64_t
+	GlyphCache::getDistanceAtlasGeneration() const noexcept
+	{
+		return distanceAtlasGeneration_;
+	}
+
+	void
+	GlyphCache::clear() noexcept
+	{
+		std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+		glyphs_.clear();
+		paths_.clear();
+		contours_.clear();
+		meshes_.clear();
+
+		distanceGlyphs_.clear();
+		distanceAtlas_.clear();
+		distanceAtlasHeight_ = 0;
+		distanceAtlasGeneration_++;
+		shelfCursor_ = math::uint2(0, 0);
+		shelfHeight_ = 0;
+	}
+
+	const GlyphCache::Glyph&
+	GlyphCache::loadGlyph(wchar_t ch) noexcept(false)
+	{
+		assert(font_);
+		assert(pixelSize_ > 0);
+
+		// The face is shared by every cache of the font, so its size is set again for each glyph.
+		FT_Face face = (FT_Face)font_->getFont();
+
+		if (::FT_Set_Pixel_Sizes(face, pixelSize_, pixelSize_))
+			throw runtime::runtime_error::create("FT_Set_Char_Size() failed (there is probably a problem with your font size", 3);
+
+		if (::FT_Load_Glyph(face, ::FT_Get_Char_Index(face, ch), FT_LOAD_DEFAULT))
+			throw runtime::runtime_error::create("FT_Load_Glyph failed.");
+
+		if (face->glyph->format != FT_GLYPH_FORMAT_OUTLINE)
+			throw runtime::runtime_error::create("Invalid Glyph Format.");
+
+		auto& outline = face->glyph->outline;
+
+		Glyph glyph;
+		glyph.advance = face->glyph->advance.x / 64.0f;
+		glyph.points.resize(outline.n_points);
+		glyph.tags.assign(outline.tags, outline.tags + outline.n_points);
+		glyph.contours.assign(outline.contours, outline.contours + outline.n_contours);
+
+		for (short i = 0; i < outline.n_points; i++)
+			glyph.points[i] = math::float3(outline.points[i].x / 64.0f, outline.points[i].y / 64.0f, 0.0f);
+
+		return glyphs_[ch] = std::move(glyph);
+	}
+}
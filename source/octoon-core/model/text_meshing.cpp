@@ -6,38 +6,40 @@
 #include <octoon/model/path_group.h>
 #include <octoon/runtime/except.h>
 
-#include <ft2build.h>
-#include <freetype/ftglyph.h>
-
 namespace octoon::font
 {
 	TextMeshing::TextMeshing() noexcept
 		: font_(nullptr)
 		, pixelSize_(12)
+		, glyphCache_(nullptr)
 	{
 	}
 
 	TextMeshing::TextMeshing(const char* path, std::uint16_t pixelsSize) noexcept
 		: font_(std::make_shared<Font>(path))
 		, pixelSize_(pixelsSize)
+		, glyphCache_(font_ ? std::make_shared<GlyphCache>(font_, pixelsSize) : nullptr)
 	{
 	}
 
 	TextMeshing::TextMeshing(const std::string& path, std::uint16_t pixelsSize) noexcept
 		: font_(std::make_shared<Font>(path.c_str()))
 		, pixelSize_(pixelsSize)
+		, glyphCache_(font_ ? std::make_shared<GlyphCache>(font_, pixelsSize) : nullptr)
 	{
 	}
 
 	TextMeshing::TextMeshing(std::shared_ptr<Font>&& font, std::uint16_t pixelsSize) noexcept
 		: font_(std::move(font))
 		, pixelSize_(pixelsSize)
+		, glyphCache_(font_ ? std::make_shared<GlyphCache>(font_, pixelsSize) : nullptr)
 	{
 	}
 
 	TextMeshing::TextMeshing(const std::shared_ptr<Font>& font, std::uint16_t pixelsSize) noexcept
 		: font_(std::move(font))
 		, pixelSize_(pixelsSize)
+		, glyphCache_(font_ ? std::make_shared<GlyphCache>(font_, pixelsSize) : nullptr)
 	{
 	}
 
@@ -48,13 +50,21 @@ namespace octoon::font
 	void
 	TextMeshing::setFont(std::shared_ptr<Font>&& font) noexcept
 	{
-		font_ = std::move(font);
+		if (font_ != font)
+		{
+			font_ = std::move(font);
+			glyphCache_ = font_ ? std::make_shared<GlyphCache>(font_, pixelSize_) : nullptr;
+		}
 	}
 
 	void
 	TextMeshing::setFont(const std::shared_ptr<Font>& font) noexcept
 	{
-		font_ = font;
+		if (font_ != font)
+		{
+			font_ = font;
+			glyphCache_ = font_ ? std::make_shared<GlyphCache>(font_, pixelSize_) : nullptr;
+		}
 	}
 
 	const std::shared_ptr<Font>&
@@ -66,7 +76,11 @@ namespace octoon::font
 	void
 	TextMeshing::setPixelsSize(std::uint16_t pixelsSize) noexcept
 	{
-		pixelSize_ = pixelsSize;
+		if (pixelSize_ != pixelsSize)
+		{
+			pixelSize_ = pixelsSize;
+			glyphCache_ = font_ ? std::make_shared<GlyphCache>(font_, pixelSize_) : nullptr;
+		}
 	}
 
 	std::uint16_t
@@ -75,111 +89,67 @@ namespace octoon::font
 		return pixelSize_;
 	}
 
+	const std::shared_ptr<GlyphCache>&
+	TextMeshing::getGlyphCache() const noexcept
+	{
+		return glyphCache_;
+	}
+
 	std::shared_ptr<TextMeshing>
 	TextMeshing::clone() const noexcept
 	{
 		auto instance = std::make_shared<TextMeshing>();
 		instance->setFont(this->getFont());
 		instance->setPixelsSize(this->getPixelsSize());
+		instance->glyphCache_ = glyphCache_;
 
 		return instance;
 	}
 
-	PathGroups makeTextPaths(const std::wstring& string, const TextMeshing& params) noexcept(false)
+	static float makeTextOffset(const std::wstring& string, GlyphCache& cache, TextAlign align) noexcept(false)
 	{
-		assert(params.getFont());
-		assert(params.getPixelsSize() > 0);
-
-		auto addEdge = [](Path& contours, const FT_Vector* contour, const char* tags, std::size_t n) -> void
-		{
-			math::float3 prev;
-			math::float3 cur(contour[(n - 1) % n].x / 64.0f, contour[(n - 1) % n].y / 64.0f, 0.0);
-			math::float3 next(contour[0].x / 64.0f, contour[0].y / 64.0f, 0.0);
-
-			for (std::size_t i = 0; i < n; i++)
-			{
-				prev = cur;
-				cur = next;
-				next = math::float3(contour[(i + 1) % n].x / 64.0f, contour[(i + 1) % n].y / 64.0f, 0.0f);
-
-				switch (FT_CURVE_TAG(tags[i]))
-				{
-				case FT_Curve_Tag_On:
-					contours.addEdge(cur);
-					break;
-				case FT_Curve_Tag_Cubic:
-					contours.addEdge(prev, cur, next, math::float3(contour[(i + 2) % n].x / 64.0f, contour[(i + 2) % n].y / 64.0f, 0.0f));
-					break;
-				case FT_Curve_Tag_Conic:
-				{
-					math::float3 prev2 = prev, next2 = next;
-
-					if (FT_CURVE_TAG(tags[(i + 1) % n]) == FT_Curve_Tag_Conic)
-						next2 = (cur + next) * 0.5f;
-
-					if (FT_CURVE_TAG(tags[(i - 1 + n) % n]) == FT_Curve_Tag_Conic)
-						prev2 = (cur + prev) * 0.5f;
-
-					contours.addEdge(prev2, cur, next2);
-				}
-				break;
-				}
-			}
-		};
+		float width = 0;
+		for (auto& ch : string)
+			width += cache.getGlyph(ch).advance;
 
-		auto addPath = [addEdge](const FT_GlyphSlot glyph, FT_Pos offset)
+		switch (align)
 		{
-			Paths paths(glyph->outline.n_contours);
-
-			for (short i = 0; i < glyph->outline.n_contours; i++)
-				paths[i] = std::make_unique<Path>();
-
-			for (short startIndex = 0, i = 0; i < glyph->outline.n_contours; i++)
-			{
-				auto points = &glyph->outline.points[startIndex];
-				auto tags = &glyph->outline.tags[startIndex];
-				auto index = (glyph->outline.contours[i] - startIndex) + 1;
-
-				startIndex = glyph->outline.contours[i] + 1;
-
-				addEdge(*paths[i], points, tags, index);
-			}
-
-			paths += math::float3((float)offset, 0, 0);
-
-			return std::move(paths);
-		};
+		case TextAlign::Right:
+			return -width;
+		case TextAlign::Middle:
+			return -width * 0.5f;
+		default:
+			return 0;
+		}
+	}
 
-		if (::FT_Set_Pixel_Sizes((FT_Face)(params.getFont()->getFont()), params.getPixelsSize(), params.getPixelsSize()))
-			throw runtime::runtime_error::create("FT_Set_Char_Size() failed (there is probably a problem with your font size", 3);
+	PathGroups makeTextPaths(const std::wstring& string, const TextMeshing& params) noexcept(false)
+	{
+		assert(params.getGlyphCache());
 
-		FT_Face ftface = (FT_Face)params.getFont()->getFont();
+		auto& cache = *params.getGlyphCache();
 
-		auto offset = ftface->glyph->advance.x;
+		float offset = 0;
 
 		PathGroups groups;
 
 		for (auto& ch : string)
 		{
-			FT_UInt index = FT_Get_Char_Index(ftface, ch);
-			if (::FT_Load_Glyph(ftface, index, FT_LOAD_DEFAULT))
-				throw runtime::runtime_error::create("FT_Load_Glyph failed.");
-
-			FT_Glyph glyph;
-			if (::FT_Get_Glyph(ftface->glyph, &glyph))
-				throw runtime::runtime_error::create("FT_Get_Glyph failed.");
-
-			if (glyph->format != FT_GLYPH_FORMAT_OUTLINE)
-				throw runtime::runtime_error::create("Invalid Glyph Format.");
-
-			if (ch == ' ')
-				offset += ftface->glyph->advance.x / 64;
-			else
+			if (ch != ' ')
 			{
-				groups.push_back(std::make_shared<PathGroup>(addPath(ftface->glyph, offset)));
+				auto group = std::make_shared<PathGroup>();
 
-				offset += ftface->glyph->bitmap_left + ftface->glyph->bitmap.width;
+				for (auto& path : cache.getPaths(ch)->getPaths())
+				{
+					auto instance = path->clone();
+					*instance += math::float3(offset, 0, 0);
+					group->addPath(std::move(instance));
+				}
+
+				groups.push_back(std::move(group));
 			}
+
+			offset += cache.getGlyph(ch).advance;
 		}
 
 		return groups;
@@ -207,147 +177,132 @@ namespace octoon::font
 
 	ContourGroups makeTextContours(const std::wstring& string, const TextMeshing& params, std::uint16_t bezierSteps, TextAlign align) noexcept(false)
 	{
-		assert(params.getFont());
-		assert(params.getPixelsSize() > 0);
+		assert(params.getGlyphCache());
 
-		auto addPoints = [](Contour& contours, const FT_Vector* contour, const char* tags, std::size_t n, std::uint16_t bezierSteps) -> void
-		{
-			math::float3 prev;
-			math::float3 cur(contour[(n - 1) % n].x / 64.0f, contour[(n - 1) % n].y / 64.0f, 0.0);
-			math::float3 next(contour[0].x / 64.0f, contour[0].y / 64.0f, 0.0);
+		auto& cache = *params.getGlyphCache();
 
-			for (std::size_t i = 0; i < n; i++)
-			{
-				prev = cur;
-				cur = next;
-				next = math::float3(contour[(i + 1) % n].x / 64.0f, contour[(i + 1) % n].y / 64.0f, 0.0f);
-					
-				switch (FT_CURVE_TAG(tags[i]))
-				{
-				case FT_Curve_Tag_On:
-					contours.addPoints(cur);
-					break;
-				case FT_Curve_Tag_Cubic:
-					contours.addPoints(prev, cur, next, math::float3(contour[(i + 2) % n].x / 64.0f, contour[(i + 2) % n].y / 64.0f, 0.0f), bezierSteps);
-					break;
-				case FT_Curve_Tag_Conic:
-				{
-					math::float3 prev2 = prev, next2 = next;
+		float offset = makeTextOffset(string, cache, align);
 
-					if (FT_CURVE_TAG(tags[(i + 1) % n]) == FT_Curve_Tag_Conic)
-						next2 = (cur + next) * 0.5f;
+		ContourGroups groups;
 
-					if (FT_CURVE_TAG(tags[(i - 1 + n) % n]) == FT_Curve_Tag_Conic)
-						prev2 = (cur + prev) * 0.5f;
+		for (auto& ch : string)
+		{
+			if (ch != ' ')
+			{
+				Contours contours;
 
-					contours.addPoints(prev2, cur, next2, bezierSteps);
-				}
-				break;
+				for (auto& contour : cache.getContours(ch, bezierSteps)->getContours())
+				{
+					auto instance = contour->clone();
+					*instance += math::float3(offset, 0, 0);
+					contours.push_back(std::move(instance));
 				}
+
+				groups.push_back(std::make_shared<ContourGroup>(std::move(contours)));
 			}
-		};
 
-		auto addContours = [addPoints](const FT_GlyphSlot glyph, FT_Pos offset, std::uint16_t bezierSteps)
-		{
-			Contours contours(glyph->outline.n_contours);
+			offset += cache.getGlyph(ch).advance;
+		}
 
-			for (short i = 0; i < glyph->outline.n_contours; i++)
-				contours[i] = std::make_unique<Contour>();
+		return groups;
+	}
 
-			for (short startIndex = 0, i = 0; i < glyph->outline.n_contours; i++)
-			{
-				auto points = &glyph->outline.points[startIndex];
-				auto tags = &glyph->outline.tags[startIndex];
-				auto index = (glyph->outline.contours[i] - startIndex) + 1;
+	Mesh makeText(const std::wstring& string, const TextMeshing& params, float thickness, std::uint16_t bezierSteps, TextAlign align) noexcept(false)
+	{
+		assert(params.getGlyphCache());
 
-				startIndex = glyph->outline.contours[i] + 1;
+		auto& cache = *params.getGlyphCache();
 
-				addPoints(*contours[i], points, tags, index, bezierSteps);
-			}
+		float offset = makeTextOffset(string, cache, align);
 
-			for (auto& contour : contours)
+		Mesh mesh;
+		math::float3s& vertices = mesh.getVertexArray();
+		math::float3s& normals = mesh.getNormalArray();
+
+		for (auto& ch : string)
+		{
+			if (ch != ' ')
 			{
-				for (auto& point : contour->points())
-					point.x += offset;
-			}
+				auto glyph = cache.getMesh(ch, bezierSteps, thickness, false);
 
-			return std::make_shared<ContourGroup>(std::move(contours));
-		};
+				for (auto& it : glyph->getVertexArray())
+					vertices.emplace_back(it.x + offset, it.y, it.z);
 
-		if (::FT_Set_Pixel_Sizes((FT_Face)(params.getFont()->getFont()), params.getPixelsSize(), params.getPixelsSize()))
-			throw runtime::runtime_error::create("FT_Set_Char_Size() failed (there is probably a problem with your font size", 3);
+				normals.insert(normals.end(), glyph->getNormalArray().begin(), glyph->getNormalArray().end());
+			}
 
-		FT_Face ftface = (FT_Face)params.getFont()->getFont();
+			offset += cache.getGlyph(ch).advance;
+		}
 
-		auto offset = 0;
+		mesh.computeBoundingBox();
 
-		ContourGroups groups;
+		return mesh;
+	}
 
-		for (auto& ch : string)
-		{
-			FT_UInt index = FT_Get_Char_Index(ftface, ch);
-			if (::FT_Load_Glyph(ftface, index, FT_LOAD_DEFAULT))
-				throw runtime::runtime_error::create("FT_Load_Glyph failed.");
+	Mesh makeTextWireframe(const std::wstring& string, const TextMeshing& params, float thickness, std::uint16_t bezierSteps) noexcept(false)
+	{
+		Mesh mesh = makeMeshWireframe(makeTextContours(string, params, bezierSteps), thickness);
+		mesh.computeBoundingBox();
 
-			FT_Glyph glyph;
-			if (::FT_Get_Glyph(ftface->glyph, &glyph))
-				throw runtime::runtime_error::create("FT_Get_Glyph failed.");
+		return mesh;
+	}
 
-			if (glyph->format != FT_GLYPH_FORMAT_OUTLINE)
-				throw runtime::runtime_error::create("Invalid Glyph Format.");
+	Mesh makeTextQuads(const std::wstring& string, const TextMeshing& params, TextAlign align) noexcept(false)
+	{
+		assert(params.getGlyphCache());
 
-			if (ch == ' ')
-				offset += ftface->glyph->advance.x / 64;
-			else
-			{
-				groups.push_back(addContours(ftface->glyph, offset, bezierSteps));
+		auto& cache = *params.getGlyphCache();
 
-				offset += ftface->glyph->bitmap_left + ftface->glyph->bitmap.width;
-			}
-		}
+		float offset = makeTextOffset(string, cache, align);
 
-		switch (align)
-		{
-		case TextAlign::Left:
-			break;
-		case TextAlign::Right:
+		Mesh mesh;
+		math::float3s& vertices = mesh.getVertexArray();
+		math::float3s& normals = mesh.getNormalArray();
+		math::float2s& texcoords = mesh.getTexcoordArray();
+		math::uint1s indices;
+
+		for (auto& ch : string)
 		{
-			for (auto& group : groups)
+			auto& glyph = cache.getDistanceGlyph(ch);
+			if (glyph.rect.z > 0)
 			{
-				for (auto& contour : group->getContours())
-					for (auto& pt : contour->points())
-						pt.x -= offset;
+				float x = offset + glyph.offset.x;
+				float y = glyph.offset.y;
+
+				auto index = (math::uint1)vertices.size();
+				vertices.emplace_back(x, y, 0.0f);
+				vertices.emplace_back(x + glyph.rect.z, y, 0.0f);
+				vertices.emplace_back(x + glyph.rect.z, y + glyph.rect.w, 0.0f);
+				vertices.emplace_back(x, y + glyph.rect.w, 0.0f);
+
+				normals.insert(normals.end(), 4, math::float3::UnitZ);
+
+				indices.insert(indices.end(), { index, index + 1, index + 2, index, index + 2, index + 3 });
 			}
+
+			offset += glyph.advance;
 		}
-		break;
-		case TextAlign::Middle:
+
+		// Looked up after every glyph is in the atlas, the ones added above may have made it taller.
+		float width = (float)cache.getDistanceAtlasWidth();
+		float height = (float)cache.getDistanceAtlasHeight();
+
+		for (auto& ch : string)
 		{
-			for (auto& group : groups)
+			auto& glyph = cache.getDistanceGlyph(ch);
+			if (glyph.rect.z > 0)
 			{
-				for (auto& contour : group->getContours())
-					for (auto& pt : contour->points())
-						pt.x -= offset * 0.5f;
+				float u1 = glyph.rect.x / width, u2 = (glyph.rect.x + glyph.rect.z) / width;
+				float v1 = glyph.rect.y / height, v2 = (glyph.rect.y + glyph.rect.w) / height;
+
+				texcoords.emplace_back(u1, v2);
+				texcoords.emplace_back(u2, v2);
+				texcoords.emplace_back(u2, v1);
+				texcoords.emplace_back(u1, v1);
 			}
 		}
-		break;
-		default:
-			break;
-		}
-
-		return groups;
-	}
-
-	Mesh makeText(const std::wstring& string, const TextMeshing& params, float thickness, std::uint16_t bezierSteps) noexcept(false)
-	{
-		Mesh mesh = makeMesh(makeTextContours(string, params, bezierSteps), thickness, false);
-		mesh.computeBoundingBox();
-
-		return mesh;
-	}
 
-	Mesh makeTextWireframe(const std::wstring& string, const TextMeshing& params, float thickness, std::uint16_t bezierSteps) noexcept(false)
-	{
-		Mesh mesh = makeMeshWireframe(makeTextContours(string, params, bezierSteps), thickness);
+		mesh.setIndicesArray(std::move(indices));
 		mesh.computeBoundingBox();
 
 		return mesh;
@@ -22,6 +22,9 @@ namespace octoon
 		, filterCallback_(std::make_unique<FilterCallback>())
 		, solver_(std::make_unique<btSequentialImpulseConstraintSolver>())
 		, maxSubSteps_(1)
+		, simulating_(false)
+		, pendingTime_(0.0f)
+		, stepThread_([this]() { this->simulate(pendingTime_); })
 	{
 		dispatcher_ = std::make_unique<btCollisionDispatcher>(collisionConfiguration_.get());
 
@@ -32,6 +35,8 @@ namespace octoon
 
 	BulletScene::~BulletScene()
 	{
+		this->endSimulate();
+
 		dynamicsWorld_.reset();
 		dispatcher_.reset();
 	}
@@ -112,6 +117,27 @@ namespace octoon
 		this->dynamicsWorld_->stepSimulation(time, maxSubSteps_, time);
 	}
 
+	void
+	BulletScene::beginSimulate(float time)
+	{
+		this->endSimulate();
+
+		pendingTime_ = time;
+		simulating_ = true;
+
+		stepThread_.start();
+	}
+
+	void
+	BulletScene::endSimulate()
+	{
+		if (simulating_)
+		{
+			simulating_ = false;
+			stepThread_.wait();
+		}
+	}
+
 	void
 	BulletScene::fetchResults()
 	{
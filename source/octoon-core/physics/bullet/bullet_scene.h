@@ -10,6 +10,7 @@
 
 #include "bullet_rigidbody.h"
 #include "bullet_type.h"
+#include "../physics_step_thread.h"
 
 namespace octoon
 {
@@ -32,6 +33,9 @@ namespace octoon
 		virtual int getMaxSubStepCount() noexcept override;
 
 		virtual void simulate(float time) override;
+
+		virtual void beginSimulate(float time) override;
+		virtual void endSimulate() override;
 			
 		virtual void fetchResults() override;
 
@@ -41,12 +45,15 @@ namespace octoon
 
     private:
 		int maxSubSteps_;
+		bool simulating_;
+		float pendingTime_;
 		std::unique_ptr<btOverlapFilterCallback> filterCallback_;
 		std::unique_ptr<btBroadphaseInterface> broadphase_;
 		std::unique_ptr<btCollisionDispatcher> dispatcher_;
 		std::unique_ptr<btDefaultCollisionConfiguration> collisionConfiguration_;
 		std::unique_ptr<btSequentialImpulseConstraintSolver> solver_;
 		std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld_;
+		PhysicsStepThread stepThread_;
 	};
 }
 
@@ -0,0 +1,68 @@
+#include "physics_step_thread.h"
+
+namespace octoon
+{
+	PhysicsStepThread::PhysicsStepThread(std::function<void()> step) noexcept
+		: pending_(false)
+		, quit_(false)
+		, step_(std::move(step))
+	{
+	}
+
+	PhysicsStepThread::~PhysicsStepThread() noexcept
+	{
+		if (thread_.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				quit_ = true;
+			}
+
+			wakeup_.notify_one();
+			thread_.join();
+		}
+	}
+
+	void
+	PhysicsStepThread::start() noexcept
+	{
+		this->wait();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			pending_ = true;
+		}
+
+		if (thread_.joinable())
+			wakeup_.notify_one();
+		else
+			thread_ = std::thread(std::bind(&PhysicsStepThread::run, this));
+	}
+
+	void
+	PhysicsStepThread::wait() noexcept
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		done_.wait(lock, [this]() { return !pending_; });
+	}
+
+	void
+	PhysicsStepThread::run() noexcept
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		for (;;)
+		{
+			wakeup_.wait(lock, [this]() { return pending_ || quit_; });
+			if (quit_)
+				break;
+
+			lock.unlock();
+			step_();
+			lock.lock();
+
+			pending_ = false;
+			done_.notify_all();
+		}
+	}
+}
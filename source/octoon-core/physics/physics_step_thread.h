@@ -0,0 +1,41 @@
+#ifndef OCTOON_PHYSICS_STEP_THREAD_H_
+#define OCTOON_PHYSICS_STEP_THREAD_H_
+
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+
+namespace octoon
+{
+	// Runs a scene's step on a persistent worker so beginSimulate can return immediately.
+	class PhysicsStepThread final
+	{
+	public:
+		PhysicsStepThread(std::function<void()> step) noexcept;
+		~PhysicsStepThread() noexcept;
+
+		void start() noexcept;
+		void wait() noexcept;
+
+	private:
+		void run() noexcept;
+
+	private:
+		PhysicsStepThread(const PhysicsStepThread&) = delete;
+		PhysicsStepThread& operator=(const PhysicsStepThread&) = delete;
+
+	private:
+		bool pending_;
+		bool quit_;
+
+		std::function<void()> step_;
+
+		std::mutex mutex_;
+		std::condition_variable wakeup_;
+		std::condition_variable done_;
+		std::thread thread_;
+	};
+}
+
+#endif
@@ -66,6 +66,9 @@ namespace octoon
 		, px_scene(nullptr)
 		, simulationEventCallback_(std::make_unique<SimulationEventCallback>())
 		, maxSubSteps_(1)
+		, simulating_(false)
+		, pendingTime_(0.0f)
+		, stepThread_([this]() { this->simulate(pendingTime_); })
 	{
 		physx::PxSceneDesc sceneDesc(context->getPxPhysics()->getTolerancesScale());
 		sceneDesc.gravity = physx::PxVec3(desc.gravity.x, desc.gravity.y, desc.gravity.z);
@@ -88,6 +91,8 @@ namespace octoon
 
 	PhysxScene::~PhysxScene()
 	{
+		this->endSimulate();
+
 		px_scene->release();
 		px_scene = nullptr;
 	}
@@ -151,6 +156,27 @@ namespace octoon
 		}
 	}
 
+	void
+	PhysxScene::beginSimulate(float time)
+	{
+		this->endSimulate();
+
+		pendingTime_ = time;
+		simulating_ = true;
+
+		stepThread_.start();
+	}
+
+	void
+	PhysxScene::endSimulate()
+	{
+		if (simulating_)
+		{
+			simulating_ = false;
+			stepThread_.wait();
+		}
+	}
+
 	void
 	PhysxScene::fetchResults()
 	{
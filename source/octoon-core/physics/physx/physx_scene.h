@@ -10,6 +10,7 @@
 
 #include "physx_type.h"
 #include "physx_rigidbody.h"
+#include "../physics_step_thread.h"
 
 namespace octoon
 {
@@ -32,6 +33,9 @@ namespace octoon
 		virtual int getMaxSubStepCount() noexcept override;
 
 		virtual void simulate(float time) override;
+
+		virtual void beginSimulate(float time) override;
+		virtual void endSimulate() override;
 			
 		virtual void fetchResults() override;
 
@@ -42,8 +46,11 @@ namespace octoon
 	private:
 		PhysxContext* context;
 		int maxSubSteps_;
+		bool simulating_;
+		float pendingTime_;
 		physx::PxScene* px_scene;
 		std::unique_ptr<class SimulationEventCallback> simulationEventCallback_;
+		PhysicsStepThread stepThread_;
 	};
 }
 
@@ -0,0 +1,261 @@
+#include <octoon/runtime/profiler.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace octoon
+{
+	namespace runtime
+	{
+		namespace
+		{
+			constexpr std::size_t RING_CAPACITY = 8192;
+			constexpr std::size_t MAX_DEPTH = 64;
+
+			struct ThreadBuffer
+			{
+				std::uint32_t thread;
+				std::uint32_t depth;
+
+				std::atomic<std::size_t> head;
+				std::size_t tail;
+
+				ProfileEvent open[MAX_DEPTH];
+				ProfileEvent ring[RING_CAPACITY];
+			};
+
+			struct ProfileFrame
+			{
+				std::uint64_t begin;
+				std::uint64_t end;
+				std::vector<ProfileEvent> events;
+			};
+
+			std::atomic<bool> enable_(false);
+
+			std::mutex mutex_;
+			std::vector<std::shared_ptr<ThreadBuffer>> threads_;
+			std::deque<ProfileFrame> history_;
+			std::size_t historyLength_ = 120;
+
+			std::uint64_t frameBegin_ = 0;
+			std::vector<ProfileEvent> pending_;
+
+			const std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+
+			ThreadBuffer& threadBuffer() noexcept
+			{
+				thread_local std::shared_ptr<ThreadBuffer> buffer;
+				if (!buffer)
+				{
+					buffer = std::make_shared<ThreadBuffer>();
+					buffer->depth = 0;
+					buffer->head = 0;
+					buffer->tail = 0;
+
+					std::lock_guard<std::mutex> lock(mutex_);
+					buffer->thread = (std::uint32_t)threads_.size();
+					threads_.push_back(buffer);
+				}
+
+				return *buffer;
+			}
+
+			void collect(std::vector<ProfileEvent>& events) noexcept
+			{
+				for (auto& buffer : threads_)
+				{
+					auto head = buffer->head.load(std::memory_order_acquire);
+					if (head - buffer->tail > RING_CAPACITY)
+						buffer->tail = head - RING_CAPACITY;
+
+					for (; buffer->tail < head; buffer->tail++)
+						events.push_back(buffer->ring[buffer->tail % RING_CAPACITY]);
+				}
+			}
+
+			void writeString(std::ostream& stream, const char* str)
+			{
+				stream << '"';
+				for (; *str; str++)
+				{
+					if (*str == '"' || *str == '\\')
+						stream << '\\';
+					stream << *str;
+				}
+				stream << '"';
+			}
+		}
+
+		void
+		Profiler::setEnable(bool enable) noexcept
+		{
+			enable_.store(enable, std::memory_order_relaxed);
+		}
+
+		bool
+		Profiler::getEnable() noexcept
+		{
+			return enable_.load(std::memory_order_relaxed);
+		}
+
+		std::uint64_t
+		Profiler::now() noexcept
+		{
+			return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+		}
+
+		void
+		Profiler::beginScope(const char* name) noexcept
+		{
+			auto& buffer = threadBuffer();
+			if (buffer.depth < MAX_DEPTH)
+			{
+				auto& event = buffer.open[buffer.depth];
+				event.name = name;
+				event.depth = buffer.depth;
+				event.thread = buffer.thread;
+				event.begin = now();
+			}
+
+			buffer.depth++;
+		}
+
+		void
+		Profiler::endScope() noexcept
+		{
+			auto& buffer = threadBuffer();
+			if (buffer.depth == 0)
+				return;
+
+			buffer.depth--;
+
+			if (buffer.depth < MAX_DEPTH)
+			{
+				auto head = buffer.head.load(std::memory_order_relaxed);
+				auto& event = buffer.ring[head % RING_CAPACITY];
+				event = buffer.open[buffer.depth];
+				event.end = now();
+				buffer.head.store(head + 1, std::memory_order_release);
+			}
+		}
+
+		void
+		Profiler::addEvent(const char* name, std::uint32_t thread, std::uint64_t begin, std::uint64_t end, std::uint32_t depth) noexcept
+		{
+			ProfileEvent event;
+			event.name = name;
+			event.begin = begin;
+			event.end = end;
+			event.depth = depth;
+			event.thread = thread;
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			pending_.push_back(event);
+		}
+
+		void
+		Profiler::beginFrame() noexcept
+		{
+			if (!getEnable())
+				return;
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			frameBegin_ = now();
+		}
+
+		void
+		Profiler::endFrame() noexcept
+		{
+			if (!getEnable())
+				return;
+
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			ProfileFrame frame;
+			frame.begin = frameBegin_;
+			frame.end = now();
+			frame.events = std::move(pending_);
+			pending_.clear();
+
+			collect(frame.events);
+
+			std::sort(frame.events.begin(), frame.events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+			{
+				if (a.thread != b.thread)
+					return a.thread < b.thread;
+				return a.begin != b.begin ? a.begin < b.begin : a.depth < b.depth;
+			});
+
+			history_.push_back(std::move(frame));
+			while (history_.size() > historyLength_)
+				history_.pop_front();
+		}
+
+		void
+		Profiler::setHistoryLength(std::size_t frames) noexcept
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			historyLength_ = std::max<std::size_t>(frames, 1);
+			while (history_.size() > historyLength_)
+				history_.pop_front();
+		}
+
+		std::size_t
+		Profiler::getHistoryLength() noexcept
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return historyLength_;
+		}
+
+		std::vector<ProfileEvent>
+		Profiler::getFrameEvents() noexcept
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (history_.empty())
+				return std::vector<ProfileEvent>();
+			return history_.back().events;
+		}
+
+		std::uint64_t
+		Profiler::getFrameTime() noexcept
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (history_.empty())
+				return 0;
+			return history_.back().end - history_.back().begin;
+		}
+
+		bool
+		Profiler::saveChromeTrace(const std::string& path) noexcept
+		{
+			std::ofstream stream(path, std::ios_base::out | std::ios_base::trunc);
+			if (!stream)
+				return false;
+
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << GPU_THREAD << ",\"args\":{\"name\":\"GPU\"}}";
+
+			for (auto& frame : history_)
+			{
+				for (auto& event : frame.events)
+				{
+					stream << ",{\"name\":";
+					writeString(stream, event.name);
+					stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread;
+					stream << ",\"ts\":" << event.begin / 1000.0 << ",\"dur\":" << (event.end - event.begin) / 1000.0 << '}';
+				}
+			}
+
+			stream << "]}";
+
+			return stream.good();
+		}
+	}
+}
@@ -9,6 +9,8 @@ namespace octoon
 			: name_(name)
 			, parent_(parent)
 			, construct_(creator)
+			, first_(0)
+			, last_(0)
 		{
 			RttiFactory::instance()->add(this);
 		}
@@ -37,6 +39,9 @@ namespace octoon
 		{
 			assert(other);
 
+			if (first_ != 0 && other->first_ != 0)
+				return other->first_ <= first_ && first_ <= other->last_;
+
 			for (const Rtti* cur = this; cur != 0; cur = cur->getParent())
 			{
 				if (cur == other)
@@ -57,6 +62,10 @@ namespace octoon
 		bool
 		Rtti::isDerivedFrom(std::string_view name) const noexcept
 		{
+			auto rtti = RttiFactory::instance()->getRtti(name);
+			if (rtti && first_ != 0 && rtti->first_ != 0)
+				return rtti->first_ <= first_ && first_ <= rtti->last_;
+
 			for (const Rtti* cur = this; cur != 0; cur = cur->getParent())
 			{
 				if (cur->name_ == name)
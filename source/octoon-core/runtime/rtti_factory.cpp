@@ -7,11 +7,51 @@ namespace octoon
 		bool
 		RttiFactory::open() noexcept
 		{
+			std::vector<Rtti*> roots;
+			std::unordered_map<const Rtti*, std::vector<Rtti*>> children;
+
 			for (auto& it : rttis_)
 			{
 				if (it)
+				{
 					rttiLists_[it->type_name()] = it;
+
+					if (it->getParent())
+						children[it->getParent()].push_back(it);
+					else
+						roots.push_back(it);
+				}
+			}
+
+			std::uint32_t index = 1;
+			std::vector<std::pair<Rtti*, bool>> stack;
+
+			for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+				stack.emplace_back(*it, false);
+
+			while (!stack.empty())
+			{
+				auto [rtti, visited] = stack.back();
+				stack.pop_back();
+
+				if (visited)
+				{
+					rtti->last_ = index - 1;
+				}
+				else
+				{
+					rtti->first_ = index++;
+					stack.emplace_back(rtti, true);
+
+					auto it = children.find(rtti);
+					if (it != children.end())
+					{
+						for (auto child = it->second.rbegin(); child != it->second.rend(); ++child)
+							stack.emplace_back(*child, false);
+					}
+				}
 			}
+
 			return true;
 		}
 
@@ -25,21 +65,15 @@ namespace octoon
 		Rtti*
 		RttiFactory::getRtti(std::string_view name) noexcept
 		{
-			auto it = rttiLists_.lower_bound(name);
-			for (; it != rttiLists_.end(); ++it)
-				if ((*it).first == name)
-					return (*it).second;
-			return nullptr;
+			auto it = rttiLists_.find(name);
+			return it != rttiLists_.end() ? (*it).second : nullptr;
 		}
 
 		const Rtti*
 		RttiFactory::getRtti(std::string_view name) const noexcept
 		{
-			auto it = rttiLists_.lower_bound(name);
-			for (; it != rttiLists_.end(); ++it)
-				if ((*it).first == name)
-					return (*it).second;
-			return nullptr;
+			auto it = rttiLists_.find(name);
+			return it != rttiLists_.end() ? (*it).second : nullptr;
 		}
 
 		RttiInterfacePtr
@@ -1,5 +1,6 @@
 #include <octoon/runtime/rtti_singleton.h>
 #include <octoon/runtime/rtti_factory.h>
+#include <map>
 
 namespace octoon
 {
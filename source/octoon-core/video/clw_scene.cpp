@@ -3,7 +3,13 @@
 namespace octoon
 {
 	ClwScene::ClwScene(CLWContext context)
-		: context_(context)
+		: numVertices(0)
+		, numIndices(0)
+		, numFreeVertices(0)
+		, numFreeIndices(0)
+		, numTextureBytes(0)
+		, numFreeTextureBytes(0)
+		, context_(context)
 	{
 	}
 }
\ No newline at end of file
@@ -8,8 +8,15 @@
 #include <octoon/video/collector.h>
 #include <octoon/video/compiled_scene.h>
 
+#include <memory>
+#include <unordered_map>
+
 namespace octoon
 {
+    class Mesh;
+    class Material;
+    class Geometry;
+
     enum class CameraType
     {
         kPerspective,
@@ -28,9 +35,42 @@ namespace octoon
 
         #include "../../lib/system/Kernels/CL/payload.cl"
 
+        // Vertices and indices of one mesh inside the shared geometry buffers.
+        struct MeshRange
+        {
+            std::weak_ptr<octoon::Mesh> mesh;
+            std::uint64_t generation;
+            std::size_t startvtx;
+            std::size_t numvtx;
+            std::size_t startidx;
+            std::size_t numidx;
+            std::vector<std::size_t> subsets;
+        };
+
+        // Bytes of one texture inside `texturedata`.
+        struct TextureRange
+        {
+            std::weak_ptr<runtime::RttiInterface> texture;
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        // Host side of a `shapes` entry, the slot is the shape id minus one.
+        struct ShapeRecord
+        {
+            const octoon::Geometry* geometry;
+            const octoon::Mesh* mesh;
+            const octoon::Material* material;
+            std::uint64_t generation;
+            std::size_t subset;
+            RadeonRays::Shape* isect;
+        };
+
         bool dirty;
         bool showBackground;
 
+        std::uint64_t generation;
+
         CLWBuffer<math::float4> vertices;
         CLWBuffer<math::float4> normals;
         CLWBuffer<math::float2> uvs;
@@ -64,8 +104,21 @@ namespace octoon
         int cameraVolumeIndex;
         CameraType cameraType;
 
-        std::vector<RadeonRays::Shape*> isectShapes;
-        std::vector<RadeonRays::Shape*> visibleShapes;
+        // Geometry and textures are appended and patched in place, released ranges stay as
+        // holes until they make up half of a buffer and everything is uploaded again.
+        std::unordered_map<const octoon::Mesh*, MeshRange> meshRanges;
+        std::unordered_map<const void*, TextureRange> textureRanges;
+
+        std::vector<Shape> shapeData;
+        std::vector<ShapeRecord> shapeRecords;
+        std::vector<std::size_t> freeShapes;
+
+        std::size_t numVertices;
+        std::size_t numIndices;
+        std::size_t numFreeVertices;
+        std::size_t numFreeIndices;
+        std::size_t numTextureBytes;
+        std::size_t numFreeTextureBytes;
 
 	private:
 		CLWContext context_;
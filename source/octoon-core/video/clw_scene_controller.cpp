@@ -1,4 +1,5 @@
 #include "clw_scene_controller.h"
+#include <octoon/video/render_journal.h>
 #include <octoon/camera/film_camera.h>
 #include <octoon/camera/perspective_camera.h>
 #include <octoon/camera/ortho_camera.h>
@@ -6,6 +7,7 @@
 #include <octoon/light/spot_light.h>
 #include <octoon/light/directional_light.h>
 #include <octoon/light/environment_light.h>
+#include <cstring>
 #include <set>
 
 namespace octoon
@@ -103,17 +105,32 @@ namespace octoon
 		return texture ? collector.GetItemIndex(texture.get()) : (-1);
 	}
 
+	template<typename T>
+	static void ReserveBuffer(const CLWContext& context, CLWBuffer<T>& buffer, std::size_t used, std::size_t required)
+	{
+		if (required > buffer.GetElementCount())
+		{
+			auto resized = context.CreateBuffer<T>(std::max(required, buffer.GetElementCount() * 3 / 2), CL_MEM_READ_ONLY);
+			if (used > 0)
+				context.CopyBuffer(0, buffer, resized, 0, 0, used).Wait();
+
+			buffer = resized;
+		}
+	}
+
 	ClwSceneController::ClwSceneController(const CLWContext& context, const std::shared_ptr<RadeonRays::IntersectionApi>& api, const CLProgramManager* program_manager)
 		: context_(context)
 		, api_(api)
 		, programManager_(program_manager)
+		, collectedScene_(nullptr)
+		, attachedScene_(nullptr)
+		, collectedGeneration_(0)
 	{
 		auto acc_type = "fatbvh";
 		auto builder_type = "sah";
 
-#ifdef ENABLE_RAYMASK
+		// Two level BVHs are refitted when only transforms change instead of being rebuilt.
 		api_->SetOption("bvh.force2level", 1.f);
-#endif
 
 		api_->SetOption("acc.type", acc_type);
 		api_->SetOption("bvh.builder", builder_type);
@@ -126,7 +143,13 @@ namespace octoon
 		for (auto it = sceneCache_.begin(); it != sceneCache_.end();)
 		{
 			if ((*it).first.use_count() == 1)
+			{
+				if (attachedScene_ == (*it).second.get())
+					attachedScene_ = nullptr;
+
+				this->releaseShapes(*(*it).second);
 				it = sceneCache_.erase(it);
+			}
 			else
 				++it;
 		}
@@ -134,6 +157,114 @@ namespace octoon
 
 	void
 	ClwSceneController::compileScene(const std::shared_ptr<ScriptableRenderContext>& context, const std::shared_ptr<RenderScene>& scene) noexcept
+	{
+		bool should_collect = collectedScene_ != scene.get() || collectedGeneration_ != scene->getGeneration();
+		bool should_update_lights = false;
+		bool should_update_shapes = false;
+
+		std::vector<Material*> dirty_materials;
+
+		for (auto& object : RenderJournal::getRenderObjects())
+		{
+			if (!object->isDirty())
+				continue;
+
+			if (object->isA<Light>())
+			{
+				should_update_lights = true;
+				should_collect |= object->isA<EnvironmentLight>();
+			}
+			else if (object->isA<Geometry>())
+			{
+				should_update_shapes = true;
+				should_collect = true;
+			}
+		}
+
+		for (auto& material : RenderJournal::getMaterials())
+		{
+			if (material->isDirty())
+			{
+				dirty_materials.push_back(material);
+				should_collect = true;
+			}
+		}
+
+		for (auto& mesh : RenderJournal::getMeshes())
+			should_update_shapes |= mesh->isDirty();
+
+		if (should_collect)
+		{
+			this->collectResources(scene);
+
+			collectedScene_ = scene.get();
+			collectedGeneration_ = scene->getGeneration();
+		}
+
+		auto iter = sceneCache_.find(scene);
+		if (iter == sceneCache_.cend())
+		{
+			auto clwscene = std::make_unique<ClwScene>(this->context_);
+			clwscene->dirty = true;
+			clwscene->generation = scene->getGeneration();
+			this->updateCamera(scene, *clwscene);
+			this->updateTextures(scene, *clwscene);
+			this->updateMaterials(scene, *clwscene);
+			this->attachShapes(*clwscene);
+			this->updateShapes(scene, *clwscene);
+			this->updateLights(scene, *clwscene);
+			sceneCache_[scene] = std::move(clwscene);
+		}
+		else
+		{
+			auto& out = (*iter).second;
+
+			bool should_update_textures = !out->texture_bundle || (should_collect && textureCollector.NeedsUpdate(out->texture_bundle.get(),
+				[](runtime::RttiInterface* ptr)->bool
+			{
+				return false;
+			}));
+
+			bool should_update_materials = !out->material_bundle || (should_collect && materialCollector.NeedsUpdate(out->material_bundle.get(),
+				[](runtime::RttiInterface* ptr)->bool
+				{
+					return false;
+				}));
+
+			should_update_shapes |= should_update_materials | should_update_textures | (out->generation != scene->getGeneration());
+			out->generation = scene->getGeneration();
+
+			auto camera = scene->getMainCamera();
+			if (camera->isDirty())
+				this->updateCamera(scene, *out);
+
+			if (should_update_textures)
+				this->updateTextures(scene, *out);
+
+			// Texture indices only move when the set of textures changes, edits of a single
+			// material are patched in place together with the shapes that copy it.
+			if (should_update_materials | should_update_textures)
+				this->updateMaterials(scene, *out);
+			else
+			{
+				for (auto& material : dirty_materials)
+					this->updateMaterial(material, *out);
+			}
+
+			if (should_update_lights | should_update_textures)
+				this->updateLights(scene, *out);
+
+			this->attachShapes(*out);
+
+			if (should_update_shapes)
+				this->updateShapes(scene, *out);
+
+			out->dirty = camera->isDirty() | should_update_textures | should_update_materials | !dirty_materials.empty() | should_update_lights | should_update_shapes;
+		}
+	}
+
+	void
+	ClwSceneController::collectResources(const std::shared_ptr<RenderScene>& scene) noexcept
 	{
 		textureCollector.Clear();
 		materialCollector.Clear();
@@ -198,87 +329,6 @@ namespace octoon
 
 		textureCollector.Commit();
 		materialCollector.Commit();
-
-		auto iter = sceneCache_.find(scene);
-		if (iter == sceneCache_.cend())
-		{
-			auto clwscene = std::make_unique<ClwScene>(this->context_);
-			clwscene->dirty = true;
-			this->updateCamera(scene, *clwscene);
-			this->updateTextures(scene, *clwscene);
-			this->updateMaterials(scene, *clwscene);
-			this->updateShapes(scene, *clwscene);
-			this->updateLights(scene, *clwscene);
-			sceneCache_[scene] = std::move(clwscene);
-		}
-		else
-		{
-			auto& out = (*iter).second;
-
-			bool should_update_textures = !out->texture_bundle || textureCollector.NeedsUpdate(out->texture_bundle.get(),
-				[](runtime::RttiInterface* ptr)->bool
-			{
-				return false;
-			});
-
-			bool should_update_materials = !out->material_bundle || materialCollector.NeedsUpdate(out->material_bundle.get(),
-				[](runtime::RttiInterface* ptr)->bool
-				{
-					auto mat = ptr->downcast<Material>();
-					return mat->isDirty();
-				});
-
-			bool should_update_lights = false;
-			for (auto& light : scene->getLights())
-			{
-				if (light->isDirty())
-				{
-					should_update_lights = true;
-					break;
-				}
-			}
-
-			bool should_update_shapes = should_update_materials;
-			if (!should_update_shapes)
-			{
-				std::size_t num_geometries = 0;
-
-				for (auto& geometry : scene->getGeometries())
-				{
-					if (!geometry->getVisible() || !geometry->getGlobalIllumination()) {
-						continue;
-					}
-
-					num_geometries++;
-
-					if (geometry->isDirty())
-					{
-						should_update_shapes = true;
-						break;
-					}
-				}
-
-				should_update_shapes |= (num_geometries != out->numGeometries);
-			}
-
-			auto camera = scene->getMainCamera();
-			if (camera->isDirty())
-				this->updateCamera(scene, *out);
-
-			if (should_update_textures)
-				this->updateTextures(scene, *out);
-
-			if (should_update_materials | should_update_textures)
-				this->updateMaterials(scene, *out);
-
-			if (should_update_lights | should_update_textures)
-				this->updateLights(scene, *out);
-
-			if (should_update_shapes | should_update_textures)
-				this->updateShapes(scene, *out);
-
-			out->dirty = camera->isDirty() | should_update_textures | should_update_materials | should_update_lights | should_update_shapes;
-		}
 	}
 
 	CompiledScene&
@@ -424,45 +474,78 @@ namespace octoon
 	{
 		out.texture_bundle.reset(textureCollector.CreateBundle());
 
+		std::set<const void*> textures;
+		std::unique_ptr<Iterator> tex_iter(textureCollector.CreateIterator());
+		for (; tex_iter->IsValid(); tex_iter->Next())
+			textures.insert(tex_iter->Item());
+
+		for (auto it = out.textureRanges.begin(); it != out.textureRanges.end();)
+		{
+			if (it->second.texture.expired() || textures.find(it->first) == textures.end())
+			{
+				out.numFreeTextureBytes += it->second.size;
+				it = out.textureRanges.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		if (out.numFreeTextureBytes > out.numTextureBytes / 2)
+		{
+			out.textureRanges.clear();
+			out.numTextureBytes = 0;
+			out.numFreeTextureBytes = 0;
+		}
+
 		auto numTextures = textureCollector.GetNumItems();
 		if (numTextures > 0)
 		{
-			std::size_t numTexturesWritten = 0;
-			std::size_t numTexDataBufferSize = 0;
-
 			if (numTextures > out.textures.GetElementCount())
 				out.textures = context_.CreateBuffer<ClwScene::Texture>(numTextures, CL_MEM_READ_ONLY);
 
-			ClwScene::Texture* textures;
-			context_.MapBuffer(0, out.textures, CL_MAP_WRITE, &textures).Wait();
+			std::size_t numBytesUsed = out.numTextureBytes;
+			std::vector<hal::GraphicsTexture*> uploads;
+
+			ClwScene::Texture* data = nullptr;
+			context_.MapBuffer(0, out.textures, CL_MAP_WRITE, &data).Wait();
 
-			std::unique_ptr<Iterator> tex_iter(textureCollector.CreateIterator());
-			for (; tex_iter->IsValid(); tex_iter->Next())
+			std::size_t numTexturesWritten = 0;
+			for (tex_iter->Reset(); tex_iter->IsValid(); tex_iter->Next())
 			{
 				auto tex = tex_iter->ItemAs<hal::GraphicsTexture>();
-				this->WriteTexture(*tex, numTexDataBufferSize, textures + numTexturesWritten);
 
-				numTexturesWritten++;
-				numTexDataBufferSize += GetTextureSize(tex->getTextureDesc());
-			}
+				auto range = out.textureRanges.find(tex);
+				if (range == out.textureRanges.end())
+				{
+					ClwScene::TextureRange textureRange;
+					textureRange.texture = tex->shared_from_this();
+					textureRange.offset = out.numTextureBytes;
+					textureRange.size = GetTextureSize(tex->getTextureDesc());
 
-			context_.UnmapBuffer(0, out.textures, textures);
+					range = out.textureRanges.emplace(tex, textureRange).first;
+					out.numTextureBytes += textureRange.size;
 
-			if (numTexDataBufferSize > out.texturedata.GetElementCount())
-				out.texturedata = context_.CreateBuffer<char>(numTexDataBufferSize, CL_MEM_READ_ONLY);
+					uploads.push_back(tex);
+				}
 
-			char* data = nullptr;
-			context_.MapBuffer(0, out.texturedata, CL_MAP_WRITE, &data).Wait();
+				this->WriteTexture(*tex, range->second.offset, data + numTexturesWritten++);
+			}
 
-			std::size_t numBytesWritten = 0;
-			for (tex_iter->Reset(); tex_iter->IsValid(); tex_iter->Next())
+			context_.UnmapBuffer(0, out.textures, data);
+
+			ReserveBuffer(context_, out.texturedata, numBytesUsed, out.numTextureBytes);
+
+			for (auto& tex : uploads)
 			{
-				auto tex = tex_iter->ItemAs<hal::GraphicsTexture>();
-				this->WriteTextureData(*tex, data + numBytesWritten);
-				numBytesWritten += GetTextureSize(tex->getTextureDesc());
-			}
+				auto& range = out.textureRanges[tex];
 
-			context_.UnmapBuffer(0, out.texturedata, data);
+				char* bytes = nullptr;
+				context_.MapBuffer(0, out.texturedata, CL_MAP_WRITE, range.offset, range.size, &bytes).Wait();
+				this->WriteTextureData(*tex, bytes);
+				context_.UnmapBuffer(0, out.texturedata, bytes);
+			}
 		}
 	}
 
@@ -577,6 +660,46 @@ namespace octoon
 		out.numLights = static_cast<int>(numLightsWritten);
 	}
 
+	void
+	ClwSceneController::WriteMaterial(const MeshStandardMaterial& mat, void* data) const
+	{
+		auto& material = *reinterpret_cast<ClwScene::Material*>(data);
+		material.offset = 0;
+		material.shadow = mat.getReceiveShadow();
+		material.flags = ClwScene::BxdfFlags::kBxdfFlagsDiffuse | ClwScene::BxdfFlags::kBxdfFlagsBrdf;
+		material.disney.base_color = RadeonRays::float3(mat.getColor().x, mat.getColor().y, mat.getColor().z);
+		material.disney.base_color_map_idx = GetTextureIndex(textureCollector, mat.getColorMap());
+		material.disney.opacity = mat.getOpacity();
+		material.disney.opacity_map_idx = GetTextureIndex(textureCollector, mat.getOpacityMap());
+		material.disney.normal_map_idx = GetTextureIndex(textureCollector, mat.getNormalMap());
+		material.disney.roughness = 1 - mat.getSmoothness();
+		material.disney.roughness_map_idx = GetTextureIndex(textureCollector, mat.getRoughnessMap());
+		material.disney.metallic = mat.getMetalness();
+		material.disney.metallic_map_idx = GetTextureIndex(textureCollector, mat.getMetalnessMap());
+		material.disney.anisotropy = mat.getAnisotropy();
+		material.disney.anisotropy_map_idx = GetTextureIndex(textureCollector, mat.getAnisotropyMap());
+		material.disney.specular = mat.getSpecular();
+		material.disney.specular_map_idx = GetTextureIndex(textureCollector, mat.getSpecularMap());
+		material.disney.specular_tint = 0;
+		material.disney.specular_tint_map_idx = -1;
+		material.disney.sheen = mat.getSheen();
+		material.disney.sheen_map_idx = GetTextureIndex(textureCollector, mat.getSheenMap());
+		material.disney.sheen_tint = 0;
+		material.disney.sheen_tint_map_idx = -1;
+		material.disney.clearcoat = mat.getClearCoat();
+		material.disney.clearcoat_map_idx = GetTextureIndex(textureCollector, mat.getClearCoatMap());
+		material.disney.clearcoat_roughness = mat.getClearCoatRoughness();
+		material.disney.clearcoat_roughness_map_idx = GetTextureIndex(textureCollector, mat.getClearCoatRoughnessMap());
+		material.disney.subsurface = mat.getSubsurface();
+		material.disney.subsurface_map_idx = GetTextureIndex(textureCollector, mat.getSubsurfaceMap());
+		material.disney.subsurface_color = RadeonRays::float3(mat.getSubsurfaceColor().x, mat.getSubsurfaceColor().y, mat.getSubsurfaceColor().z);
+		material.disney.subsurface_color_map_idx = GetTextureIndex(textureCollector, mat.getSubsurfaceColorMap());
+		material.disney.emissive = RadeonRays::float3(mat.getEmissive().x, mat.getEmissive().y, mat.getEmissive().z) * mat.getEmissiveIntensity();
+		material.disney.emissive_map_idx = GetTextureIndex(textureCollector, mat.getEmissiveMap());
+		material.disney.refraction_ior = mat.getRefractionRatio();
+		material.disney.transmission = mat.getTransmission();
+	}
+
 	void
 	ClwSceneController::updateMaterials(const std::shared_ptr<RenderScene>& scene, ClwScene& out)
 	{
@@ -594,129 +717,216 @@ namespace octoon
 		for (std::size_t i = 0; mat_iter->IsValid(); mat_iter->Next(), i++)
 		{
 			auto mat = mat_iter->ItemAs<MeshStandardMaterial>();
-
-			auto& material = materials[i];
-			material.offset = 0;
-			material.shadow = mat->getReceiveShadow();
-			material.flags = ClwScene::BxdfFlags::kBxdfFlagsDiffuse | ClwScene::BxdfFlags::kBxdfFlagsBrdf;
-			material.disney.base_color = RadeonRays::float3(mat->getColor().x, mat->getColor().y, mat->getColor().z);
-			material.disney.base_color_map_idx = GetTextureIndex(textureCollector, mat->getColorMap());
-			material.disney.opacity = mat->getOpacity();
-			material.disney.opacity_map_idx = GetTextureIndex(textureCollector, mat->getOpacityMap());
-			material.disney.normal_map_idx = GetTextureIndex(textureCollector, mat->getNormalMap());
-			material.disney.roughness = 1 - mat->getSmoothness();
-			material.disney.roughness_map_idx = GetTextureIndex(textureCollector, mat->getRoughnessMap());
-			material.disney.metallic = mat->getMetalness();
-			material.disney.metallic_map_idx = GetTextureIndex(textureCollector, mat->getMetalnessMap());
-			material.disney.anisotropy = mat->getAnisotropy();
-			material.disney.anisotropy_map_idx = GetTextureIndex(textureCollector, mat->getAnisotropyMap());
-			material.disney.specular = mat->getSpecular();
-			material.disney.specular_map_idx = GetTextureIndex(textureCollector, mat->getSpecularMap());
-			material.disney.specular_tint = 0;
-			material.disney.specular_tint_map_idx = -1;
-			material.disney.sheen = mat->getSheen();
-			material.disney.sheen_map_idx = GetTextureIndex(textureCollector, mat->getSheenMap());
-			material.disney.sheen_tint = 0;
-			material.disney.sheen_tint_map_idx = -1;
-			material.disney.clearcoat = mat->getClearCoat();
-			material.disney.clearcoat_map_idx = GetTextureIndex(textureCollector, mat->getClearCoatMap());
-			material.disney.clearcoat_roughness = mat->getClearCoatRoughness();
-			material.disney.clearcoat_roughness_map_idx = GetTextureIndex(textureCollector, mat->getClearCoatRoughnessMap());
-			material.disney.subsurface = mat->getSubsurface();
-			material.disney.subsurface_map_idx = GetTextureIndex(textureCollector, mat->getSubsurfaceMap());
-			material.disney.subsurface_color = RadeonRays::float3(mat->getSubsurfaceColor().x, mat->getSubsurfaceColor().y, mat->getSubsurfaceColor().z);
-			material.disney.subsurface_color_map_idx = GetTextureIndex(textureCollector, mat->getSubsurfaceColorMap());
-			material.disney.emissive = RadeonRays::float3(mat->getEmissive().x, mat->getEmissive().y, mat->getEmissive().z) * mat->getEmissiveIntensity();
-			material.disney.emissive_map_idx = GetTextureIndex(textureCollector, mat->getEmissiveMap());
-			material.disney.refraction_ior = mat->getRefractionRatio();
-			material.disney.transmission = mat->getTransmission();
-
-			this->materialidToOffset_[mat] = material;
+			this->WriteMaterial(*mat, materials + i);
+			this->materialidToOffset_[mat] = materials[i];
 		}
 
 		context_.UnmapBuffer(0, out.materials, materials);
 	}
 
-    void
-    ClwSceneController::updateIntersector(const std::shared_ptr<RenderScene>& scene, ClwScene& out) const
-    {
-		api_->DetachAll();
+	void
+	ClwSceneController::updateMaterial(Material* material, ClwScene& out)
+	{
+		auto it = this->materialidToOffset_.find(material);
+		if (it == this->materialidToOffset_.end() || !material->isInstanceOf<MeshStandardMaterial>())
+			return;
 
-		for (auto& shape : out.isectShapes)
-			api_->DeleteShape(shape);
+		auto mat = material->downcast<MeshStandardMaterial>();
+		auto index = materialCollector.GetItemIndex(mat);
 
-		out.isectShapes.clear();
-		out.visibleShapes.clear();
+		this->WriteMaterial(*mat, &it->second);
+		context_.WriteBuffer(0, out.materials, &it->second, index, 1).Wait();
 
-		int id = 1;
-		for (auto& geometry : scene->getGeometries())
+		std::size_t first = out.shapeRecords.size();
+		std::size_t last = 0;
+
+		for (std::size_t i = 0; i < out.shapeRecords.size(); i++)
 		{
-			if (!geometry->getVisible() || !geometry->getGlobalIllumination()) {
-				continue;
+			if (out.shapeRecords[i].isect && out.shapeRecords[i].material == material)
+			{
+				out.shapeData[i].material = it->second;
+				first = std::min(first, i);
+				last = std::max(last, i + 1);
 			}
+		}
 
-			auto& mesh = geometry->getMesh();
-			if (!mesh)
-				continue;
+		this->writeShapes(out, first, last);
+	}
+
+	const ClwScene::MeshRange&
+	ClwSceneController::updateMesh(const std::shared_ptr<Mesh>& mesh, ClwScene& out) const
+	{
+		auto& vertexArray = mesh->getVertexArray();
+		auto& normalArray = mesh->getNormalArray();
+		auto& texcoordArray = mesh->getTexcoordArray();
+
+		std::size_t numIndices = 0;
+		for (std::size_t i = 0; i < mesh->getNumSubsets(); i++)
+			numIndices += mesh->getIndicesArray(i).size();
+
+		auto it = out.meshRanges.find(mesh.get());
+		if (it != out.meshRanges.end())
+		{
+			if (!it->second.mesh.expired() && it->second.generation == mesh->getGeneration())
+				return it->second;
+
+			// Deformed meshes such as skinned ones keep their sizes, so their range is rewritten in place.
+			if (it->second.mesh.expired() || it->second.numvtx != vertexArray.size() || it->second.numidx != numIndices)
+			{
+				out.numFreeVertices += it->second.numvtx;
+				out.numFreeIndices += it->second.numidx;
+				out.meshRanges.erase(it);
+				it = out.meshRanges.end();
+			}
+		}
+
+		if (it == out.meshRanges.end())
+		{
+			ClwScene::MeshRange range;
+			range.startvtx = out.numVertices;
+			range.numvtx = vertexArray.size();
+			range.startidx = out.numIndices;
+			range.numidx = numIndices;
+
+			ReserveBuffer(context_, out.vertices, out.numVertices, out.numVertices + range.numvtx);
+			ReserveBuffer(context_, out.normals, out.numVertices, out.numVertices + range.numvtx);
+			ReserveBuffer(context_, out.uvs, out.numVertices, out.numVertices + range.numvtx);
+			ReserveBuffer(context_, out.indices, out.numIndices, out.numIndices + range.numidx);
+
+			out.numVertices += range.numvtx;
+			out.numIndices += range.numidx;
+
+			it = out.meshRanges.emplace(mesh.get(), std::move(range)).first;
+		}
+
+		auto& range = it->second;
+		range.mesh = mesh;
+		range.generation = mesh->getGeneration();
+		range.subsets.clear();
+
+		for (std::size_t i = 0, offset = range.startidx; i < mesh->getNumSubsets(); i++)
+		{
+			range.subsets.push_back(offset);
+			offset += mesh->getIndicesArray(i).size();
+		}
+
+		if (range.numvtx > 0)
+		{
+			math::float4* vertices = nullptr;
+			math::float4* normals = nullptr;
+			math::float2* uvs = nullptr;
+
+			context_.MapBuffer(0, out.vertices, CL_MAP_WRITE, range.startvtx, range.numvtx, &vertices);
+			context_.MapBuffer(0, out.normals, CL_MAP_WRITE, range.startvtx, range.numvtx, &normals);
+			context_.MapBuffer(0, out.uvs, CL_MAP_WRITE, range.startvtx, range.numvtx, &uvs).Wait();
+
+			for (std::size_t i = 0; i < range.numvtx; i++)
+			{
+				vertices[i].set(vertexArray[i]);
+				normals[i].set(i < normalArray.size() ? normalArray[i] : math::float3::Zero);
+			}
+
+			std::copy(texcoordArray.begin(), texcoordArray.begin() + std::min(texcoordArray.size(), range.numvtx), uvs);
+
+			context_.UnmapBuffer(0, out.vertices, vertices);
+			context_.UnmapBuffer(0, out.normals, normals);
+			context_.UnmapBuffer(0, out.uvs, uvs);
+		}
+
+		if (range.numidx > 0)
+		{
+			std::int32_t* indices = nullptr;
+			context_.MapBuffer(0, out.indices, CL_MAP_WRITE, range.startidx, range.numidx, &indices).Wait();
 
 			for (std::size_t i = 0; i < mesh->getNumSubsets(); i++)
 			{
-				auto material = this->getMaterialIndex(geometry->getMaterial(i));
-				if (!material)
-					continue;
+				auto& indicesArray = mesh->getIndicesArray(i);
+				std::copy(indicesArray.begin(), indicesArray.end(), indices + (range.subsets[i] - range.startidx));
+			}
+
+			context_.UnmapBuffer(0, out.indices, indices).Wait();
+		}
 
-				auto shape = this->api_->CreateMesh(
-					(float*)mesh->getVertexArray().data(),
-					static_cast<int>(mesh->getVertexArray().size()),
-					sizeof(math::float3),
-					reinterpret_cast<int const*>(mesh->getIndicesArray(i).data()),
-					0,
-					nullptr,
-					static_cast<int>(mesh->getIndicesArray(i).size() / 3)
-				);
-
-				auto transform = geometry->getTransform();
-				auto transformInverse = geometry->getTransformInverse();
-
-				RadeonRays::matrix m(
-					transform.a1, transform.b1, transform.c1, transform.d1,
-					transform.a2, transform.b2, transform.c2, transform.d2,
-					transform.a3, transform.b3, transform.c3, transform.d3,
-					transform.a4, transform.b4, transform.c4, transform.d4);
-
-				RadeonRays::matrix minv(
-					transformInverse.a1, transformInverse.b1, transformInverse.c1, transformInverse.d1,
-					transformInverse.a2, transformInverse.b2, transformInverse.c2, transformInverse.d2,
-					transformInverse.a3, transformInverse.b3, transformInverse.c3, transformInverse.d3,
-					transformInverse.a4, transformInverse.b4, transformInverse.c4, transformInverse.d4);
-
-				shape->SetId(id++);
-				shape->SetTransform(m, minv);
-
-				this->api_->AttachShape(shape);
-
-				out.isectShapes.push_back(shape);
-				out.visibleShapes.push_back(shape);
+		return range;
+	}
+
+	void
+	ClwSceneController::attachShapes(ClwScene& out)
+	{
+		if (attachedScene_ == &out)
+			return;
+
+		api_->DetachAll();
+
+		for (auto& record : out.shapeRecords)
+		{
+			if (record.isect)
+				api_->AttachShape(record.isect);
+		}
+
+		if (out.freeShapes.size() < out.shapeRecords.size())
+			api_->Commit();
+
+		attachedScene_ = &out;
+	}
+
+	void
+	ClwSceneController::releaseShapes(ClwScene& out) const
+	{
+		for (auto& record : out.shapeRecords)
+		{
+			if (record.isect)
+			{
+				api_->DetachShape(record.isect);
+				api_->DeleteShape(record.isect);
 			}
 		}
 
-		if (!out.isectShapes.empty())
-			this->api_->Commit();
+		out.shapeData.clear();
+		out.shapeRecords.clear();
+		out.freeShapes.clear();
+		out.meshRanges.clear();
+		out.numVertices = 0;
+		out.numIndices = 0;
+		out.numFreeVertices = 0;
+		out.numFreeIndices = 0;
+	}
+
+	void
+	ClwSceneController::writeShapes(ClwScene& out, std::size_t first, std::size_t last) const
+	{
+		if (out.shapeData.size() > out.shapes.GetElementCount())
+		{
+			auto capacity = std::max(out.shapeData.size(), out.shapes.GetElementCount() * 3 / 2);
+			out.shapes = context_.CreateBuffer<ClwScene::Shape>(capacity, CL_MEM_READ_ONLY);
+			out.shapesAdditional = context_.CreateBuffer<ClwScene::ShapeAdditionalData>(capacity, CL_MEM_READ_ONLY);
+
+			first = 0;
+			last = out.shapeData.size();
+		}
+
+		if (first < last)
+			context_.WriteBuffer(0, out.shapes, out.shapeData.data() + first, first, last - first).Wait();
 	}
 
 	void
 	ClwSceneController::updateShapes(const std::shared_ptr<RenderScene>& scene, ClwScene& out) const
 	{
-		std::size_t num_vertices = 0;
-		std::size_t num_indices = 0;
-		std::size_t num_shapes = 0;
-		std::size_t num_geometries = 0;
+		if (out.numFreeVertices > out.numVertices / 2 || out.numFreeIndices > out.numIndices / 2)
+			this->releaseShapes(out);
 
-		std::size_t num_vertices_written = 0;
-		std::size_t num_normals_written = 0;
-		std::size_t num_uvs_written = 0;
-		std::size_t num_indices_written = 0;
-		std::size_t num_shapes_written = 0;
+		std::map<std::pair<const Geometry*, std::size_t>, std::size_t> slots;
+		for (std::size_t i = 0; i < out.shapeRecords.size(); i++)
+		{
+			if (out.shapeRecords[i].isect)
+				slots[std::make_pair(out.shapeRecords[i].geometry, out.shapeRecords[i].subset)] = i;
+		}
+
+		std::vector<bool> visited(out.shapeRecords.size(), false);
+		std::size_t first = out.shapeRecords.size();
+		std::size_t last = 0;
+		std::size_t num_geometries = 0;
+		bool should_commit = false;
 
 		for (auto& geometry : scene->getGeometries())
 		{
@@ -725,122 +935,165 @@ namespace octoon
 			}
 
 			auto& mesh = geometry->getMesh();
-			if (mesh)
-			{
-				num_vertices += mesh->getVertexArray().size();
-				num_geometries++;
-
-				for (std::size_t i = 0; i < mesh->getNumSubsets(); i++)
-				{
-					num_indices += mesh->getIndicesArray(i).size();
-					num_shapes++;
-				}
+			if (!mesh) {
+				continue;
 			}
-		}
 
-		if (num_vertices > out.vertices.GetElementCount())
-			out.vertices = context_.CreateBuffer<math::float4>(num_vertices, CL_MEM_READ_ONLY);
-		if (num_vertices > out.normals.GetElementCount())
-			out.normals = context_.CreateBuffer<math::float4>(num_vertices, CL_MEM_READ_ONLY);
-		if (num_vertices > out.uvs.GetElementCount())
-			out.uvs = context_.CreateBuffer<math::float2>(num_vertices, CL_MEM_READ_ONLY);
-		if (num_indices > out.indices.GetElementCount())
-			out.indices = context_.CreateBuffer<int>(num_indices, CL_MEM_READ_ONLY);
+			num_geometries++;
 
-		if (num_shapes > 0)
-		{
-			out.shapes = context_.CreateBuffer<ClwScene::Shape>(num_shapes, CL_MEM_READ_ONLY);
-			out.shapesAdditional = context_.CreateBuffer<ClwScene::ShapeAdditionalData>(num_shapes, CL_MEM_READ_ONLY);
+			auto& transform = geometry->getTransform();
+			auto& transformInverse = geometry->getTransformInverse();
 
-			math::float4* vertices = nullptr;
-			math::float4* normals = nullptr;
-			math::float2* uvs = nullptr;
-			std::int32_t* indices = nullptr;
-			ClwScene::Shape* shapes = nullptr;
-			ClwScene::ShapeAdditionalData* shapesAdditional = nullptr;
-
-			context_.MapBuffer(0, out.vertices, CL_MAP_WRITE, &vertices);
-			context_.MapBuffer(0, out.normals, CL_MAP_WRITE, &normals);
-			context_.MapBuffer(0, out.uvs, CL_MAP_WRITE, &uvs);
-			context_.MapBuffer(0, out.indices, CL_MAP_WRITE, &indices);
-			context_.MapBuffer(0, out.shapes, CL_MAP_WRITE, &shapes).Wait();
-			context_.MapBuffer(0, out.shapesAdditional, CL_MAP_WRITE, &shapesAdditional).Wait();
-
-			int id = 1;
-
-			for (auto& geometry : scene->getGeometries())
+			for (std::size_t i = 0; i < mesh->getNumSubsets(); i++)
 			{
-				if (!geometry->getVisible() || !geometry->getGlobalIllumination()) {
-					continue;
-				}
-
-				auto& mesh = geometry->getMesh();
-				if (!mesh) {
+				auto material = this->getMaterialIndex(geometry->getMaterial(i));
+				if (!material)
 					continue;
-				}
-
-				auto mesh_vertex_array = mesh->getVertexArray().data();
-				auto mesh_num_vertices = mesh->getVertexArray().size();
 
-				auto mesh_normal_array = mesh->getNormalArray().data();
-				auto mesh_num_normals = mesh->getNormalArray().size();
+				auto& range = this->updateMesh(mesh, out);
 
-				auto mesh_uv_array = mesh->getTexcoordArray().data();
-				auto mesh_num_uvs = mesh->getTexcoordArray().size();
+				std::size_t slot;
+				auto it = slots.find(std::make_pair(geometry, i));
+				if (it != slots.end())
+				{
+					slot = it->second;
 
-				for (auto i = 0; i < mesh_num_vertices; i++)
+					auto& record = out.shapeRecords[slot];
+					if (record.mesh != mesh.get() || record.generation != range.generation)
+					{
+						api_->DetachShape(record.isect);
+						api_->DeleteShape(record.isect);
+						record.isect = nullptr;
+					}
+				}
+				else if (!out.freeShapes.empty())
 				{
-					vertices[num_vertices_written + i].set(mesh_vertex_array[i]);
-					normals[num_normals_written + i].set(mesh_normal_array[i]);
+					slot = out.freeShapes.back();
+					out.freeShapes.pop_back();
+				}
+				else
+				{
+					slot = out.shapeRecords.size();
+					out.shapeRecords.emplace_back();
+					out.shapeRecords.back().isect = nullptr;
+					out.shapeData.emplace_back();
+					visited.push_back(false);
 				}
 
-				std::copy(mesh_uv_array, mesh_uv_array + mesh_num_uvs, uvs + num_uvs_written);
-
-				for (std::size_t i = 0; i < mesh->getNumSubsets(); i++)
+				visited[slot] = true;
+
+				auto& record = out.shapeRecords[slot];
+				record.geometry = geometry;
+				record.material = geometry->getMaterial(i).get();
+
+				ClwScene::Shape shape;
+				std::memset(&shape, 0, sizeof(shape));
+				shape.id = static_cast<int>(slot + 1);
+				shape.startvtx = static_cast<int>(range.startvtx);
+				shape.startidx = static_cast<int>(range.subsets[i]);
+				shape.transform.m0 = { transform.a1, transform.b1, transform.c1, transform.d1 };
+				shape.transform.m1 = { transform.a2, transform.b2, transform.c2, transform.d2 };
+				shape.transform.m2 = { transform.a3, transform.b3, transform.c3, transform.d3 };
+				shape.transform.m3 = { transform.a4, transform.b4, transform.c4, transform.d4 };
+				shape.linearvelocity = float3(0.0f, 0.f, 0.f);
+				shape.angularvelocity = float3(0.f, 0.f, 0.f, 1.f);
+				shape.material = material.value();
+				shape.volume_idx = 0;
+
+				bool transformChanged = std::memcmp(&shape.transform, &out.shapeData[slot].transform, sizeof(shape.transform)) != 0;
+
+				if (!record.isect)
 				{
-					auto material = this->getMaterialIndex(geometry->getMaterial(i));
-					if (!material)
-						continue;
+					record.isect = this->api_->CreateMesh(
+						(float*)mesh->getVertexArray().data(),
+						static_cast<int>(mesh->getVertexArray().size()),
+						sizeof(math::float3),
+						reinterpret_cast<int const*>(mesh->getIndicesArray(i).data()),
+						0,
+						nullptr,
+						static_cast<int>(mesh->getIndicesArray(i).size() / 3)
+					);
+
+					record.mesh = mesh.get();
+					record.generation = range.generation;
+					record.subset = i;
+					record.isect->SetId(shape.id);
+
+					this->api_->AttachShape(record.isect);
+
+					transformChanged = true;
+				}
 
-					ClwScene::Shape shape;
-					shape.id = id++;
-					shape.startvtx = static_cast<int>(num_vertices_written);
-					shape.startidx = static_cast<int>(num_indices_written);
+				if (transformChanged)
+				{
+					RadeonRays::matrix m(
+						transform.a1, transform.b1, transform.c1, transform.d1,
+						transform.a2, transform.b2, transform.c2, transform.d2,
+						transform.a3, transform.b3, transform.c3, transform.d3,
+						transform.a4, transform.b4, transform.c4, transform.d4);
+
+					RadeonRays::matrix minv(
+						transformInverse.a1, transformInverse.b1, transformInverse.c1, transformInverse.d1,
+						transformInverse.a2, transformInverse.b2, transformInverse.c2, transformInverse.d2,
+						transformInverse.a3, transformInverse.b3, transformInverse.c3, transformInverse.d3,
+						transformInverse.a4, transformInverse.b4, transformInverse.c4, transformInverse.d4);
+
+					record.isect->SetTransform(m, minv);
+					should_commit = true;
+				}
 
-					auto transform = geometry->getTransform();
-					shape.transform.m0 = { transform.a1, transform.b1, transform.c1, transform.d1 };
-					shape.transform.m1 = { transform.a2, transform.b2, transform.c2, transform.d2 };
-					shape.transform.m2 = { transform.a3, transform.b3, transform.c3, transform.d3 };
-					shape.transform.m3 = { transform.a4, transform.b4, transform.c4, transform.d4 };
+				if (std::memcmp(&shape, &out.shapeData[slot], sizeof(shape)) != 0)
+				{
+					out.shapeData[slot] = shape;
+					first = std::min(first, slot);
+					last = std::max(last, slot + 1);
+				}
+			}
+		}
 
-					shape.linearvelocity = float3(0.0f, 0.f, 0.f);
-					shape.angularvelocity = float3(0.f, 0.f, 0.f, 1.f);
-					shape.material = material.value();
-					shape.volume_idx = 0;
+		for (std::size_t i = 0; i < out.shapeRecords.size(); i++)
+		{
+			auto& record = out.shapeRecords[i];
+			if (record.isect && !visited[i])
+			{
+				api_->DetachShape(record.isect);
+				api_->DeleteShape(record.isect);
 
-					auto mesh_index_array = mesh->getIndicesArray(i).data();
-					auto mesh_num_indices = mesh->getIndicesArray(i).size();
+				record.isect = nullptr;
+				record.geometry = nullptr;
+				record.mesh = nullptr;
+				record.material = nullptr;
 
-					std::copy(mesh_index_array, mesh_index_array + mesh_num_indices, indices + num_indices_written);
-					num_indices_written += mesh_num_indices;
+				out.freeShapes.push_back(i);
+				should_commit = true;
+			}
+		}
 
-					shapes[num_shapes_written++] = shape;
-				}
+		std::set<const Mesh*> meshes;
+		for (auto& record : out.shapeRecords)
+		{
+			if (record.isect)
+				meshes.insert(record.mesh);
+		}
 
-				num_vertices_written += mesh_num_vertices;
-				num_normals_written += mesh_num_normals;
-				num_uvs_written += mesh_num_uvs;
+		for (auto it = out.meshRanges.begin(); it != out.meshRanges.end();)
+		{
+			if (meshes.find(it->first) == meshes.end())
+			{
+				out.numFreeVertices += it->second.numvtx;
+				out.numFreeIndices += it->second.numidx;
+				it = out.meshRanges.erase(it);
+			}
+			else
+			{
+				++it;
 			}
-
-			context_.UnmapBuffer(0, out.vertices, vertices);
-			context_.UnmapBuffer(0, out.normals, normals);
-			context_.UnmapBuffer(0, out.uvs, uvs);
-			context_.UnmapBuffer(0, out.indices, indices);
-			context_.UnmapBuffer(0, out.shapes, shapes).Wait();
-			context_.UnmapBuffer(0, out.shapesAdditional, shapesAdditional).Wait();
 		}
 
-		this->updateIntersector(scene, out);
+		this->writeShapes(out, first, last);
+
+		if (should_commit && out.freeShapes.size() < out.shapeRecords.size())
+			this->api_->Commit();
 
 		out.numGeometries = static_cast<int>(num_geometries);
 	}
@@ -24,14 +24,22 @@ namespace octoon
 		CompiledScene& getCachedScene(const std::shared_ptr<RenderScene>& scene) const noexcept(false);
 
 	private:
+		void collectResources(const std::shared_ptr<RenderScene>& scene) noexcept;
+
 		void updateCamera(const std::shared_ptr<RenderScene>& scene, ClwScene& out) const;
 		void updateTextures(const std::shared_ptr<RenderScene>& scene, ClwScene& out);
 		void updateMaterials(const std::shared_ptr<RenderScene>& scene, ClwScene& out);
+		void updateMaterial(Material* material, ClwScene& out);
 		void updateShapes(const std::shared_ptr<RenderScene>& scene, ClwScene& out) const;
-		void updateIntersector(const std::shared_ptr<RenderScene>& scene, ClwScene& out) const;
 		void updateLights(const std::shared_ptr<RenderScene>& scene, ClwScene& out);
 
+		const ClwScene::MeshRange& updateMesh(const std::shared_ptr<Mesh>& mesh, ClwScene& out) const;
+		void attachShapes(ClwScene& out);
+		void releaseShapes(ClwScene& out) const;
+		void writeShapes(ClwScene& out, std::size_t first, std::size_t last) const;
+
 		void WriteLight(const std::shared_ptr<RenderScene>& scene, Light const& light, void* data) const;
+		void WriteMaterial(const MeshStandardMaterial& material, void* data) const;
 		void WriteTexture(const hal::GraphicsTexture& texture, std::size_t data_offset, void* data) const;
 		void WriteTextureData(hal::GraphicsTexture& texture, void* data) const;
 
@@ -47,6 +55,10 @@ namespace octoon
 
 		Collector textureCollector;
 		Collector materialCollector;
+
+		const RenderScene* collectedScene_;
+		const ClwScene* attachedScene_;
+		std::uint64_t collectedGeneration_;
 	};
 }
 
@@ -156,10 +156,21 @@ namespace octoon
 	void
 	ForwardRenderer::render(const std::shared_ptr<ScriptableRenderContext>& context, const RenderingData& renderingData)
 	{
+		context->beginSample("ShadowCasterPass");
 		lightsShadowCasterPass_->Execute(*context, renderingData);
+		context->endSample();
+
+		context->beginSample("DrawOpaquePass");
 		drawOpaquePass_->Execute(*context, renderingData);
+		context->endSample();
+
+		context->beginSample("DrawTransparentPass");
 		drawTranparentPass_->Execute(*context, renderingData);
+		context->endSample();
+
+		context->beginSample("DrawSkyboxPass");
 		drawSkyboxPass_->Execute(*context, renderingData);
+		context->endSample();
 
 		auto& camera = renderingData.camera;
 
@@ -169,6 +180,7 @@ namespace octoon
 			auto vp = camera->getPixelViewport();
 			auto viewport = math::float4((float)vp.x, (float)vp.y, (float)vp.width, (float)vp.height);
 
+			context->beginSample("BlitPass");
 			context->configureTarget(nullptr);
 			context->configureClear(hal::GraphicsClearFlagBits::AllBit, math::float4::Zero, 1.0f, 0);
 
@@ -191,6 +203,8 @@ namespace octoon
 					context->discardFramebuffer(fbo, hal::GraphicsClearFlagBits::AllBit);
 				}
 			}
+
+			context->endSample();
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include <octoon/video/light_clusters.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace octoon
+{
+	static_assert(sizeof(RenderingData::PointLight) == 64, "PointLight must match the std140 layout of the PointLights block");
+	static_assert(sizeof(RenderingData::SpotLight) == 80, "SpotLight must match the std140 layout of the SpotLights block");
+
+	LightClusters::LightClusters() noexcept
+		: znear_(0.0f)
+		, zfar_(0.0f)
+		, forward_(1.0f)
+		, numDropped_(0)
+		, numPromoted_(0)
+	{
+		std::memset(&grid_, 0, sizeof(grid_));
+		counts_[0].resize(NUM_CLUSTERS);
+		counts_[1].resize(NUM_CLUSTERS);
+	}
+
+	void
+	LightClusters::build(const math::float4x4& projection, const math::float4x4& projectionInverse, float znear, float zfar, const std::vector<RenderingData::PointLight>& pointLights, const std::vector<RenderingData::SpotLight>& spotLights) noexcept
+	{
+		this->updateBounds(projection, projectionInverse, znear, zfar);
+
+		links_.clear();
+
+		for (std::uint32_t type = 0; type < 2; type++)
+		{
+			std::fill(counts_[type].begin(), counts_[type].end(), 0);
+			globals_[type].clear();
+			numLinks_[type].assign(MAX_LIGHTS, 0);
+		}
+
+		auto numPoint = std::min<std::size_t>(pointLights.size(), MAX_LIGHTS);
+		for (std::size_t i = 0; i < numPoint; i++)
+			this->assign(pointLights[i].position, pointLights[i].distance, (std::uint32_t)i, 0);
+
+		auto numSpot = std::min<std::size_t>(spotLights.size(), MAX_LIGHTS);
+		for (std::size_t i = 0; i < numSpot; i++)
+			this->assign(spotLights[i].position, spotLights[i].distance, (std::uint32_t)i, 1);
+
+		// The light blocks hold MAX_LIGHTS entries, lights past them cannot reach the shader.
+		auto numDropped = (pointLights.size() - numPoint) + (spotLights.size() - numSpot);
+		if (numDropped != numDropped_)
+		{
+			if (numDropped > 0)
+				std::cerr << "LightClusters: " << numDropped << " point or spot lights exceed the limit of " << MAX_LIGHTS << " per type and are not rendered." << std::endl;
+			numDropped_ = numDropped;
+		}
+
+		// When the links do not fit in the index list, the lights covering the most clusters are
+		// shaded everywhere instead, which costs time but never loses a light.
+		std::size_t total = links_.size() + globals_[0].size() + globals_[1].size();
+		std::size_t numPromoted = 0;
+
+		while (total > MAX_INDICES)
+		{
+			std::uint32_t type = 0;
+			std::uint32_t light = 0;
+
+			for (std::uint32_t t = 0; t < 2; t++)
+			{
+				for (std::uint32_t i = 0; i < MAX_LIGHTS; i++)
+				{
+					if (numLinks_[t][i] > numLinks_[type][light])
+					{
+						type = t;
+						light = i;
+					}
+				}
+			}
+
+			if (numLinks_[type][light] <= 1)
+				break;
+
+			total -= numLinks_[type][light] - 1;
+			numLinks_[type][light] = 0;
+			globals_[type].push_back(light);
+			numPromoted++;
+		}
+
+		if (numPromoted != numPromoted_)
+		{
+			if (numPromoted > 0)
+				std::cerr << "LightClusters: the index list is full, " << numPromoted << " lights are shaded in every cluster." << std::endl;
+			numPromoted_ = numPromoted;
+		}
+
+		for (auto link : links_)
+		{
+			auto light = (link >> 16) & 0xFF;
+			auto type = link >> 24;
+
+			if (numLinks_[type][light] > 0)
+				counts_[type][link & 0xFFFF]++;
+		}
+
+		// Global lights lead the index list, points then spots, followed by a counting sort
+		// of the links by cluster with point lights first.
+		auto numGlobals = (std::uint32_t)(globals_[0].size() + globals_[1].size());
+
+		grid_.params.z = float(globals_[0].size());
+		grid_.params.w = float(globals_[1].size());
+
+		std::uint32_t offset = numGlobals;
+
+		for (std::uint32_t i = 0; i < NUM_CLUSTERS; i++)
+		{
+			auto point = counts_[0][i];
+			auto spot = counts_[1][i];
+
+			grid_.records[i] = offset | (point << 16) | (spot << 24);
+
+			counts_[0][i] = offset;
+			counts_[1][i] = offset + point;
+
+			offset += point + spot;
+		}
+
+		indices_.resize(offset);
+
+		std::copy(globals_[0].begin(), globals_[0].end(), indices_.begin());
+		std::copy(globals_[1].begin(), globals_[1].end(), indices_.begin() + globals_[0].size());
+
+		for (auto link : links_)
+		{
+			auto light = (link >> 16) & 0xFF;
+			auto type = link >> 24;
+
+			if (numLinks_[type][light] > 0)
+				indices_[counts_[type][link & 0xFFFF]++] = (std::uint8_t)light;
+		}
+	}
+
+	const LightClusters::Grid&
+	LightClusters::getGrid() const noexcept
+	{
+		return grid_;
+	}
+
+	const std::uint8_t*
+	LightClusters::getIndices() const noexcept
+	{
+		return indices_.data();
+	}
+
+	std::size_t
+	LightClusters::getNumIndices() const noexcept
+	{
+		return indices_.size();
+	}
+
+	void
+	LightClusters::updateBounds(const math::float4x4& projection, const math::float4x4& projectionInverse, float znear, float zfar) noexcept
+	{
+		znear = std::max(znear, 1e-3f);
+		zfar = std::max(zfar, znear * 1.001f);
+
+		if (!bounds_.empty() && znear_ == znear && zfar_ == zfar && std::memcmp(&projection_, &projection, sizeof(projection)) == 0)
+			return;
+
+		projection_ = projection;
+		znear_ = znear;
+		zfar_ = zfar;
+
+		// Depth is measured along whichever direction the projection looks down.
+		auto origin = projectionInverse * math::float3(0.0f, 0.0f, 0.0f);
+		auto target = projectionInverse * math::float3(0.0f, 0.0f, 1.0f);
+		forward_ = target.z >= origin.z ? 1.0f : -1.0f;
+
+		auto scale = SLICES / std::log(zfar / znear);
+		grid_.params = math::float4(scale, -std::log(znear) * scale, 0.0f, 0.0f);
+
+		float depths[SLICES + 1];
+		for (std::uint32_t i = 0; i <= SLICES; i++)
+			depths[i] = znear * std::pow(zfar / znear, float(i) / SLICES);
+
+		bounds_.resize(NUM_CLUSTERS);
+
+		for (std::uint32_t y = 0; y < TILES_Y; y++)
+		{
+			for (std::uint32_t x = 0; x < TILES_X; x++)
+			{
+				math::float3 nears[4];
+				math::float3 fars[4];
+
+				for (std::uint32_t i = 0; i < 4; i++)
+				{
+					auto ndcX = float(x + (i & 1)) / TILES_X * 2.0f - 1.0f;
+					auto ndcY = float(y + (i >> 1)) / TILES_Y * 2.0f - 1.0f;
+					nears[i] = projectionInverse * math::float3(ndcX, ndcY, 0.0f);
+					fars[i] = projectionInverse * math::float3(ndcX, ndcY, 1.0f);
+				}
+
+				for (std::uint32_t z = 0; z < SLICES; z++)
+				{
+					auto& bound = bounds_[(z * TILES_Y + y) * TILES_X + x];
+					bound.min = math::float3(FLT_MAX);
+					bound.max = math::float3(-FLT_MAX);
+
+					for (std::uint32_t i = 0; i < 4; i++)
+					{
+						for (auto depth : { depths[z], depths[z + 1] })
+						{
+							auto t = (depth * forward_ - nears[i].z) / (fars[i].z - nears[i].z);
+							auto point = nears[i] + (fars[i] - nears[i]) * t;
+							bound.min = math::min(bound.min, point);
+							bound.max = math::max(bound.max, point);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void
+	LightClusters::assign(const math::float3& position, float radius, std::uint32_t light, std::uint32_t type) noexcept
+	{
+		auto link = (light << 16) | (type << 24);
+
+		if (radius <= 0.0f)
+		{
+			globals_[type].push_back(light);
+			return;
+		}
+
+		auto depth = position.z * forward_;
+		if (depth + radius < znear_ || depth - radius > zfar_)
+			return;
+
+		auto slice = [this](float depth)
+		{
+			auto z = std::log(depth) * grid_.params.x + grid_.params.y;
+			return (std::uint32_t)std::clamp<std::int32_t>((std::int32_t)z, 0, SLICES - 1);
+		};
+
+		std::uint32_t z0 = slice(std::max(depth - radius, znear_));
+		std::uint32_t z1 = slice(std::min(depth + radius, zfar_));
+		std::uint32_t x0 = 0, x1 = TILES_X - 1;
+		std::uint32_t y0 = 0, y1 = TILES_Y - 1;
+
+		// A sphere crossing the near plane can cover any tile, otherwise its projected box bounds the tiles.
+		if (depth - radius > znear_)
+		{
+			math::float2 min(FLT_MAX);
+			math::float2 max(-FLT_MAX);
+
+			for (std::uint32_t i = 0; i < 8; i++)
+			{
+				auto corner = position + math::float3(i & 1 ? radius : -radius, i & 2 ? radius : -radius, i & 4 ? radius : -radius);
+				auto ndc = projection_ * corner;
+				min = math::min(min, ndc.xy());
+				max = math::max(max, ndc.xy());
+			}
+
+			if (max.x < -1.0f || min.x > 1.0f || max.y < -1.0f || min.y > 1.0f)
+				return;
+
+			x0 = (std::uint32_t)std::clamp<std::int32_t>((std::int32_t)std::floor((min.x * 0.5f + 0.5f) * TILES_X), 0, TILES_X - 1);
+			x1 = (std::uint32_t)std::clamp<std::int32_t>((std::int32_t)std::floor((max.x * 0.5f + 0.5f) * TILES_X), 0, TILES_X - 1);
+			y0 = (std::uint32_t)std::clamp<std::int32_t>((std::int32_t)std::floor((min.y * 0.5f + 0.5f) * TILES_Y), 0, TILES_Y - 1);
+			y1 = (std::uint32_t)std::clamp<std::int32_t>((std::int32_t)std::floor((max.y * 0.5f + 0.5f) * TILES_Y), 0, TILES_Y - 1);
+		}
+
+		auto radius2 = radius * radius;
+
+		for (auto z = z0; z <= z1; z++)
+		{
+			for (auto y = y0; y <= y1; y++)
+			{
+				for (auto x = x0; x <= x1; x++)
+				{
+					auto cluster = (z * TILES_Y + y) * TILES_X + x;
+					auto& bound = bounds_[cluster];
+
+					auto closest = math::clamp(position, bound.min, bound.max);
+					if (math::length2(position - closest) > radius2)
+						continue;
+
+					links_.push_back(link | cluster);
+					numLinks_[type][light]++;
+				}
+			}
+		}
+	}
+}
@@ -1,11 +1,22 @@
 #include <octoon/video/lights_shadow_caster_pass.h>
+#include <octoon/video/rendering_data.h>
+#include <octoon/video/render_journal.h>
 #include <octoon/light/point_light.h>
 #include <octoon/light/spot_light.h>
 #include <octoon/light/directional_light.h>
 #include <octoon/hal/graphics_framebuffer.h>
+#include <octoon/hal/graphics_texture.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace octoon
 {
+	LightsShadowCasterPass::LightsShadowCasterPass() noexcept
+		: generation_(std::numeric_limits<std::uint64_t>::max())
+	{
+	}
+
 	void
 	LightsShadowCasterPass::Execute(ScriptableRenderContext& context, const RenderingData& renderingData) noexcept(false)
 	{
@@ -14,55 +25,302 @@ namespace octoon
 			if (!light->getVisible())
 				continue;
 
-			std::uint32_t faceCount = 0;
 			std::shared_ptr<Camera> camera;
+			views_.clear();
 
 			if (light->isA<DirectionalLight>())
 			{
 				auto directionalLight = light->cast<DirectionalLight>();
 				if (directionalLight->getShadowEnable())
 				{
-					faceCount = 1;
 					camera = directionalLight->getCamera();
+
+					for (auto& shadow : renderingData.directionalShadowCascades)
+					{
+						if (shadow.light != light)
+							continue;
+
+						for (std::uint32_t i = 0; i < shadow.numCascades; i++)
+							views_.push_back(ShadowView{ shadow.cascades[i].viewProjection, shadow.cascades[i].viewport, nullptr, &shadow.cascades[i] });
+					}
 				}
 			}
 			else if (light->isA<SpotLight>())
 			{
 				auto spotLight = light->cast<SpotLight>();
 				if (spotLight->getShadowEnable())
-				{
-					faceCount = 1;
 					camera = spotLight->getCamera();
-				}
 			}
 			else if (light->isA<PointLight>())
 			{
+				// The point light camera renders a single face, drawing it six times gave the same map.
 				auto pointLight = light->cast<PointLight>();
 				if (pointLight->getShadowEnable())
-				{
-					faceCount = 6;
 					camera = pointLight->getCamera();
-				}
 			}
 
-			for (std::uint32_t face = 0; face < faceCount; face++)
+			if (!camera || !camera->getFramebuffer())
+				continue;
+
+			if (views_.empty())
 			{
-				auto framebuffer = camera->getFramebuffer();
-				if (framebuffer)
-				{
-					context.configureTarget(framebuffer);
-					context.configureClear(camera->getClearFlags(), camera->getClearColor(), 1.0f, 0);
-					context.drawRenderers(renderingData.geometries, *camera, renderingData.depthMaterial);
+				auto& desc = camera->getFramebuffer()->getFramebufferDesc();
+				views_.push_back(ShadowView{ camera->getViewProjection(), math::float4(0.0f, 0.0f, float(desc.getWidth()), float(desc.getHeight())), camera.get(), nullptr });
+			}
 
-					if (camera->getRenderToScreen())
-					{
-						auto& v = camera->getPixelViewport();
-						context.blitFramebuffer(framebuffer, v, nullptr, v);
-					}
+			this->renderShadow(context, renderingData, *light, *camera, views_);
+		}
 
-					context.discardFramebuffer(framebuffer, hal::GraphicsClearFlagBits::DepthStencilBit);
-				}
+		for (auto it = caches_.begin(); it != caches_.end();)
+		{
+			if (std::find(renderingData.lights.begin(), renderingData.lights.end(), it->first) == renderingData.lights.end())
+				it = caches_.erase(it);
+			else
+				++it;
+		}
+
+		generation_ = RenderJournal::getGeneration();
+	}
+
+	void
+	LightsShadowCasterPass::renderShadow(ScriptableRenderContext& context, const RenderingData& renderingData, const Light& light, const Camera& camera, const std::vector<ShadowView>& views) noexcept
+	{
+		auto& target = camera.getFramebuffer();
+
+		cascadeCamera_.setLayer(camera.getLayer());
+		cascadeCamera_.setTransform(light.getTransform(), light.getTransformInverse());
+
+		auto less = [](const ShadowCaster& a, const ShadowCaster& b) { return a.view != b.view ? a.view < b.view : a.geometry < b.geometry; };
+		auto same = [](const ShadowCaster& a, const ShadowCaster& b) { return a.view == b.view && a.geometry == b.geometry && a.generation == b.generation && a.meshGeneration == b.meshGeneration; };
+
+		casters_.clear();
+
+		for (std::uint32_t i = 0; i < views.size(); i++)
+		{
+			for (auto& geometry : renderingData.geometries)
+			{
+				if (!geometry->getVisible() || geometry->getLayer() != camera.getLayer())
+					continue;
+
+				if (!intersects(views[i], light, *geometry))
+					continue;
+
+				auto& mesh = geometry->getMesh();
+				casters_.push_back(ShadowCaster{ i, geometry, geometry->getGeneration(), mesh ? mesh->getGeneration() : 0 });
+			}
+		}
+
+		std::sort(casters_.begin(), casters_.end(), less);
+
+		auto& cache = caches_[&light];
+
+		bool valid = cache.framebuffer && cache.target == target && cache.views.size() == views.size();
+		for (std::size_t i = 0; valid && i < views.size(); i++)
+			valid = std::memcmp(&cache.views[i], &views[i].viewProjection, sizeof(math::float4x4)) == 0;
+
+		std::size_t matched = 0;
+		std::vector<ShadowCaster> dynamics;
+
+		for (auto& caster : casters_)
+		{
+			auto it = std::lower_bound(cache.statics.begin(), cache.statics.end(), caster, less);
+			if (valid && it != cache.statics.end() && same(*it, caster))
+				matched++;
+			else
+				dynamics.push_back(caster);
+		}
+
+		valid &= matched == cache.statics.size();
+
+		auto unchanged = std::equal(dynamics.begin(), dynamics.end(), cache.dynamics.begin(), cache.dynamics.end(), same);
+		if (valid && unchanged)
+			return;
+
+		// Casters that stood still since the last frame but are not part of the cached depth yet
+		// are worth caching as soon as something else moves.
+		auto moved = [this](const ShadowCaster& caster) { return std::max(caster.generation, caster.meshGeneration) > generation_; };
+		if (valid && !std::all_of(dynamics.begin(), dynamics.end(), moved))
+			valid = false;
+
+		auto& desc = target->getFramebufferDesc();
+		auto viewport = math::float4(0.0f, 0.0f, float(desc.getWidth()), float(desc.getHeight()));
+
+		if (!valid)
+		{
+			cache.target = target;
+			cache.views.resize(views.size());
+			for (std::size_t i = 0; i < views.size(); i++)
+				cache.views[i] = views[i].viewProjection;
+
+			cache.statics.clear();
+			dynamics.clear();
+
+			for (auto& caster : casters_)
+			{
+				if (moved(caster))
+					dynamics.push_back(caster);
+				else
+					cache.statics.push_back(caster);
+			}
+
+			if (this->setupCache(context, cache, target))
+			{
+				context.configureTarget(cache.framebuffer);
+				context.configureClear(camera.getClearFlags(), camera.getClearColor(), 1.0f, 0);
+				this->drawCasters(context, renderingData, views, cache.statics);
+			}
+			else
+			{
+				cache.statics.clear();
+				dynamics = casters_;
 			}
 		}
+
+		if (cache.framebuffer)
+		{
+			context.blitFramebuffer(cache.framebuffer, viewport, target, viewport, hal::GraphicsClearFlagBits::ColorBit | hal::GraphicsClearFlagBits::DepthBit);
+			context.configureTarget(target);
+		}
+		else
+		{
+			context.configureTarget(target);
+			context.configureClear(camera.getClearFlags(), camera.getClearColor(), 1.0f, 0);
+		}
+
+		this->drawCasters(context, renderingData, views, dynamics);
+
+		context.setViewport(0, viewport);
+
+		if (camera.getRenderToScreen())
+		{
+			auto& v = camera.getPixelViewport();
+			context.blitFramebuffer(target, v, nullptr, v);
+		}
+
+		context.discardFramebuffer(target, hal::GraphicsClearFlagBits::DepthStencilBit);
+
+		cache.dynamics = std::move(dynamics);
+	}
+
+	void
+	LightsShadowCasterPass::drawCasters(ScriptableRenderContext& context, const RenderingData& renderingData, const std::vector<ShadowView>& views, const std::vector<ShadowCaster>& casters) noexcept
+	{
+		for (auto it = casters.begin(); it != casters.end();)
+		{
+			auto& view = views[it->view];
+
+			geometries_.clear();
+			for (auto first = it->view; it != casters.end() && it->view == first; ++it)
+				geometries_.push_back(it->geometry);
+
+			const Camera* camera = view.camera;
+			if (view.cascade)
+			{
+				cascadeCamera_.setOrtho(view.cascade->ortho);
+				cascadeCamera_.setNear(view.cascade->znear);
+				cascadeCamera_.setFar(view.cascade->zfar);
+				camera = &cascadeCamera_;
+			}
+
+			context.setViewport(0, view.viewport);
+			context.drawRenderers(geometries_, *camera, renderingData.depthMaterial);
+		}
+	}
+
+	bool
+	LightsShadowCasterPass::setupCache(ScriptableRenderContext& context, ShadowCache& cache, const hal::GraphicsFramebufferPtr& target) noexcept
+	{
+		auto& desc = target->getFramebufferDesc();
+
+		if (cache.framebuffer)
+		{
+			auto& cacheDesc = cache.framebuffer->getFramebufferDesc();
+			if (cacheDesc.getWidth() == desc.getWidth() && cacheDesc.getHeight() == desc.getHeight())
+				return true;
+		}
+
+		cache.framebuffer.reset();
+
+		auto colorAttachment = desc.getColorAttachment().getBindingTexture();
+		auto depthAttachment = desc.getDepthStencilAttachment().getBindingTexture();
+		if (!colorAttachment || !depthAttachment)
+			return false;
+
+		auto colorFormat = colorAttachment->getTextureDesc().getTexFormat();
+		auto depthFormat = depthAttachment->getTextureDesc().getTexFormat();
+
+		hal::GraphicsFramebufferLayoutDesc framebufferLayoutDesc;
+		framebufferLayoutDesc.addComponent(hal::GraphicsAttachmentLayout(0, hal::GraphicsImageLayout::ColorAttachmentOptimal, colorFormat));
+		framebufferLayoutDesc.addComponent(hal::GraphicsAttachmentLayout(1, hal::GraphicsImageLayout::DepthStencilAttachmentOptimal, depthFormat));
+
+		hal::GraphicsTextureDesc colorTextureDesc;
+		colorTextureDesc.setWidth(desc.getWidth());
+		colorTextureDesc.setHeight(desc.getHeight());
+		colorTextureDesc.setTexDim(hal::GraphicsTextureDim::Texture2D);
+		colorTextureDesc.setTexFormat(colorFormat);
+		cache.colorTexture = context.createTexture(colorTextureDesc);
+		if (!cache.colorTexture)
+			return false;
+
+		hal::GraphicsTextureDesc depthTextureDesc;
+		depthTextureDesc.setWidth(desc.getWidth());
+		depthTextureDesc.setHeight(desc.getHeight());
+		depthTextureDesc.setTexDim(hal::GraphicsTextureDim::Texture2D);
+		depthTextureDesc.setTexFormat(depthFormat);
+		cache.depthTexture = context.createTexture(depthTextureDesc);
+		if (!cache.depthTexture)
+			return false;
+
+		hal::GraphicsFramebufferDesc framebufferDesc;
+		framebufferDesc.setWidth(desc.getWidth());
+		framebufferDesc.setHeight(desc.getHeight());
+		framebufferDesc.setFramebufferLayout(context.createFramebufferLayout(framebufferLayoutDesc));
+		framebufferDesc.setDepthStencilAttachment(hal::GraphicsAttachmentBinding(cache.depthTexture, 0, 0));
+		framebufferDesc.addColorAttachment(hal::GraphicsAttachmentBinding(cache.colorTexture, 0, 0));
+
+		cache.framebuffer = context.createFramebuffer(framebufferDesc);
+		return cache.framebuffer != nullptr;
+	}
+
+	bool
+	LightsShadowCasterPass::intersects(const ShadowView& view, const Light& light, const Geometry& geometry) noexcept
+	{
+		auto& bound = geometry.getBoundingBox();
+		if (bound.empty())
+			return true;
+
+		auto& box = bound.box();
+		auto& transform = geometry.getTransform();
+
+		// Point and spot lights with a range only reach casters inside their sphere.
+		if (!light.isA<DirectionalLight>() && light.getRange() > 0.0f)
+		{
+			auto world = math::transform(box, transform);
+			auto closest = math::clamp(light.getTranslate(), world.min, world.max);
+			if (math::length2(closest - light.getTranslate()) > light.getRange() * light.getRange())
+				return false;
+		}
+
+		// The box is culled when all of its corners are outside the same clip plane.
+		auto matrix = view.viewProjection * transform;
+		std::uint32_t outside = 0x3F;
+
+		for (std::uint32_t i = 0; i < 8 && outside; i++)
+		{
+			auto corner = math::float3(i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y, i & 4 ? box.max.z : box.min.z);
+			auto clip = matrix * math::float4(corner, 1.0f);
+
+			std::uint32_t mask = 0;
+			if (clip.x < -clip.w) mask |= 0x01;
+			if (clip.x > clip.w) mask |= 0x02;
+			if (clip.y < -clip.w) mask |= 0x04;
+			if (clip.y > clip.w) mask |= 0x08;
+			if (clip.z < -clip.w) mask |= 0x10;
+			if (clip.z > clip.w) mask |= 0x20;
+
+			outside &= mask;
+		}
+
+		return outside == 0;
 	}
-}
\ No newline at end of file
+}
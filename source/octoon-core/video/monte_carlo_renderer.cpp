@@ -3,25 +3,41 @@
 #include "clw_texture_output.h"
 #include "clw_scene.h"
 
+#include <chrono>
+
 namespace octoon
 {
+	// The estimator's random buffer is indexed by pixel, so its work buffer still covers a whole frame.
 	int constexpr kTileSizeX = 2560;
 	int constexpr kTileSizeY = 1440;
+	int constexpr kAdaptiveTileSize = 256;
 
 	MonteCarloRenderer::MonteCarloRenderer(CLWContext context, const CLProgramManager* programManager, std::unique_ptr<PathTracingEstimator> estimator) noexcept
 		: ClwClass(context, programManager, "../../system/Kernels/CL/rtx_renderer.cl", "")
 		, context_(context)
 		, estimator_(std::move(estimator))
 		, sampleCounter_(0)
+		, frameBudget_(0.0f)
+		, convergenceThreshold_(0.0f)
+		, minSamples_(16)
+		, converged_(false)
+		, outputSize_(0, 0)
+		, tileCursor_(0)
+		, tileCost_(0.0)
 	{
 		estimator_->setWorkBufferSize(kTileSizeX * kTileSizeY);
 
+		samples_ = context.CreateBuffer<math::float4>(kAdaptiveTileSize * kAdaptiveTileSize, CL_MEM_READ_WRITE);
+
 		copyKernel_ = getKernel("ApplyGammaAndCopyData");
 		generateKernel_ = getKernel("GenerateTileDomain");
 		perspectiveCameraKernel_ = getKernel("PerspectiveCamera_GeneratePaths");
 		perspectiveCameraDofKernel_ = getKernel("PerspectiveCameraDof_GeneratePaths");
 		orthographicCameraKernel_ = getKernel("OrthographicCamera_GeneratePaths");
 		fillKernel_ = getKernel("FillAOVs");
+		maskedDomainKernel_ = getKernel("GenerateTileDomain_Masked");
+		accumulateKernel_ = getKernel("AccumulateAdaptiveSample");
+		convergenceKernel_ = getKernel("EstimateConvergence");
 	}
 
 	MonteCarloRenderer::~MonteCarloRenderer() noexcept
@@ -40,6 +56,50 @@ namespace octoon
 		return estimator_->getMaxBounces();
 	}
 
+	void
+	MonteCarloRenderer::setFrameBudget(float milliseconds)
+	{
+		frameBudget_ = std::max(milliseconds, 0.0f);
+	}
+
+	float
+	MonteCarloRenderer::getFrameBudget() const
+	{
+		return frameBudget_;
+	}
+
+	void
+	MonteCarloRenderer::setConvergenceThreshold(float threshold)
+	{
+		convergenceThreshold_ = std::max(threshold, 0.0f);
+		converged_ = false;
+	}
+
+	float
+	MonteCarloRenderer::getConvergenceThreshold() const
+	{
+		return convergenceThreshold_;
+	}
+
+	void
+	MonteCarloRenderer::setMinSamples(std::uint32_t samples)
+	{
+		minSamples_ = std::max<std::uint32_t>(samples, 2);
+		converged_ = false;
+	}
+
+	std::uint32_t
+	MonteCarloRenderer::getMinSamples() const
+	{
+		return minSamples_;
+	}
+
+	bool
+	MonteCarloRenderer::isConverged() const
+	{
+		return converged_;
+	}
+
 	void
 	MonteCarloRenderer::clear(const math::float4& val)
 	{
@@ -53,6 +113,15 @@ namespace octoon
 				output->clear(val);
 		}
 
+		if (outputSize_.x > 0 && outputSize_.y > 0)
+		{
+			getContext().FillBuffer(0, moments_, math::float2(0.0f, 0.0f), moments_.GetElementCount());
+			getContext().FillBuffer(0, mask_, 0, mask_.GetElementCount());
+		}
+
+		tiles_.clear();
+		tileCursor_ = 0;
+		converged_ = false;
 		sampleCounter_ = 0;
 	}
 
@@ -62,7 +131,7 @@ namespace octoon
 		assert(includeMultipass || includeSinglepass);
 
 		std::uint32_t start_index = includeMultipass ? 0 : static_cast<std::uint32_t>(OutputType::kMaxMultiPassOutput) + 1;
-		std::uint32_t end_index = includeSinglepass ? static_cast<std::uint32_t>(OutputType::kMax) : static_cast<std::uint32_t>(OutputType::kMaxMultiPassOutput);
+		std::uint32_t end_index = includeSinglepass ? static_cast<std::uint32_t>(OutputType::kMaxSinglePassOutput) : static_cast<std::uint32_t>(OutputType::kMaxMultiPassOutput);
 
 		for (auto i = start_index; i < end_index; ++i)
 		{
@@ -81,25 +150,36 @@ namespace octoon
 		if (output)
 		{
 			auto output_size = math::int2(output->width(), output->height());
-			if (output_size.x > kTileSizeX || output_size.y > kTileSizeY)
+
+			this->prepareAdaptiveData(output_size);
+
+			if (tileCursor_ >= tiles_.size() && !converged_)
+				this->scheduleTiles(output_size);
+
+			if (tileCursor_ < tiles_.size())
 			{
-				auto num_tiles_x = (output_size.x + kTileSizeX - 1) / kTileSizeX;
-				auto num_tiles_y = (output_size.y + kTileSizeY - 1) / kTileSizeY;
+				// Tiles are rendered until the budget is spent, using the cost measured on earlier calls.
+				auto count = tiles_.size() - tileCursor_;
+				if (frameBudget_ > 0.0f && tileCost_ > 0.0)
+					count = std::min(count, std::max<std::size_t>(static_cast<std::size_t>(frameBudget_ / tileCost_), 1));
+
+				auto begin = std::chrono::steady_clock::now();
 
-				for (auto x = 0; x < num_tiles_x; ++x)
+				for (std::size_t i = 0; i < count; ++i, ++tileCursor_)
 				{
-					for (auto y = 0; y < num_tiles_y; ++y)
-					{
-						auto tile_offset = math::int2(x * kTileSizeX, y * kTileSizeY);
-						auto tile_size = math::int2(std::min(kTileSizeX, output_size.x - tile_offset.x), std::min(kTileSizeY, output_size.y - tile_offset.y));
+					auto tile_offset = tiles_[tileCursor_];
+					auto tile_size = math::int2(std::min(kAdaptiveTileSize, output_size.x - tile_offset.x), std::min(kAdaptiveTileSize, output_size.y - tile_offset.y));
 
-						renderTile(scene, tile_offset, tile_size);
-					}
+					renderTile(scene, tile_offset, tile_size);
 				}
-			}
-			else
-			{
-				renderTile(scene, math::int2(), output_size);
+
+				getContext().Finish(0);
+
+				auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / count;
+				tileCost_ = tileCost_ > 0.0 ? tileCost_ * 0.75 + elapsed * 0.25 : elapsed;
+
+				if (tileCursor_ >= tiles_.size())
+					++sampleCounter_;
 			}
 
 			std::uint32_t start_index = 0;
@@ -111,8 +191,6 @@ namespace octoon
 				if (aov)
 					aov->syncData(this->copyKernel_);
 			}
-
-			++sampleCounter_;
 		}
 		else
 		{
@@ -129,10 +207,14 @@ namespace octoon
 			auto numRays = tile_size.x * tile_size.y;
 			auto outputSize = math::int2(colorOutput->width(), colorOutput->height());
 
-			this->generateTileDomain(outputSize, tile_origin, tile_size);
+			this->generateAdaptiveTileDomain(outputSize, tile_origin, tile_size);
 			this->generatePrimaryRays(scene, *colorOutput, tile_size);
 
-			estimator_->estimate(dynamic_cast<const ClwScene&>(scene), numRays, colorOutput->data());
+			// Samples land in a scratch buffer first, so each one can feed the variance estimate.
+			getContext().FillBuffer(0, samples_, math::float4::Zero, numRays);
+			estimator_->estimate(dynamic_cast<const ClwScene&>(scene), numRays, samples_, false);
+
+			this->accumulateSamples(*colorOutput, numRays);
 		}
 
 		bool aov_pass_needed = (this->findFirstNonZeroOutput(false) != nullptr);
@@ -143,6 +225,61 @@ namespace octoon
 		}
 	}
 
+	void
+	MonteCarloRenderer::prepareAdaptiveData(const math::int2& output_size)
+	{
+		if (outputSize_.x != output_size.x || outputSize_.y != output_size.y)
+		{
+			auto num_pixels = static_cast<std::size_t>(output_size.x * output_size.y);
+			auto num_tiles_x = (output_size.x + kAdaptiveTileSize - 1) / kAdaptiveTileSize;
+			auto num_tiles_y = (output_size.y + kAdaptiveTileSize - 1) / kAdaptiveTileSize;
+
+			moments_ = getContext().CreateBuffer<math::float2>(num_pixels, CL_MEM_READ_WRITE);
+			mask_ = getContext().CreateBuffer<int>(num_pixels, CL_MEM_READ_WRITE);
+			tileActive_ = getContext().CreateBuffer<int>(num_tiles_x * num_tiles_y, CL_MEM_READ_WRITE);
+
+			outputSize_ = output_size;
+
+			getContext().FillBuffer(0, moments_, math::float2(0.0f, 0.0f), num_pixels);
+			getContext().FillBuffer(0, mask_, 0, num_pixels);
+
+			tiles_.clear();
+			tileCursor_ = 0;
+			converged_ = false;
+		}
+	}
+
+	void
+	MonteCarloRenderer::scheduleTiles(const math::int2& output_size)
+	{
+		auto num_tiles_x = (output_size.x + kAdaptiveTileSize - 1) / kAdaptiveTileSize;
+		auto num_tiles_y = (output_size.y + kAdaptiveTileSize - 1) / kAdaptiveTileSize;
+
+		std::vector<int> active(num_tiles_x * num_tiles_y, 1);
+
+		if (sampleCounter_ > 0 && getOutput(OutputType::kColor))
+		{
+			this->estimateConvergence(output_size);
+
+			if (convergenceThreshold_ > 0.0f && sampleCounter_ >= minSamples_)
+				getContext().ReadBuffer(0, tileActive_, active.data(), active.size()).Wait();
+		}
+
+		tiles_.clear();
+		tileCursor_ = 0;
+
+		for (auto y = 0; y < num_tiles_y; ++y)
+		{
+			for (auto x = 0; x < num_tiles_x; ++x)
+			{
+				if (active[y * num_tiles_x + x])
+					tiles_.push_back(math::int2(x * kAdaptiveTileSize, y * kAdaptiveTileSize));
+			}
+		}
+
+		converged_ = tiles_.empty();
+	}
+
 	void
 	MonteCarloRenderer::generateTileDomain(const math::int2& output_size, const math::int2& tile_origin, const math::int2& tile_size)
 	{
@@ -166,6 +303,66 @@ namespace octoon
 		getContext().Launch2D(0, gs, ls, generateKernel_);
 	}
 
+	void
+	MonteCarloRenderer::generateAdaptiveTileDomain(const math::int2& output_size, const math::int2& tile_origin, const math::int2& tile_size)
+	{
+		getContext().FillBuffer(0, estimator_->getRayCountBuffer(), 0, 1);
+
+		int argc = 0;
+		maskedDomainKernel_.SetArg(argc++, output_size.x);
+		maskedDomainKernel_.SetArg(argc++, tile_origin.x);
+		maskedDomainKernel_.SetArg(argc++, tile_origin.y);
+		maskedDomainKernel_.SetArg(argc++, tile_size.x);
+		maskedDomainKernel_.SetArg(argc++, tile_size.y);
+		maskedDomainKernel_.SetArg(argc++, mask_);
+		maskedDomainKernel_.SetArg(argc++, estimator_->getOutputIndexBuffer());
+		maskedDomainKernel_.SetArg(argc++, estimator_->getRayCountBuffer());
+
+		int globalsize = tile_size.x * tile_size.y;
+		getContext().Launch1D(0, ((globalsize + 63) / 64) * 64, 64, maskedDomainKernel_);
+	}
+
+	void
+	MonteCarloRenderer::accumulateSamples(const ClwOutput& output, std::size_t num_rays)
+	{
+		int argc = 0;
+		accumulateKernel_.SetArg(argc++, samples_);
+		accumulateKernel_.SetArg(argc++, estimator_->getOutputIndexBuffer());
+		accumulateKernel_.SetArg(argc++, estimator_->getRayCountBuffer());
+		accumulateKernel_.SetArg(argc++, output.data());
+		accumulateKernel_.SetArg(argc++, moments_);
+
+		getContext().Launch1D(0, ((num_rays + 63) / 64) * 64, 64, accumulateKernel_);
+	}
+
+	void
+	MonteCarloRenderer::estimateConvergence(const math::int2& output_size)
+	{
+		auto colorOutput = static_cast<ClwOutput*>(getOutput(OutputType::kColor));
+		auto sampleCountOutput = static_cast<ClwOutput*>(getOutput(OutputType::kSampleCount));
+		auto convergenceOutput = static_cast<ClwOutput*>(getOutput(OutputType::kConvergence));
+
+		getContext().FillBuffer(0, tileActive_, 0, tileActive_.GetElementCount());
+
+		int argc = 0;
+		convergenceKernel_.SetArg(argc++, colorOutput->data());
+		convergenceKernel_.SetArg(argc++, moments_);
+		convergenceKernel_.SetArg(argc++, output_size.x);
+		convergenceKernel_.SetArg(argc++, output_size.y);
+		convergenceKernel_.SetArg(argc++, kAdaptiveTileSize);
+		convergenceKernel_.SetArg(argc++, static_cast<int>(minSamples_));
+		convergenceKernel_.SetArg(argc++, convergenceThreshold_);
+		convergenceKernel_.SetArg(argc++, mask_);
+		convergenceKernel_.SetArg(argc++, tileActive_);
+		convergenceKernel_.SetArg(argc++, sampleCountOutput ? 1 : 0);
+		convergenceKernel_.SetArg(argc++, sampleCountOutput ? sampleCountOutput->data() : samples_);
+		convergenceKernel_.SetArg(argc++, convergenceOutput ? 1 : 0);
+		convergenceKernel_.SetArg(argc++, convergenceOutput ? convergenceOutput->data() : samples_);
+
+		int globalsize = output_size.x * output_size.y;
+		getContext().Launch1D(0, ((globalsize + 63) / 64) * 64, 64, convergenceKernel_);
+	}
+
 	void
 	MonteCarloRenderer::generatePrimaryRays(const CompiledScene& scene, Output const& output, math::int2 const& tile_size, bool generate_at_pixel_center)
 	{
@@ -247,7 +444,7 @@ namespace octoon
 		fillKernel_.SetArg(argc++, estimator_->getRandomBuffer(Estimator::RandomBufferType::kSobolLUT));
 		fillKernel_.SetArg(argc++, sampleCounter_);
 
-		for (auto i = static_cast<std::uint32_t>(OutputType::kMaxMultiPassOutput) + 1; i < static_cast<std::uint32_t>(OutputType::kMax); ++i)
+		for (auto i = static_cast<std::uint32_t>(OutputType::kMaxMultiPassOutput) + 1; i < static_cast<std::uint32_t>(OutputType::kMaxSinglePassOutput); ++i)
 		{
 			if (auto aov = static_cast<ClwOutput*>(getOutput(static_cast<OutputType>(i))))
 			{
@@ -5,6 +5,7 @@
 #include "path_tracing_estimator.h"
 
 #include "clw_class.h"
+#include "clw_output.h"
 #include "cl_program_manager.h"
 
 namespace octoon
@@ -18,6 +19,19 @@ namespace octoon
 		void setMaxBounces(std::uint32_t num_bounces);
 		std::uint32_t getMaxBounces() const;
 
+		// Milliseconds of tiles rendered per call; 0 renders a whole pass per call.
+		void setFrameBudget(float milliseconds);
+		float getFrameBudget() const;
+
+		// Pixels stop sampling once their relative standard error falls below the threshold; 0 disables it.
+		void setConvergenceThreshold(float threshold);
+		float getConvergenceThreshold() const;
+
+		void setMinSamples(std::uint32_t samples);
+		std::uint32_t getMinSamples() const;
+
+		bool isConverged() const;
+
 		void clear(const math::float4& val) override;
 
 		void render(const std::shared_ptr<ScriptableRenderContext>& context, const CompiledScene& scene) override;
@@ -27,6 +41,12 @@ namespace octoon
 		Output* findFirstNonZeroOutput(bool includeMultipass = true, bool includeSinglepass = true) const noexcept;
 
 		void generateTileDomain(const math::int2& output_size, const math::int2& tile_origin, const math::int2& tile_size);
+		void generateAdaptiveTileDomain(const math::int2& output_size, const math::int2& tile_origin, const math::int2& tile_size);
+		void accumulateSamples(const ClwOutput& output, std::size_t num_rays);
+		void estimateConvergence(const math::int2& output_size);
+
+		void prepareAdaptiveData(const math::int2& output_size);
+		void scheduleTiles(const math::int2& output_size);
 		void generatePrimaryRays(const CompiledScene& scene, Output const& output, math::int2 const& tile_size, bool generate_at_pixel_center = false);
 		void fillAOVs(const CompiledScene& scene, math::int2 const& tile_origin, math::int2 const& tile_size);
 
@@ -38,9 +58,27 @@ namespace octoon
 		CLWKernel perspectiveCameraDofKernel_;
 		CLWKernel orthographicCameraKernel_;
 		CLWKernel fillKernel_;
+		CLWKernel maskedDomainKernel_;
+		CLWKernel accumulateKernel_;
+		CLWKernel convergenceKernel_;
 
 		std::uint32_t sampleCounter_;
 		std::unique_ptr<PathTracingEstimator> estimator_;
+
+		float frameBudget_;
+		float convergenceThreshold_;
+		std::uint32_t minSamples_;
+		bool converged_;
+
+		math::int2 outputSize_;
+		std::vector<math::int2> tiles_;
+		std::size_t tileCursor_;
+		double tileCost_;
+
+		CLWBuffer<math::float4> samples_;
+		CLWBuffer<math::float2> moments_;
+		CLWBuffer<int> mask_;
+		CLWBuffer<int> tileActive_;
 	};
 }
 
@@ -26,6 +26,9 @@ namespace octoon
         kBackground,
         kDepth,
         kShapeId,
+        kMaxSinglePassOutput,
+        kSampleCount,
+        kConvergence,
         kMax
     };
 
@@ -0,0 +1,136 @@
+#include <octoon/video/render_journal.h>
+#include <algorithm>
+#include <mutex>
+
+namespace octoon
+{
+	namespace
+	{
+		std::mutex journalMutex_;
+
+		std::uint64_t generation_ = 0;
+		std::uint64_t frameGeneration_ = 0;
+
+		std::vector<Mesh*> meshes_;
+		std::vector<Material*> materials_;
+		std::vector<RenderObject*> objects_;
+
+		template<typename T>
+		std::uint64_t enqueue(std::vector<T*>& queue, T* object, std::uint64_t generation) noexcept
+		{
+			std::lock_guard<std::mutex> lock(journalMutex_);
+
+			if (generation <= frameGeneration_)
+				queue.push_back(object);
+
+			return ++generation_;
+		}
+
+		template<typename T>
+		void dequeue(std::vector<T*>& queue, T* object, std::uint64_t generation) noexcept
+		{
+			std::lock_guard<std::mutex> lock(journalMutex_);
+
+			if (generation > frameGeneration_)
+			{
+				auto it = std::find(queue.begin(), queue.end(), object);
+				if (it != queue.end())
+					queue.erase(it);
+			}
+		}
+
+		template<typename T>
+		std::vector<T*> snapshot(const std::vector<T*>& queue) noexcept
+		{
+			std::lock_guard<std::mutex> lock(journalMutex_);
+			return queue;
+		}
+	}
+
+	std::uint64_t
+	RenderJournal::getGeneration() noexcept
+	{
+		std::lock_guard<std::mutex> lock(journalMutex_);
+		return generation_;
+	}
+
+	std::uint64_t
+	RenderJournal::getFrameGeneration() noexcept
+	{
+		std::lock_guard<std::mutex> lock(journalMutex_);
+		return frameGeneration_;
+	}
+
+	std::uint64_t
+	RenderJournal::record(Mesh* mesh, std::uint64_t generation) noexcept
+	{
+		return enqueue(meshes_, mesh, generation);
+	}
+
+	std::uint64_t
+	RenderJournal::record(Material* material, std::uint64_t generation) noexcept
+	{
+		return enqueue(materials_, material, generation);
+	}
+
+	std::uint64_t
+	RenderJournal::record(RenderObject* object, std::uint64_t generation) noexcept
+	{
+		return enqueue(objects_, object, generation);
+	}
+
+	void
+	RenderJournal::erase(Mesh* mesh, std::uint64_t generation) noexcept
+	{
+		dequeue(meshes_, mesh, generation);
+	}
+
+	void
+	RenderJournal::erase(Material* material, std::uint64_t generation) noexcept
+	{
+		dequeue(materials_, material, generation);
+	}
+
+	void
+	RenderJournal::erase(RenderObject* object, std::uint64_t generation) noexcept
+	{
+		dequeue(objects_, object, generation);
+	}
+
+	std::vector<Mesh*>
+	RenderJournal::getMeshes() noexcept
+	{
+		return snapshot(meshes_);
+	}
+
+	std::vector<Material*>
+	RenderJournal::getMaterials() noexcept
+	{
+		return snapshot(materials_);
+	}
+
+	std::vector<RenderObject*>
+	RenderJournal::getRenderObjects() noexcept
+	{
+		return snapshot(objects_);
+	}
+
+	bool
+	RenderJournal::empty() noexcept
+	{
+		std::lock_guard<std::mutex> lock(journalMutex_);
+		return meshes_.empty() && materials_.empty() && objects_.empty();
+	}
+
+	void
+	RenderJournal::clear() noexcept
+	{
+		std::lock_guard<std::mutex> lock(journalMutex_);
+
+		meshes_.clear();
+		materials_.clear();
+		objects_.clear();
+
+		frameGeneration_ = generation_;
+	}
+}
@@ -1,5 +1,6 @@
 #include <octoon/video/render_object.h>
 #include <octoon/video/render_scene.h>
+#include <octoon/video/render_journal.h>
 
 namespace octoon
 {
@@ -16,6 +17,7 @@ namespace octoon
 	RenderObject::RenderObject() noexcept
 		: visible_(true)
 		, dirty_(true)
+		, generation_(0)
 		, layer_(0)
 		, order_(0)
 		, transform_(math::float4x4::One)
@@ -26,6 +28,7 @@ namespace octoon
 
 	RenderObject::~RenderObject() noexcept
 	{
+		RenderJournal::erase(this, generation_);
 	}
 
 	void
@@ -70,6 +73,9 @@ namespace octoon
 	void
 	RenderObject::setDirty(bool dirty) noexcept
 	{
+		if (dirty)
+			this->generation_ = RenderJournal::record(this, this->generation_);
+
 		this->dirty_ = dirty;
 	}
 
@@ -79,6 +85,12 @@ namespace octoon
 		return this->dirty_;
 	}
 
+	std::uint64_t
+	RenderObject::getGeneration() const noexcept
+	{
+		return this->generation_;
+	}
+
 	void
 	RenderObject::setOwnerListener(RenderListener* listener) noexcept
 	{
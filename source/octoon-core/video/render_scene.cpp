@@ -5,6 +5,7 @@ namespace octoon
 	RenderScene::RenderScene() noexcept
 		: mainCamera_(nullptr)
 		, enableGlobalIllumination_(false)
+		, generation_(0)
 	{
 	}
 
@@ -41,6 +42,7 @@ namespace octoon
 			}
 
 			this->enableGlobalIllumination_ = enable;
+			this->generation_++;
 		}
 	}
 
@@ -57,7 +59,10 @@ namespace octoon
 
 		auto it = std::find(cameras_.begin(), cameras_.end(), camera);
 		if (it == cameras_.end())
+		{
 			cameras_.push_back(camera);
+			this->generation_++;
+		}
 	}
 
 	void
@@ -67,7 +72,10 @@ namespace octoon
 
 		auto it = std::find(cameras_.begin(), cameras_.end(), camera);
 		if (it != cameras_.end())
+		{
 			cameras_.erase(it);
+			this->generation_++;
+		}
 	}
 
 	const std::vector<Camera*>&
@@ -83,7 +91,10 @@ namespace octoon
 
 		auto it = std::find(lights_.begin(), lights_.end(), light);
 		if (it == lights_.end())
+		{
 			lights_.push_back(light);
+			this->generation_++;
+		}
 	}
 
 	void
@@ -93,7 +104,10 @@ namespace octoon
 
 		auto it = std::find(lights_.begin(), lights_.end(), light);
 		if (it != lights_.end())
+		{
 			lights_.erase(it);
+			this->generation_++;
+		}
 	}
 
 	const std::vector<Light*>&
@@ -109,7 +123,10 @@ namespace octoon
 
 		auto it = std::find(renderables_.begin(), renderables_.end(), geometry);
 		if (it == renderables_.end())
+		{
 			renderables_.push_back(geometry);
+			this->generation_++;
+		}
 	}
 
 	void
@@ -119,7 +136,10 @@ namespace octoon
 
 		auto it = std::find(renderables_.begin(), renderables_.end(), geometry);
 		if (it != renderables_.end())
+		{
 			renderables_.erase(it);
+			this->generation_++;
+		}
 	}
 
 	const std::vector<Geometry*>&
@@ -171,4 +191,10 @@ namespace octoon
 			return a->getRenderOrder() < b->getRenderOrder();
 		});
 	}
+
+	std::uint64_t
+	RenderScene::getGeneration() const noexcept
+	{
+		return this->generation_;
+	}
 }
\ No newline at end of file
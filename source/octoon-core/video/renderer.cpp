@@ -1,8 +1,10 @@
 #include <octoon/video/renderer.h>
 #include <octoon/video/render_scene.h>
+#include <octoon/video/render_journal.h>
 #include <octoon/video/forward_renderer.h>
 
 #include <octoon/runtime/except.h>
+#include <octoon/runtime/profiler.h>
 
 #include "rtx_manager.h"
 
@@ -15,6 +17,8 @@ namespace octoon
 		, height_(0)
 		, enableGlobalIllumination_(false)
 		, numBounces_(3)
+		, frameBudget_(0.0f)
+		, convergenceThreshold_(0.0f)
 	{
 	}
 
@@ -73,6 +77,24 @@ namespace octoon
 		return this->rtxManager_->readNormalBuffer(data);
 	}
 
+	bool
+	Renderer::readColorBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return rtxManager_ ? rtxManager_->readColorBufferAsync(format, std::move(callback)) : false;
+	}
+
+	bool
+	Renderer::readAlbedoBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return rtxManager_ ? rtxManager_->readAlbedoBufferAsync(format, std::move(callback)) : false;
+	}
+
+	bool
+	Renderer::readNormalBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return rtxManager_ ? rtxManager_->readNormalBufferAsync(format, std::move(callback)) : false;
+	}
+
 	const hal::GraphicsFramebufferPtr&
 	Renderer::getFramebuffer() const noexcept
 	{
@@ -105,6 +127,42 @@ namespace octoon
 		return numBounces_;
 	}
 
+	void
+	Renderer::setFrameBudget(float milliseconds)
+	{
+		frameBudget_ = milliseconds;
+
+		if (rtxManager_)
+			rtxManager_->setFrameBudget(milliseconds);
+	}
+
+	float
+	Renderer::getFrameBudget() const
+	{
+		return frameBudget_;
+	}
+
+	void
+	Renderer::setConvergenceThreshold(float threshold)
+	{
+		convergenceThreshold_ = threshold;
+
+		if (rtxManager_)
+			rtxManager_->setConvergenceThreshold(threshold);
+	}
+
+	float
+	Renderer::getConvergenceThreshold() const
+	{
+		return convergenceThreshold_;
+	}
+
+	bool
+	Renderer::isConverged() const
+	{
+		return rtxManager_ ? rtxManager_->isConverged() : false;
+	}
+
 	void
 	Renderer::setOverrideMaterial(const std::shared_ptr<Material>& material) noexcept
 	{
@@ -126,6 +184,7 @@ namespace octoon
 	void 
 	Renderer::endFrameRendering(const std::shared_ptr<RenderScene>& scene, const std::vector<Camera*>& camera) noexcept
 	{
+		RenderJournal::clear();
 	}
 
 	void
@@ -195,13 +254,14 @@ namespace octoon
 			{
 				rtxManager_ = std::make_unique<RtxManager>();
 				rtxManager_->setMaxBounces(this->getMaxBounces());
+				rtxManager_->setFrameBudget(this->getFrameBudget());
+				rtxManager_->setConvergenceThreshold(this->getConvergenceThreshold());
 			}
 
 			this->rtxManager_->render(this->context_, scene);
 		}
 		else
 		{
-			context_->cleanCache();
 			context_->compileScene(scene);
 
 			forwardRenderer_->render(this->context_, this->context_->getRenderingData());
@@ -211,13 +271,18 @@ namespace octoon
 	void
 	Renderer::render(const std::shared_ptr<RenderScene>& scene) noexcept(false)
 	{
+		OCTOON_PROFILE_SCOPE("Renderer::render");
+
+		this->context_->resolveSamples();
 		this->beginFrameRendering(scene, scene->getCameras());
 
 		for (auto& camera : scene->getCameras())
 		{
 			this->beginCameraRendering(scene, camera);
 
+			this->context_->beginSample("Camera");
 			this->renderSingleCamera(scene, camera);
+			this->context_->endSample();
 
 			this->endCameraRendering(scene, camera);
 		}
@@ -31,7 +31,9 @@ namespace octoon
 		this->directionalShadows.clear();
 		this->environmentShadows.clear();
 
-		this->directionalShadowMatrix.clear();
+		this->directionalShadowCascades.clear();
+		this->directionalShadowMatrices.clear();
+		this->directionalShadowSplits.clear();
 
 		this->lights.clear();
 	}
@@ -1,4 +1,5 @@
 #include "rtx_manager.h"
+#include <algorithm>
 #include <radeon_rays.h>
 #include <octoon/runtime/except.h>
 #include "monte_carlo_renderer.h"
@@ -33,7 +34,19 @@ namespace octoon
 		: width_(0)
 		, height_(0)
 		, dirty_(true)
+		, readbackQuit_(false)
 	{
+		for (auto& readback : readbacks_)
+		{
+			readback.state = ReadbackState::Free;
+			readback.pbo = GL_NONE;
+			readback.fence = nullptr;
+			readback.size = 0;
+			readback.data = nullptr;
+			readback.width = 0;
+			readback.height = 0;
+		}
+
 		std::vector<CLWPlatform> platforms;
 
 		CLWPlatform::CreateAllPlatforms(platforms);
@@ -150,6 +163,28 @@ namespace octoon
 		}
 	}
 
+	RtxManager::~RtxManager() noexcept
+	{
+		this->pollReadbacks(true);
+
+		if (readbackThread_.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(readbackMutex_);
+				readbackQuit_ = true;
+			}
+
+			readbackWait_.notify_one();
+			readbackThread_.join();
+		}
+
+		for (auto& readback : readbacks_)
+		{
+			if (readback.pbo != GL_NONE)
+				glDeleteBuffers(1, &readback.pbo);
+		}
+	}
+
 	void
 	RtxManager::setRenderScene(RenderScene* scene) noexcept
 	{
@@ -202,6 +237,48 @@ namespace octoon
 		return 0;
 	}
 
+	void
+	RtxManager::setFrameBudget(float milliseconds)
+	{
+		for (auto& it : configs_)
+			dynamic_cast<MonteCarloRenderer*>(it.pipeline.get())->setFrameBudget(milliseconds);
+	}
+
+	float
+	RtxManager::getFrameBudget() const
+	{
+		if (!configs_.empty())
+			return dynamic_cast<MonteCarloRenderer*>(configs_.front().pipeline.get())->getFrameBudget();
+		return 0.0f;
+	}
+
+	void
+	RtxManager::setConvergenceThreshold(float threshold)
+	{
+		for (auto& it : configs_)
+			dynamic_cast<MonteCarloRenderer*>(it.pipeline.get())->setConvergenceThreshold(threshold);
+	}
+
+	float
+	RtxManager::getConvergenceThreshold() const
+	{
+		if (!configs_.empty())
+			return dynamic_cast<MonteCarloRenderer*>(configs_.front().pipeline.get())->getConvergenceThreshold();
+		return 0.0f;
+	}
+
+	bool
+	RtxManager::isConverged() const
+	{
+		for (auto& it : configs_)
+		{
+			if (!dynamic_cast<MonteCarloRenderer*>(it.pipeline.get())->isConverged())
+				return false;
+		}
+
+		return !configs_.empty();
+	}
+
 	void
 	RtxManager::readColorBuffer(math::float3 colorBuffer[])
 	{
@@ -268,6 +345,181 @@ namespace octoon
 		}
 	}
 
+	bool
+	RtxManager::readColorBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return this->readBufferAsync(colorTexture_, format, std::move(callback));
+	}
+
+	bool
+	RtxManager::readAlbedoBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return this->readBufferAsync(albedoTexture_, format, std::move(callback));
+	}
+
+	bool
+	RtxManager::readNormalBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return this->readBufferAsync(normalTexture_, format, std::move(callback));
+	}
+
+	bool
+	RtxManager::readBufferAsync(const hal::GraphicsTexturePtr& texture, hal::GraphicsFormat format, ReadbackCallback&& callback)
+	{
+		if (!texture || !callback)
+			return false;
+
+		GLenum glformat;
+		GLenum gltype;
+		GLsizeiptr pixelSize;
+
+		switch (format)
+		{
+		case hal::GraphicsFormat::R32G32B32SFloat:
+			glformat = GL_RGB; gltype = GL_FLOAT; pixelSize = sizeof(math::float3);
+			break;
+		case hal::GraphicsFormat::R32G32B32A32SFloat:
+			glformat = GL_RGBA; gltype = GL_FLOAT; pixelSize = sizeof(math::float4);
+			break;
+		case hal::GraphicsFormat::R8G8B8UNorm:
+			glformat = GL_RGB; gltype = GL_UNSIGNED_BYTE; pixelSize = 3;
+			break;
+		case hal::GraphicsFormat::R8G8B8A8UNorm:
+			glformat = GL_RGBA; gltype = GL_UNSIGNED_BYTE; pixelSize = 4;
+			break;
+		default:
+			return false;
+		}
+
+		this->pollReadbacks(false);
+
+		auto it = std::find_if(readbacks_.begin(), readbacks_.end(), [](const Readback& readback) { return readback.state == ReadbackState::Free; });
+		if (it == readbacks_.end())
+		{
+			this->pollReadbacks(true);
+			it = readbacks_.begin();
+		}
+
+		if (!readbackThread_.joinable())
+			readbackThread_ = std::thread(&RtxManager::readbackThread, this);
+
+		auto& desc = texture->getTextureDesc();
+		auto& readback = *it;
+
+		if (readback.pbo == GL_NONE)
+			glGenBuffers(1, &readback.pbo);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+
+		auto size = static_cast<GLsizeiptr>(desc.getWidth() * desc.getHeight()) * pixelSize;
+		if (readback.size != size)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+			readback.size = size;
+		}
+
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(texture->handle()));
+		glGetTexImage(GL_TEXTURE_2D, 0, glformat, gltype, nullptr);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		std::lock_guard<std::mutex> lock(readbackMutex_);
+		readback.state = ReadbackState::Pending;
+		readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		readback.width = desc.getWidth();
+		readback.height = desc.getHeight();
+		readback.callback = std::move(callback);
+		readbackOrder_.push_back(std::distance(readbacks_.begin(), it));
+
+		return true;
+	}
+
+	void
+	RtxManager::pollReadbacks(bool wait)
+	{
+		std::unique_lock<std::mutex> lock(readbackMutex_);
+
+		for (auto it = readbackOrder_.begin(); it != readbackOrder_.end();)
+		{
+			auto& readback = readbacks_[*it];
+
+			if (readback.state == ReadbackState::Pending)
+			{
+				GLenum status;
+				do
+				{
+					status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? 1000000 : 0);
+				} while (wait && status == GL_TIMEOUT_EXPIRED);
+
+				// Fences signal in submission order, so the later copies are not done either.
+				if (status == GL_TIMEOUT_EXPIRED)
+					break;
+
+				glDeleteSync(readback.fence);
+				readback.fence = nullptr;
+
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+				readback.data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback.size, GL_MAP_READ_BIT);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+				readback.state = ReadbackState::Mapped;
+				readbackJobs_.push_back(*it);
+				readbackWait_.notify_one();
+			}
+
+			if (readback.state == ReadbackState::Mapped && wait)
+				readbackDone_.wait(lock, [&readback]() { return readback.state == ReadbackState::Done; });
+
+			if (readback.state == ReadbackState::Done)
+			{
+				if (readback.data)
+				{
+					glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+					glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+					glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+				}
+
+				readback.state = ReadbackState::Free;
+				readback.data = nullptr;
+				readback.callback = nullptr;
+
+				it = readbackOrder_.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	void
+	RtxManager::readbackThread() noexcept
+	{
+		std::unique_lock<std::mutex> lock(readbackMutex_);
+
+		for (;;)
+		{
+			readbackWait_.wait(lock, [this]() { return readbackQuit_ || !readbackJobs_.empty(); });
+			if (readbackJobs_.empty())
+				break;
+
+			auto& readback = readbacks_[readbackJobs_.front()];
+			readbackJobs_.pop_front();
+
+			lock.unlock();
+
+			if (readback.data)
+				readback.callback(readback.data, readback.width, readback.height);
+
+			lock.lock();
+
+			readback.state = ReadbackState::Done;
+			readbackDone_.notify_all();
+		}
+	}
+
 	const hal::GraphicsFramebufferPtr&
 	RtxManager::getFramebuffer() const
 	{
@@ -352,6 +604,7 @@ namespace octoon
 	void
 	RtxManager::render(const std::shared_ptr<ScriptableRenderContext>& context, const std::shared_ptr<RenderScene>& scene)
 	{
+		this->pollReadbacks(false);
 		this->prepareScene(context, scene);
 
 		for (auto& c : configs_)
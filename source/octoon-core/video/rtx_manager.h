@@ -1,8 +1,13 @@
 #ifndef OCTOON_VIDEO_RTX_MANAGER_H_
 #define OCTOON_VIDEO_RTX_MANAGER_H_
 
-#include <vector>
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <GL/glew.h>
 
@@ -13,6 +18,7 @@
 #include <octoon/camera/camera.h>
 #include <octoon/hal/graphics.h>
 #include <octoon/video/render_scene.h>
+#include <octoon/video/renderer.h>
 #include <octoon/video/scriptable_render_context.h>
 
 namespace octoon
@@ -36,6 +42,7 @@ namespace octoon
 	{
 	public:
 		RtxManager() noexcept(false);
+		~RtxManager() noexcept;
 
 		void setRenderScene(RenderScene* scene) noexcept;
 		const RenderScene* getRenderScene() const noexcept;
@@ -46,10 +53,22 @@ namespace octoon
 		void setMaxBounces(std::uint32_t num_bounces);
 		std::uint32_t getMaxBounces() const;
 
+		void setFrameBudget(float milliseconds);
+		float getFrameBudget() const;
+
+		void setConvergenceThreshold(float threshold);
+		float getConvergenceThreshold() const;
+
+		bool isConverged() const;
+
 		void readColorBuffer(math::float3 data[]);
 		void readAlbedoBuffer(math::float3 data[]);
 		void readNormalBuffer(math::float3 data[]);
 
+		bool readColorBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+		bool readAlbedoBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+		bool readNormalBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback);
+
 		const hal::GraphicsFramebufferPtr& getFramebuffer() const;
 
 		void render(const std::shared_ptr<ScriptableRenderContext>& context, const std::shared_ptr<RenderScene>& scene);
@@ -58,7 +77,34 @@ namespace octoon
 		void prepareScene(const std::shared_ptr<ScriptableRenderContext>& context, const std::shared_ptr<RenderScene>& scene) noexcept;
 		void generateWorkspace(std::uint32_t width, std::uint32_t height);
 
+		bool readBufferAsync(const hal::GraphicsTexturePtr& texture, hal::GraphicsFormat format, ReadbackCallback&& callback);
+		void pollReadbacks(bool wait);
+		void readbackThread() noexcept;
+
 	private:
+		enum class ReadbackState
+		{
+			Free,
+			Pending,
+			Mapped,
+			Done
+		};
+
+		struct Readback
+		{
+			ReadbackState state;
+			GLuint pbo;
+			GLsync fence;
+			GLsizeiptr size;
+			void* data;
+			std::uint32_t width;
+			std::uint32_t height;
+			ReadbackCallback callback;
+		};
+
+		// Two in flight for each of the color, albedo and normal outputs.
+		static constexpr std::size_t kNumReadbacks = 6;
+
 		struct Config
 		{
 			DeviceType type;
@@ -94,6 +140,15 @@ namespace octoon
 
 		std::vector<Config> configs_;
 		std::array<Output*, static_cast<std::size_t>(OutputType::kMax)> outputs_;
+
+		bool readbackQuit_;
+		std::array<Readback, kNumReadbacks> readbacks_;
+		std::deque<std::size_t> readbackOrder_;
+		std::deque<std::size_t> readbackJobs_;
+		std::mutex readbackMutex_;
+		std::condition_variable readbackWait_;
+		std::condition_variable readbackDone_;
+		std::thread readbackThread_;
 	};
 }
 
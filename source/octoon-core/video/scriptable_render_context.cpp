@@ -2,8 +2,12 @@
 #include <octoon/video/scriptable_render_buffer.h>
 #include <octoon/video/scriptable_render_material.h>
 #include <octoon/video/rendering_data.h>
+#include <octoon/video/render_journal.h>
+#include <octoon/video/shadow_cascades.h>
 
 #include <octoon/camera/perspective_camera.h>
+#include <octoon/camera/film_camera.h>
+#include <octoon/camera/ortho_camera.h>
 #include <octoon/light/ambient_light.h>
 #include <octoon/light/directional_light.h>
 #include <octoon/light/point_light.h>
@@ -18,14 +22,51 @@
 #include <octoon/hal/graphics_data.h>
 #include <octoon/hal/graphics_context.h>
 
+#include <octoon/runtime/profiler.h>
+
 namespace octoon
 {
+	// A box is outside the view when all of its corners are beyond the same clip plane.
+	static bool
+	isVisible(const math::float4x4& viewProjection, const math::BoundingBox& bound) noexcept
+	{
+		if (bound.empty())
+			return true;
+
+		auto& box = bound.box();
+		std::uint32_t outside = 0x3F;
+
+		for (std::uint32_t i = 0; i < 8 && outside; i++)
+		{
+			auto corner = math::float3(i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y, i & 4 ? box.max.z : box.min.z);
+			auto clip = viewProjection * math::float4(corner, 1.0f);
+
+			std::uint32_t mask = 0;
+			if (clip.x < -clip.w) mask |= 0x01;
+			if (clip.x > clip.w) mask |= 0x02;
+			if (clip.y < -clip.w) mask |= 0x04;
+			if (clip.y > clip.w) mask |= 0x08;
+			if (clip.z < -clip.w) mask |= 0x10;
+			if (clip.z > clip.w) mask |= 0x20;
+
+			outside &= mask;
+		}
+
+		return outside == 0;
+	}
+
 	ScriptableRenderContext::ScriptableRenderContext()
+		: compiledScene_(nullptr)
+		, compiledGeneration_(0)
+		, sampleFrame_(0)
 	{
 	}
 
 	ScriptableRenderContext::ScriptableRenderContext(const hal::GraphicsContextPtr& context)
-		: context_(context)
+		: compiledScene_(nullptr)
+		, compiledGeneration_(0)
+		, context_(context)
+		, sampleFrame_(0)
 	{
 	}
 
@@ -249,9 +290,9 @@ namespace octoon
 	}
 
 	void
-	ScriptableRenderContext::blitFramebuffer(const hal::GraphicsFramebufferPtr& src, const math::float4& v1, const hal::GraphicsFramebufferPtr& dest, const math::float4& v2) noexcept
+	ScriptableRenderContext::blitFramebuffer(const hal::GraphicsFramebufferPtr& src, const math::float4& v1, const hal::GraphicsFramebufferPtr& dest, const math::float4& v2, hal::GraphicsClearFlags flags) noexcept
 	{
-		this->context_->blitFramebuffer(src, v1, dest, v2);
+		this->context_->blitFramebuffer(src, v1, dest, v2, flags);
 	}
 
 	void
@@ -297,82 +338,191 @@ namespace octoon
 	}
 
 	void
-	ScriptableRenderContext::compileScene(const std::shared_ptr<RenderScene>& scene) noexcept
+	ScriptableRenderContext::beginSample(const char* name) noexcept
 	{
-		materialCollector.Clear();
+		if (!runtime::Profiler::getEnable())
+		{
+			sampleStack_.push_back(-2);
+			return;
+		}
 
-		for (auto& geometry : scene->getGeometries())
+		runtime::Profiler::beginScope(name);
+
+		auto& samples = samples_[sampleFrame_];
+		if (samples.size() < MAX_SAMPLES)
 		{
-			if (!geometry->getVisible())
+			auto index = (std::uint32_t)samples.size();
+			samples.push_back(Sample{ name, (std::uint32_t)sampleStack_.size(), runtime::Profiler::now() });
+			sampleStack_.push_back(index);
+
+			this->context_->writeTimestamp((sampleFrame_ * MAX_SAMPLES + index) * 2);
+		}
+		else
+		{
+			sampleStack_.push_back(-1);
+		}
+	}
+
+	void
+	ScriptableRenderContext::endSample() noexcept
+	{
+		if (sampleStack_.empty())
+			return;
+
+		auto index = sampleStack_.back();
+		sampleStack_.pop_back();
+
+		if (index >= 0)
+			this->context_->writeTimestamp((sampleFrame_ * MAX_SAMPLES + index) * 2 + 1);
+		if (index != -2)
+			runtime::Profiler::endScope();
+	}
+
+	void
+	ScriptableRenderContext::resolveSamples() noexcept
+	{
+		sampleFrame_ = (sampleFrame_ + 1) % SAMPLE_FRAMES;
+		sampleStack_.clear();
+
+		auto& samples = samples_[sampleFrame_];
+
+		// GPU clocks have their own epoch, so the first sample is lined up with the time it was submitted.
+		bool aligned = false;
+		std::int64_t offset = 0;
+
+		for (std::uint32_t i = 0; i < samples.size(); i++)
+		{
+			std::uint64_t begin = 0, end = 0;
+			auto base = (sampleFrame_ * MAX_SAMPLES + i) * 2;
+			if (!this->context_->getTimestamp(base, begin) || !this->context_->getTimestamp(base + 1, end))
 				continue;
 
-			for (std::size_t i = 0; i < geometry->getMaterials().size(); ++i)
+			if (!aligned)
 			{
-				auto& mat = geometry->getMaterial(i);
-				materialCollector.Collect(mat);
+				offset = (std::int64_t)samples[i].time - (std::int64_t)begin;
+				aligned = true;
 			}
+
+			runtime::Profiler::addEvent(samples[i].name, runtime::Profiler::GPU_THREAD, begin + offset, end + offset, samples[i].depth);
 		}
 
-		materialCollector.Commit();
+		samples.clear();
+	}
 
-		if (!renderingData_)
+	void
+	ScriptableRenderContext::compileScene(const std::shared_ptr<RenderScene>& scene) noexcept
+	{
+		if (!renderingData_ || compiledScene_ != scene.get() || compiledGeneration_ != scene->getGeneration())
 		{
+			this->collectMaterials(scene);
+
 			auto out = std::make_unique<RenderingData>();
 			this->updateCamera(scene, *out, true);
 			this->updateLights(scene, *out, true);
 			this->updateMaterials(scene, *out, true);
 			this->updateShapes(scene, *out, true);
 			renderingData_ = std::move(out);
+
+			compiledScene_ = scene.get();
+			compiledGeneration_ = scene->getGeneration();
 		}
 		else
 		{
 			auto& out = *renderingData_;
 
 			bool should_update_lights = false;
-			for (auto& light : scene->getLights())
+			bool should_collect_materials = false;
+			bool should_update_batches = false;
+
+			std::vector<Geometry*> geometries;
+			std::vector<Material*> materials;
+			std::vector<Mesh*> meshes;
+
+			for (auto& object : RenderJournal::getRenderObjects())
 			{
-				if (light->isDirty())
-				{
+				if (!object->isDirty())
+					continue;
+
+				if (object->isA<Light>())
 					should_update_lights = true;
-					break;
+				else if (object->isA<Geometry>())
+				{
+					// Batches only change with a static geometry, hidden ones included since they leave theirs.
+					auto geometry = object->downcast<Geometry>();
+					should_update_batches |= geometry->getStatic() || staticBatcher_.contains(geometry);
+
+					if (!geometry->getVisible())
+						continue;
+
+					for (auto& mat : geometry->getMaterials())
+						should_collect_materials |= mat && this->materials_.find(mat.get()) == this->materials_.end();
+
+					geometries.push_back(geometry);
 				}
 			}
 
-			bool should_update_shapes = false;
-			for (auto& geometry : scene->getGeometries())
+			for (auto& material : RenderJournal::getMaterials())
 			{
-				if (!geometry->getVisible())
-					continue;
+				if (material->isDirty())
+					materials.push_back(material);
+			}
 
-				if (geometry->isDirty())
+			for (auto& mesh : RenderJournal::getMeshes())
+			{
+				if (mesh->isDirty())
 				{
-					should_update_shapes = true;
-					break;
+					meshes.push_back(mesh);
+					should_update_batches |= staticBatcher_.contains(mesh);
 				}
 			}
 
-			bool should_update_materials = !out.material_bundle || materialCollector.NeedsUpdate(out.material_bundle.get(),
-				[](runtime::RttiInterface* ptr)->bool
-			{
-				auto mat = ptr->downcast<Material>();
-				return mat->isDirty();
-			});
-
 			auto camera = scene->getMainCamera();
-			if (camera->isDirty())
+			auto cameraChanged = out.camera != camera || camera->isDirty();
+			if (cameraChanged)
 				this->updateCamera(scene, out);
 			
-			if (should_update_lights || camera->isDirty())
+			if (should_update_lights || cameraChanged)
 				this->updateLights(scene, out);
 
-			if (should_update_materials)
+			// Only a geometry that picked up a material we have never seen can change the collected set.
+			if (should_collect_materials)
+			{
+				this->collectMaterials(scene);
 				this->updateMaterials(scene, out);
+			}
+			else if (!materials.empty())
+			{
+				this->updateMaterials(out, materials);
+			}
+
+			if (!geometries.empty() || !meshes.empty())
+				this->updateShapes(scene, out, geometries, meshes);
 
-			if (should_update_shapes)
-				this->updateShapes(scene, out);
+			if (should_update_batches)
+				this->updateBatches(out);
 		}
 	}
 
+	void
+	ScriptableRenderContext::collectMaterials(const std::shared_ptr<RenderScene>& scene) noexcept
+	{
+		materialCollector.Clear();
+
+		for (auto& geometry : scene->getGeometries())
+		{
+			if (!geometry->getVisible())
+				continue;
+
+			for (std::size_t i = 0; i < geometry->getMaterials().size(); ++i)
+			{
+				auto& mat = geometry->getMaterial(i);
+				materialCollector.Collect(mat);
+			}
+		}
+
+		materialCollector.Commit();
+	}
+
 	void
 	ScriptableRenderContext::cleanCache() noexcept
 	{
@@ -396,6 +546,25 @@ namespace octoon
 	{
 		out.reset();
 
+		float znear = 0.1f;
+		float zfar = 1000.0f;
+
+		if (out.camera->isA<PerspectiveCamera>())
+		{
+			znear = out.camera->downcast<PerspectiveCamera>()->getNear();
+			zfar = out.camera->downcast<PerspectiveCamera>()->getFar();
+		}
+		else if (out.camera->isA<FilmCamera>())
+		{
+			znear = out.camera->downcast<FilmCamera>()->getNear();
+			zfar = out.camera->downcast<FilmCamera>()->getFar();
+		}
+		else if (out.camera->isA<OrthographicCamera>())
+		{
+			znear = out.camera->downcast<OrthographicCamera>()->getNear();
+			zfar = out.camera->downcast<OrthographicCamera>()->getFar();
+		}
+
 		for (auto& light : scene->getLights())
 		{
 			if (!light->getVisible())
@@ -433,20 +602,44 @@ namespace octoon
 				directionLight.color[2] = color.z;
 				directionLight.shadow = it->getShadowEnable();
 
+				out.directionalShadowMatrices.resize(out.directionalShadowMatrices.size() + DirectionalLight::MAX_SHADOW_CASCADES);
+				out.directionalShadowSplits.emplace_back(0.0f);
+
 				auto framebuffer = it->getCamera()->getFramebuffer();
 				if (framebuffer && directionLight.shadow)
 				{
+					auto& desc = framebuffer->getFramebufferDesc();
+					auto& tileSize = it->getShadowMapSize();
+
 					directionLight.shadow = it->getShadowEnable();
 					directionLight.shadowBias = it->getShadowBias();
 					directionLight.shadowRadius = it->getShadowRadius();
-					directionLight.shadowMapSize = math::float2(float(framebuffer->getFramebufferDesc().getWidth()), float(framebuffer->getFramebufferDesc().getHeight()));
+					directionLight.shadowMapSize = math::float2(float(desc.getWidth()), float(desc.getHeight()));
+
+					RenderingData::DirectionalShadow shadow;
+					shadow.light = light;
+					shadow.numCascades = it->getShadowCascades();
+
+					float splits[DirectionalLight::MAX_SHADOW_CASCADES];
+					auto distance = it->getShadowDistance() > 0.0f ? std::min(zfar, znear + it->getShadowDistance()) : zfar;
+					ShadowCascades::split(znear, distance, shadow.numCascades, 0.75f, splits);
 
-					math::float4x4 viewport;
-					viewport.makeScale(math::float3(0.5f, 0.5f, 0.5f));
-					viewport.translate(math::float3(0.5f, 0.5f, 0.5f));
+					auto matrices = out.directionalShadowMatrices.data() + out.numDirectional * DirectionalLight::MAX_SHADOW_CASCADES;
+					auto& ends = out.directionalShadowSplits.back();
 
-					out.directionalShadows.emplace_back(framebuffer->getFramebufferDesc().getColorAttachment().getBindingTexture());
-					out.directionalShadowMatrix.push_back(viewport * it->getCamera()->getViewProjection());
+					for (std::uint32_t i = 0; i < shadow.numCascades; i++)
+					{
+						math::float4 viewport(float((i & 1) * tileSize.x), float((i >> 1) * tileSize.y), float(tileSize.x), float(tileSize.y));
+						ShadowCascades::fit(*out.camera, i > 0 ? splits[i - 1] : znear, splits[i], it->getTransformInverse(), distance, viewport, math::uint2(desc.getWidth(), desc.getHeight()), shadow.cascades[i]);
+						matrices[i] = shadow.cascades[i].shadowMatrix;
+					}
+
+					// Unused cascades repeat the last split, so anything past it selects no cascade at all.
+					for (std::uint32_t i = 0; i < DirectionalLight::MAX_SHADOW_CASCADES; i++)
+						ends[i] = splits[std::min(i, shadow.numCascades - 1)];
+
+					out.directionalShadows.emplace_back(desc.getColorAttachment().getBindingTexture());
+					out.directionalShadowCascades.push_back(shadow);
 				}
 
 				out.numDirectional++;
@@ -456,11 +649,11 @@ namespace octoon
 			{
 				auto it = light->downcast<SpotLight>();
 				RenderingData::SpotLight spotLight;
-				spotLight.color.set(it->getColor() * it->getIntensity());
-				spotLight.direction.set(math::float3x3(out.camera->getView()) * it->getForward());
-				spotLight.position.set(it->getTranslate());
-				spotLight.distance = 0;
-				spotLight.decay = 0;
+				spotLight.color = it->getColor() * it->getIntensity();
+				spotLight.direction = math::float3x3(out.camera->getView()) * it->getForward();
+				spotLight.position = out.camera->getView() * it->getTranslate();
+				spotLight.distance = it->getRange();
+				spotLight.decay = it->getRange() > 0.0f ? 2.0f : 0.0f;
 				spotLight.coneCos = it->getInnerCone().y;
 				spotLight.penumbraCos = it->getOuterCone().y;
 				spotLight.shadow = it->getShadowEnable();
@@ -485,10 +678,10 @@ namespace octoon
 			{
 				auto it = light->downcast<PointLight>();
 				RenderingData::PointLight pointLight;
-				pointLight.color.set(it->getColor() * it->getIntensity());
-				pointLight.position.set(it->getTranslate());
-				pointLight.distance = 0;
-				pointLight.decay = 0;
+				pointLight.color = it->getColor() * it->getIntensity();
+				pointLight.position = out.camera->getView() * it->getTranslate();
+				pointLight.distance = it->getRange();
+				pointLight.decay = it->getRange() > 0.0f ? 2.0f : 0.0f;
 				pointLight.shadow = it->getShadowEnable();
 
 				if (pointLight.shadow)
@@ -524,70 +717,55 @@ namespace octoon
 			out.lights.push_back(light);
 		}
 
-		if (out.numSpot)
+		// Point and spot lights are culled per cluster, so their blocks always have the same size
+		// and the programs never depend on how many there are.
+		auto upload = [this](hal::GraphicsDataPtr& buffer, const void* data, std::size_t size, std::size_t capacity)
 		{
-			if (!out.spotLightBuffer)
+			if (!buffer)
 			{
-				out.spotLightBuffer = this->context_->getDevice()->createGraphicsData(hal::GraphicsDataDesc(
+				buffer = this->context_->getDevice()->createGraphicsData(hal::GraphicsDataDesc(
 					hal::GraphicsDataType::UniformBuffer,
 					hal::GraphicsUsageFlagBits::ReadBit | hal::GraphicsUsageFlagBits::WriteBit,
-					out.spotLights.data(),
-					sizeof(RenderingData::SpotLight) * out.numSpot
+					nullptr,
+					capacity
 				));
 			}
-			else
-			{
-				auto desc = out.spotLightBuffer->getDataDesc();
-				if (desc.getStreamSize() < out.spotLights.size() * sizeof(RenderingData::SpotLight))
-				{
-					out.spotLightBuffer = this->context_->getDevice()->createGraphicsData(hal::GraphicsDataDesc(
-						hal::GraphicsDataType::UniformBuffer,
-						hal::GraphicsUsageFlagBits::ReadBit | hal::GraphicsUsageFlagBits::WriteBit,
-						out.spotLights.data(),
-						sizeof(RenderingData::SpotLight) * out.numSpot
-					));
-				}
-				else
-				{
-					void* data;
-					if (out.spotLightBuffer->map(0, desc.getStreamSize(), &data))
-						std::memcpy(data, out.spotLights.data(), out.spotLights.size() * sizeof(RenderingData::SpotLight));
-					out.spotLightBuffer->unmap();
-				}
-			}
-		}
 
-		if (out.numPoint)
-		{
-			if (!out.pointLightBuffer)
+			else if (buffer->getDataDesc().getStreamSize() < capacity)
 			{
-				out.pointLightBuffer = this->context_->getDevice()->createGraphicsData(hal::GraphicsDataDesc(
+				buffer = this->context_->getDevice()->createGraphicsData(hal::GraphicsDataDesc(
 					hal::GraphicsDataType::UniformBuffer,
 					hal::GraphicsUsageFlagBits::ReadBit | hal::GraphicsUsageFlagBits::WriteBit,
-					out.pointLights.data(),
-					sizeof(RenderingData::PointLight) * out.numPoint
+					nullptr,
+					capacity
 				));
 			}
-			else
+
+			void* mapped;
+			if (buffer->map(0, capacity, &mapped))
 			{
-				auto desc = out.pointLightBuffer->getDataDesc();
-				if (desc.getStreamSize() < out.pointLights.size() * sizeof(RenderingData::PointLight))
-				{
-					out.pointLightBuffer = this->context_->getDevice()->createGraphicsData(hal::GraphicsDataDesc(
-						hal::GraphicsDataType::UniformBuffer,
-						hal::GraphicsUsageFlagBits::ReadBit | hal::GraphicsUsageFlagBits::WriteBit,
-						out.pointLights.data(),
-						sizeof(RenderingData::PointLight) * out.numPoint
-					));
-				}
-				else
-				{
-					void* data;
-					if (out.pointLightBuffer->map(0, desc.getStreamSize(), &data))
-						std::memcpy(data, out.pointLights.data(), out.pointLights.size() * sizeof(RenderingData::PointLight));
-					out.pointLightBuffer->unmap();
-				}
+				std::memcpy(mapped, data, std::min(size, capacity));
+				buffer->unmap();
 			}
+		};
+
+		lightClusters_.build(out.camera->getProjection(), out.camera->getProjectionInverse(), znear, zfar, out.pointLights, out.spotLights);
+
+		upload(out.pointLightBuffer, out.pointLights.data(), out.pointLights.size() * sizeof(RenderingData::PointLight), LightClusters::MAX_LIGHTS * sizeof(RenderingData::PointLight));
+		upload(out.spotLightBuffer, out.spotLights.data(), out.spotLights.size() * sizeof(RenderingData::SpotLight), LightClusters::MAX_LIGHTS * sizeof(RenderingData::SpotLight));
+		upload(out.clusterBuffer, &lightClusters_.getGrid(), sizeof(LightClusters::Grid), sizeof(LightClusters::Grid));
+		upload(out.clusterIndexBuffer, lightClusters_.getIndices(), lightClusters_.getNumIndices(), LightClusters::MAX_INDICES);
+
+		if (out.numDirectional)
+		{
+			auto matricesSize = out.directionalShadowMatrices.size() * sizeof(math::float4x4);
+			auto splitsSize = out.directionalShadowSplits.size() * sizeof(math::float4);
+
+			std::vector<std::uint8_t> shadows(matricesSize + splitsSize);
+			std::memcpy(shadows.data(), out.directionalShadowMatrices.data(), matricesSize);
+			std::memcpy(shadows.data() + matricesSize, out.directionalShadowSplits.data(), splitsSize);
+
+			upload(out.directionalShadowBuffer, shadows.data(), shadows.size(), shadows.size());
 		}
 
 		if (out.numRectangle)
@@ -678,7 +856,7 @@ namespace octoon
 		for (std::size_t i = 0; mat_iter->IsValid(); mat_iter->Next(), i++)
 		{
 			auto mat = mat_iter->ItemAs<Material>();
-			if (mat->isDirty() || force)
+			if (mat->isDirty() || force || this->materials_.find(mat) == this->materials_.end())
 			{
 				auto material = mat->downcast_pointer<Material>();
 				this->materials_[material.get()] = std::make_shared<ScriptableRenderMaterial>(*this, material, out);
@@ -702,18 +880,62 @@ namespace octoon
 				this->buffers_[mesh.get()] = std::make_shared<ScriptableRenderBuffer>(*this, mesh);
 			}
 		}
+
+		this->updateBatches(out);
     }
 
 	void
-	ScriptableRenderContext::setMaterial(const std::shared_ptr<Material>& material, const Camera& camera, const Geometry& geometry)
+	ScriptableRenderContext::updateMaterials(RenderingData& out, const std::vector<Material*>& materials)
 	{
-		assert(material);
+		for (auto& mat : materials)
+		{
+			auto it = this->materials_.find(mat);
+			if (it != this->materials_.end())
+			{
+				auto material = mat->downcast_pointer<Material>();
+				it->second = std::make_shared<ScriptableRenderMaterial>(*this, material, out);
+			}
+		}
+	}
 
-		auto& pipeline = this->materials_.at(material.get());
-		pipeline->update(*this->renderingData_, camera, geometry);
+	void
+	ScriptableRenderContext::updateShapes(const std::shared_ptr<RenderScene>& scene, RenderingData& out, const std::vector<Geometry*>& geometries, const std::vector<Mesh*>& meshes)
+	{
+		out.geometries = scene->getGeometries();
+
+		for (auto& geometry : geometries)
+		{
+			auto mesh = geometry->getMesh();
+			if (mesh)
+				this->buffers_[mesh.get()] = std::make_shared<ScriptableRenderBuffer>(*this, mesh);
+		}
+
+		for (auto& mesh : meshes)
+		{
+			auto it = this->buffers_.find(mesh);
+			if (it != this->buffers_.end())
+				it->second = std::make_shared<ScriptableRenderBuffer>(*this, mesh->downcast_pointer<Mesh>());
+		}
+	}
+
+	void
+	ScriptableRenderContext::updateBatches(RenderingData& out)
+	{
+		staticBatcher_.update(out.geometries);
+
+		for (auto& mesh : staticBatcher_.getRetiredMeshes())
+			this->buffers_.erase(mesh);
 
-		this->setRenderPipeline(pipeline->getPipeline());
-		this->setDescriptorSet(pipeline->getDescriptorSet());
+		for (auto& geometry : staticBatcher_.getRebuiltGeometries())
+		{
+			this->buffers_[geometry->getMesh().get()] = std::make_shared<ScriptableRenderBuffer>(*this, geometry->getMesh());
+
+			// Batches are not walked by endCameraRendering, so they are cleaned once uploaded.
+			geometry->getMesh()->setDirty(false);
+			geometry->setDirty(false);
+		}
+
+		out.batchedGeometries = staticBatcher_.getGeometries();
 	}
 
 	void
@@ -722,25 +944,71 @@ namespace octoon
 		this->context_->generateMipmap(texture);
 	}
 
+	void
+	ScriptableRenderContext::setMaterial(const std::shared_ptr<Material>& material, const Camera& camera, const Geometry& geometry)
+	{
+		this->commandList_.clear();
+		this->setMaterial(this->commandList_, material, camera, geometry);
+		this->commandList_.execute(*this->context_);
+	}
+
+	void
+	ScriptableRenderContext::setMaterial(hal::GraphicsCommandList& commands, const std::shared_ptr<Material>& material, const Camera& camera, const Geometry& geometry) const
+	{
+		assert(material);
+
+		auto& pipeline = this->materials_.at(material.get());
+		pipeline->update(commands, *this->renderingData_, camera, geometry);
+
+		commands.setRenderPipeline(pipeline->getPipeline());
+		commands.setDescriptorSet(pipeline->getDescriptorSet());
+	}
+
 	void
 	ScriptableRenderContext::drawMesh(const std::shared_ptr<Mesh>& mesh, std::size_t subset)
+	{
+		this->commandList_.clear();
+		this->drawMesh(this->commandList_, mesh, subset);
+		this->commandList_.execute(*this->context_);
+	}
+
+	void
+	ScriptableRenderContext::drawMesh(hal::GraphicsCommandList& commands, const std::shared_ptr<Mesh>& mesh, std::size_t subset) const
 	{
 		auto& buffer = buffers_.at(mesh.get());
-		this->setVertexBufferData(0, buffer->getVertexBuffer(), 0);
-		this->setIndexBufferData(buffer->getIndexBuffer(), 0, hal::GraphicsIndexType::UInt32);
+		commands.setVertexBufferData(0, buffer->getVertexBuffer(), 0);
 
 		if (buffer->getIndexBuffer())
-			this->drawIndexed((std::uint32_t)buffer->getNumIndices(subset), 1, (std::uint32_t)buffer->getStartIndices(subset), 0, 0);
+		{
+			commands.setIndexBufferData(buffer->getIndexBuffer(), 0, hal::GraphicsIndexType::UInt32);
+			commands.drawIndexed((std::uint32_t)buffer->getNumIndices(subset), 1, (std::uint32_t)buffer->getStartIndices(subset), 0, 0);
+		}
 		else
-			this->draw((std::uint32_t)buffer->getNumVertices(), 1, 0, 0);
+		{
+			commands.draw((std::uint32_t)buffer->getNumVertices(), 1, 0, 0);
+		}
 	}
 
 	void
 	ScriptableRenderContext::drawRenderers(const Geometry& geometry, const Camera& camera, const std::shared_ptr<Material>& overrideMaterial) noexcept
+	{
+		this->commandList_.clear();
+		this->drawRenderers(this->commandList_, geometry, camera, overrideMaterial);
+		this->commandList_.execute(*this->context_);
+	}
+
+	void
+	ScriptableRenderContext::drawRenderers(hal::GraphicsCommandList& commands, const Geometry& geometry, const Camera& camera, const std::shared_ptr<Material>& overrideMaterial) const noexcept
 	{
 		if (camera.getLayer() != geometry.getLayer())
 			return;
 
+		if (staticBatcher_.isBatch(&geometry))
+		{
+			this->drawBatch(commands, geometry, camera, overrideMaterial);
+			return;
+		}
+
 		if (geometry.getVisible())
 		{
 			for (std::size_t i = 0; i < geometry.getMaterials().size(); i++)
@@ -755,17 +1023,83 @@ namespace octoon
 
 				if (mesh && material)
 				{
-					this->setMaterial(overrideMaterial ? overrideMaterial : material, camera, geometry);
-					this->drawMesh(mesh, i);
+					this->setMaterial(commands, overrideMaterial ? overrideMaterial : material, camera, geometry);
+					this->drawMesh(commands, mesh, i);
 				}
 			}
 		}
 	}
 
+	void
+	ScriptableRenderContext::drawBatch(hal::GraphicsCommandList& commands, const Geometry& geometry, const Camera& camera, const std::shared_ptr<Material>& overrideMaterial) const noexcept
+	{
+		auto& mesh = geometry.getMesh();
+		auto& buffer = buffers_.at(mesh.get());
+		auto& viewProjection = camera.getViewProjection();
+
+		std::shared_ptr<Material> current;
+		std::size_t startIndices = 0;
+		std::size_t numIndices = 0;
+
+		// Subsets that use the same material follow each other in the index buffer, so the
+		// visible ones between two culled subsets are a single draw.
+		for (std::size_t i = 0; i < geometry.getMaterials().size(); i++)
+		{
+			auto& material = overrideMaterial ? overrideMaterial : geometry.getMaterials()[i];
+			if (!geometry.getMaterials()[i] || !isVisible(viewProjection, mesh->getBoundingBox(i)))
+				continue;
+
+			auto start = buffer->getStartIndices(i);
+			auto count = buffer->getNumIndices(i);
+
+			if (material == current && start == startIndices + numIndices)
+			{
+				numIndices += count;
+				continue;
+			}
+
+			if (numIndices > 0)
+				commands.drawIndexed((std::uint32_t)numIndices, 1, (std::uint32_t)startIndices, 0, 0);
+
+			if (material != current)
+			{
+				this->setMaterial(commands, material, camera, geometry);
+				commands.setVertexBufferData(0, buffer->getVertexBuffer(), 0);
+				commands.setIndexBufferData(buffer->getIndexBuffer(), 0, hal::GraphicsIndexType::UInt32);
+				current = material;
+			}
+
+			startIndices = start;
+			numIndices = count;
+		}
+
+		if (numIndices > 0)
+			commands.drawIndexed((std::uint32_t)numIndices, 1, (std::uint32_t)startIndices, 0, 0);
+	}
+
 	void
 	ScriptableRenderContext::drawRenderers(const std::vector<Geometry*>& geometries, const Camera& camera, const std::shared_ptr<Material>& overrideMaterial) noexcept
 	{
-		for (auto& geometry : geometries)
-			this->drawRenderers(*geometry, camera, overrideMaterial);
+		// Each chunk of geometries is recorded on its own thread, then replayed in submission order.
+		constexpr std::size_t GEOMETRIES_PER_LIST = 64;
+
+		auto numLists = (geometries.size() + GEOMETRIES_PER_LIST - 1) / GEOMETRIES_PER_LIST;
+		if (this->commandLists_.size() < numLists)
+			this->commandLists_.resize(numLists);
+
+#		pragma omp parallel for
+		for (std::int32_t i = 0; i < (std::int32_t)numLists; ++i)
+		{
+			auto& commands = this->commandLists_[i];
+			commands.clear();
+
+			auto first = i * GEOMETRIES_PER_LIST;
+			auto last = std::min(first + GEOMETRIES_PER_LIST, geometries.size());
+
+			for (auto j = first; j < last; j++)
+				this->drawRenderers(commands, *geometries[j], camera, overrideMaterial);
+		}
+
+		hal::GraphicsCommandList::execute(*this->context_, this->commandLists_.data(), numLists);
 	}
 }
@@ -1,5 +1,6 @@
 ﻿#include <octoon/video/scriptable_render_material.h>
 #include <octoon/video/rendering_data.h>
+#include <octoon/video/light_clusters.h>
 #include <octoon/video/renderer.h>
 #include <octoon/material/mesh_standard_material.h>
 #include <octoon/hal/graphics.h>
@@ -1092,21 +1093,56 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 #endif
 
 
-#if NUM_POINT_LIGHTS > 0
+	// Point and spot lights are looked up through the froxel grid built by LightClusters, each
+	// record holds the offset of the cluster in the index list and its point and spot light counts.
+	uniform mat4 projectionMatrix;
+
+	uniform LightClusters {
+		vec4 params;
+		uvec4 records[ LIGHT_CLUSTER_COUNT / 4 ];
+	} lightClusters;
+
+	uniform LightClusterIndices {
+		uvec4 indices[ LIGHT_CLUSTER_MAX_INDICES / 16 ];
+	} lightClusterIndices;
+
+	uint getLightCluster( const in vec3 position ) {
+
+		vec4 clip = projectionMatrix * vec4( position, 1.0 );
+		vec2 tile = clamp( ( clip.xy / clip.w * 0.5 + 0.5 ) * vec2( LIGHT_CLUSTER_TILES_X, LIGHT_CLUSTER_TILES_Y ), vec2( 0.0 ), vec2( LIGHT_CLUSTER_TILES_X - 1, LIGHT_CLUSTER_TILES_Y - 1 ) );
+		float slice = clamp( log( max( abs( position.z ), EPSILON ) ) * lightClusters.params.x + lightClusters.params.y, 0.0, float( LIGHT_CLUSTER_SLICES - 1 ) );
+
+		return ( uint( slice ) * uint( LIGHT_CLUSTER_TILES_Y ) + uint( tile.y ) ) * uint( LIGHT_CLUSTER_TILES_X ) + uint( tile.x );
+
+	}
+
+	uint getLightClusterRecord( const in uint cluster ) {
+
+		return lightClusters.records[ cluster >> 2u ][ cluster & 3u ];
+
+	}
+
+	int getLightClusterIndex( const in uint i ) {
+
+		return int( ( lightClusterIndices.indices[ i >> 4u ][ ( i >> 2u ) & 3u ] >> ( ( i & 3u ) * 8u ) ) & 0xFFu );
+
+	}
 
 	struct PointLight {
 		vec3 position;
-		vec3 color;
 		float distance;
+		vec3 color;
 		float decay;
 
 		int shadow;
 		float shadowBias;
-		float shadowRadius;
 		vec2 shadowMapSize;
+		float shadowRadius;
 	};
 
-	uniform PointLight pointLights[ NUM_POINT_LIGHTS ];
+	uniform PointLights {
+		PointLight lights[ LIGHT_CLUSTER_MAX_LIGHTS ];
+	} pointLights;
 
 	// directLight is an out parameter as having it as a return value caused compiler errors on some devices
 	void getPointDirectLightIrradiance( const in PointLight pointLight, const in GeometricContext geometry, out IncidentLight directLight ) {
@@ -1122,26 +1158,24 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 
 	}
 
-#endif
-
-
-#if NUM_SPOT_LIGHTS > 0
 	struct SpotLight {
 		vec3 position;
-		vec3 direction;
-		vec3 color;
 		float distance;
+		vec3 direction;
 		float decay;
+		vec3 color;
 		float coneCos;
 		float penumbraCos;
 
 		int shadow;
+		vec2 shadowMapSize;
 		float shadowBias;
 		float shadowRadius;
-		vec2 shadowMapSize;
 	};
 
-	uniform SpotLight spotLights[ NUM_SPOT_LIGHTS ];
+	uniform SpotLights {
+		SpotLight lights[ LIGHT_CLUSTER_MAX_LIGHTS ];
+	} spotLights;
 
 	// directLight is an out parameter as having it as a return value caused compiler errors on some devices
 	void getSpotDirectLightIrradiance( const in SpotLight spotLight, const in GeometricContext geometry, out IncidentLight directLight  ) {
@@ -1168,8 +1202,6 @@ vec3 getAmbientLightIrradiance( const in vec3 ambientLightColor ) {
 		}
 	}
 
-#endif
-
 #if NUM_RECT_AREA_LIGHTS > 0
 
 	struct RectAreaLight {
@@ -1629,39 +1661,54 @@ geometry.viewDir = normalize( vViewPosition );
 
 IncidentLight directLight;
 
-#if ( NUM_POINT_LIGHTS > 0 ) && defined( RE_Direct )
+#if defined( RE_Direct )
+
+	uint clusterRecord = getLightClusterRecord( getLightCluster( geometry.position ) );
+	uint clusterOffset = clusterRecord & 0xFFFFu;
+	uint numClusterPointLights = ( clusterRecord >> 16u ) & 0xFFu;
+	uint numClusterSpotLights = clusterRecord >> 24u;
+	uint numGlobalPointLights = uint( lightClusters.params.z );
+	uint numGlobalSpotLights = uint( lightClusters.params.w );
 
 	PointLight pointLight;
 
-	for ( int i = 0; i < NUM_POINT_LIGHTS; i ++ ) {
+	for ( uint i = 0u; i < numGlobalPointLights; i ++ ) {
 
-		pointLight = pointLights[ i ];
+		pointLight = pointLights.lights[ getLightClusterIndex( i ) ];
 
 		getPointDirectLightIrradiance( pointLight, geometry, directLight );
 
-		#ifdef USE_SHADOWMAP
-		directLight.color *= all( bvec2( pointLight.shadow, directLight.visible ) ) ? getPointShadow( pointShadowMap[ i ], pointLight.shadowMapSize, pointLight.shadowBias, pointLight.shadowRadius, vPointShadowCoord[ i ] ) : 1.0;
-		#endif
-
 		RE_Direct( directLight, geometry, material, reflectedLight );
 
 	}
 
-#endif
+	for ( uint i = 0u; i < numClusterPointLights; i ++ ) {
+
+		pointLight = pointLights.lights[ getLightClusterIndex( clusterOffset + i ) ];
 
-#if ( NUM_SPOT_LIGHTS > 0 ) && defined( RE_Direct )
+		getPointDirectLightIrradiance( pointLight, geometry, directLight );
+
+		RE_Direct( directLight, geometry, material, reflectedLight );
+
+	}
 
 	SpotLight spotLight;
 
-	for ( int i = 0; i < NUM_SPOT_LIGHTS; i ++ ) {
+	for ( uint i = 0u; i < numGlobalSpotLights; i ++ ) {
 
-		spotLight = spotLights[ i ];
+		spotLight = spotLights.lights[ getLightClusterIndex( numGlobalPointLights + i ) ];
 
 		getSpotDirectLightIrradiance( spotLight, geometry, directLight );
 
-		#ifdef USE_SHADOWMAP
-		directLight.color *= all( bvec2( spotLight.shadow, directLight.visible ) ) ? getShadow( spotShadowMap[ i ], spotLight.shadowMapSize, spotLight.shadowBias, spotLight.shadowRadius, vSpotShadowCoord[ i ] ) : 1.0;
-		#endif
+		RE_Direct( directLight, geometry, material, reflectedLight );
+
+	}
+
+	for ( uint i = 0u; i < numClusterSpotLights; i ++ ) {
+
+		spotLight = spotLights.lights[ getLightClusterIndex( clusterOffset + numClusterPointLights + i ) ];
+
+		getSpotDirectLightIrradiance( spotLight, geometry, directLight );
 
 		RE_Direct( directLight, geometry, material, reflectedLight );
 
@@ -1684,7 +1731,7 @@ IncidentLight directLight;
 		getDirectionalDirectLightIrradiance( directionalLight, geometry, directLight );
 
 		#ifdef USE_SHADOWMAP
-		directLight.color *= all( bvec2( directionalLight.shadow, directLight.visible ) ) ? getShadow( directionalShadowMap[ i ], directionalLight.shadowMapSize, directionalLight.shadowBias, directionalLight.shadowRadius, vDirectionalShadowCoord[ i ] ) : 1.0;
+		directLight.color *= all( bvec2( directionalLight.shadow, directLight.visible ) ) ? getShadow( directionalShadowMap[ i ], directionalLight.shadowMapSize, directionalLight.shadowBias, directionalLight.shadowRadius, getDirectionalShadowCoord( i, geometry.position ) ) : 1.0;
 		#endif
 
 		RE_Direct( directLight, geometry, material, reflectedLight );
@@ -1760,36 +1807,6 @@ IncidentLight directLight;
 static const char* shadowmap_vertex = R"(
 #ifdef USE_SHADOWMAP
 
-	#if NUM_DIR_LIGHTS > 0
-
-	for ( int i = 0; i < NUM_DIR_LIGHTS; i ++ ) {
-
-		vDirectionalShadowCoord[ i ] = directionalShadowMatrix[ i ] * worldPosition;
-
-	}
-
-	#endif
-
-	#if NUM_SPOT_LIGHTS > 0
-
-	for ( int i = 0; i < NUM_SPOT_LIGHTS; i ++ ) {
-
-		vSpotShadowCoord[ i ] = spotShadowMatrix[ i ] * worldPosition;
-
-	}
-
-	#endif
-
-	#if NUM_POINT_LIGHTS > 0
-
-	for ( int i = 0; i < NUM_POINT_LIGHTS; i ++ ) {
-
-		vPointShadowCoord[ i ] = pointShadowMatrix[ i ] * worldPosition;
-
-	}
-
-	#endif
-
 	/*
 	#if NUM_RECT_AREA_LIGHTS > 0
 
@@ -1803,27 +1820,6 @@ static const char* shadowmap_vertex = R"(
 static const char* shadowmap_pars_vertex = R"(
 #ifdef USE_SHADOWMAP
 
-	#if NUM_DIR_LIGHTS > 0
-
-		uniform mat4 directionalShadowMatrix[ NUM_DIR_LIGHTS ];
-		out vec4 vDirectionalShadowCoord[ NUM_DIR_LIGHTS ];
-
-	#endif
-
-	#if NUM_SPOT_LIGHTS > 0
-
-		uniform mat4 spotShadowMatrix[ NUM_SPOT_LIGHTS ];
-		out vec4 vSpotShadowCoord[ NUM_SPOT_LIGHTS ];
-
-	#endif
-
-	#if NUM_POINT_LIGHTS > 0
-
-		uniform mat4 pointShadowMatrix[ NUM_POINT_LIGHTS ];
-		out vec4 vPointShadowCoord[ NUM_POINT_LIGHTS ];
-
-	#endif
-
 	/*
 	#if NUM_RECT_AREA_LIGHTS > 0
 
@@ -1841,21 +1837,21 @@ static const char* shadowmap_pars_fragment = R"(
 	#if NUM_DIR_LIGHTS > 0
 
 		uniform sampler2D directionalShadowMap[ NUM_DIR_LIGHTS ];
-		in vec4 vDirectionalShadowCoord[ NUM_DIR_LIGHTS ];
-
-	#endif
 
-	#if NUM_SPOT_LIGHTS > 0
+		uniform DirectionalShadows {
+			mat4 matrices[ NUM_DIR_LIGHTS * SHADOW_CASCADES ];
+			vec4 splits[ NUM_DIR_LIGHTS ];
+		} directionalShadows;
 
-		uniform sampler2D spotShadowMap[ NUM_SPOT_LIGHTS ];
-		in vec4 vSpotShadowCoord[ NUM_SPOT_LIGHTS ];
+		// Picks the cascade by view depth, positions past the last one land outside the atlas and stay lit.
+		vec4 getDirectionalShadowCoord( int light, vec3 position ) {
 
-	#endif
+			int cascade = int( dot( step( directionalShadows.splits[ light ], vec4( abs( position.z ) ) ), vec4( 1.0 ) ) );
+			if ( cascade >= SHADOW_CASCADES ) return vec4( -1.0, -1.0, 0.0, 1.0 );
 
-	#if NUM_POINT_LIGHTS > 0
+			return directionalShadows.matrices[ light * SHADOW_CASCADES + cascade ] * vec4( position, 1.0 );
 
-		uniform sampler2D pointShadowMap[ NUM_POINT_LIGHTS ];
-		in vec4 vPointShadowCoord[ NUM_POINT_LIGHTS ];
+		}
 
 	#endif
 
@@ -2165,8 +2161,11 @@ namespace octoon
 
 		ambientLightColor_.reset();
 		directionalLights_.reset();
+		directionalShadows_.reset();
 		pointLights_.reset();
 		spotLights_.reset();
+		lightClusters_.reset();
+		lightClusterIndices_.reset();
 		rectAreaLights_.reset();
 		hemisphereLights_.reset();
 		flipEnvMap_.reset();
@@ -2198,54 +2197,63 @@ namespace octoon
 	}
 
 	void
-	ScriptableRenderMaterial::update(const RenderingData& context, const Camera& camera, const Geometry& geometry) noexcept
+	ScriptableRenderMaterial::update(hal::GraphicsCommandList& commands, const RenderingData& context, const Camera& camera, const Geometry& geometry) const noexcept
 	{
 		if (this->material_)
 		{
 			if (this->modelMatrix_)
-				this->modelMatrix_->uniform4fmat(geometry.getTransform());
+				commands.uniform4fmat(this->modelMatrix_, geometry.getTransform());
 			
 			if (this->viewMatrix_)
-				this->viewMatrix_->uniform4fmat(camera.getView());
+				commands.uniform4fmat(this->viewMatrix_, camera.getView());
 
 			if (this->viewProjMatrix_)
-				this->viewProjMatrix_->uniform4fmat(camera.getViewProjection());
+				commands.uniform4fmat(this->viewProjMatrix_, camera.getViewProjection());
 
 			if (this->modelViewMatrix_)
-				this->modelViewMatrix_->uniform4fmat(camera.getView() * geometry.getTransform());
+				commands.uniform4fmat(this->modelViewMatrix_, camera.getView() * geometry.getTransform());
 			
 			if (this->projectionMatrix_)
-				this->projectionMatrix_->uniform4fmat(camera.getProjection());
+				commands.uniform4fmat(this->projectionMatrix_, camera.getProjection());
 			
 			if (this->normalMatrix_)
-				this->normalMatrix_->uniform3fmat((math::float3x3)camera.getView() * (math::float3x3)geometry.getTransform());
+				commands.uniform3fmat(this->normalMatrix_, (math::float3x3)camera.getView() * (math::float3x3)geometry.getTransform());
 
 			if (this->ambientLightColor_)
-				this->ambientLightColor_->uniform3f(context.ambientLightColors);
+				commands.uniform3f(this->ambientLightColor_, context.ambientLightColors);
 
 			if (this->spotLights_)
-				this->spotLights_->uniformBuffer(context.spotLightBuffer);
+				commands.uniformBuffer(this->spotLights_, context.spotLightBuffer);
 
 			if (this->pointLights_)
-				this->pointLights_->uniformBuffer(context.pointLightBuffer);
+				commands.uniformBuffer(this->pointLights_, context.pointLightBuffer);
+
+			if (this->lightClusters_)
+				commands.uniformBuffer(this->lightClusters_, context.clusterBuffer);
+
+			if (this->lightClusterIndices_)
+				commands.uniformBuffer(this->lightClusterIndices_, context.clusterIndexBuffer);
 
 			if (this->rectAreaLights_)
-				this->rectAreaLights_->uniformBuffer(context.rectangleLightBuffer);
+				commands.uniformBuffer(this->rectAreaLights_, context.rectangleLightBuffer);
 
 			if (this->directionalLights_)
-				this->directionalLights_->uniformBuffer(context.directionLightBuffer);
+				commands.uniformBuffer(this->directionalLights_, context.directionLightBuffer);
+
+			if (this->directionalShadows_)
+				commands.uniformBuffer(this->directionalShadows_, context.directionalShadowBuffer);
 
 			if (this->flipEnvMap_)
-				this->flipEnvMap_->uniform1f(1.0f);
+				commands.uniform1f(this->flipEnvMap_, 1.0f);
 
 			if (this->envMap_ && context.environmentLights.size())
-				this->envMap_->uniformTexture(context.environmentLights.front().radiance.lock());
+				commands.uniformTexture(this->envMap_, context.environmentLights.front().radiance.lock());
 
 			if (this->envMapIntensity_&& context.environmentLights.size())
-				this->envMapIntensity_->uniform1f(context.environmentLights.front().intensity);
+				commands.uniform1f(this->envMapIntensity_, context.environmentLights.front().intensity);
 
 			if (this->envMapOffset_ && context.environmentLights.size())
-				this->envMapOffset_->uniform2f(context.environmentLights.front().offset);
+				commands.uniform2f(this->envMapOffset_, context.environmentLights.front().offset);
 
 			if (this->directionalShadowMaps_.size() > 0)
 			{
@@ -2254,14 +2262,13 @@ namespace octoon
 					auto& it = context.directionalLights[i];
 					if (it.shadow)
 					{
-						this->directionalShadowMaps_[j]->uniformTexture(context.directionalShadows[i]);
-						this->directionalShadowMatrixs_[j]->uniform4fmat(context.directionalShadowMatrix[i]);
+						commands.uniformTexture(this->directionalShadowMaps_[j], context.directionalShadows[j]);
 						j++;
 					}
 				}
 			}
 
-			this->updateParameters(true);
+			this->updateParameters(commands, true);
 		}
 	}
 
@@ -2303,9 +2310,7 @@ namespace octoon
 		};
 
 		replace(str, "NUM_DIR_LIGHTS", std::to_string(parameters.numDirectional));
-		replace(str, "NUM_SPOT_LIGHTS", std::to_string(parameters.numSpot));
 		replace(str, "NUM_RECT_AREA_LIGHTS", std::to_string(parameters.numRectangle));
-		replace(str, "NUM_POINT_LIGHTS", std::to_string(parameters.numPoint));
 		replace(str, "NUM_HEMI_LIGHTS", std::to_string(parameters.numHemi));
 	}
 
@@ -2347,6 +2352,13 @@ namespace octoon
 		fragmentShader += "#define SHADOWMAP_TYPE_PCF_SOFT\n";
 		fragmentShader += "#define USE_ENVMAP\n";
 		fragmentShader += "#define USE_SHADOWMAP\n";
+		fragmentShader += "#define LIGHT_CLUSTER_TILES_X " + std::to_string(LightClusters::TILES_X) + "\n";
+		fragmentShader += "#define LIGHT_CLUSTER_TILES_Y " + std::to_string(LightClusters::TILES_Y) + "\n";
+		fragmentShader += "#define LIGHT_CLUSTER_SLICES " + std::to_string(LightClusters::SLICES) + "\n";
+		fragmentShader += "#define LIGHT_CLUSTER_COUNT " + std::to_string(LightClusters::NUM_CLUSTERS) + "\n";
+		fragmentShader += "#define LIGHT_CLUSTER_MAX_LIGHTS " + std::to_string(LightClusters::MAX_LIGHTS) + "\n";
+		fragmentShader += "#define LIGHT_CLUSTER_MAX_INDICES " + std::to_string(LightClusters::MAX_INDICES) + "\n";
+		fragmentShader += "#define SHADOW_CASCADES " + std::to_string(DirectionalLight::MAX_SHADOW_CASCADES) + "\n";
 
 		if (material->isInstanceOf<MeshStandardMaterial>())
 		{
@@ -2534,14 +2546,26 @@ namespace octoon
 				if (directionalLights != end)
 					directionalLights_ = *directionalLights;
 
-				auto pointLights = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "pointLights"; });
+				auto directionalShadows = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "DirectionalShadows"; });
+				if (directionalShadows != end)
+					directionalShadows_ = *directionalShadows;
+
+				auto pointLights = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "PointLights"; });
 				if (pointLights != end)
 					pointLights_ = *pointLights;
 
-				auto spotLights = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "spotLights"; });
+				auto spotLights = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "SpotLights"; });
 				if (spotLights != end)
 					spotLights_ = *spotLights;
 
+				auto lightClusters = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "LightClusters"; });
+				if (lightClusters != end)
+					lightClusters_ = *lightClusters;
+
+				auto lightClusterIndices = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "LightClusterIndices"; });
+				if (lightClusterIndices != end)
+					lightClusterIndices_ = *lightClusterIndices;
+
 				auto rectAreaLights = std::find_if(begin, end, [](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "rectAreaLights"; });
 				if (rectAreaLights != end)
 					rectAreaLights_ = *rectAreaLights;
@@ -2574,13 +2598,12 @@ namespace octoon
 						auto shadowMap = std::find_if(begin, end, [i](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "directionalShadowMap[" + std::to_string(i) + "]"; });
 						if (shadowMap != end)
 							this->directionalShadowMaps_.emplace_back(*shadowMap);
-						auto shadowMatrix = std::find_if(begin, end, [i](const hal::GraphicsUniformSetPtr& set) { return set->getName() == "directionalShadowMatrix[" + std::to_string(i) + "]"; });
-						if (shadowMatrix != end)
-							this->directionalShadowMatrixs_.emplace_back(*shadowMatrix);
 					}
 				}
 
-				this->updateParameters(true);
+				hal::GraphicsCommandList commands;
+				this->updateParameters(commands, true);
+				commands.execute(*context.getGraphicsContext());
 			}
 		}
 		else
@@ -2590,7 +2613,7 @@ namespace octoon
 	}
 
 	void
-	ScriptableRenderMaterial::updateParameters(bool force) noexcept
+	ScriptableRenderMaterial::updateParameters(hal::GraphicsCommandList& commands, bool force) const noexcept
 	{
 		if (this->material_->isDirty() || force)
 		{
@@ -2602,55 +2625,55 @@ namespace octoon
 				auto it = std::find_if(begin, end, [&](const hal::GraphicsUniformSetPtr& set) { return set->getName() == prop.key; });
 				if (it != end)
 				{
-					auto uniform = *it;
+					auto& uniform = *it;
 					switch (prop.type)
 					{
 					case PropertyTypeInfo::PropertyTypeInfoBool:
 					{
 						auto value = (bool*)prop.data;
-						uniform->uniform1b(*value);
+						commands.uniform1b(uniform, *value);
 					}
 					break;
 					case PropertyTypeInfo::PropertyTypeInfoInt | PropertyTypeInfo::PropertyTypeInfoBuffer:
 					{
 						auto value = (int*)prop.data;
 						if (prop.length == 4)
-							uniform->uniform1i(value[0]);
+							commands.uniform1i(uniform, value[0]);
 						else if (prop.length == 8)
-							uniform->uniform2i(value[0], value[1]);
+							commands.uniform2i(uniform, math::int2(value[0], value[1]));
 						else if (prop.length == 12)
-							uniform->uniform3i(value[0], value[1], value[2]);
+							commands.uniform3i(uniform, math::int3(value[0], value[1], value[2]));
 						else if (prop.length == 16)
-							uniform->uniform4i(value[0], value[1], value[2], value[3]);
+							commands.uniform4i(uniform, math::int4(value[0], value[1], value[2], value[3]));
 					}
 					break;
 					case PropertyTypeInfo::PropertyTypeInfoFloat:
 					{
 						auto value = (float*)prop.data;
-						uniform->uniform1f(value[0]);
+						commands.uniform1f(uniform, value[0]);
 					}
 					break;
 					case PropertyTypeInfo::PropertyTypeInfoFloat2:
 					{
 						auto value = (float*)prop.data;
-						uniform->uniform2f(value[0], value[1]);
+						commands.uniform2f(uniform, math::float2(value[0], value[1]));
 					}
 					break;
 					case PropertyTypeInfo::PropertyTypeInfoFloat3:
 					{
 						auto value = (float*)prop.data;
-						uniform->uniform3f(value[0], value[1], value[2]);
+						commands.uniform3f(uniform, math::float3(value[0], value[1], value[2]));
 					}
 					break;
 					case PropertyTypeInfo::PropertyTypeInfoFloat4:
 					{
 						auto value = (float*)prop.data;
-						uniform->uniform4f(value[0], value[1], value[2], value[3]);
+						commands.uniform4f(uniform, math::float4(value[0], value[1], value[2], value[3]));
 					}
 					break;
 					case PropertyTypeInfo::PropertyTypeInfoTexture:
 					{
-						uniform->uniformTexture(prop.texture);
+						commands.uniformTexture(uniform, prop.texture);
 					}
 					break;
 					default:
@@ -0,0 +1,85 @@
+#include <octoon/video/shadow_cascades.h>
+#include <algorithm>
+#include <cmath>
+
+namespace octoon
+{
+	void
+	ShadowCascades::split(float znear, float zfar, std::uint32_t count, float lambda, float splits[]) noexcept
+	{
+		znear = std::max(znear, 1e-3f);
+		zfar = std::max(zfar, znear * 1.001f);
+
+		for (std::uint32_t i = 1; i <= count; i++)
+		{
+			auto t = float(i) / count;
+			auto logarithmic = znear * std::pow(zfar / znear, t);
+			auto uniform = znear + (zfar - znear) * t;
+			splits[i - 1] = lambda * logarithmic + (1.0f - lambda) * uniform;
+		}
+	}
+
+	void
+	ShadowCascades::fit(const Camera& camera, float zmin, float zmax, const math::float4x4& lightView, float casterDistance, const math::float4& viewport, const math::uint2& atlasSize, RenderingData::ShadowCascade& cascade) noexcept
+	{
+		// Texels kept free at the tile border so filtering never reads a neighbouring cascade.
+		constexpr float BORDER = 2.0f;
+
+		auto& projectionInverse = camera.getProjectionInverse();
+
+		auto origin = projectionInverse * math::float3(0.0f, 0.0f, 0.0f);
+		auto target = projectionInverse * math::float3(0.0f, 0.0f, 1.0f);
+		auto forward = target.z >= origin.z ? 1.0f : -1.0f;
+
+		math::float3 corners[8];
+
+		for (std::uint32_t i = 0; i < 4; i++)
+		{
+			auto ndcX = i & 1 ? 1.0f : -1.0f;
+			auto ndcY = i & 2 ? 1.0f : -1.0f;
+			auto nearPoint = projectionInverse * math::float3(ndcX, ndcY, 0.0f);
+			auto farPoint = projectionInverse * math::float3(ndcX, ndcY, 1.0f);
+
+			for (std::uint32_t j = 0; j < 2; j++)
+			{
+				auto t = ((j ? zmax : zmin) * forward - nearPoint.z) / (farPoint.z - nearPoint.z);
+				corners[i * 2 + j] = nearPoint + (farPoint - nearPoint) * t;
+			}
+		}
+
+		// The sphere is measured in view space so its radius does not depend on the camera rotation.
+		math::float3 center = math::float3::Zero;
+		for (auto& corner : corners)
+			center += corner;
+		center /= 8.0f;
+
+		float radius = 0.0f;
+		for (auto& corner : corners)
+			radius = std::max(radius, math::length(corner - center));
+
+		auto tileSize = std::min(viewport.z, viewport.w);
+		radius = std::ceil(radius * 16.0f) / 16.0f;
+		radius *= tileSize / std::max(tileSize - BORDER * 2.0f, 1.0f);
+
+		auto lightCenter = lightView * (camera.getTransform() * center);
+
+		auto texel = radius * 2.0f / tileSize;
+		lightCenter.x = std::floor(lightCenter.x / texel) * texel;
+		lightCenter.y = std::floor(lightCenter.y / texel) * texel;
+
+		cascade.ortho = math::float4(lightCenter.x - radius, lightCenter.x + radius, lightCenter.y - radius, lightCenter.y + radius);
+		cascade.znear = lightCenter.z - radius - casterDistance;
+		cascade.zfar = lightCenter.z + radius;
+		cascade.viewport = viewport;
+
+		auto projection = math::makeOrthoLH(cascade.ortho.x, cascade.ortho.y, cascade.ortho.z, cascade.ortho.w, cascade.znear, cascade.zfar);
+		cascade.viewProjection = projection * lightView;
+
+		// Clip space of the cascade to its tile of the atlas, with depth in the range the depth pass writes.
+		math::float4x4 tile;
+		tile.makeScale(viewport.z * 0.5f / atlasSize.x, viewport.w * 0.5f / atlasSize.y, 0.5f);
+		tile.translate((viewport.x + viewport.z * 0.5f) / atlasSize.x, (viewport.y + viewport.w * 0.5f) / atlasSize.y, 0.5f);
+
+		cascade.shadowMatrix = tile * cascade.viewProjection * camera.getTransform();
+	}
+}
@@ -0,0 +1,241 @@
+#include <octoon/video/static_batcher.h>
+#include <algorithm>
+#include <numeric>
+
+namespace octoon
+{
+	static bool isBlended(const Material& material) noexcept
+	{
+		for (auto& blend : material.getColorBlends())
+		{
+			if (blend.getBlendEnable())
+				return true;
+		}
+
+		return false;
+	}
+
+	StaticBatcher::StaticBatcher() noexcept
+	{
+	}
+
+	void
+	StaticBatcher::update(const std::vector<Geometry*>& geometries) noexcept
+	{
+		geometries_.clear();
+		rebuilt_.clear();
+		retired_.clear();
+		members_.clear();
+		meshes_.clear();
+
+		std::vector<Batch> batches;
+		std::vector<std::size_t> numVertices;
+		std::unordered_map<std::uint64_t, std::size_t> filling;
+
+		for (auto& geometry : geometries)
+		{
+			auto& mesh = geometry->getMesh();
+			if (!geometry->getStatic() || !geometry->getVisible() || !mesh || mesh->getNumSubsets() == 0 || mesh->getNumVertices() == 0)
+			{
+				geometries_.push_back(geometry);
+				continue;
+			}
+
+			auto key = makeKey(*geometry);
+			auto it = filling.find(key);
+			if (it == filling.end() || numVertices[it->second] + mesh->getNumVertices() > MAX_VERTICES)
+			{
+				it = filling.insert_or_assign(key, batches.size()).first;
+				batches.push_back(Batch{ key });
+				numVertices.push_back(0);
+			}
+
+			batches[it->second].members.push_back(Member{ geometry, geometry->getGeneration(), mesh->getGeneration() });
+			numVertices[it->second] += mesh->getNumVertices();
+
+			members_.insert(geometry);
+			meshes_.insert(mesh.get());
+		}
+
+		for (auto& batch : batches)
+		{
+			auto it = std::find_if(batches_.begin(), batches_.end(), [&](const Batch& old) { return old.geometry && old.key == batch.key && old.members == batch.members; });
+			if (it != batches_.end())
+			{
+				batch.geometry = std::move(it->geometry);
+			}
+			else if (this->build(batch))
+			{
+				rebuilt_.push_back(batch.geometry.get());
+			}
+			else
+			{
+				// Meshes with different attributes cannot be merged, they are drawn on their own.
+				for (auto& member : batch.members)
+				{
+					geometries_.push_back(member.geometry);
+					members_.erase(member.geometry);
+					meshes_.erase(member.geometry->getMesh().get());
+				}
+			}
+		}
+
+		for (auto& old : batches_)
+		{
+			if (old.geometry)
+				retired_.push_back(old.geometry->getMesh().get());
+		}
+
+		batches.erase(std::remove_if(batches.begin(), batches.end(), [](const Batch& batch) { return !batch.geometry; }), batches.end());
+		batches_ = std::move(batches);
+
+		batchGeometries_.clear();
+		for (auto& batch : batches_)
+		{
+			geometries_.push_back(batch.geometry.get());
+			batchGeometries_.insert(batch.geometry.get());
+		}
+
+		std::stable_sort(geometries_.begin(), geometries_.end(), [](const Geometry* a, const Geometry* b)
+		{
+			return a->getRenderOrder() < b->getRenderOrder();
+		});
+	}
+
+	const std::vector<Geometry*>&
+	StaticBatcher::getGeometries() const noexcept
+	{
+		return this->geometries_;
+	}
+
+	const std::vector<Geometry*>&
+	StaticBatcher::getRebuiltGeometries() const noexcept
+	{
+		return this->rebuilt_;
+	}
+
+	const std::vector<Mesh*>&
+	StaticBatcher::getRetiredMeshes() const noexcept
+	{
+		return this->retired_;
+	}
+
+	bool
+	StaticBatcher::isBatch(const Geometry* geometry) const noexcept
+	{
+		return this->batchGeometries_.find(geometry) != this->batchGeometries_.end();
+	}
+
+	bool
+	StaticBatcher::contains(const Geometry* geometry) const noexcept
+	{
+		return this->members_.find(geometry) != this->members_.end();
+	}
+
+	bool
+	StaticBatcher::contains(const Mesh* mesh) const noexcept
+	{
+		return this->meshes_.find(mesh) != this->meshes_.end();
+	}
+
+	void
+	StaticBatcher::clear() noexcept
+	{
+		for (auto& batch : batches_)
+			retired_.push_back(batch.geometry->getMesh().get());
+
+		batches_.clear();
+		geometries_.clear();
+		rebuilt_.clear();
+		members_.clear();
+		meshes_.clear();
+		batchGeometries_.clear();
+	}
+
+	std::uint64_t
+	StaticBatcher::makeKey(const Geometry& geometry) noexcept
+	{
+		std::uint64_t key = static_cast<std::uint32_t>(geometry.getRenderOrder());
+		key = (key << 8) | geometry.getLayer();
+		key = (key << 1) | (geometry.getCastShadow() ? 1 : 0);
+		key = (key << 1) | (geometry.getReceiveShadow() ? 1 : 0);
+		return key;
+	}
+
+	bool
+	StaticBatcher::build(Batch& batch) noexcept
+	{
+		std::vector<CombineMesh> instances;
+		std::vector<std::shared_ptr<Material>> materials;
+
+		for (auto& member : batch.members)
+		{
+			auto& mesh = member.geometry->getMesh();
+			auto& geometryMaterials = member.geometry->getMaterials();
+
+			instances.emplace_back(mesh, member.geometry->getTransform());
+
+			for (std::size_t i = 0; i < mesh->getNumSubsets(); i++)
+				materials.push_back(i < geometryMaterials.size() ? geometryMaterials[i] : nullptr);
+		}
+
+		auto mesh = std::make_shared<Mesh>();
+		if (!mesh->mergeMeshes(instances, false))
+			return false;
+
+		// Subsets come out in member order. A stable sort on the first use of each material brings the
+		// opaque ones drawn with the same pipeline together, the blended ones follow in member order so
+		// they still draw back to front as before, and the ones without a material are left at the end.
+		std::unordered_map<const Material*, std::size_t> ranks;
+		std::vector<std::pair<std::size_t, std::size_t>> keys(materials.size());
+		std::size_t numMaterials = 0;
+
+		for (std::size_t i = 0; i < materials.size(); i++)
+		{
+			auto material = materials[i].get();
+			if (!material)
+				keys[i] = std::make_pair(2, i);
+			else if (isBlended(*material))
+				keys[i] = std::make_pair(1, i);
+			else
+				keys[i] = std::make_pair(0, ranks.emplace(material, ranks.size()).first->second);
+
+			if (material)
+				numMaterials++;
+		}
+
+		std::vector<std::size_t> order(materials.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+		{
+			return keys[a] < keys[b];
+		});
+
+		std::vector<math::uint1s> subsets(order.size());
+		for (std::size_t i = 0; i < order.size(); i++)
+			subsets[i] = std::move(mesh->getIndicesArray(i));
+
+		std::vector<std::shared_ptr<Material>> sortedMaterials(numMaterials);
+		for (std::size_t i = 0; i < order.size(); i++)
+		{
+			mesh->setIndicesArray(std::move(subsets[order[i]]), i);
+			if (i < numMaterials)
+				sortedMaterials[i] = materials[order[i]];
+		}
+
+		mesh->computeBoundingBox();
+
+		auto& first = *batch.members.front().geometry;
+
+		batch.geometry = std::make_shared<Geometry>();
+		batch.geometry->setStatic(true);
+		batch.geometry->setLayer(first.getLayer());
+		batch.geometry->setRenderOrder(first.getRenderOrder());
+		batch.geometry->setCastShadow(first.getCastShadow());
+		batch.geometry->setReceiveShadow(first.getReceiveShadow());
+		batch.geometry->setMesh(std::move(mesh));
+		batch.geometry->setMaterials(std::move(sortedMaterials));
+
+		return true;
+	}
+}
@@ -1,6 +1,7 @@
 #include <octoon/animator_component.h>
 #include <octoon/transform_component.h>
 #include <octoon/solver_component.h>
+#include <octoon/skinned_component.h>
 #include <octoon/timer_feature.h>
 #include <octoon/rigidbody_component.h>
 
@@ -292,7 +293,7 @@ namespace octoon
 			transform->setLocalQuaternion(math::Quaternion(euler));
 		}
 
-		this->sendMessage("octoon:animation:update");
+		this->sendEvent(SkinnedComponent::AnimationUpdateEvent);
 	}
 
 	void
@@ -341,7 +342,7 @@ namespace octoon
 				else if (curve.first == "Transform:move")
 					move = curve.second.value;
 				else
-					this->sendMessage(curve.first, curve.second.value);
+					this->sendEvent(SkinnedComponent::makeControlEvent(curve.first), curve.second.value);
 			}
 
 			if (move != 0.0f)
@@ -358,6 +359,6 @@ namespace octoon
 			}
 		}
 
-		this->sendMessage("octoon:animation:update");
+		this->sendEvent(SkinnedComponent::AnimationUpdateEvent);
 	}
 }
\ No newline at end of file
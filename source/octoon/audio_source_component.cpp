@@ -45,7 +45,7 @@ namespace octoon
 	float
 	AudioSourceComponent::getTime() const noexcept
 	{
-		return source_->getSampleOffset() / audioReader_->frequency();
+		return source_->getSampleOffset() / float(audioReader_->frequency());
 	}
 
 	float
@@ -59,31 +59,7 @@ namespace octoon
 	{
 		if (audioReader_ != reader)
 		{
-			AudioClip clip;
-
-			if (reader)
-			{
-				clip.samples = reader->samples();
-				clip.channels = reader->channels();
-				clip.freq = reader->frequency();
-				clip.bitsPerSample = reader->bitsPerSample();
-				clip.length = clip.samples / float(clip.freq);
-				clip.data.resize(reader->size());
-
-				reader->seekg(0, io::ios_base::beg);
-				reader->read((char*)clip.data.data(), clip.data.size());
-			}
-			else
-			{
-				clip.samples = 0;
-				clip.channels = 0;
-				clip.freq = 0;
-				clip.length = 0;
-				clip.bitsPerSample = 0;
-			}
-
-			source_->setAudioClip(clip);
-
+			source_->setAudioReader(reader);
 			audioReader_ = reader;
 		}
 	}
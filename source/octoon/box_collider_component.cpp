@@ -58,6 +58,8 @@ namespace octoon
 	void
 	BoxColliderComponent::setWidth(float width) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setWidth(width);
 		this->size_.x = width;
@@ -66,6 +68,8 @@ namespace octoon
 	void 
 	BoxColliderComponent::setHeight(float height) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setHeight(height);
 		this->size_.y = height;
@@ -74,6 +78,8 @@ namespace octoon
 	void
 	BoxColliderComponent::setDepth(float depth) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setDepth(depth);
 		this->size_.z = depth;
@@ -82,6 +88,8 @@ namespace octoon
 	void
 	BoxColliderComponent::setSize(const math::float3& sz) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 		{
 			shape_->setWidth(size_.x);
@@ -96,6 +104,8 @@ namespace octoon
 	{
 		if (this->center_ != center)
 		{
+			this->waitSimulate();
+
 			if (shape_)
 				shape_->setCenter(center);
 
@@ -109,6 +119,8 @@ namespace octoon
 	{
 		if (this->rotation_ != rotation)
 		{
+			this->waitSimulate();
+
 			if (shape_)
 				shape_->setQuaternion(rotation);
 
@@ -168,6 +180,8 @@ namespace octoon
 	void
 	BoxColliderComponent::setContactOffset(float offset) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setContactOffset(offset);
 		this->contactOffset_ = shape_->getContactOffset();
@@ -182,6 +196,8 @@ namespace octoon
 	void
 	BoxColliderComponent::setRestOffset(float offset) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setRestOffset(offset);
 		this->restOffset_ = shape_->getRestOffset();
@@ -237,6 +253,8 @@ namespace octoon
     void
 	BoxColliderComponent::onDeactivate() noexcept
     {
+		this->waitSimulate();
+
 		shape_.reset();
 		shape_ = nullptr;
     }
@@ -49,6 +49,8 @@ namespace octoon
 	void
 	CapsuleColliderComponent::setRadius(float radius) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setRadius(radius);
 		this->radius_ = radius;
@@ -57,6 +59,8 @@ namespace octoon
 	void 
 	CapsuleColliderComponent::setHeight(float height) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setHeight(height);
 		this->height_ = height;
@@ -67,6 +71,8 @@ namespace octoon
 	{
 		if (this->center_ != center)
 		{
+			this->waitSimulate();
+
 			if (shape_)
 				shape_->setCenter(center);
 
@@ -80,6 +86,8 @@ namespace octoon
 	{
 		if (this->rotation_ != rotation)
 		{
+			this->waitSimulate();
+
 			if (shape_)
 				shape_->setQuaternion(rotation);
 
@@ -115,6 +123,8 @@ namespace octoon
 	void
 	CapsuleColliderComponent::setContactOffset(float offset) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setContactOffset(offset);
 		this->contactOffset_ = shape_->getContactOffset();
@@ -129,6 +139,8 @@ namespace octoon
 	void
 	CapsuleColliderComponent::setRestOffset(float offset) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setRestOffset(offset);
 		this->restOffset_ = shape_->getRestOffset();
@@ -194,6 +206,8 @@ namespace octoon
     void
 	CapsuleColliderComponent::onDeactivate() noexcept
     {
+		this->waitSimulate();
+
 		shape_.reset();
 		shape_ = nullptr;
     }
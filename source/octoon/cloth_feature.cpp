@@ -1,4 +1,5 @@
 #include <octoon/cloth_feature.h>
+#include <octoon/timer_feature.h>
 #include <octoon/runtime/except.h>
 
 #include <PxPhysicsAPI.h>
@@ -47,7 +48,7 @@ namespace octoon
     void
 	ClothFeature::onActivate() except
     {
-		this->addMessageListener("feature:timer:fixed", std::bind(&ClothFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->addEventListener<&ClothFeature::onFixedUpdate>(TimerFeature::FixedUpdateEvent, this);
 
 		nv::cloth::InitializeNvCloth(defaultAllocatorCallback.get(), defaultErrorCallback.get(), nv::cloth::GetNvClothAssertHandler(), profileCallback_.get());
 
@@ -63,6 +64,8 @@ namespace octoon
     void
 	ClothFeature::onDeactivate() noexcept
     {
+		this->removeEventListener<&ClothFeature::onFixedUpdate>(TimerFeature::FixedUpdateEvent, this);
+
 		if (factory_)
 			NvClothDestroyFactory(factory_);
     }
@@ -88,19 +91,16 @@ namespace octoon
     }
 
 	void
-	ClothFeature::onFixedUpdate(const std::any& data) noexcept
+	ClothFeature::onFixedUpdate(float timeInterval) noexcept
 	{
-		if (data.type() == typeid(float))
+		timeInterval_ = timeInterval;
+		if (timeInterval_ > 0.0f)
 		{
-			timeInterval_ = std::any_cast<float>(data);
-			if (timeInterval_ > 0.0f)
+			if (solver_->beginSimulation(timeInterval_))
 			{
-				if (solver_->beginSimulation(timeInterval_))
-				{
-					for (int j = 0; j < solver_->getSimulationChunkCount(); j++)
-						solver_->simulateChunk(j);
-					solver_->endSimulation();
-				}
+				for (int j = 0; j < solver_->getSimulationChunkCount(); j++)
+					solver_->simulateChunk(j);
+				solver_->endSimulation();
 			}
 		}
 	}
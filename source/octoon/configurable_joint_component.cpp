@@ -88,6 +88,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setXMotion(ConfigurableJointMotion motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setXMotion(motion);
 		this->motionX_ = motion;
@@ -96,6 +98,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setYMotion(ConfigurableJointMotion motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setYMotion(motion);
 		this->motionY_ = motion;
@@ -104,6 +108,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setZMotion(ConfigurableJointMotion motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setZMotion(motion);
 		this->motionZ_ = motion;
@@ -112,6 +118,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setAngularXMotion(ConfigurableJointMotion motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setAngularXMotion(motion);
 		this->angularMotionX_= motion;
@@ -120,6 +128,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setAngularYMotion(ConfigurableJointMotion motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setAngularYMotion(motion);
 		this->angularMotionY_ = motion;
@@ -128,6 +138,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setAngularZMotion(ConfigurableJointMotion motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setAngularZMotion(motion);
 		this->angularMotionZ_ = motion;
@@ -172,6 +184,8 @@ namespace octoon
 	void 
 	ConfigurableJointComponent::setLowXLimit(float limit) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setLowXLimit(limit);
 		this->lowX_ = limit;
@@ -180,6 +194,8 @@ namespace octoon
 	void 
 	ConfigurableJointComponent::setLowYLimit(float limit) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setLowYLimit(limit);
 		this->lowY_ = limit;
@@ -188,6 +204,8 @@ namespace octoon
 	void 
 	ConfigurableJointComponent::setLowZLimit(float limit) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setLowZLimit(limit);
 		this->lowZ_ = limit;
@@ -196,6 +214,8 @@ namespace octoon
 	void 
 	ConfigurableJointComponent::setHighXLimit(float limit) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setHighXLimit(limit);
 		this->highX_ = limit;
@@ -204,6 +224,8 @@ namespace octoon
 	void 
 	ConfigurableJointComponent::setHighYLimit(float limit) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setHighYLimit(limit);
 		this->highY_ = limit;
@@ -211,6 +233,8 @@ namespace octoon
 	void 
 	ConfigurableJointComponent::setHighZLimit(float limit) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setHighZLimit(limit);
 		this->highZ_ = limit;
@@ -219,6 +243,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setDistanceLimit(float distance) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setDistanceLimit(distance);
 		this->distanceLimit_ = distance;
@@ -227,6 +253,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setTwistLimit(float min, float max) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setTwistLimit(min, max);
 		lowAngleXLimit_ = min;
@@ -236,6 +264,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setSwingLimit(float y, float z) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setSwingLimit(y, z);
 		lowAngleYLimit_ = -y;
@@ -247,6 +277,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setPyramidSwingLimit(float min_y, float max_y, float min_z, float max_z) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setPyramidSwingLimit(min_y, max_y, min_z, max_z);
 		lowAngleYLimit_ = min_y;
@@ -258,6 +290,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setDriveMotionX(float motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setDriveMotionX(motion);
 		driveMotion_.x = motion;
@@ -266,6 +300,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setDriveMotionY(float motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setDriveMotionY(motion);
 		driveMotion_.y = motion;
@@ -274,6 +310,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setDriveMotionZ(float motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setDriveMotionZ(motion);
 		driveMotion_.z = motion;
@@ -282,6 +320,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setDriveAngularX(float motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setDriveAngularX(motion);
 		driveAngular_.z = motion;
@@ -290,6 +330,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setDriveAngularY(float motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setDriveAngularY(motion);
 		driveAngular_.z = motion;
@@ -298,6 +340,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setDriveAngularZ(float motion) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->setDriveAngularZ(motion);
 		driveAngular_.z = motion;
@@ -306,6 +350,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::enableProjection(bool enable) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->enableProjection(enable);
 		enableProjection_ = enable;
@@ -314,6 +360,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::enablePreprocessing(bool enable) noexcept
 	{
+		this->waitSimulate();
+
 		if (joint_)
 			joint_->enablePreprocessing(enable);
 		enablePreprocessing_ = enable;
@@ -362,6 +410,8 @@ namespace octoon
 	void
 	ConfigurableJointComponent::setupConfigurableTransform(const math::float3& position, const math::Quaternion& rotation)
 	{
+		this->waitSimulate();
+
 		if (joint_)
 		{
 			math::float4x4 transform;
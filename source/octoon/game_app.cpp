@@ -230,6 +230,15 @@ namespace octoon
 			throw runtime::runtime_error::create("please call open() before openScene()");
 	}
 
+	bool
+	GameApp::saveScene(const GameScenePtr& scene, std::string_view filename) except
+	{
+		if (server_)
+			return server_->saveScene(scene, filename);
+		else
+			throw runtime::runtime_error::create("please call open() before saveScene()");
+	}
+
 	void
 	GameApp::closeScene(const GameScenePtr& name) noexcept
 	{
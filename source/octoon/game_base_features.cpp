@@ -1,6 +1,7 @@
 #include <octoon/game_base_features.h>
 #include <octoon/game_object_manager.h>
 #include <octoon/game_listener.h>
+#include <octoon/timer_feature.h>
 #include <octoon/input/input.h>
 
 namespace octoon
@@ -32,9 +33,15 @@ namespace octoon
 	GameBaseFeature::onActivate() noexcept
     {
 		this->addMessageListener("feature:input:event", std::bind(&GameBaseFeature::onInputEvent, this, std::placeholders::_1));
-		this->addMessageListener("feature:timer:fixed", std::bind(&GameBaseFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->addEventListener<&GameBaseFeature::onFixedUpdate>(TimerFeature::FixedUpdateEvent, this);
     }
 
+	void
+	GameBaseFeature::onDeactivate() noexcept
+	{
+		this->removeEventListener<&GameBaseFeature::onFixedUpdate>(TimerFeature::FixedUpdateEvent, this);
+	}
+
 	void
 	GameBaseFeature::onFrameBegin() noexcept
 	{
@@ -117,7 +124,7 @@ namespace octoon
 	}
 
 	void
-	GameBaseFeature::onFixedUpdate(const std::any& data) noexcept
+	GameBaseFeature::onFixedUpdate(float timeInterval) noexcept
 	{
 		GameObjectManager::instance()->onFixedUpdate();
 	}
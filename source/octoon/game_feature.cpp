@@ -87,6 +87,13 @@ namespace octoon
 		server_->removeMessageListener(event, listener);
 	}
 
+	runtime::EventDispatcher&
+	GameFeature::getEventDispatcher() noexcept
+	{
+		assert(server_);
+		return server_->getEventDispatcher();
+	}
+
 	void
 	GameFeature::_setGameServer(GameServer* server) noexcept
 	{
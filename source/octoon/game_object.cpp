@@ -3,6 +3,7 @@
 #include <octoon/game_component.h>
 #include <octoon/game_scene_manager.h>
 #include <octoon/transform_component.h>
+#include <octoon/runtime/profiler.h>
 
 namespace octoon
 {
@@ -711,7 +712,10 @@ namespace octoon
 
 		auto& components = dispatchComponents_[GameDispatchType::FixedUpdate];
 		for (auto& it : components)
+		{
+			OCTOON_PROFILE_SCOPE(it->type_name());
 			it->onFixedUpdate();
+		}
 	}
 
 	void
@@ -721,7 +725,10 @@ namespace octoon
 
 		auto& components = dispatchComponents_[GameDispatchType::Frame];
 		for (auto& it : components)
+		{
+			OCTOON_PROFILE_SCOPE(it->type_name());
 			it->onUpdate();
+		}
 	}
 
 	void
@@ -731,7 +738,10 @@ namespace octoon
 
 		auto& components = dispatchComponents_[GameDispatchType::LateUpdate];
 		for (auto& it : components)
+		{
+			OCTOON_PROFILE_SCOPE(it->type_name());
 			it->onLateUpdate();
+		}
 	}
 
 	void
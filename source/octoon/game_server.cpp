@@ -3,6 +3,9 @@
 #include <octoon/game_feature.h>
 #include <octoon/game_listener.h>
 #include <octoon/io/json_reader.h>
+#include <octoon/io/binary_archive.h>
+#include <octoon/io/mmap_stream.h>
+#include <octoon/runtime/profiler.h>
 
 namespace octoon
 {
@@ -84,14 +87,31 @@ namespace octoon
 
 		try
 		{
-			io::JsonReader json;
-			json.open(std::string(filename));
-			if (json)
+			io::immapstream stream;
+			if (!stream.open(std::string(filename)))
+				return false;
+
+			std::unique_ptr<io::iarchive> reader;
+
+			if (io::BinaryArchiveReader::accept(stream))
+			{
+				auto binary = std::make_unique<io::BinaryArchiveReader>();
+				binary->open(stream);
+				reader = std::move(binary);
+			}
+			else
+			{
+				auto json = std::make_unique<io::JsonReader>();
+				json->open(stream);
+				reader = std::move(json);
+			}
+
+			if (*reader)
 			{
 				auto scene = std::make_shared<GameScene>();
 				scene->_setGameServer(this);
 				scene->setGameListener(listener_);
-				scene->load(*json.rdbuf());
+				scene->load(*reader->rdbuf());
 
 				return this->addScene(scene);
 			}
@@ -109,6 +129,27 @@ namespace octoon
 		}
 	}
 
+	bool
+	GameServer::saveScene(const GameScenePtr& scene, std::string_view filename) noexcept
+	{
+		assert(scene && !filename.empty());
+
+		try
+		{
+			io::BinaryArchiveWrite writer;
+			scene->save(*writer.rdbuf());
+
+			return (bool)writer.save(std::string(filename));
+		}
+		catch (const std::exception& e)
+		{
+			if (listener_)
+				listener_->onMessage(e.what());
+
+			return false;
+		}
+	}
+
 	void
 	GameServer::closeScene(std::string_view sceneName) noexcept
 	{
@@ -366,12 +407,15 @@ namespace octoon
 
 		features_.clear();
 		dispatchEvents_.clear();
+		events_.clear();
 	}
 
 	void
 	GameServer::sendMessage(std::string_view event, const std::any& data) noexcept
 	{
-		dispatchEvents_[std::string(event)].call_all_slots(data);
+		auto it = dispatchEvents_.find(event);
+		if (it != dispatchEvents_.end())
+			(*it).second.call_all_slots(data);
 	}
 
 	void 
@@ -383,7 +427,15 @@ namespace octoon
 	void 
 	GameServer::removeMessageListener(std::string_view event, std::function<void(const std::any&)> listener) noexcept
 	{
-		dispatchEvents_[std::string(event)].disconnect(listener);
+		auto it = dispatchEvents_.find(event);
+		if (it != dispatchEvents_.end())
+			(*it).second.disconnect(listener);
+	}
+
+	runtime::EventDispatcher&
+	GameServer::getEventDispatcher() noexcept
+	{
+		return events_;
 	}
 
 	void
@@ -408,14 +460,29 @@ namespace octoon
 		{
 			if (!isQuitRequest_)
 			{
+				runtime::Profiler::beginFrame();
+
 				for (auto& it : features_)
+				{
+					OCTOON_PROFILE_SCOPE(it->type_name());
 					it->onFrameBegin();
+				}
 
 				for (auto& it : features_)
+				{
+					OCTOON_PROFILE_SCOPE(it->type_name());
 					it->onFrame();
+				}
 
 				for (auto& it : features_)
+				{
+					OCTOON_PROFILE_SCOPE(it->type_name());
 					it->onFrameEnd();
+				}
+
+				events_.flush();
+
+				runtime::Profiler::endFrame();
 			}
 		}
 		catch (const std::exception& e)
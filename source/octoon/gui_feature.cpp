@@ -11,6 +11,7 @@
 #include <octoon/ui/imgui_system.h>
 
 #include <octoon/runtime/except.h>
+#include <octoon/runtime/profiler.h>
 #include <octoon/hal_feature.h>
 
 #include <octoon/game_object_manager.h>
@@ -25,6 +26,7 @@ namespace octoon
 		, height_(0)
 		, framebuffer_w_(0)
 		, framebuffer_h_(0)
+		, profilerOverlay_(false)
 	{
 	}
 
@@ -34,6 +36,7 @@ namespace octoon
 		, height_(h)
 		, framebuffer_w_(framebuffer_w)
 		, framebuffer_h_(framebuffer_h)
+		, profilerOverlay_(false)
 	{
 	}
 
@@ -77,6 +80,19 @@ namespace octoon
 		system_->setFramebufferScale(w, h);
 	}
 
+	void
+	GuiFeature::setProfilerOverlay(bool enable) noexcept
+	{
+		profilerOverlay_ = enable;
+		runtime::Profiler::setEnable(enable);
+	}
+
+	bool
+	GuiFeature::getProfilerOverlay() const noexcept
+	{
+		return profilerOverlay_;
+	}
+
 	void
 	GuiFeature::onActivate() except
 	{
@@ -158,6 +174,43 @@ namespace octoon
 		}
 	}
 
+	void
+	GuiFeature::onProfilerOverlay() noexcept
+	{
+		imgui::setNextWindowPos(math::float2(10.0f, 10.0f), imgui::GuiSetCondFlagBits::FirstUseEverBit);
+
+		if (imgui::begin("Profiler", &profilerOverlay_, imgui::GuiWindowFlagBits::AlwaysAutoResizeBit))
+		{
+			imgui::text("Frame %.3f ms", runtime::Profiler::getFrameTime() / 1e6);
+
+			auto thread = 0u;
+			bool first = true;
+
+			for (auto& event : runtime::Profiler::getFrameEvents())
+			{
+				if (first || event.thread != thread)
+				{
+					imgui::separator();
+
+					if (event.thread == runtime::Profiler::GPU_THREAD)
+						imgui::text("GPU");
+					else
+						imgui::text("Thread %u", event.thread);
+
+					thread = event.thread;
+					first = false;
+				}
+
+				imgui::text("%*s%s %.3f ms", (int)(event.depth + 1) * 2, "", event.name, (event.end - event.begin) / 1e6);
+			}
+		}
+
+		imgui::end();
+
+		if (!profilerOverlay_)
+			runtime::Profiler::setEnable(false);
+	}
+
 	void
 	GuiFeature::onFrameBegin() noexcept
 	{
@@ -178,6 +231,9 @@ namespace octoon
 		{
 			GameObjectManager::instance()->onGui();
 
+			if (profilerOverlay_)
+				this->onProfilerOverlay();
+
 			auto graphics = this->getFeature<GraphicsFeature>();
 			if (graphics)
 				system_->render(*graphics->getContext());
@@ -1,4 +1,5 @@
 #include <octoon/joint_component.h>
+#include <octoon/physics_feature.h>
 
 namespace octoon
 {
@@ -11,4 +12,12 @@ namespace octoon
 	JointComponent::~JointComponent()
 	{
 	}
+
+	void
+	JointComponent::waitSimulate() noexcept
+	{
+		auto physicsFeature = this->tryGetFeature<PhysicsFeature>();
+		if (physicsFeature)
+			physicsFeature->waitSimulate();
+	}
 }
\ No newline at end of file
@@ -11,6 +11,7 @@ namespace octoon
 		: visible_(true)
 		, renderOrder_(0)
 		, globalIllumination_(false)
+		, static_(false)
 	{
 	}
 
@@ -92,11 +93,29 @@ namespace octoon
 		return this->globalIllumination_;
 	}
 
+	void
+	MeshRendererComponent::setStatic(bool enable) noexcept
+	{
+		if (this->static_ != enable)
+		{
+			if (this->geometry_)
+				this->geometry_->setStatic(enable);
+			this->static_ = enable;
+		}
+	}
+
+	bool
+	MeshRendererComponent::getStatic() const noexcept
+	{
+		return this->static_;
+	}
+
 	GameComponentPtr
 	MeshRendererComponent::clone() const noexcept
 	{
 		auto instance = std::make_shared<MeshRendererComponent>();
 		instance->setName(this->getName());
+		instance->setStatic(this->getStatic());
 
 		if (!this->getMaterials().empty())
 		{
@@ -124,6 +143,7 @@ namespace octoon
 		this->geometry_->setOwnerListener(this);
 		this->geometry_->setVisible(this->getVisible());
 		this->geometry_->setGlobalIllumination(this->getGlobalIllumination());
+		this->geometry_->setStatic(this->getStatic());
 		this->geometry_->setRenderOrder(this->getRenderOrder());
 
 		this->onMoveAfter();
@@ -0,0 +1,944 @@
+#include <octoon/model_cache.h>
+#include <octoon/texture_loader.h>
+#include <octoon/material/mesh_standard_material.h>
+#include <octoon/hal/graphics_texture.h>
+#include <octoon/io/mmap_buf.h>
+
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <type_traits>
+
+namespace octoon
+{
+	namespace
+	{
+		constexpr char kCookedMagic[4] = { 'O', 'C', 'M', 'D' };
+		constexpr std::size_t kCookedAlignment = 4096;
+
+		enum CookedSection : std::uint32_t
+		{
+			CookedSectionMeshInfo,
+			CookedSectionVertices,
+			CookedSectionNormals,
+			CookedSectionColors,
+			CookedSectionTangents,
+			CookedSectionTexcoords,
+			CookedSectionWeights,
+			CookedSectionBindposes,
+			CookedSectionIndices,
+			CookedSectionBones,
+			CookedSectionIKs,
+			CookedSectionMorphs,
+			CookedSectionRigidbodies,
+			CookedSectionJoints,
+			CookedSectionSoftbodies,
+			CookedSectionMaterials,
+		};
+
+		struct CookedHeader
+		{
+			char magic[4];
+			std::uint32_t version;
+			std::uint64_t hash;
+			std::uint32_t numSections;
+			std::uint32_t reserved;
+		};
+
+		struct CookedEntry
+		{
+			std::uint32_t type;
+			std::uint16_t mesh;
+			std::uint16_t slot;
+			std::uint64_t offset;
+			std::uint64_t size;
+		};
+
+		class CookedWriter final
+		{
+		public:
+			template<typename T>
+			void put(const T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+				this->put(&value, sizeof(T));
+			}
+
+			void put(const void* data, std::size_t size)
+			{
+				auto offset = buffer_.size();
+				buffer_.resize(offset + size);
+				if (size > 0)
+					std::memcpy(buffer_.data() + offset, data, size);
+			}
+
+			void putString(const std::string& str)
+			{
+				this->put((std::uint32_t)str.size());
+				this->put(str.data(), str.size());
+			}
+
+			template<typename T>
+			void putVector(const std::vector<T>& array)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+				this->put((std::uint32_t)array.size());
+				this->put(array.data(), array.size() * sizeof(T));
+			}
+
+			std::vector<char>& buffer() noexcept
+			{
+				return buffer_;
+			}
+
+		private:
+			std::vector<char> buffer_;
+		};
+
+		class CookedReader final
+		{
+		public:
+			CookedReader(const char* data, std::size_t size) noexcept
+				: ptr_(data)
+				, end_(data + size)
+			{
+			}
+
+			bool get(void* dst, std::size_t size) noexcept
+			{
+				if (std::size_t(end_ - ptr_) < size)
+					return false;
+				if (size > 0)
+					std::memcpy(dst, ptr_, size);
+				ptr_ += size;
+				return true;
+			}
+
+			template<typename T>
+			bool get(T& value) noexcept
+			{
+				return this->get(&value, sizeof(T));
+			}
+
+			bool getString(std::string& str)
+			{
+				std::uint32_t length = 0;
+				if (!this->get(length) || std::size_t(end_ - ptr_) < length)
+					return false;
+				str.assign(ptr_, length);
+				ptr_ += length;
+				return true;
+			}
+
+			template<typename T>
+			bool getVector(std::vector<T>& array)
+			{
+				std::uint32_t count = 0;
+				if (!this->get(count) || std::size_t(end_ - ptr_) / sizeof(T) < count)
+					return false;
+				array.resize(count);
+				return this->get(array.data(), count * sizeof(T));
+			}
+
+		private:
+			const char* ptr_;
+			const char* end_;
+		};
+
+		class CookedFile final
+		{
+		public:
+			// Sections only point at `data`, it has to stay alive until `write` returns.
+			void addSection(CookedSection type, std::uint16_t mesh, std::uint16_t slot, const void* data, std::size_t size)
+			{
+				CookedEntry entry;
+				entry.type = type;
+				entry.mesh = mesh;
+				entry.slot = slot;
+				entry.offset = 0;
+				entry.size = size;
+
+				entries_.push_back(entry);
+				datas_.push_back(std::string_view((const char*)data, size));
+			}
+
+			void addSection(CookedSection type, std::uint16_t mesh, std::uint16_t slot, std::vector<char>&& buffer)
+			{
+				buffers_.push_back(std::move(buffer));
+				this->addSection(type, mesh, slot, buffers_.back().data(), buffers_.back().size());
+			}
+
+			template<typename T>
+			void addArray(CookedSection type, std::uint16_t mesh, std::uint16_t slot, const std::vector<T>& array)
+			{
+				if (!array.empty())
+					this->addSection(type, mesh, slot, array.data(), array.size() * sizeof(T));
+			}
+
+			bool write(const std::string& path, std::uint64_t hash)
+			{
+				CookedHeader header;
+				std::memcpy(header.magic, kCookedMagic, sizeof(kCookedMagic));
+				header.version = ModelCache::version;
+				header.hash = hash;
+				header.numSections = (std::uint32_t)entries_.size();
+				header.reserved = 0;
+
+				std::size_t offset = align(sizeof(CookedHeader) + sizeof(CookedEntry) * entries_.size());
+				for (auto& entry : entries_)
+				{
+					entry.offset = offset;
+					offset = align(offset + entry.size);
+				}
+
+				auto tmpPath = path + ".tmp";
+
+				std::ofstream stream(tmpPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+				if (!stream)
+					return false;
+
+				stream.write((const char*)&header, sizeof(header));
+				stream.write((const char*)entries_.data(), sizeof(CookedEntry) * entries_.size());
+
+				std::size_t position = sizeof(CookedHeader) + sizeof(CookedEntry) * entries_.size();
+				static const char zeros[kCookedAlignment] = {};
+
+				for (std::size_t i = 0; i < entries_.size(); i++)
+				{
+					stream.write(zeros, entries_[i].offset - position);
+					stream.write(datas_[i].data(), datas_[i].size());
+					position = entries_[i].offset + entries_[i].size;
+				}
+
+				stream.close();
+				if (!stream)
+				{
+					std::remove(tmpPath.c_str());
+					return false;
+				}
+
+				std::remove(path.c_str());
+				return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+			}
+
+		private:
+			static std::size_t align(std::size_t offset) noexcept
+			{
+				return (offset + kCookedAlignment - 1) & ~(kCookedAlignment - 1);
+			}
+
+		private:
+			std::vector<CookedEntry> entries_;
+			std::vector<std::string_view> datas_;
+			std::list<std::vector<char>> buffers_;
+		};
+
+		template<typename T>
+		bool readArray(const char* data, const CookedEntry& entry, std::vector<T>& array)
+		{
+			if (entry.size % sizeof(T) != 0)
+				return false;
+
+			auto begin = reinterpret_cast<const T*>(data + entry.offset);
+			array.assign(begin, begin + entry.size / sizeof(T));
+			return true;
+		}
+
+		void writeBones(CookedWriter& writer, const Model& model)
+		{
+			writer.put((std::uint32_t)model.bones.size());
+
+			for (auto& bone : model.bones)
+			{
+				writer.putString(bone->getName());
+				writer.put(bone->getPosition());
+				writer.put(bone->getRotation());
+				writer.put(bone->getParent());
+				writer.put(bone->getAdditiveParent());
+				writer.put((std::uint8_t)bone->getVisable());
+				writer.put((std::uint8_t)bone->getAdditiveUseLocal());
+				writer.put(bone->getAdditiveMoveRatio());
+				writer.put(bone->getAdditiveRotationRatio());
+			}
+		}
+
+		bool readBones(CookedReader& reader, Model& model)
+		{
+			std::uint32_t count = 0;
+			if (!reader.get(count)) return false;
+
+			model.bones.reserve(count);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				std::string name;
+				math::float3 position;
+				math::Quaternion rotation;
+				std::int16_t parent, additiveParent;
+				std::uint8_t visable, additiveUseLocal;
+				float moveRatio, rotationRatio;
+
+				if (!reader.getString(name)) return false;
+				if (!reader.get(position)) return false;
+				if (!reader.get(rotation)) return false;
+				if (!reader.get(parent)) return false;
+				if (!reader.get(additiveParent)) return false;
+				if (!reader.get(visable)) return false;
+				if (!reader.get(additiveUseLocal)) return false;
+				if (!reader.get(moveRatio)) return false;
+				if (!reader.get(rotationRatio)) return false;
+
+				auto bone = std::make_shared<Bone>(name);
+				bone->setPosition(position);
+				bone->setRotation(rotation);
+				bone->setParent(parent);
+				bone->setAdditiveParent(additiveParent);
+				bone->setVisable(visable != 0);
+				bone->setAdditiveUseLocal(additiveUseLocal != 0);
+				bone->setAdditiveMoveRatio(moveRatio);
+				bone->setAdditiveRotationRatio(rotationRatio);
+
+				model.bones.emplace_back(std::move(bone));
+			}
+
+			return true;
+		}
+
+		void writeIKs(CookedWriter& writer, const Model& model)
+		{
+			writer.put((std::uint32_t)model.iks.size());
+
+			for (auto& ik : model.iks)
+			{
+				writer.put(ik->boneIndex);
+				writer.put(ik->targetBoneIndex);
+				writer.put(ik->iterations);
+				writer.put(ik->chainLength);
+				writer.putVector(ik->child);
+			}
+		}
+
+		bool readIKs(CookedReader& reader, Model& model)
+		{
+			std::uint32_t count = 0;
+			if (!reader.get(count)) return false;
+
+			model.iks.reserve(count);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				auto ik = std::make_shared<IKAttr>();
+				if (!reader.get(ik->boneIndex)) return false;
+				if (!reader.get(ik->targetBoneIndex)) return false;
+				if (!reader.get(ik->iterations)) return false;
+				if (!reader.get(ik->chainLength)) return false;
+				if (!reader.getVector(ik->child)) return false;
+
+				model.iks.emplace_back(std::move(ik));
+			}
+
+			return true;
+		}
+
+		void writeMorphs(CookedWriter& writer, const Model& model)
+		{
+			writer.put((std::uint32_t)model.morphs.size());
+
+			for (auto& morph : model.morphs)
+			{
+				writer.putString(morph->name);
+				writer.put(morph->control);
+				writer.put(morph->morphType);
+				writer.put(morph->morphCount);
+				writer.putVector(morph->groupList);
+				writer.putVector(morph->vertices);
+				writer.putVector(morph->boneList);
+				writer.putVector(morph->texcoordList);
+				writer.putVector(morph->materialList);
+			}
+		}
+
+		bool readMorphs(CookedReader& reader, Model& model)
+		{
+			std::uint32_t count = 0;
+			if (!reader.get(count)) return false;
+
+			model.morphs.reserve(count);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				auto morph = std::make_shared<Morph>();
+				if (!reader.getString(morph->name)) return false;
+				if (!reader.get(morph->control)) return false;
+				if (!reader.get(morph->morphType)) return false;
+				if (!reader.get(morph->morphCount)) return false;
+				if (!reader.getVector(morph->groupList)) return false;
+				if (!reader.getVector(morph->vertices)) return false;
+				if (!reader.getVector(morph->boneList)) return false;
+				if (!reader.getVector(morph->texcoordList)) return false;
+				if (!reader.getVector(morph->materialList)) return false;
+
+				model.morphs.emplace_back(std::move(morph));
+			}
+
+			return true;
+		}
+
+		void writeRigidbodies(CookedWriter& writer, const Model& model)
+		{
+			writer.put((std::uint32_t)model.rigidbodies.size());
+
+			for (auto& body : model.rigidbodies)
+			{
+				writer.putString(body->name);
+				writer.put(body->bone);
+				writer.put(body->group);
+				writer.put(body->groupMask);
+				writer.put((std::uint32_t)body->shape);
+				writer.put(body->scale);
+				writer.put(body->position);
+				writer.put(body->rotation);
+				writer.put(body->mass);
+				writer.put(body->movementDecay);
+				writer.put(body->rotationDecay);
+				writer.put(body->elasticity);
+				writer.put(body->friction);
+				writer.put(body->physicsOperation);
+			}
+		}
+
+		bool readRigidbodies(CookedReader& reader, Model& model)
+		{
+			std::uint32_t count = 0;
+			if (!reader.get(count)) return false;
+
+			model.rigidbodies.reserve(count);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				std::uint32_t shape = 0;
+
+				auto body = std::make_shared<Rigidbody>();
+				if (!reader.getString(body->name)) return false;
+				if (!reader.get(body->bone)) return false;
+				if (!reader.get(body->group)) return false;
+				if (!reader.get(body->groupMask)) return false;
+				if (!reader.get(shape)) return false;
+				if (!reader.get(body->scale)) return false;
+				if (!reader.get(body->position)) return false;
+				if (!reader.get(body->rotation)) return false;
+				if (!reader.get(body->mass)) return false;
+				if (!reader.get(body->movementDecay)) return false;
+				if (!reader.get(body->rotationDecay)) return false;
+				if (!reader.get(body->elasticity)) return false;
+				if (!reader.get(body->friction)) return false;
+				if (!reader.get(body->physicsOperation)) return false;
+
+				body->shape = (ShapeType)shape;
+
+				model.rigidbodies.emplace_back(std::move(body));
+			}
+
+			return true;
+		}
+
+		void writeJoints(CookedWriter& writer, const Model& model)
+		{
+			writer.put((std::uint32_t)model.joints.size());
+
+			for (auto& joint : model.joints)
+			{
+				writer.putString(joint->name);
+				writer.put(joint->type);
+				writer.put(joint->position);
+				writer.put(joint->rotation);
+				writer.put(joint->bodyIndexA);
+				writer.put(joint->bodyIndexB);
+				writer.put(joint->movementLowerLimit);
+				writer.put(joint->movementUpperLimit);
+				writer.put(joint->rotationLowerLimit);
+				writer.put(joint->rotationUpperLimit);
+				writer.put(joint->springMovementConstant);
+				writer.put(joint->springRotationConstant);
+			}
+		}
+
+		bool readJoints(CookedReader& reader, Model& model)
+		{
+			std::uint32_t count = 0;
+			if (!reader.get(count)) return false;
+
+			model.joints.reserve(count);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				auto joint = std::make_shared<Joint>();
+				if (!reader.getString(joint->name)) return false;
+				if (!reader.get(joint->type)) return false;
+				if (!reader.get(joint->position)) return false;
+				if (!reader.get(joint->rotation)) return false;
+				if (!reader.get(joint->bodyIndexA)) return false;
+				if (!reader.get(joint->bodyIndexB)) return false;
+				if (!reader.get(joint->movementLowerLimit)) return false;
+				if (!reader.get(joint->movementUpperLimit)) return false;
+				if (!reader.get(joint->rotationLowerLimit)) return false;
+				if (!reader.get(joint->rotationUpperLimit)) return false;
+				if (!reader.get(joint->springMovementConstant)) return false;
+				if (!reader.get(joint->springRotationConstant)) return false;
+
+				model.joints.emplace_back(std::move(joint));
+			}
+
+			return true;
+		}
+
+		void writeSoftbodies(CookedWriter& writer, const Model& model)
+		{
+			writer.put((std::uint32_t)model.softbodies.size());
+
+			for (auto& body : model.softbodies)
+			{
+				writer.putString(body->name);
+				writer.put(body->materialIndex);
+				writer.put(body->group);
+				writer.put(body->groupMask);
+				writer.put(body->aeroModel);
+				writer.put(body->blinkLength);
+				writer.put(body->numClusters);
+				writer.put(body->LST);
+				writer.put(body->totalMass);
+				writer.put(body->collisionMargin);
+				writer.putVector(body->anchorRigidbodies);
+				writer.putVector(body->pinVertexIndices);
+			}
+		}
+
+		bool readSoftbodies(CookedReader& reader, Model& model)
+		{
+			std::uint32_t count = 0;
+			if (!reader.get(count)) return false;
+
+			model.softbodies.reserve(count);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				auto body = std::make_shared<Softbody>();
+				if (!reader.getString(body->name)) return false;
+				if (!reader.get(body->materialIndex)) return false;
+				if (!reader.get(body->group)) return false;
+				if (!reader.get(body->groupMask)) return false;
+				if (!reader.get(body->aeroModel)) return false;
+				if (!reader.get(body->blinkLength)) return false;
+				if (!reader.get(body->numClusters)) return false;
+				if (!reader.get(body->LST)) return false;
+				if (!reader.get(body->totalMass)) return false;
+				if (!reader.get(body->collisionMargin)) return false;
+				if (!reader.getVector(body->anchorRigidbodies)) return false;
+				if (!reader.getVector(body->pinVertexIndices)) return false;
+
+				model.softbodies.emplace_back(std::move(body));
+			}
+
+			return true;
+		}
+
+		void writeMaterials(CookedWriter& writer, const Model& model, std::string_view rootPath)
+		{
+			auto prefix = std::string(rootPath) + "/";
+
+			writer.put((std::uint32_t)model.materials.size());
+
+			for (auto& it : model.materials)
+			{
+				auto standard = it->downcast<MeshStandardMaterial>();
+				auto& colorMap = standard->getColorMap();
+				auto& blends = standard->getColorBlends();
+
+				writer.putString(standard->getName());
+				writer.put(standard->getColor());
+				writer.put(standard->getOpacity());
+				// Textures next to the model are kept relative to it, the same file may be cached from another folder.
+				auto texture = colorMap ? colorMap->getTextureDesc().getName() : std::string();
+				auto relative = !texture.empty() && texture.compare(0, prefix.size(), prefix) == 0;
+
+				writer.put((std::uint8_t)relative);
+				writer.putString(relative ? texture.substr(prefix.size()) : texture);
+				writer.put((std::uint8_t)(!blends.empty() && blends.front().getBlendEnable()));
+			}
+		}
+
+		bool readMaterials(CookedReader& reader, Model& model, std::string_view rootPath)
+		{
+			std::uint32_t count = 0;
+			if (!reader.get(count)) return false;
+
+			model.materials.reserve(count);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				std::string name;
+				std::string colorMap;
+				math::float3 color;
+				float opacity;
+				std::uint8_t relative;
+				std::uint8_t blendEnable;
+
+				if (!reader.getString(name)) return false;
+				if (!reader.get(color)) return false;
+				if (!reader.get(opacity)) return false;
+				if (!reader.get(relative)) return false;
+				if (!reader.getString(colorMap)) return false;
+				if (!reader.get(blendEnable)) return false;
+
+				auto material = std::make_shared<MeshStandardMaterial>();
+				material->setName(name);
+				material->setColor(color);
+				material->setOpacity(opacity);
+
+				try
+				{
+					if (!colorMap.empty())
+						material->setColorMap(TextureLoader::load(relative ? std::string(rootPath) + "/" + colorMap : colorMap));
+				}
+				catch (...)
+				{
+				}
+
+				if (blendEnable)
+				{
+					hal::GraphicsColorBlend blend;
+					blend.setBlendEnable(true);
+					blend.setBlendSrc(hal::GraphicsBlendFactor::SrcAlpha);
+					blend.setBlendDest(hal::GraphicsBlendFactor::OneMinusSrcAlpha);
+
+					std::vector<hal::GraphicsColorBlend> blends;
+					blends.push_back(blend);
+
+					material->setColorBlends(std::move(blends));
+				}
+
+				model.materials.emplace_back(std::move(material));
+			}
+
+			return true;
+		}
+
+		bool isCookable(const Model& model) noexcept
+		{
+			if (model.meshes.size() > std::numeric_limits<std::uint16_t>::max())
+				return false;
+
+			for (auto& it : model.materials)
+			{
+				if (!it || !it->isInstanceOf<MeshStandardMaterial>())
+					return false;
+			}
+
+			return true;
+		}
+	}
+
+	static std::string cacheDirectory_;
+
+	bool
+	ModelCache::setCacheDirectory(std::string_view path) noexcept
+	{
+		std::error_code ec;
+		if (!path.empty() && std::filesystem::is_directory(std::filesystem::u8path(path), ec))
+		{
+			cacheDirectory_ = path;
+			return true;
+		}
+
+		cacheDirectory_.clear();
+		return false;
+	}
+
+	const std::string&
+	ModelCache::getCacheDirectory() noexcept
+	{
+		return cacheDirectory_;
+	}
+
+	bool
+	ModelCache::isEnabled() noexcept
+	{
+		return !cacheDirectory_.empty();
+	}
+
+	std::uint64_t
+	ModelCache::hash(const char* data, std::size_t size) noexcept
+	{
+		constexpr std::uint64_t prime = 0x100000001b3ULL;
+
+		std::uint64_t h = 0xcbf29ce484222325ULL ^ size;
+		std::size_t i = 0;
+
+		for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+		{
+			std::uint64_t word;
+			std::memcpy(&word, data + i, sizeof(word));
+			h = (h ^ word) * prime;
+			h ^= h >> 29;
+		}
+
+		for (; i < size; i++)
+			h = (h ^ (std::uint8_t)data[i]) * prime;
+
+		h ^= h >> 32;
+		return h;
+	}
+
+	std::string
+	ModelCache::makePath(std::uint64_t hash) noexcept
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.ocm", (unsigned long long)hash);
+		return cacheDirectory_ + "/" + name;
+	}
+
+	bool
+	ModelCache::load(std::uint64_t hash, std::string_view rootPath, Model& model) noexcept(false)
+	{
+		if (!isEnabled())
+			return false;
+
+		return load(makePath(hash), hash, rootPath, model);
+	}
+
+	bool
+	ModelCache::save(std::uint64_t hash, std::string_view rootPath, const Model& model) noexcept(false)
+	{
+		if (!isEnabled())
+			return false;
+
+		return save(makePath(hash), hash, rootPath, model);
+	}
+
+	bool
+	ModelCache::load(std::string_view filepath, std::uint64_t hash, std::string_view rootPath, Model& model) noexcept(false)
+	{
+		io::mmapbuf file;
+		if (!file.open(std::string(filepath)))
+			return false;
+
+		auto data = file.data();
+		auto size = (std::size_t)file.size();
+
+		if (size < sizeof(CookedHeader))
+			return false;
+
+		CookedHeader header;
+		std::memcpy(&header, data, sizeof(header));
+
+		if (std::memcmp(header.magic, kCookedMagic, sizeof(kCookedMagic)) != 0)
+			return false;
+		if (header.version != version || header.hash != hash)
+			return false;
+		if ((size - sizeof(CookedHeader)) / sizeof(CookedEntry) < header.numSections)
+			return false;
+
+		std::vector<CookedEntry> entries(header.numSections);
+		std::memcpy(entries.data(), data + sizeof(CookedHeader), sizeof(CookedEntry) * entries.size());
+
+		for (auto& entry : entries)
+		{
+			if (entry.offset > size || entry.size > size - entry.offset)
+				return false;
+		}
+
+		Model result;
+		std::vector<std::vector<std::uint32_t>> subsets;
+
+		for (auto& entry : entries)
+		{
+			if (entry.type > CookedSectionIndices)
+				continue;
+
+			if (entry.mesh >= result.meshes.size())
+			{
+				result.meshes.resize(entry.mesh + 1);
+				subsets.resize(entry.mesh + 1);
+			}
+
+			auto& mesh = result.meshes[entry.mesh];
+			if (!mesh)
+				mesh = std::make_shared<Mesh>();
+
+			switch (entry.type)
+			{
+			case CookedSectionMeshInfo:
+			{
+				std::string name;
+				CookedReader reader(data + entry.offset, (std::size_t)entry.size);
+				if (!reader.getString(name)) return false;
+				if (!reader.getVector(subsets[entry.mesh])) return false;
+				mesh->setName(name);
+			}
+			break;
+			case CookedSectionVertices:
+			{
+				math::float3s array;
+				if (!readArray(data, entry, array)) return false;
+				mesh->setVertexArray(std::move(array));
+			}
+			break;
+			case CookedSectionNormals:
+			{
+				math::float3s array;
+				if (!readArray(data, entry, array)) return false;
+				mesh->setNormalArray(std::move(array));
+			}
+			break;
+			case CookedSectionColors:
+			{
+				math::float4s array;
+				if (!readArray(data, entry, array)) return false;
+				mesh->setColorArray(std::move(array));
+			}
+			break;
+			case CookedSectionTangents:
+			{
+				math::float4s array;
+				if (!readArray(data, entry, array)) return false;
+				mesh->setTangentArray(std::move(array));
+			}
+			break;
+			case CookedSectionTexcoords:
+			{
+				math::float2s array;
+				if (entry.slot >= TEXTURE_ARRAY_COUNT) return false;
+				if (!readArray(data, entry, array)) return false;
+				mesh->setTexcoordArray(std::move(array), (std::uint8_t)entry.slot);
+			}
+			break;
+			case CookedSectionWeights:
+			{
+				VertexWeights array;
+				if (!readArray(data, entry, array)) return false;
+				mesh->setWeightArray(std::move(array));
+			}
+			break;
+			case CookedSectionBindposes:
+			{
+				math::float4x4s array;
+				if (!readArray(data, entry, array)) return false;
+				mesh->setBindposes(std::move(array));
+			}
+			break;
+			}
+		}
+
+		for (auto& entry : entries)
+		{
+			if (entry.type != CookedSectionIndices || entry.mesh >= result.meshes.size())
+				continue;
+
+			auto& mesh = result.meshes[entry.mesh];
+			auto indices = reinterpret_cast<const std::uint32_t*>(data + entry.offset);
+			auto numIndices = (std::size_t)entry.size / sizeof(std::uint32_t);
+
+			std::size_t offset = 0;
+			for (std::size_t i = 0; i < subsets[entry.mesh].size(); i++)
+			{
+				auto count = subsets[entry.mesh][i];
+				if (offset + count > numIndices)
+					return false;
+
+				mesh->setIndicesArray(math::uint1s(indices + offset, indices + offset + count), i);
+				offset += count;
+			}
+		}
+
+		for (auto& mesh : result.meshes)
+		{
+			if (!mesh)
+				return false;
+			mesh->computeBoundingBox();
+		}
+
+		for (auto& entry : entries)
+		{
+			CookedReader reader(data + entry.offset, (std::size_t)entry.size);
+
+			switch (entry.type)
+			{
+			case CookedSectionBones: if (!readBones(reader, result)) return false; break;
+			case CookedSectionIKs: if (!readIKs(reader, result)) return false; break;
+			case CookedSectionMorphs: if (!readMorphs(reader, result)) return false; break;
+			case CookedSectionRigidbodies: if (!readRigidbodies(reader, result)) return false; break;
+			case CookedSectionJoints: if (!readJoints(reader, result)) return false; break;
+			case CookedSectionSoftbodies: if (!readSoftbodies(reader, result)) return false; break;
+			case CookedSectionMaterials: if (!readMaterials(reader, result, rootPath)) return false; break;
+			}
+		}
+
+		model = std::move(result);
+		return true;
+	}
+
+	bool
+	ModelCache::save(std::string_view filepath, std::uint64_t hash, std::string_view rootPath, const Model& model) noexcept(false)
+	{
+		if (!isCookable(model))
+			return false;
+
+		CookedFile file;
+
+		for (std::size_t i = 0; i < model.meshes.size(); i++)
+		{
+			auto& mesh = model.meshes[i];
+			auto index = (std::uint16_t)i;
+
+			std::vector<std::uint32_t> subsets(mesh->getNumSubsets());
+			std::vector<char> indices;
+
+			for (std::size_t j = 0; j < subsets.size(); j++)
+			{
+				auto& array = mesh->getIndicesArray(j);
+				subsets[j] = (std::uint32_t)array.size();
+				indices.insert(indices.end(), (const char*)array.data(), (const char*)(array.data() + array.size()));
+			}
+
+			CookedWriter info;
+			info.putString(mesh->getName());
+			info.putVector(subsets);
+
+			file.addSection(CookedSectionMeshInfo, index, 0, std::move(info.buffer()));
+			file.addArray(CookedSectionVertices, index, 0, mesh->getVertexArray());
+			file.addArray(CookedSectionNormals, index, 0, mesh->getNormalArray());
+			file.addArray(CookedSectionColors, index, 0, mesh->getColorArray());
+			file.addArray(CookedSectionTangents, index, 0, mesh->getTangentArray());
+
+			for (std::uint8_t slot = 0; slot < TEXTURE_ARRAY_COUNT; slot++)
+				file.addArray(CookedSectionTexcoords, index, slot, mesh->getTexcoordArray(slot));
+
+			file.addArray(CookedSectionWeights, index, 0, mesh->getWeightArray());
+			file.addArray(CookedSectionBindposes, index, 0, mesh->getBindposes());
+			if (!indices.empty())
+				file.addSection(CookedSectionIndices, index, 0, std::move(indices));
+		}
+
+		CookedWriter bones, iks, morphs, rigidbodies, joints, softbodies, materials;
+		writeBones(bones, model);
+		writeIKs(iks, model);
+		writeMorphs(morphs, model);
+		writeRigidbodies(rigidbodies, model);
+		writeJoints(joints, model);
+		writeSoftbodies(softbodies, model);
+		writeMaterials(materials, model, rootPath);
+
+		file.addSection(CookedSectionBones, 0, 0, std::move(bones.buffer()));
+		file.addSection(CookedSectionIKs, 0, 0, std::move(iks.buffer()));
+		file.addSection(CookedSectionMorphs, 0, 0, std::move(morphs.buffer()));
+		file.addSection(CookedSectionRigidbodies, 0, 0, std::move(rigidbodies.buffer()));
+		file.addSection(CookedSectionJoints, 0, 0, std::move(joints.buffer()));
+		file.addSection(CookedSectionSoftbodies, 0, 0, std::move(softbodies.buffer()));
+		file.addSection(CookedSectionMaterials, 0, 0, std::move(materials.buffer()));
+
+		return file.write(std::string(filepath), hash);
+	}
+}
@@ -1,5 +1,6 @@
 #include <octoon/physics_feature.h>
 #include <octoon/physics/physics_system.h>
+#include <octoon/timer_feature.h>
 
 namespace octoon
 {
@@ -10,7 +11,11 @@ namespace octoon
 		, physicsScene(nullptr)
 		, gravity_(0.0f, -9.8f, 0.0f)
 		, enableSimulate_(true)
+		, enableAsyncSimulate_(false)
+		, enableInterpolation_(false)
 		, forceSimulate_(false)
+		, simulating_(false)
+		, simulateCount_(0)
 		, maxSubSteps_(10)
 	{
 	}
@@ -31,9 +36,55 @@ namespace octoon
 		return this->enableSimulate_;
 	}
 
+	void
+	PhysicsFeature::setEnableAsyncSimulate(bool enable) noexcept
+	{
+		if (!enable)
+			this->fetchResults();
+
+		this->enableAsyncSimulate_ = enable;
+	}
+
+	bool
+	PhysicsFeature::getEnableAsyncSimulate() const noexcept
+	{
+		return this->enableAsyncSimulate_;
+	}
+
+	void
+	PhysicsFeature::setEnableInterpolation(bool enable) noexcept
+	{
+		this->enableInterpolation_ = enable;
+	}
+
+	bool
+	PhysicsFeature::getEnableInterpolation() const noexcept
+	{
+		return this->enableInterpolation_;
+	}
+
+	float
+	PhysicsFeature::getInterpolationFactor() const noexcept
+	{
+#if defined(OCTOON_FEATURE_TIMER_ENABLE)
+		auto timer = this->getFeature<TimerFeature>();
+		if (timer)
+			return timer->fixedAlpha();
+#endif
+		return 1.0f;
+	}
+
+	std::uint64_t
+	PhysicsFeature::getSimulateCount() const noexcept
+	{
+		return this->simulateCount_;
+	}
+
 	void
 	PhysicsFeature::setGravity(const math::float3& gravity) noexcept
 	{
+		this->waitSimulate();
+
 		if (physicsScene)
 			physicsScene->setGravity(gravity);
 		gravity_ = gravity;
@@ -51,10 +102,53 @@ namespace octoon
 		this->forceSimulate_ = true;
 	}
 
+	void
+	PhysicsFeature::fetchResults() noexcept
+	{
+		if (simulating_)
+		{
+			simulating_ = false;
+			simulateCount_++;
+
+			physicsScene->endSimulate();
+			this->applyPendingPoses();
+
+			physicsScene->fetchResults();
+		}
+	}
+
+	void
+	PhysicsFeature::waitSimulate() noexcept
+	{
+		if (simulating_)
+		{
+			physicsScene->endSimulate();
+			this->applyPendingPoses();
+		}
+	}
+
+	void
+	PhysicsFeature::setKinematicPose(const std::shared_ptr<PhysicsRigidbody>& rigidbody, const math::float3& position, const math::Quaternion& rotation) noexcept
+	{
+		if (simulating_)
+			pendingPoses_[rigidbody.get()] = PendingPose{ rigidbody, position, rotation };
+		else
+			rigidbody->setPositionAndRotation(position, rotation);
+	}
+
+	void
+	PhysicsFeature::applyPendingPoses() noexcept
+	{
+		for (auto& it : pendingPoses_)
+			it.second.rigidbody->setPositionAndRotation(it.second.position, it.second.rotation);
+
+		pendingPoses_.clear();
+	}
+
 	void
 	PhysicsFeature::onActivate() except
 	{
-		this->addMessageListener("feature:timer:fixed", std::bind(&PhysicsFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->addEventListener<&PhysicsFeature::onFixedUpdate>(TimerFeature::FixedUpdateEvent, this);
 
 		PhysicsSceneDesc physicsSceneDesc;
 		physicsSceneDesc.gravity = gravity_;
@@ -67,7 +161,9 @@ namespace octoon
 	void
 	PhysicsFeature::onDeactivate() noexcept
 	{
-		this->removeMessageListener("feature:timer:fixed", std::bind(&PhysicsFeature::onFixedUpdate, this, std::placeholders::_1));
+		this->removeEventListener<&PhysicsFeature::onFixedUpdate>(TimerFeature::FixedUpdateEvent, this);
+
+		this->fetchResults();
 
 		physicsScene.reset();
 		physicsContext.reset();
@@ -76,6 +172,7 @@ namespace octoon
 	void
 	PhysicsFeature::onReset() noexcept
 	{
+		this->fetchResults();
 	}
 
 	void
@@ -86,6 +183,7 @@ namespace octoon
 	void
 	PhysicsFeature::onFrame() except
 	{
+		this->fetchResults();
 	}
 
 	void
@@ -94,20 +192,28 @@ namespace octoon
 	}
 
 	void
-	PhysicsFeature::onFixedUpdate(const std::any& data) noexcept
+	PhysicsFeature::onFixedUpdate(float timeInterval) noexcept
 	{
-		if (data.type() == typeid(float))
+		if (timeInterval > 0.0f)
 		{
-			auto timeInterval = std::any_cast<float>(data);
-			if (timeInterval > 0.0f)
+			if (this->getEnableSimulate() || forceSimulate_)
 			{
-				if (this->getEnableSimulate() || forceSimulate_)
+				if (enableAsyncSimulate_)
 				{
+					this->fetchResults();
+
+					physicsScene->beginSimulate(timeInterval);
+					simulating_ = true;
+				}
+				else
+				{
+					simulateCount_++;
+
 					physicsScene->simulate(timeInterval);
 					physicsScene->fetchResults();
+				}
 
-					forceSimulate_ = false;
-				}				
+				forceSimulate_ = false;
 			}
 		}
 	}
@@ -115,12 +221,14 @@ namespace octoon
 	std::shared_ptr<PhysicsContext>
 	PhysicsFeature::getContext()
 	{
+		this->waitSimulate();
 		return physicsContext;
 	}
 
 	std::shared_ptr<PhysicsScene> 
 	PhysicsFeature::getScene()
 	{
+		this->waitSimulate();
 		return physicsScene;
 	}
 }
\ No newline at end of file
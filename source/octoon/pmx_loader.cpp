@@ -3,18 +3,227 @@
 #include <octoon/mesh/mesh.h>
 #include <octoon/material/mesh_standard_material.h>
 #include <octoon/model/model.h>
+#include <octoon/model_cache.h>
 #include <octoon/texture_loader.h>
-#include <octoon/io/fstream.h>
+#include <octoon/io/mmap_stream.h>
 #include <octoon/math/mathfwd.h>
 #include <octoon/math/mathutil.h>
 #include <octoon/runtime/string.h>
 
 #include <map>
+#include <algorithm>
 #include <cstring>
 #include <codecvt>
+#include <locale>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define OCTOON_PMX_SSE2
+#endif
 
 namespace octoon
 {
+	namespace
+	{
+		class PmxReader final
+		{
+		public:
+			PmxReader(const char* data, std::size_t size) noexcept
+				: ptr_(data)
+				, end_(data + size)
+			{
+			}
+
+			bool read(void* dst, std::size_t size) noexcept
+			{
+				if (std::size_t(end_ - ptr_) < size)
+					return false;
+				std::memcpy(dst, ptr_, size);
+				ptr_ += size;
+				return true;
+			}
+
+			template<typename T>
+			bool read(T& value) noexcept
+			{
+				return this->read(&value, sizeof(T));
+			}
+
+			bool skip(std::size_t size) noexcept
+			{
+				if (std::size_t(end_ - ptr_) < size)
+					return false;
+				ptr_ += size;
+				return true;
+			}
+
+			template<std::size_t N>
+			bool readText(PmxUInt32& length, PmxChar (&text)[N]) noexcept
+			{
+				if (!this->read(length))
+					return false;
+
+				std::size_t count = std::min<std::size_t>(length, sizeof(PmxChar) * (N - 1));
+				if (!this->read(text, count))
+					return false;
+				if (!this->skip(length - count))
+					return false;
+
+				length = static_cast<PmxUInt32>(count);
+				text[count / sizeof(PmxChar)] = 0;
+				return true;
+			}
+
+			bool readName(PmxName& name) noexcept
+			{
+				return this->readText(name.length, name.name);
+			}
+
+			template<typename T, typename U>
+			bool readAs(U& value) noexcept
+			{
+				T v;
+				if (!this->read(&v, sizeof(T)))
+					return false;
+				value = static_cast<U>(v);
+				return true;
+			}
+
+		private:
+			const char* ptr_;
+			const char* end_;
+		};
+
+		std::string toUtf8(std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t>& cv, const PmxChar* str) noexcept
+		{
+			try
+			{
+				return cv.to_bytes(str);
+			}
+			catch (...)
+			{
+				return std::string();
+			}
+		}
+
+		template<typename BoneIndex>
+		bool readVertices(PmxReader& reader, PMX& pmx) noexcept
+		{
+			const std::size_t size = sizeof(PmxVector3) * 2 + sizeof(PmxVector2) + sizeof(PmxVector4) * pmx.header.addUVCount;
+
+			for (auto& vertex : pmx.vertices)
+			{
+				auto& weight = vertex.weight;
+
+				if (!reader.read(&vertex.position, size)) return false;
+				if (!reader.read(vertex.type)) return false;
+
+				switch (vertex.type)
+				{
+				case PMX_BDEF1:
+				{
+					if (!reader.readAs<BoneIndex>(weight.bone1)) return false;
+					weight.weight1 = 1.0f;
+				}
+				break;
+				case PMX_BDEF2:
+				{
+					BoneIndex bones[2];
+					if (!reader.read(bones)) return false;
+					if (!reader.read(weight.weight1)) return false;
+					weight.bone1 = static_cast<PmxUInt16>(bones[0]);
+					weight.bone2 = static_cast<PmxUInt16>(bones[1]);
+					weight.weight2 = 1.0f - weight.weight1;
+				}
+				break;
+				case PMX_BDEF4:
+				case PMX_QDEF:
+				{
+					BoneIndex bones[4];
+					if (!reader.read(bones)) return false;
+					if (!reader.read(&weight.weight1, sizeof(PmxFloat) * 4)) return false;
+					weight.bone1 = static_cast<PmxUInt16>(bones[0]);
+					weight.bone2 = static_cast<PmxUInt16>(bones[1]);
+					weight.bone3 = static_cast<PmxUInt16>(bones[2]);
+					weight.bone4 = static_cast<PmxUInt16>(bones[3]);
+				}
+				break;
+				case PMX_SDEF:
+				{
+					BoneIndex bones[2];
+					if (!reader.read(bones)) return false;
+					if (!reader.read(weight.weight1)) return false;
+					if (!reader.read(&weight.SDEF_C, sizeof(PmxVector3) * 3)) return false;
+					weight.bone1 = static_cast<PmxUInt16>(bones[0]);
+					weight.bone2 = static_cast<PmxUInt16>(bones[1]);
+					weight.weight2 = 1.0f - weight.weight1;
+				}
+				break;
+				default:
+					return false;
+				}
+
+				if (!reader.read(vertex.edge)) return false;
+			}
+
+			return true;
+		}
+
+		void widenIndices(const std::uint8_t* src, std::size_t sizeOfIndices, std::uint32_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+
+			switch (sizeOfIndices)
+			{
+			case 1:
+			{
+#if defined(OCTOON_PMX_SSE2)
+				const __m128i zero = _mm_setzero_si128();
+				for (; i + 16 <= count; i += 16)
+				{
+					__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+					__m128i lo = _mm_unpacklo_epi8(v, zero);
+					__m128i hi = _mm_unpackhi_epi8(v, zero);
+					_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi16(lo, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+				}
+#endif
+				for (; i < count; i++)
+					dst[i] = src[i];
+			}
+			break;
+			case 2:
+			{
+				const std::uint8_t* src16 = src;
+#if defined(OCTOON_PMX_SSE2)
+				const __m128i zero = _mm_setzero_si128();
+				for (; i + 8 <= count; i += 8)
+				{
+					__m128i v = _mm_loadu_si128((const __m128i*)(src16 + i * 2));
+					_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi16(v, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(v, zero));
+				}
+#endif
+				for (; i < count; i++)
+				{
+					std::uint16_t index;
+					std::memcpy(&index, src16 + i * 2, sizeof(index));
+					dst[i] = index;
+				}
+			}
+			break;
+			case 4:
+				std::memcpy(dst, src, count * sizeof(std::uint32_t));
+				break;
+			default:
+				std::memset(dst, 0, count * sizeof(std::uint32_t));
+				break;
+			}
+		}
+	}
+
 	bool PmxLoader::doCanRead(io::istream& stream) const noexcept
 	{
 		PmxHeader header;
@@ -43,134 +252,87 @@ namespace octoon
 
 	bool PmxLoader::doLoad(std::string_view filepath, PMX& pmx) noexcept
 	{
-		io::ifstream stream;
+		io::immapstream stream;
 		if (!stream.open(std::string(filepath))) return false;
 
-		if (!stream.read((char*)&pmx.header, sizeof(pmx.header))) return false;
-		if (!stream.read((char*)&pmx.description.japanModelLength, sizeof(pmx.description.japanModelLength))) return false;
+		return this->doLoad(stream.data(), stream.size(), pmx);
+	}
+
+	bool PmxLoader::doLoad(const char* data, std::size_t size, PMX& pmx) noexcept
+	{
+		if (!data) return false;
+
+		PmxReader reader(data, size);
+
+		if (!reader.read((char*)&pmx.header, sizeof(pmx.header))) return false;
+		if (pmx.header.addUVCount > 4) return false;
+		if (!reader.read((char*)&pmx.description.japanModelLength, sizeof(pmx.description.japanModelLength))) return false;
 
 		if (pmx.description.japanModelLength > 0)
 		{
 			pmx.description.japanModelName.resize(pmx.description.japanModelLength);
 
-			if (!stream.read((char*)&pmx.description.japanModelName[0], pmx.description.japanModelLength)) return false;
+			if (!reader.read((char*)&pmx.description.japanModelName[0], pmx.description.japanModelLength)) return false;
 		}
 
-		if (!stream.read((char*)&pmx.description.englishModelLength, sizeof(pmx.description.englishModelLength))) return false;
+		if (!reader.read((char*)&pmx.description.englishModelLength, sizeof(pmx.description.englishModelLength))) return false;
 
 		if (pmx.description.englishModelLength > 0)
 		{
 			pmx.description.englishModelName.resize(pmx.description.englishModelLength);
 
-			if (!stream.read((char*)&pmx.description.englishModelName[0], pmx.description.englishModelLength)) return false;
+			if (!reader.read((char*)&pmx.description.englishModelName[0], pmx.description.englishModelLength)) return false;
 		}
 
-		if (!stream.read((char*)&pmx.description.japanCommentLength, sizeof(pmx.description.japanCommentLength))) return false;
+		if (!reader.read((char*)&pmx.description.japanCommentLength, sizeof(pmx.description.japanCommentLength))) return false;
 
 		if (pmx.description.japanCommentLength > 0)
 		{
 			pmx.description.japanCommentName.resize(pmx.description.japanCommentLength);
 
-			if (!stream.read((char*)&pmx.description.japanCommentName[0], pmx.description.japanCommentLength)) return false;
+			if (!reader.read((char*)&pmx.description.japanCommentName[0], pmx.description.japanCommentLength)) return false;
 		}
 
-		if (!stream.read((char*)&pmx.description.englishCommentLength, sizeof(pmx.description.englishCommentLength))) return false;
+		if (!reader.read((char*)&pmx.description.englishCommentLength, sizeof(pmx.description.englishCommentLength))) return false;
 
 		if (pmx.description.englishCommentLength > 0)
 		{
 			pmx.description.englishCommentName.resize(pmx.description.englishCommentLength);
 
-			if (!stream.read((char*)&pmx.description.englishCommentName[0], pmx.description.englishCommentLength)) return false;
+			if (!reader.read((char*)&pmx.description.englishCommentName[0], pmx.description.englishCommentLength)) return false;
 		}
 
-		if (!stream.read((char*)&pmx.numVertices, sizeof(pmx.numVertices))) return false;
+		if (!reader.read((char*)&pmx.numVertices, sizeof(pmx.numVertices))) return false;
 
 		if (pmx.numVertices > 0)
 		{
 			pmx.vertices.resize(pmx.numVertices);
 
-			for (auto& vertex : pmx.vertices)
+			switch (pmx.header.sizeOfBone)
 			{
-				if (pmx.header.addUVCount == 0)
-				{
-					std::streamsize size = sizeof(vertex.position) + sizeof(vertex.normal) + sizeof(vertex.coord);
-					if (!stream.read((char*)&vertex.position, size)) return false;
-				}
-				else
-				{
-					std::streamsize size = sizeof(vertex.position) + sizeof(vertex.normal) + sizeof(vertex.coord) + sizeof(vertex.addCoord[0]) * pmx.header.addUVCount;
-					if (!stream.read((char*)&vertex.position, size)) return false;
-				}
-
-				if (!stream.read((char*)&vertex.type, sizeof(vertex.type))) return false;
-				switch (vertex.type)
-				{
-					case PMX_BDEF1:
-					{
-						if (!stream.read((char*)&vertex.weight.bone1, pmx.header.sizeOfBone)) return false;
-						vertex.weight.weight1 = 1.0f;
-					}
-					break;
-					case PMX_BDEF2:
-					{
-						if (!stream.read((char*)&vertex.weight.bone1, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.bone2, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.weight1, sizeof(vertex.weight.weight2))) return false;
-						vertex.weight.weight2 = 1.0f - vertex.weight.weight1;
-					}
-					break;
-					case PMX_BDEF4:
-					{
-						if (!stream.read((char*)&vertex.weight.bone1, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.bone2, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.bone3, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.bone4, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.weight1, sizeof(vertex.weight.weight1))) return false;
-						if (!stream.read((char*)&vertex.weight.weight2, sizeof(vertex.weight.weight2))) return false;
-						if (!stream.read((char*)&vertex.weight.weight3, sizeof(vertex.weight.weight3))) return false;
-						if (!stream.read((char*)&vertex.weight.weight4, sizeof(vertex.weight.weight4))) return false;
-					}
-					break;
-					case PMX_SDEF:
-					{
-						if (!stream.read((char*)&vertex.weight.bone1, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.bone2, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&vertex.weight.weight1, sizeof(vertex.weight.weight1))) return false;
-						if (!stream.read((char*)&vertex.weight.SDEF_C, sizeof(vertex.weight.SDEF_C))) return false;
-						if (!stream.read((char*)&vertex.weight.SDEF_R0, sizeof(vertex.weight.SDEF_R0))) return false;
-						if (!stream.read((char*)&vertex.weight.SDEF_R1, sizeof(vertex.weight.SDEF_R1))) return false;
-
-						vertex.weight.weight2 = 1.0f - vertex.weight.weight1;
-					}
-					break;
-					case PMX_QDEF:
-					{
-						if (!stream.read((char*)& vertex.weight.bone1, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)& vertex.weight.bone2, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)& vertex.weight.bone3, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)& vertex.weight.bone4, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)& vertex.weight.weight1, sizeof(vertex.weight.weight1))) return false;
-						if (!stream.read((char*)& vertex.weight.weight2, sizeof(vertex.weight.weight2))) return false;
-						if (!stream.read((char*)& vertex.weight.weight3, sizeof(vertex.weight.weight3))) return false;
-						if (!stream.read((char*)& vertex.weight.weight4, sizeof(vertex.weight.weight4))) return false;
-					}
-					default:
-						return false;
-				}
-
-				if (!stream.read((char*)&vertex.edge, sizeof(vertex.edge))) return false;
+			case 1:
+				if (!readVertices<PmxUInt8>(reader, pmx)) return false;
+				break;
+			case 2:
+				if (!readVertices<PmxUInt16>(reader, pmx)) return false;
+				break;
+			case 4:
+				if (!readVertices<PmxUInt32>(reader, pmx)) return false;
+				break;
+			default:
+				return false;
 			}
 		}
 
-		if (!stream.read((char*)&pmx.numIndices, sizeof(pmx.numIndices))) return false;
+		if (!reader.read((char*)&pmx.numIndices, sizeof(pmx.numIndices))) return false;
 
 		if (pmx.numIndices > 0)
 		{
 			pmx.indices.resize(pmx.numIndices * pmx.header.sizeOfIndices);
-			if (!stream.read((char*)pmx.indices.data(), pmx.indices.size())) return false;
+			if (!reader.read((char*)pmx.indices.data(), pmx.indices.size())) return false;
 		}
 
-		if (!stream.read((char*)&pmx.numTextures, sizeof(pmx.numTextures))) return false;
+		if (!reader.read((char*)&pmx.numTextures, sizeof(pmx.numTextures))) return false;
 
 		if (pmx.numTextures > 0)
 		{
@@ -178,12 +340,11 @@ namespace octoon
 
 			for (auto& texture : pmx.textures)
 			{
-				if (!stream.read((char*)&texture.length, sizeof(texture.length))) return false;
-				if (!stream.read((char*)&texture.name, texture.length)) return false;
+				if (!reader.readName(texture)) return false;
 			}
 		}
 
-		if (!stream.read((char*)&pmx.numMaterials, sizeof(pmx.numMaterials))) return false;
+		if (!reader.read((char*)&pmx.numMaterials, sizeof(pmx.numMaterials))) return false;
 
 		if (pmx.numMaterials > 0)
 		{
@@ -191,43 +352,37 @@ namespace octoon
 
 			for (auto& material : pmx.materials)
 			{
-				if (!stream.read((char*)&material.name.length, sizeof(material.name.length))) return false;
-				if (!stream.read((char*)&material.name.name, material.name.length)) return false;
-				if (!stream.read((char*)&material.nameEng.length, sizeof(material.nameEng.length))) return false;
-				if (!stream.read((char*)&material.nameEng.name, material.nameEng.length)) return false;
-				if (!stream.read((char*)&material.Diffuse, sizeof(material.Diffuse))) return false;
-				if (!stream.read((char*)&material.Opacity, sizeof(material.Opacity))) return false;
-				if (!stream.read((char*)&material.Specular, sizeof(material.Specular))) return false;
-				if (!stream.read((char*)&material.Shininess, sizeof(material.Shininess))) return false;
-				if (!stream.read((char*)&material.Ambient, sizeof(material.Ambient))) return false;
-				if (!stream.read((char*)&material.Flag, sizeof(material.Flag))) return false;
-				if (!stream.read((char*)&material.EdgeColor, sizeof(material.EdgeColor))) return false;
-				if (!stream.read((char*)&material.EdgeSize, sizeof(material.EdgeSize))) return false;
-				if (!stream.read((char*)&material.TextureIndex, pmx.header.sizeOfTexture)) return false;
-				if (!stream.read((char*)&material.SphereTextureIndex, pmx.header.sizeOfTexture)) return false;
-				if (!stream.read((char*)&material.SphereMode, sizeof(material.SphereMode))) return false;
-				if (!stream.read((char*)&material.ToonIndex, sizeof(material.ToonIndex))) return false;
+				if (!reader.readName(material.name)) return false;
+				if (!reader.readName(material.nameEng)) return false;
+				if (!reader.read((char*)&material.Diffuse, sizeof(material.Diffuse))) return false;
+				if (!reader.read((char*)&material.Opacity, sizeof(material.Opacity))) return false;
+				if (!reader.read((char*)&material.Specular, sizeof(material.Specular))) return false;
+				if (!reader.read((char*)&material.Shininess, sizeof(material.Shininess))) return false;
+				if (!reader.read((char*)&material.Ambient, sizeof(material.Ambient))) return false;
+				if (!reader.read((char*)&material.Flag, sizeof(material.Flag))) return false;
+				if (!reader.read((char*)&material.EdgeColor, sizeof(material.EdgeColor))) return false;
+				if (!reader.read((char*)&material.EdgeSize, sizeof(material.EdgeSize))) return false;
+				if (!reader.read((char*)&material.TextureIndex, pmx.header.sizeOfTexture)) return false;
+				if (!reader.read((char*)&material.SphereTextureIndex, pmx.header.sizeOfTexture)) return false;
+				if (!reader.read((char*)&material.SphereMode, sizeof(material.SphereMode))) return false;
+				if (!reader.read((char*)&material.ToonIndex, sizeof(material.ToonIndex))) return false;
 
 				if (material.ToonIndex == 1)
 				{
-					if (!stream.read((char*)&material.ToonTexture, 1)) return false;
+					if (!reader.read((char*)&material.ToonTexture, 1)) return false;
 				}
 				else
 				{
-					if (!stream.read((char*)&material.ToonTexture, pmx.header.sizeOfTexture)) return false;
+					if (!reader.read((char*)&material.ToonTexture, pmx.header.sizeOfTexture)) return false;
 				}
 
-				if (!stream.read((char*)&material.memLength, sizeof(material.memLength))) return false;
-				if (material.memLength > 0)
-				{
-					if (!stream.read((char*)&material.mem, material.memLength)) return false;
-				}
+				if (!reader.readText(material.memLength, material.mem)) return false;
 
-				if (!stream.read((char*)&material.FaceCount, sizeof(material.FaceCount))) return false;
+				if (!reader.read((char*)&material.FaceCount, sizeof(material.FaceCount))) return false;
 			}
 		}
 
-		if (!stream.read((char*)&pmx.numBones, sizeof(pmx.numBones))) return false;
+		if (!reader.read((char*)&pmx.numBones, sizeof(pmx.numBones))) return false;
 
 		if (pmx.numBones > 0)
 		{
@@ -235,15 +390,13 @@ namespace octoon
 
 			for (auto& bone : pmx.bones)
 			{
-				if (!stream.read((char*)&bone.name.length, sizeof(bone.name.length))) return false;
-				if (!stream.read((char*)&bone.name.name, bone.name.length)) return false;
-				if (!stream.read((char*)&bone.nameEng.length, sizeof(bone.nameEng.length))) return false;
-				if (!stream.read((char*)&bone.nameEng.name, bone.nameEng.length)) return false;
+				if (!reader.readName(bone.name)) return false;
+				if (!reader.readName(bone.nameEng)) return false;
 
-				if (!stream.read((char*)&bone.position, sizeof(bone.position))) return false;
-				if (!stream.read((char*)&bone.Parent, pmx.header.sizeOfBone)) return false;
-				if (!stream.read((char*)&bone.Level, sizeof(bone.Level))) return false;
-				if (!stream.read((char*)&bone.Flag, sizeof(bone.Flag))) return false;
+				if (!reader.read((char*)&bone.position, sizeof(bone.position))) return false;
+				if (!reader.read((char*)&bone.Parent, pmx.header.sizeOfBone)) return false;
+				if (!reader.read((char*)&bone.Level, sizeof(bone.Level))) return false;
+				if (!reader.read((char*)&bone.Flag, sizeof(bone.Flag))) return false;
 
 				if (bone.Flag & PMX_BONE_DISPLAY)
 					bone.Visable = true;
@@ -252,17 +405,17 @@ namespace octoon
 
 				if (bone.Flag & PMX_BONE_INDEX)
 				{
-					if (!stream.read((char*)&bone.ConnectedBoneIndex, pmx.header.sizeOfBone)) return false;
+					if (!reader.read((char*)&bone.ConnectedBoneIndex, pmx.header.sizeOfBone)) return false;
 				}
 				else
 				{
-					if (!stream.read((char*)&bone.Offset, sizeof(bone.Offset))) return false;
+					if (!reader.read((char*)&bone.Offset, sizeof(bone.Offset))) return false;
 				}
 
 				if ((bone.Flag & (PMX_BONE_ADD_ROTATION | PMX_BONE_ADD_MOVE)) != 0)
 				{
-					if (!stream.read((char*)&bone.ProvidedParentBoneIndex, pmx.header.sizeOfBone)) return false;
-					if (!stream.read((char*)&bone.ProvidedRatio, sizeof(bone.ProvidedRatio))) return false;
+					if (!reader.read((char*)&bone.ProvidedParentBoneIndex, pmx.header.sizeOfBone)) return false;
+					if (!reader.read((char*)&bone.ProvidedRatio, sizeof(bone.ProvidedRatio))) return false;
 				}
 				else
 				{
@@ -272,26 +425,26 @@ namespace octoon
 
 				if (bone.Flag & PMX_BONE_FIXED_AXIS)
 				{
-					if (!stream.read((char*)&bone.AxisDirection, sizeof(bone.AxisDirection))) return false;
+					if (!reader.read((char*)&bone.AxisDirection, sizeof(bone.AxisDirection))) return false;
 				}
 
 				if (bone.Flag & PMX_BONE_LOCAL_AXIS)
 				{
-					if (!stream.read((char*)&bone.DimentionXDirection, sizeof(bone.DimentionXDirection))) return false;
-					if (!stream.read((char*)&bone.DimentionZDirection, sizeof(bone.DimentionZDirection))) return false;
+					if (!reader.read((char*)&bone.DimentionXDirection, sizeof(bone.DimentionXDirection))) return false;
+					if (!reader.read((char*)&bone.DimentionZDirection, sizeof(bone.DimentionZDirection))) return false;
 				}
 
 				if (bone.Flag & PMX_BONE_EXTERNAL_PARENT_TRANSFORM)
 				{
-					if (!stream.read((char*)& bone.ExternalParent, sizeof(bone.ExternalParent))) return false;
+					if (!reader.read((char*)& bone.ExternalParent, sizeof(bone.ExternalParent))) return false;
 				}
 
 				if (bone.Flag & PMX_BONE_IK)
 				{
-					if (!stream.read((char*)&bone.IKTargetBoneIndex, pmx.header.sizeOfBone)) return false;
-					if (!stream.read((char*)&bone.IKLoopCount, sizeof(bone.IKLoopCount))) return false;
-					if (!stream.read((char*)&bone.IKLimitedRadian, sizeof(bone.IKLimitedRadian))) return false;
-					if (!stream.read((char*)&bone.IKLinkCount, sizeof(bone.IKLinkCount))) return false;
+					if (!reader.read((char*)&bone.IKTargetBoneIndex, pmx.header.sizeOfBone)) return false;
+					if (!reader.read((char*)&bone.IKLoopCount, sizeof(bone.IKLoopCount))) return false;
+					if (!reader.read((char*)&bone.IKLimitedRadian, sizeof(bone.IKLimitedRadian))) return false;
+					if (!reader.read((char*)&bone.IKLinkCount, sizeof(bone.IKLinkCount))) return false;
 
 					if (bone.IKLinkCount > 0)
 					{
@@ -299,12 +452,12 @@ namespace octoon
 
 						for (auto& chain : bone.IKList)
 						{
-							if (!stream.read((char*)&chain.BoneIndex, pmx.header.sizeOfBone)) return false;
-							if (!stream.read((char*)&chain.rotateLimited, (std::streamsize)sizeof(chain.rotateLimited))) return false;
+							if (!reader.read((char*)&chain.BoneIndex, pmx.header.sizeOfBone)) return false;
+							if (!reader.read((char*)&chain.rotateLimited, (std::streamsize)sizeof(chain.rotateLimited))) return false;
 							if (chain.rotateLimited)
 							{
-								if (!stream.read((char*)&chain.minimumRadian, (std::streamsize)sizeof(chain.minimumRadian))) return false;
-								if (!stream.read((char*)&chain.maximumRadian, (std::streamsize)sizeof(chain.maximumRadian))) return false;
+								if (!reader.read((char*)&chain.minimumRadian, (std::streamsize)sizeof(chain.minimumRadian))) return false;
+								if (!reader.read((char*)&chain.maximumRadian, (std::streamsize)sizeof(chain.maximumRadian))) return false;
 							}
 						}
 					}
@@ -312,7 +465,7 @@ namespace octoon
 			}
 		}
 
-		if (!stream.read((char*)&pmx.numMorphs, sizeof(pmx.numMorphs))) return false;
+		if (!reader.read((char*)&pmx.numMorphs, sizeof(pmx.numMorphs))) return false;
 
 		if (pmx.numMorphs > 0)
 		{
@@ -320,13 +473,11 @@ namespace octoon
 
 			for (auto& morph : pmx.morphs)
 			{
-				if (!stream.read((char*)&morph.name.length, sizeof(morph.name.length))) return false;
-				if (!stream.read((char*)&morph.name.name, morph.name.length)) return false;
-				if (!stream.read((char*)&morph.nameEng.length, sizeof(morph.nameEng.length))) return false;
-				if (!stream.read((char*)&morph.nameEng.name, morph.nameEng.length)) return false;
-				if (!stream.read((char*)&morph.control, sizeof(morph.control))) return false;
-				if (!stream.read((char*)&morph.morphType, sizeof(morph.morphType))) return false;
-				if (!stream.read((char*)&morph.morphCount, sizeof(morph.morphCount))) return false;
+				if (!reader.readName(morph.name)) return false;
+				if (!reader.readName(morph.nameEng)) return false;
+				if (!reader.read((char*)&morph.control, sizeof(morph.control))) return false;
+				if (!reader.read((char*)&morph.morphType, sizeof(morph.morphType))) return false;
+				if (!reader.read((char*)&morph.morphCount, sizeof(morph.morphCount))) return false;
 
 				if (morph.morphType == PmxMorphType::PMX_MorphTypeGroup)
 				{
@@ -334,8 +485,8 @@ namespace octoon
 
 					for (auto& group : morph.groupList)
 					{
-						if (!stream.read((char*)& group.morphIndex, pmx.header.sizeOfMorph)) return false;
-						if (!stream.read((char*)& group.morphRate, sizeof(group.morphRate))) return false;
+						if (!reader.read((char*)& group.morphIndex, pmx.header.sizeOfMorph)) return false;
+						if (!reader.read((char*)& group.morphRate, sizeof(group.morphRate))) return false;
 					}
 				}
 				else if (morph.morphType == PmxMorphType::PMX_MorphTypeVertex)
@@ -344,8 +495,8 @@ namespace octoon
 
 					for (auto& vertex : morph.vertices)
 					{
-						if (!stream.read((char*)&vertex.index, pmx.header.sizeOfIndices)) return false;
-						if (!stream.read((char*)&vertex.offset, sizeof(vertex.offset))) return false;
+						if (!reader.read((char*)&vertex.index, pmx.header.sizeOfIndices)) return false;
+						if (!reader.read((char*)&vertex.offset, sizeof(vertex.offset))) return false;
 					}
 				}
 				else if (morph.morphType == PmxMorphType::PMX_MorphTypeBone)
@@ -354,9 +505,9 @@ namespace octoon
 
 					for (auto& bone : morph.boneList)
 					{
-						if (!stream.read((char*)&bone.boneIndex, pmx.header.sizeOfBone)) return false;
-						if (!stream.read((char*)&bone.position, sizeof(bone.position))) return false;
-						if (!stream.read((char*)&bone.rotation, sizeof(bone.rotation))) return false;
+						if (!reader.read((char*)&bone.boneIndex, pmx.header.sizeOfBone)) return false;
+						if (!reader.read((char*)&bone.position, sizeof(bone.position))) return false;
+						if (!reader.read((char*)&bone.rotation, sizeof(bone.rotation))) return false;
 					}
 				}
 				else if (morph.morphType == PmxMorphType::PMX_MorphTypeUV || morph.morphType == PmxMorphType::PMX_MorphTypeExtraUV1 ||
@@ -367,8 +518,8 @@ namespace octoon
 
 					for (auto& texcoord : morph.texcoordList)
 					{
-						if (!stream.read((char*)&texcoord.index, pmx.header.sizeOfIndices)) return false;
-						if (!stream.read((char*)&texcoord.offset, sizeof(texcoord.offset))) return false;
+						if (!reader.read((char*)&texcoord.index, pmx.header.sizeOfIndices)) return false;
+						if (!reader.read((char*)&texcoord.offset, sizeof(texcoord.offset))) return false;
 					}
 				}
 				else if (morph.morphType == PmxMorphType::PMX_MorphTypeMaterial)
@@ -377,23 +528,23 @@ namespace octoon
 
 					for (auto& material : morph.materialList)
 					{
-						if (!stream.read((char*)&material.index, pmx.header.sizeOfMaterial)) return false;
-						if (!stream.read((char*)&material.offset, sizeof(material.offset))) return false;
-						if (!stream.read((char*)&material.diffuse, sizeof(material.diffuse))) return false;
-						if (!stream.read((char*)&material.specular, sizeof(material.specular))) return false;
-						if (!stream.read((char*)&material.shininess, sizeof(material.shininess))) return false;
-						if (!stream.read((char*)&material.ambient, sizeof(material.ambient))) return false;
-						if (!stream.read((char*)&material.edgeColor, sizeof(material.edgeColor))) return false;
-						if (!stream.read((char*)&material.edgeSize, sizeof(material.edgeSize))) return false;
-						if (!stream.read((char*)&material.tex, sizeof(material.tex))) return false;
-						if (!stream.read((char*)&material.sphere, sizeof(material.sphere))) return false;
-						if (!stream.read((char*)&material.toon, sizeof(material.toon))) return false;
+						if (!reader.read((char*)&material.index, pmx.header.sizeOfMaterial)) return false;
+						if (!reader.read((char*)&material.offset, sizeof(material.offset))) return false;
+						if (!reader.read((char*)&material.diffuse, sizeof(material.diffuse))) return false;
+						if (!reader.read((char*)&material.specular, sizeof(material.specular))) return false;
+						if (!reader.read((char*)&material.shininess, sizeof(material.shininess))) return false;
+						if (!reader.read((char*)&material.ambient, sizeof(material.ambient))) return false;
+						if (!reader.read((char*)&material.edgeColor, sizeof(material.edgeColor))) return false;
+						if (!reader.read((char*)&material.edgeSize, sizeof(material.edgeSize))) return false;
+						if (!reader.read((char*)&material.tex, sizeof(material.tex))) return false;
+						if (!reader.read((char*)&material.sphere, sizeof(material.sphere))) return false;
+						if (!reader.read((char*)&material.toon, sizeof(material.toon))) return false;
 					}
 				}
 			}
 		}
 
-		if (!stream.read((char*)&pmx.numDisplayFrames, sizeof(pmx.numDisplayFrames))) return false;
+		if (!reader.read((char*)&pmx.numDisplayFrames, sizeof(pmx.numDisplayFrames))) return false;
 
 		if (pmx.numDisplayFrames > 0)
 		{
@@ -401,33 +552,31 @@ namespace octoon
 
 			for (auto& displayFrame : pmx.displayFrames)
 			{
-				if (!stream.read((char*)&displayFrame.name.length, sizeof(displayFrame.name.length))) return false;
-				if (!stream.read((char*)&displayFrame.name.name, displayFrame.name.length)) return false;
-				if (!stream.read((char*)&displayFrame.nameEng.length, sizeof(displayFrame.nameEng.length))) return false;
-				if (!stream.read((char*)&displayFrame.nameEng.name, displayFrame.nameEng.length)) return false;
-				if (!stream.read((char*)&displayFrame.type, sizeof(displayFrame.type))) return false;
-				if (!stream.read((char*)&displayFrame.elementsWithinFrame, sizeof(displayFrame.elementsWithinFrame))) return false;
+				if (!reader.readName(displayFrame.name)) return false;
+				if (!reader.readName(displayFrame.nameEng)) return false;
+				if (!reader.read((char*)&displayFrame.type, sizeof(displayFrame.type))) return false;
+				if (!reader.read((char*)&displayFrame.elementsWithinFrame, sizeof(displayFrame.elementsWithinFrame))) return false;
 
 				displayFrame.elements.resize(displayFrame.elementsWithinFrame);
 				for (auto& element : displayFrame.elements)
 				{
-					if (!stream.read((char*)&element.target, sizeof(element.target))) return false;
+					if (!reader.read((char*)&element.target, sizeof(element.target))) return false;
 
 					if (element.target == 0)
 					{
-						if (!stream.read((char*)&element.index, pmx.header.sizeOfBone))
+						if (!reader.read((char*)&element.index, pmx.header.sizeOfBone))
 							return false;
 					}
 					else if (element.target == 1)
 					{
-						if (!stream.read((char*)&element.index, pmx.header.sizeOfMorph))
+						if (!reader.read((char*)&element.index, pmx.header.sizeOfMorph))
 							return false;
 					}
 				}
 			}
 		}
 
-		if (!stream.read((char*)&pmx.numRigidbodys, sizeof(pmx.numRigidbodys))) return false;
+		if (!reader.read((char*)&pmx.numRigidbodys, sizeof(pmx.numRigidbodys))) return false;
 
 		if (pmx.numRigidbodys > 0)
 		{
@@ -435,31 +584,29 @@ namespace octoon
 
 			for (auto& rigidbody : pmx.rigidbodies)
 			{
-				if (!stream.read((char*)&rigidbody.name.length, sizeof(rigidbody.name.length))) return false;
-				if (!stream.read((char*)&rigidbody.name.name, rigidbody.name.length)) return false;
-				if (!stream.read((char*)&rigidbody.nameEng.length, sizeof(rigidbody.nameEng.length))) return false;
-				if (!stream.read((char*)&rigidbody.nameEng.name, rigidbody.nameEng.length)) return false;
-
-				if (!stream.read((char*)&rigidbody.bone, pmx.header.sizeOfBone)) return false;
-				if (!stream.read((char*)&rigidbody.group, sizeof(rigidbody.group))) return false;
-				if (!stream.read((char*)&rigidbody.groupMask, sizeof(rigidbody.groupMask))) return false;
-
-				if (!stream.read((char*)&rigidbody.shape, sizeof(rigidbody.shape))) return false;
-
-				if (!stream.read((char*)&rigidbody.scale, sizeof(rigidbody.scale))) return false;
-				if (!stream.read((char*)&rigidbody.position, sizeof(rigidbody.position))) return false;
-				if (!stream.read((char*)&rigidbody.rotate, sizeof(rigidbody.rotate))) return false;
-
-				if (!stream.read((char*)&rigidbody.mass, sizeof(rigidbody.mass))) return false;
-				if (!stream.read((char*)&rigidbody.movementDecay, sizeof(rigidbody.movementDecay))) return false;
-				if (!stream.read((char*)&rigidbody.rotationDecay, sizeof(rigidbody.rotationDecay))) return false;
-				if (!stream.read((char*)&rigidbody.elasticity, sizeof(rigidbody.elasticity))) return false;
-				if (!stream.read((char*)&rigidbody.friction, sizeof(rigidbody.friction))) return false;
-				if (!stream.read((char*)&rigidbody.physicsOperation, sizeof(rigidbody.physicsOperation))) return false;
+				if (!reader.readName(rigidbody.name)) return false;
+				if (!reader.readName(rigidbody.nameEng)) return false;
+
+				if (!reader.read((char*)&rigidbody.bone, pmx.header.sizeOfBone)) return false;
+				if (!reader.read((char*)&rigidbody.group, sizeof(rigidbody.group))) return false;
+				if (!reader.read((char*)&rigidbody.groupMask, sizeof(rigidbody.groupMask))) return false;
+
+				if (!reader.read((char*)&rigidbody.shape, sizeof(rigidbody.shape))) return false;
+
+				if (!reader.read((char*)&rigidbody.scale, sizeof(rigidbody.scale))) return false;
+				if (!reader.read((char*)&rigidbody.position, sizeof(rigidbody.position))) return false;
+				if (!reader.read((char*)&rigidbody.rotate, sizeof(rigidbody.rotate))) return false;
+
+				if (!reader.read((char*)&rigidbody.mass, sizeof(rigidbody.mass))) return false;
+				if (!reader.read((char*)&rigidbody.movementDecay, sizeof(rigidbody.movementDecay))) return false;
+				if (!reader.read((char*)&rigidbody.rotationDecay, sizeof(rigidbody.rotationDecay))) return false;
+				if (!reader.read((char*)&rigidbody.elasticity, sizeof(rigidbody.elasticity))) return false;
+				if (!reader.read((char*)&rigidbody.friction, sizeof(rigidbody.friction))) return false;
+				if (!reader.read((char*)&rigidbody.physicsOperation, sizeof(rigidbody.physicsOperation))) return false;
 			}
 		}
 
-		if (!stream.read((char*)&pmx.numJoints, sizeof(pmx.numJoints))) return false;
+		if (!reader.read((char*)&pmx.numJoints, sizeof(pmx.numJoints))) return false;
 
 		if (pmx.numJoints > 0)
 		{
@@ -467,33 +614,31 @@ namespace octoon
 
 			for (auto& joint : pmx.joints)
 			{
-				if (!stream.read((char*)&joint.name.length, sizeof(joint.name.length))) return false;
-				if (!stream.read((char*)&joint.name.name, joint.name.length)) return false;
-				if (!stream.read((char*)&joint.nameEng.length, sizeof(joint.nameEng.length))) return false;
-				if (!stream.read((char*)&joint.nameEng.name, joint.nameEng.length)) return false;
+				if (!reader.readName(joint.name)) return false;
+				if (!reader.readName(joint.nameEng)) return false;
 
-				if (!stream.read((char*)&joint.type, sizeof(joint.type))) return false;
+				if (!reader.read((char*)&joint.type, sizeof(joint.type))) return false;
 
-				if (!stream.read((char*)&joint.relatedRigidBodyIndexA, pmx.header.sizeOfBody)) return false;
-				if (!stream.read((char*)&joint.relatedRigidBodyIndexB, pmx.header.sizeOfBody)) return false;
+				if (!reader.read((char*)&joint.relatedRigidBodyIndexA, pmx.header.sizeOfBody)) return false;
+				if (!reader.read((char*)&joint.relatedRigidBodyIndexB, pmx.header.sizeOfBody)) return false;
 
-				if (!stream.read((char*)&joint.position, sizeof(joint.position))) return false;
-				if (!stream.read((char*)&joint.rotation, sizeof(joint.rotation))) return false;
+				if (!reader.read((char*)&joint.position, sizeof(joint.position))) return false;
+				if (!reader.read((char*)&joint.rotation, sizeof(joint.rotation))) return false;
 
-				if (!stream.read((char*)&joint.movementLowerLimit, sizeof(joint.movementLowerLimit))) return false;
-				if (!stream.read((char*)&joint.movementUpperLimit, sizeof(joint.movementUpperLimit))) return false;
+				if (!reader.read((char*)&joint.movementLowerLimit, sizeof(joint.movementLowerLimit))) return false;
+				if (!reader.read((char*)&joint.movementUpperLimit, sizeof(joint.movementUpperLimit))) return false;
 
-				if (!stream.read((char*)&joint.rotationLowerLimit, sizeof(joint.rotationLowerLimit))) return false;
-				if (!stream.read((char*)&joint.rotationUpperLimit, sizeof(joint.rotationUpperLimit))) return false;
+				if (!reader.read((char*)&joint.rotationLowerLimit, sizeof(joint.rotationLowerLimit))) return false;
+				if (!reader.read((char*)&joint.rotationUpperLimit, sizeof(joint.rotationUpperLimit))) return false;
 
-				if (!stream.read((char*)&joint.springMovementConstant, sizeof(joint.springMovementConstant))) return false;
-				if (!stream.read((char*)&joint.springRotationConstant, sizeof(joint.springRotationConstant))) return false;
+				if (!reader.read((char*)&joint.springMovementConstant, sizeof(joint.springMovementConstant))) return false;
+				if (!reader.read((char*)&joint.springRotationConstant, sizeof(joint.springRotationConstant))) return false;
 			}
 		}
 
 		if (pmx.header.version > 2.0)
 		{
-			if (!stream.read((char*)& pmx.numSoftbodies, sizeof(pmx.numSoftbodies))) return false;
+			if (!reader.read((char*)& pmx.numSoftbodies, sizeof(pmx.numSoftbodies))) return false;
 
 			if (pmx.numSoftbodies > 0)
 			{
@@ -501,75 +646,73 @@ namespace octoon
 
 				for (auto& body : pmx.softbodies)
 				{
-					if (!stream.read((char*)& body.name.length, sizeof(body.name.length))) return false;
-					if (!stream.read((char*)& body.name.name, body.name.length)) return false;
-					if (!stream.read((char*)& body.nameEng.length, sizeof(body.nameEng.length))) return false;
-					if (!stream.read((char*)& body.nameEng.name, body.nameEng.length)) return false;
-
-					if (!stream.read((char*)& body.type, sizeof(body.type))) return false;
-
-					if (!stream.read((char*)& body.materialIndex, pmx.header.sizeOfMaterial)) return false;
-
-					if (!stream.read((char*)& body.group, sizeof(body.group))) return false;
-					if (!stream.read((char*)& body.groupMask, sizeof(body.groupMask))) return false;
-
-					if (!stream.read((char*)& body.flag, sizeof(body.flag))) return false;
-
-					if (!stream.read((char*)& body.blinkLength, sizeof(body.blinkLength))) return false;
-					if (!stream.read((char*)& body.numClusters, sizeof(body.numClusters))) return false;
-
-					if (!stream.read((char*)& body.totalMass, sizeof(body.totalMass))) return false;
-					if (!stream.read((char*)& body.collisionMargin, sizeof(body.collisionMargin))) return false;
-
-					if (!stream.read((char*)& body.aeroModel, sizeof(body.aeroModel))) return false;
-
-					if (!stream.read((char*)& body.VCF, sizeof(body.VCF))) return false;
-					if (!stream.read((char*)& body.DP, sizeof(body.DP))) return false;
-					if (!stream.read((char*)& body.DG, sizeof(body.DG))) return false;
-					if (!stream.read((char*)& body.LF, sizeof(body.LF))) return false;
-					if (!stream.read((char*)& body.PR, sizeof(body.PR))) return false;
-					if (!stream.read((char*)& body.VC, sizeof(body.VC))) return false;
-					if (!stream.read((char*)& body.DF, sizeof(body.DF))) return false;
-					if (!stream.read((char*)& body.MT, sizeof(body.MT))) return false;
-					if (!stream.read((char*)& body.CHR, sizeof(body.CHR))) return false;
-					if (!stream.read((char*)& body.KHR, sizeof(body.KHR))) return false;
-					if (!stream.read((char*)& body.SHR, sizeof(body.SHR))) return false;
-					if (!stream.read((char*)& body.AHR, sizeof(body.AHR))) return false;
-
-					if (!stream.read((char*)& body.SRHR_CL, sizeof(body.SRHR_CL))) return false;
-					if (!stream.read((char*)& body.SKHR_CL, sizeof(body.SKHR_CL))) return false;
-					if (!stream.read((char*)& body.SSHR_CL, sizeof(body.SSHR_CL))) return false;
-					if (!stream.read((char*)& body.SR_SPLT_CL, sizeof(body.SR_SPLT_CL))) return false;
-					if (!stream.read((char*)& body.SK_SPLT_CL, sizeof(body.SK_SPLT_CL))) return false;
-					if (!stream.read((char*)& body.SS_SPLT_CL, sizeof(body.SS_SPLT_CL))) return false;
-
-					if (!stream.read((char*)& body.V_IT, sizeof(body.V_IT))) return false;
-					if (!stream.read((char*)& body.P_IT, sizeof(body.P_IT))) return false;
-					if (!stream.read((char*)& body.D_IT, sizeof(body.D_IT))) return false;
-					if (!stream.read((char*)& body.C_IT, sizeof(body.C_IT))) return false;
-
-					if (!stream.read((char*)& body.LST, sizeof(body.LST))) return false;
-					if (!stream.read((char*)& body.AST, sizeof(body.AST))) return false;
-					if (!stream.read((char*)& body.VST, sizeof(body.VST))) return false;
-
-					if (!stream.read((char*)& body.numRigidbody, sizeof(body.numRigidbody))) return false;
+					if (!reader.readName(body.name)) return false;
+					if (!reader.readName(body.nameEng)) return false;
+
+					if (!reader.read((char*)& body.type, sizeof(body.type))) return false;
+
+					if (!reader.read((char*)& body.materialIndex, pmx.header.sizeOfMaterial)) return false;
+
+					if (!reader.read((char*)& body.group, sizeof(body.group))) return false;
+					if (!reader.read((char*)& body.groupMask, sizeof(body.groupMask))) return false;
+
+					if (!reader.read((char*)& body.flag, sizeof(body.flag))) return false;
+
+					if (!reader.read((char*)& body.blinkLength, sizeof(body.blinkLength))) return false;
+					if (!reader.read((char*)& body.numClusters, sizeof(body.numClusters))) return false;
+
+					if (!reader.read((char*)& body.totalMass, sizeof(body.totalMass))) return false;
+					if (!reader.read((char*)& body.collisionMargin, sizeof(body.collisionMargin))) return false;
+
+					if (!reader.read((char*)& body.aeroModel, sizeof(body.aeroModel))) return false;
+
+					if (!reader.read((char*)& body.VCF, sizeof(body.VCF))) return false;
+					if (!reader.read((char*)& body.DP, sizeof(body.DP))) return false;
+					if (!reader.read((char*)& body.DG, sizeof(body.DG))) return false;
+					if (!reader.read((char*)& body.LF, sizeof(body.LF))) return false;
+					if (!reader.read((char*)& body.PR, sizeof(body.PR))) return false;
+					if (!reader.read((char*)& body.VC, sizeof(body.VC))) return false;
+					if (!reader.read((char*)& body.DF, sizeof(body.DF))) return false;
+					if (!reader.read((char*)& body.MT, sizeof(body.MT))) return false;
+					if (!reader.read((char*)& body.CHR, sizeof(body.CHR))) return false;
+					if (!reader.read((char*)& body.KHR, sizeof(body.KHR))) return false;
+					if (!reader.read((char*)& body.SHR, sizeof(body.SHR))) return false;
+					if (!reader.read((char*)& body.AHR, sizeof(body.AHR))) return false;
+
+					if (!reader.read((char*)& body.SRHR_CL, sizeof(body.SRHR_CL))) return false;
+					if (!reader.read((char*)& body.SKHR_CL, sizeof(body.SKHR_CL))) return false;
+					if (!reader.read((char*)& body.SSHR_CL, sizeof(body.SSHR_CL))) return false;
+					if (!reader.read((char*)& body.SR_SPLT_CL, sizeof(body.SR_SPLT_CL))) return false;
+					if (!reader.read((char*)& body.SK_SPLT_CL, sizeof(body.SK_SPLT_CL))) return false;
+					if (!reader.read((char*)& body.SS_SPLT_CL, sizeof(body.SS_SPLT_CL))) return false;
+
+					if (!reader.read((char*)& body.V_IT, sizeof(body.V_IT))) return false;
+					if (!reader.read((char*)& body.P_IT, sizeof(body.P_IT))) return false;
+					if (!reader.read((char*)& body.D_IT, sizeof(body.D_IT))) return false;
+					if (!reader.read((char*)& body.C_IT, sizeof(body.C_IT))) return false;
+
+					if (!reader.read((char*)& body.LST, sizeof(body.LST))) return false;
+					if (!reader.read((char*)& body.AST, sizeof(body.AST))) return false;
+					if (!reader.read((char*)& body.VST, sizeof(body.VST))) return false;
+
+					if (!reader.read((char*)& body.numRigidbody, sizeof(body.numRigidbody))) return false;
 					if (body.numRigidbody > 0)
 					{
 						body.anchorRigidbodies.resize(body.numRigidbody);
 
 						for (auto& ar : body.anchorRigidbodies)
 						{
-							if (!stream.read((char*)& ar.rigidBodyIndex, pmx.header.sizeOfBody)) return false;
-							if (!stream.read((char*)& ar.vertexIndex, sizeof(ar.vertexIndex))) return false;
-							if (!stream.read((char*)& ar.nearMode, sizeof(ar.nearMode))) return false;
+							if (!reader.read((char*)& ar.rigidBodyIndex, pmx.header.sizeOfBody)) return false;
+							if (!reader.read((char*)& ar.vertexIndex, sizeof(ar.vertexIndex))) return false;
+							if (!reader.read((char*)& ar.nearMode, sizeof(ar.nearMode))) return false;
 						}
 					}
 
-					if (!stream.read((char*)& body.numIndices, sizeof(body.numIndices))) return false;
+					if (!reader.read((char*)& body.numIndices, sizeof(body.numIndices))) return false;
 					if (body.numIndices > 0)
 					{
 						body.pinVertexIndices.resize(body.numIndices * pmx.header.sizeOfIndices);
-						if (!stream.read((char*) body.pinVertexIndices.data(), body.numIndices * pmx.header.sizeOfIndices)) return false;
+						if (!reader.read((char*) body.pinVertexIndices.data(), body.numIndices * pmx.header.sizeOfIndices)) return false;
 					}
 				}
 			}
@@ -580,19 +723,39 @@ namespace octoon
 
 	bool PmxLoader::doLoad(std::string_view filepath, Model& model) noexcept
 	{
-		PMX pmx;
-		if (!this->doLoad(filepath, pmx))
-			return false;
+		io::immapstream stream;
+		if (!stream.open(std::string(filepath))) return false;
+
+		std::uint64_t hash = 0;
 
 		auto rootPath = runtime::string::directory(std::string(filepath));
 
+		if (ModelCache::isEnabled())
+		{
+			try
+			{
+				hash = ModelCache::hash(stream.data(), stream.size());
+				if (ModelCache::load(hash, rootPath, model))
+					return true;
+			}
+			catch (...)
+			{
+			}
+		}
+
+		PMX pmx;
+		if (!this->doLoad(stream.data(), stream.size(), pmx))
+			return false;
+
 		std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> cv;
 
+		bool cacheable = true;
+
 		for (auto& it : pmx.materials)
 		{
 			auto material = std::make_shared<MeshStandardMaterial>();
 			if (it.name.length > 0)
-				material->setName(cv.to_bytes(it.name.name));
+				material->setName(toUtf8(cv, it.name.name));
 			else
 				material->setName((char*)u8"δ");
 			material->setColor(math::srgb2linear(math::float3(it.Diffuse.x, it.Diffuse.y, it.Diffuse.z)));
@@ -606,16 +769,20 @@ namespace octoon
 			else if (pmx.header.sizeOfTexture == 4)
 				limits = std::numeric_limits<PmxUInt32>::max();
 
+			limits = std::min<std::uint32_t>(limits, static_cast<std::uint32_t>(pmx.textures.size()));
+
 			try
 			{
 				if (it.TextureIndex < limits)
 				{
-					std::string u8_conv = cv.to_bytes(pmx.textures[it.TextureIndex].name);
+					std::string u8_conv = toUtf8(cv, pmx.textures[it.TextureIndex].name);
 					material->setColorMap(TextureLoader::load(rootPath + "/" + u8_conv));
+					cacheable &= material->getColorMap() != nullptr;
 				}
 			}
 			catch (...)
 			{
+				cacheable = false;
 			}
 
 			bool hasAlphaTexture = it.TextureIndex < limits ? std::wstring_view(pmx.textures[it.TextureIndex].name).find(L".png") != std::string::npos : false;
@@ -681,107 +848,132 @@ namespace octoon
 		mesh->setTexcoordArray(std::move(texcoords_));
 		mesh->setWeightArray(std::move(weights));
 
-		PmxUInt32 startIndices = 0;
-
+		std::vector<std::size_t> startIndices(pmx.materials.size() + 1, 0);
 		for (std::size_t i = 0; i < pmx.materials.size(); i++)
-		{
-			math::uint1s indices_(pmx.materials[i].FaceCount);
-
-			for (std::size_t j = startIndices; j < startIndices + pmx.materials[i].FaceCount; j++)
-			{
-				std::uint32_t index = 0;
-				if (pmx.header.sizeOfIndices == 1)
-					index = *((std::uint8_t*)pmx.indices.data() + j);
-				else if (pmx.header.sizeOfIndices == 2)
-					index = *((std::uint16_t*)pmx.indices.data() + j);
-				else if (pmx.header.sizeOfIndices == 4)
-					index = *((std::uint32_t*)pmx.indices.data() + j);
+			startIndices[i + 1] = std::min<std::size_t>(startIndices[i] + pmx.materials[i].FaceCount, pmx.numIndices);
 
-				indices_[j - startIndices] = index;
-			}
+		std::vector<math::uint1s> indices(pmx.materials.size());
 
-			mesh->setIndicesArray(std::move(indices_), i);
+#		pragma omp parallel for
+		for (std::int32_t i = 0; i < (std::int32_t)pmx.materials.size(); i++)
+		{
+			auto count = startIndices[i + 1] - startIndices[i];
+			indices[i].resize(count);
 
-			startIndices += pmx.materials[i].FaceCount;
+			widenIndices(pmx.indices.data() + startIndices[i] * pmx.header.sizeOfIndices, pmx.header.sizeOfIndices, indices[i].data(), count);
 		}
 
+		for (std::size_t i = 0; i < indices.size(); i++)
+			mesh->setIndicesArray(std::move(indices[i]), i);
+
 		mesh->computeBoundingBox();
 		model.meshes.emplace_back(std::move(mesh));
 
-		for (std::size_t i = 0; i < pmx.bones.size(); i++)
+		std::vector<std::shared_ptr<Bone>> bones(pmx.bones.size());
+		std::vector<std::shared_ptr<IKAttr>> iks(pmx.bones.size());
+
+#		pragma omp parallel
 		{
-			auto& it = pmx.bones[i];
+			std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> conv;
 
-			Bone bone;
-			bone.setName(cv.to_bytes(it.name.name));
-			bone.setPosition(math::float3(it.position.x, it.position.y, it.position.z));
-			bone.setParent(it.Parent);
-			bone.setVisable(it.Visable);
-			bone.setAdditiveParent(it.ProvidedParentBoneIndex);
-			bone.setAdditiveUseLocal(!(it.Flag & PMX_BONE_ADD_LOCAL));
+#			pragma omp for
+			for (std::int32_t i = 0; i < (std::int32_t)pmx.bones.size(); i++)
+			{
+				auto& it = pmx.bones[i];
 
-			if (it.Flag & PMX_BONE_ADD_MOVE)
-				bone.setAdditiveMoveRatio(it.ProvidedRatio);
-			if (it.Flag & PMX_BONE_ADD_ROTATION)
-				bone.setAdditiveRotationRatio(it.ProvidedRatio);
+				auto bone = std::make_shared<Bone>();
+				bone->setName(toUtf8(conv, it.name.name));
+				bone->setPosition(math::float3(it.position.x, it.position.y, it.position.z));
+				bone->setParent(it.Parent);
+				bone->setVisable(it.Visable);
+				bone->setAdditiveParent(it.ProvidedParentBoneIndex);
+				bone->setAdditiveUseLocal(!(it.Flag & PMX_BONE_ADD_LOCAL));
 
-			model.bones.emplace_back(std::make_shared<Bone>(bone));
+				if (it.Flag & PMX_BONE_ADD_MOVE)
+					bone->setAdditiveMoveRatio(it.ProvidedRatio);
+				if (it.Flag & PMX_BONE_ADD_ROTATION)
+					bone->setAdditiveRotationRatio(it.ProvidedRatio);
 
-			if (it.Flag & PMX_BONE_IK)
-			{
-				IKAttr attr;
-				attr.boneIndex = static_cast<uint16_t>(i);
-				attr.targetBoneIndex = it.IKTargetBoneIndex;
-				attr.chainLength = it.IKLinkCount;
-				attr.iterations = it.IKLoopCount;
+				bones[i] = std::move(bone);
 
-				for (auto& ik : it.IKList)
+				if (it.Flag & PMX_BONE_IK)
 				{
-					IKChild child;
-					child.boneIndex = ik.BoneIndex;
-					child.angleRadian = it.IKLimitedRadian;
-					child.minimumRadian.set(ik.minimumRadian.x, ik.minimumRadian.y, ik.minimumRadian.z);
-					child.maximumRadian.set(ik.maximumRadian.x, ik.maximumRadian.y, ik.maximumRadian.z);
-					child.rotateLimited = ik.rotateLimited;
-
-					attr.child.push_back(child);
-				}
+					auto attr = std::make_shared<IKAttr>();
+					attr->boneIndex = static_cast<uint16_t>(i);
+					attr->targetBoneIndex = it.IKTargetBoneIndex;
+					attr->chainLength = it.IKLinkCount;
+					attr->iterations = it.IKLoopCount;
+
+					for (auto& ik : it.IKList)
+					{
+						IKChild child;
+						child.boneIndex = ik.BoneIndex;
+						child.angleRadian = it.IKLimitedRadian;
+						child.minimumRadian.set(ik.minimumRadian.x, ik.minimumRadian.y, ik.minimumRadian.z);
+						child.maximumRadian.set(ik.maximumRadian.x, ik.maximumRadian.y, ik.maximumRadian.z);
+						child.rotateLimited = ik.rotateLimited;
+
+						attr->child.push_back(child);
+					}
 
-				model.iks.emplace_back(std::make_shared<IKAttr>(attr));
+					iks[i] = std::move(attr);
+				}
 			}
 		}
 
-		for (auto& it : pmx.morphs)
+		for (std::size_t i = 0; i < bones.size(); i++)
 		{
-			switch (it.morphType)
-			{
-			case PmxMorphType::PMX_MorphTypeVertex:
+			model.bones.emplace_back(std::move(bones[i]));
+			if (iks[i])
+				model.iks.emplace_back(std::move(iks[i]));
+		}
+
+		std::vector<std::shared_ptr<Morph>> morphs(pmx.morphs.size());
+
+#		pragma omp parallel
+		{
+			std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> conv;
+
+#			pragma omp for
+			for (std::int32_t i = 0; i < (std::int32_t)pmx.morphs.size(); i++)
 			{
-				auto morph = std::make_shared<Morph>();
-				morph->name = cv.to_bytes(it.name.name);
-				morph->morphType = it.morphType;
-				morph->control = it.control;
-				morph->morphCount = it.morphCount;
-				morph->vertices.reserve(it.vertices.size());
-
-				for (auto& v : it.vertices)
+				auto& it = pmx.morphs[i];
+
+				switch (it.morphType)
 				{
-					MorphVertex vertex;
-					vertex.index = v.index;
-					vertex.offset.set(v.offset.x, v.offset.y, v.offset.z);
-					morph->vertices.push_back(vertex);
-				}
+				case PmxMorphType::PMX_MorphTypeVertex:
+				{
+					auto morph = std::make_shared<Morph>();
+					morph->name = toUtf8(conv, it.name.name);
+					morph->morphType = it.morphType;
+					morph->control = it.control;
+					morph->morphCount = it.morphCount;
+					morph->vertices.resize(it.vertices.size());
+
+					for (std::size_t j = 0; j < it.vertices.size(); j++)
+					{
+						auto& v = it.vertices[j];
+						morph->vertices[j].index = v.index;
+						morph->vertices[j].offset.set(v.offset.x, v.offset.y, v.offset.z);
+					}
 
-				model.morphs.emplace_back(morph);
-			}
-			break;
+					morphs[i] = std::move(morph);
+				}
+				break;
+				}
 			}
 		}
 
+		for (auto& morph : morphs)
+		{
+			if (morph)
+				model.morphs.emplace_back(std::move(morph));
+		}
+
 		for (auto& it : pmx.rigidbodies)
 		{
 			auto body = std::make_shared<Rigidbody>();
-			body->name = cv.to_bytes(it.name.name);
+			body->name = toUtf8(cv, it.name.name);
 			body->bone = it.bone;
 			body->group = it.group;
 			body->groupMask = it.groupMask;
@@ -805,7 +997,7 @@ namespace octoon
 		for (auto& it : pmx.joints)
 		{
 			auto joint = std::make_shared<Joint>();
-			joint->name = cv.to_bytes(it.name.name);
+			joint->name = toUtf8(cv, it.name.name);
 			joint->type = it.type;
 			joint->bodyIndexA = it.relatedRigidBodyIndexA;
 			joint->bodyIndexB = it.relatedRigidBodyIndexB;
@@ -824,7 +1016,7 @@ namespace octoon
 		for (auto& it : pmx.softbodies)
 		{
 			auto softbody = std::make_shared<Softbody>();
-			softbody->name = cv.to_bytes(it.name.name);
+			softbody->name = toUtf8(cv, it.name.name);
 			softbody->materialIndex = it.materialIndex;
 			softbody->group = it.group;
 			softbody->groupMask = it.groupMask;
@@ -855,6 +1047,17 @@ namespace octoon
 			model.softbodies.emplace_back(std::move(softbody));
 		}
 
+		if (ModelCache::isEnabled() && cacheable)
+		{
+			try
+			{
+				ModelCache::save(hash, rootPath, model);
+			}
+			catch (...)
+			{
+			}
+		}
+
 		return true;
 	}
 
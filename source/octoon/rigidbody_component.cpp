@@ -24,6 +24,9 @@ namespace octoon
 		, enableCCD_(false)
 		, position_(math::float3::Zero)
 		, rotation_(math::Quaternion::Zero)
+		, lastPosition_(math::float3::Zero)
+		, lastRotation_(math::Quaternion::Zero)
+		, fetchCount_(0)
     {
     }
 
@@ -46,6 +49,8 @@ namespace octoon
 	{
 		if (position_ != position)
 		{
+			this->waitSimulate();
+
 			if (rigidbody_)
 				rigidbody_->setPosition(position);
 
@@ -58,6 +63,8 @@ namespace octoon
 	{
 		if (rotation_ != quat)
 		{
+			this->waitSimulate();
+
 			if (rigidbody_)
 				rigidbody_->setRotation(quat);
 
@@ -70,6 +77,8 @@ namespace octoon
 	{
 		if (position_ != position || rotation_ != quat)
 		{
+			this->waitSimulate();
+
 			if (rigidbody_)
 				rigidbody_->setPositionAndRotation(position_, rotation_);
 			
@@ -81,6 +90,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setGroupMask(std::uint16_t groupMask) noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setGroupMask(groupMask);
 		groupMask_ = groupMask;
@@ -89,6 +100,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setSleepThreshold(float threshold) noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setSleepThreshold(threshold);
 		sleepThreshold_ = threshold;
@@ -99,6 +112,8 @@ namespace octoon
 	{
 		assert(!enable || enable && !isKinematic_);
 
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setEnableCCD(enable);
 		enableCCD_ = enable;
@@ -107,6 +122,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setSolverIterationCounts(std::uint32_t minPositionIters, std::uint32_t minVelocityIters) noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setSolverIterationCounts(minPositionIters, minVelocityIters);
 		minPositionIters_ = minPositionIters;
@@ -130,6 +147,8 @@ namespace octoon
 	{
 		if (mass_ != mass)
 		{
+			this->waitSimulate();
+
 			if (rigidbody_)
 				rigidbody_->setMass(mass);
 
@@ -148,6 +167,8 @@ namespace octoon
 	{
 		if (isKinematic_ != isKinematic)
 		{
+			this->waitSimulate();
+
 			if (rigidbody_)
 			{
 				rigidbody_->setKinematic(isKinematic);
@@ -163,6 +184,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setDynamicFriction(float dynamicFriction)
 	{
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setDynamicFriction(dynamicFriction);
 		dynamicFriction_ = dynamicFriction;
@@ -171,6 +194,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setStaticFriction(float staticFriction)
 	{
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setStaticFriction(staticFriction);
 		staticFriction_ = staticFriction;
@@ -179,6 +204,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setRestitution(float restitution)
 	{
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setRestitution(restitution);
 		restitution_ = restitution;
@@ -187,6 +214,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setLinearDamping(float value) noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_ && !isKinematic_)
 			rigidbody_->setLinearDamping(value);
 		linearDamping_ = value;
@@ -195,6 +224,8 @@ namespace octoon
 	void
 	RigidbodyComponent::setAngularDamping(float value) noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_ && !isKinematic_)
 			rigidbody_->setAngularDamping(value);
 		angularDamping_ = value;
@@ -269,6 +300,8 @@ namespace octoon
 	void
 	RigidbodyComponent::wakeUp() noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_ && !isKinematic_)
 			rigidbody_->wakeUp();
 	}
@@ -288,6 +321,8 @@ namespace octoon
 	void
 	RigidbodyComponent::clearForce() noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_ && !isKinematic_)
 			rigidbody_->clearForce();
 	}
@@ -295,6 +330,8 @@ namespace octoon
 	void
 	RigidbodyComponent::clearTorque() noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_ && !isKinematic_)
 			rigidbody_->clearTorque();
 	}
@@ -320,6 +357,7 @@ namespace octoon
 	RigidbodyComponent::onActivate() except
     {
 		this->addComponentDispatch(GameDispatchType::MoveAfter);
+		this->addComponentDispatch(GameDispatchType::LateUpdate);
 
 		auto collider = this->getComponent<ColliderComponent>();
 		if (collider)
@@ -330,6 +368,7 @@ namespace octoon
 	RigidbodyComponent::onDeactivate() noexcept
     {
 		this->removeComponentDispatch(GameDispatchType::MoveAfter);
+		this->removeComponentDispatch(GameDispatchType::LateUpdate);
 
 		if (rigidbody_)
 		{
@@ -359,14 +398,19 @@ namespace octoon
 		if (component->isA<ColliderComponent>())
 		{
 			auto collider = component->downcast_pointer<ColliderComponent>();
-			if (collider)
+			if (collider && rigidbody_)
+			{
+				this->waitSimulate();
 				rigidbody_->detachShape(collider->getShape());
+			}
 		}
     }
 
 	void
 	RigidbodyComponent::onLayerChangeAfter() noexcept
 	{
+		this->waitSimulate();
+
 		if (rigidbody_)
 			rigidbody_->setGroup(this->getGameObject()->getLayer());
 	}
@@ -374,6 +418,7 @@ namespace octoon
 	void 
 	RigidbodyComponent::onMoveAfter() noexcept
 	{
+		// Dynamic bodies are only moved here by their own results, kinematic ones are driven by the transform.
 		if (rigidbody_ && isKinematic_)
 		{
 			auto transform = this->getComponent<TransformComponent>();
@@ -381,7 +426,11 @@ namespace octoon
 			position_ = transform->getTranslate();
 			rotation_ = transform->getQuaternion();
 
-			rigidbody_->setPositionAndRotation(position_, rotation_);
+			auto physicsFeature = this->tryGetFeature<PhysicsFeature>();
+			if (physicsFeature)
+				physicsFeature->setKinematicPose(rigidbody_, position_, rotation_);
+			else
+				rigidbody_->setPositionAndRotation(position_, rotation_);
 		}
 	}
 
@@ -393,10 +442,56 @@ namespace octoon
 			auto transform = this->getComponent<TransformComponent>();
 			if (transform)
 			{
-				this->position_ = rigidbody_->getPosition();
-				this->rotation_ = rigidbody_->getRotation();
-				
-				transform->setTransform(this->position_, this->rotation_);
+				auto physicsFeature = this->tryGetFeature<PhysicsFeature>();
+				if (physicsFeature && physicsFeature->getEnableInterpolation())
+				{
+					this->lastPosition_ = this->position_;
+					this->lastRotation_ = this->rotation_;
+					this->fetchCount_ = physicsFeature->getSimulateCount();
+
+					this->position_ = rigidbody_->getPosition();
+					this->rotation_ = rigidbody_->getRotation();
+				}
+				else
+				{
+					this->position_ = rigidbody_->getPosition();
+					this->rotation_ = rigidbody_->getRotation();
+
+					transform->setTransform(this->position_, this->rotation_);
+				}
+			}
+		}
+	}
+
+	void
+	RigidbodyComponent::onLateUpdate() noexcept
+	{
+		if (rigidbody_ && !isKinematic_)
+		{
+			auto physicsFeature = this->tryGetFeature<PhysicsFeature>();
+
+			// An asynchronous step only overlaps the update, its results are needed from here on.
+			if (physicsFeature)
+				physicsFeature->fetchResults();
+
+			if (physicsFeature && physicsFeature->getEnableInterpolation())
+			{
+				auto transform = this->getComponent<TransformComponent>();
+				if (transform)
+				{
+					if (this->fetchCount_ != physicsFeature->getSimulateCount())
+					{
+						this->lastPosition_ = this->position_;
+						this->lastRotation_ = this->rotation_;
+						this->fetchCount_ = physicsFeature->getSimulateCount();
+					}
+
+					auto alpha = physicsFeature->getInterpolationFactor();
+					auto position = math::lerp(this->lastPosition_, this->position_, alpha);
+					auto rotation = math::slerp(this->lastRotation_, this->rotation_, alpha);
+
+					transform->setTransform(position, rotation);
+				}
 			}
 		}
 	}
@@ -414,6 +509,9 @@ namespace octoon
 			desc.type = isKinematic_ ? PhysicsRigidbodyType::Static : PhysicsRigidbodyType::Dynamic;
 			desc.position = position_ = transform->getTranslate();
 			desc.rotation = rotation_ = transform->getQuaternion();
+
+			lastPosition_ = position_;
+			lastRotation_ = rotation_;
 			desc.mass = mass_;
 
 			rigidbody_ = physicsFeature->getContext()->createRigidbody(desc);
@@ -443,4 +541,15 @@ namespace octoon
 			}
 		}
 	}
+
+	void
+	RigidbodyComponent::waitSimulate() noexcept
+	{
+		if (rigidbody_)
+		{
+			auto physicsFeature = this->tryGetFeature<PhysicsFeature>();
+			if (physicsFeature)
+				physicsFeature->waitSimulate();
+		}
+	}
 }
\ No newline at end of file
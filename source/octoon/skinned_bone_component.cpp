@@ -98,29 +98,28 @@ namespace octoon
 	SkinnedBoneComponent::onActivate() noexcept
 	{
 		if (!this->getName().empty())
-			this->addMessageListener(this->getName(), std::bind(&SkinnedBoneComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->addEventListener<&SkinnedBoneComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 	}
 
 	void
 	SkinnedBoneComponent::onDeactivate() noexcept
 	{
 		if (!this->getName().empty())
-			this->removeMessageListener(this->getName(), std::bind(&SkinnedBoneComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->removeEventListener<&SkinnedBoneComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 	}
 
 	void
-	SkinnedBoneComponent::onAnimationUpdate(const std::any& value) noexcept
+	SkinnedBoneComponent::onAnimationUpdate(float value) noexcept
 	{
-		assert(value.type() == typeid(float));
-		this->setControl(std::any_cast<float>(value));
+		this->setControl(value);
 	}
 
 	void
 	SkinnedBoneComponent::onTargetReplace(std::string_view name) noexcept
 	{
 		if (!this->getName().empty())
-			this->removeMessageListener(this->getName(), std::bind(&SkinnedBoneComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->removeEventListener<&SkinnedBoneComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 		if (!name.empty())
-			this->addMessageListener(name, std::bind(&SkinnedBoneComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->addEventListener<&SkinnedBoneComponent::onAnimationUpdate>(makeControlEvent(name), this);
 	}
 }
\ No newline at end of file
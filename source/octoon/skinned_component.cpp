@@ -34,7 +34,7 @@ namespace octoon
 	{
 		if (control_ != control)
 		{
-			this->sendMessage("octoon:animation:update");
+			this->sendEvent(AnimationUpdateEvent);
 			control_ = control;
 		}
 	}
@@ -1,4 +1,5 @@
 #include <octoon/skinned_joint_renderer_component.h>
+#include <octoon/skinned_component.h>
 #include <octoon/transform_component.h>
 
 namespace octoon
@@ -59,7 +60,7 @@ namespace octoon
 	SkinnedJointRendererComponent::onActivate() noexcept
 	{
 		this->addComponentDispatch(GameDispatchType::FixedUpdate);
-		this->addMessageListener("octoon:animation:update", std::bind(&SkinnedJointRendererComponent::onAnimationUpdate, this, std::placeholders::_1));
+		this->addEventListener<&SkinnedJointRendererComponent::onAnimationUpdate>(SkinnedComponent::AnimationUpdateEvent, this);
 		MeshRendererComponent::onActivate();
 	}
 
@@ -67,7 +68,7 @@ namespace octoon
 	SkinnedJointRendererComponent::onDeactivate() noexcept
 	{
 		this->removeComponentDispatch(GameDispatchType::FixedUpdate);
-		this->removeMessageListener("octoon:animation:update", std::bind(&SkinnedJointRendererComponent::onAnimationUpdate, this, std::placeholders::_1));
+		this->removeEventListener<&SkinnedJointRendererComponent::onAnimationUpdate>(SkinnedComponent::AnimationUpdateEvent, this);
 		MeshRendererComponent::onDeactivate();
 	}
 
@@ -78,7 +79,7 @@ namespace octoon
 	}
 
 	void
-	SkinnedJointRendererComponent::onAnimationUpdate(const std::any& data) noexcept
+	SkinnedJointRendererComponent::onAnimationUpdate() noexcept
 	{
 		this->needUpdate_ = true;
 	}
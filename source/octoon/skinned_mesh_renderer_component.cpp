@@ -2,6 +2,7 @@
 #include <octoon/skinned_morph_component.h>
 #include <octoon/skinned_texture_component.h>
 #include <octoon/transform_component.h>
+#include <octoon/math/simd.h>
 #include <omp.h>
 
 namespace octoon
@@ -186,7 +187,7 @@ namespace octoon
 	SkinnedMeshRendererComponent::onActivate() noexcept
 	{
 		this->addComponentDispatch(GameDispatchType::FixedUpdate);
-		this->addMessageListener("octoon:animation:update", std::bind(&SkinnedMeshRendererComponent::onAnimationUpdate, this, std::placeholders::_1));
+		this->addEventListener<&SkinnedMeshRendererComponent::onAnimationUpdate>(SkinnedComponent::AnimationUpdateEvent, this);
 		MeshRendererComponent::onActivate();
 	}
 
@@ -196,7 +197,7 @@ namespace octoon
 		mesh_.reset();
 		skinnedMesh_.reset();
 		this->removeComponentDispatch(GameDispatchType::FixedUpdate);
-		this->removeMessageListener("octoon:animation:update", std::bind(&SkinnedMeshRendererComponent::onAnimationUpdate, this, std::placeholders::_1));
+		this->removeEventListener<&SkinnedMeshRendererComponent::onAnimationUpdate>(SkinnedComponent::AnimationUpdateEvent, this);
 		MeshRendererComponent::onDeactivate();
 	}
 
@@ -220,7 +221,7 @@ namespace octoon
 	}
 
 	void
-	SkinnedMeshRendererComponent::onAnimationUpdate(const std::any& mesh) noexcept
+	SkinnedMeshRendererComponent::onAnimationUpdate() noexcept
 	{
 		if (automaticUpdate_) needUpdate_ = true;
 	}
@@ -284,7 +285,7 @@ namespace octoon
 		{
 			auto transform = transforms_[i]->getComponent<TransformComponent>();
 			quaternions_[i] = transform->getQuaternion();
-			joints_[i] = math::transformMultiply(transform->getTransform(), bindposes[i]);
+			joints_[i] = math::simd::transformMultiply(transform->getTransform(), bindposes[i]);
 		}
 
 		for (std::size_t i = boneSize; i < joints_.size(); ++i)
@@ -327,8 +328,8 @@ namespace octoon
 				auto w = blend.weights[j];
 				if (w == 0.0f)
 					break;
-				v += (joints_[blend.bones[j]] * vertices[i]) * w;
-				n += ((math::float3x3)joints_[blend.bones[j]] * normals[i]) * w;
+				v += math::simd::transformPoint(joints_[blend.bones[j]], vertices[i]) * w;
+				n += math::simd::transformNormal(joints_[blend.bones[j]], normals[i]) * w;
 			}
 
 			vertices[i] = v;
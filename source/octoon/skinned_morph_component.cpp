@@ -77,29 +77,31 @@ namespace octoon
 	SkinnedMorphComponent::onActivate() noexcept
 	{
 		if (!this->getName().empty())
-			this->addMessageListener(this->getName(), std::bind(&SkinnedMorphComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->addEventListener<&SkinnedMorphComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 	}
 
 	void
 	SkinnedMorphComponent::onDeactivate() noexcept
 	{
 		if (!this->getName().empty())
-			this->removeMessageListener(this->getName(), std::bind(&SkinnedMorphComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->removeEventListener<&SkinnedMorphComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 	}
 
 	void
-	SkinnedMorphComponent::onAnimationUpdate(const std::any& value) noexcept
+	SkinnedMorphComponent::onAnimationUpdate(float value) noexcept
 	{
-		assert(value.type() == typeid(float));
-		this->setControl(std::any_cast<float>(value));
+		this->setControl(value);
 	}
 
 	void
 	SkinnedMorphComponent::onTargetReplace(std::string_view name) noexcept
 	{
-		if (!this->getName().empty())
-			this->tryRemoveMessageListener(this->getName(), std::bind(&SkinnedMorphComponent::onAnimationUpdate, this, std::placeholders::_1));
-		if (!name.empty())
-			this->tryAddMessageListener(name, std::bind(&SkinnedMorphComponent::onAnimationUpdate, this, std::placeholders::_1));
+		if (this->getGameObject())
+		{
+			if (!this->getName().empty())
+				this->removeEventListener<&SkinnedMorphComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
+			if (!name.empty())
+				this->addEventListener<&SkinnedMorphComponent::onAnimationUpdate>(makeControlEvent(name), this);
+		}
 	}
 }
\ No newline at end of file
@@ -77,29 +77,28 @@ namespace octoon
 	SkinnedTextureComponent::onActivate() noexcept
 	{
 		if (!this->getName().empty())
-			this->addMessageListener(this->getName(), std::bind(&SkinnedTextureComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->addEventListener<&SkinnedTextureComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 	}
 
 	void
 	SkinnedTextureComponent::onDeactivate() noexcept
 	{
 		if (!this->getName().empty())
-			this->removeMessageListener(this->getName(), std::bind(&SkinnedTextureComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->removeEventListener<&SkinnedTextureComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 	}
 
 	void
-	SkinnedTextureComponent::onAnimationUpdate(const std::any& value) noexcept
+	SkinnedTextureComponent::onAnimationUpdate(float value) noexcept
 	{
-		assert(value.type() == typeid(float));
-		this->setControl(std::any_cast<float>(value));
+		this->setControl(value);
 	}
 
 	void
 	SkinnedTextureComponent::onTargetReplace(std::string_view name) noexcept
 	{
 		if (!this->getName().empty())
-			this->removeMessageListener(this->getName(), std::bind(&SkinnedTextureComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->removeEventListener<&SkinnedTextureComponent::onAnimationUpdate>(makeControlEvent(this->getName()), this);
 		if (!name.empty())
-			this->addMessageListener(name, std::bind(&SkinnedTextureComponent::onAnimationUpdate, this, std::placeholders::_1));
+			this->addEventListener<&SkinnedTextureComponent::onAnimationUpdate>(makeControlEvent(name), this);
 	}
 }
\ No newline at end of file
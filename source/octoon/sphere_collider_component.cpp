@@ -47,6 +47,8 @@ namespace octoon
     void
 	SphereColliderComponent::setRadius(float radius) noexcept
     {
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setRadius(radius);
 		this->radius_ = radius;
@@ -57,6 +59,8 @@ namespace octoon
 	{
 		if (this->center_ != center)
 		{
+			this->waitSimulate();
+
 			if (shape_)
 				shape_->setCenter(center);
 
@@ -70,6 +74,8 @@ namespace octoon
 	{
 		if (this->rotation_ != rotation)
 		{
+			this->waitSimulate();
+
 			if (shape_)
 				shape_->setQuaternion(rotation);
 
@@ -81,6 +87,8 @@ namespace octoon
 	void
 	SphereColliderComponent::setContactOffset(float offset) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setContactOffset(offset);
 		this->contactOffset_ = shape_->getContactOffset();
@@ -89,6 +97,8 @@ namespace octoon
 	void
 	SphereColliderComponent::setRestOffset(float offset) noexcept
 	{
+		this->waitSimulate();
+
 		if (shape_)
 			shape_->setRestOffset(offset);
 		this->restOffset_ = shape_->getRestOffset();
@@ -176,6 +186,8 @@ namespace octoon
     void
 	SphereColliderComponent::onDeactivate() noexcept
     {
+		this->waitSimulate();
+
 		shape_.reset();
 		shape_ = nullptr;
     }
@@ -166,10 +166,10 @@ namespace octoon
 
 		if (is_ok)
 		{
-			if (meshing_)
-				mesh_ = std::make_shared<Mesh>(makeMesh(font::makeTextContours(u16str, *meshing_, 8, align_), 0.0f, false));
-			else
-				mesh_ = std::make_shared<Mesh>(makeMesh(font::makeTextContours(u16str, { "../../system/fonts/DroidSansFallback.ttf", 24 }, 8, align_), 0.0f, false));
+			if (!meshing_ && !defaultMeshing_)
+				defaultMeshing_ = std::make_shared<font::TextMeshing>("../../system/fonts/DroidSansFallback.ttf", 24);
+
+			mesh_ = std::make_shared<Mesh>(font::makeText(u16str, meshing_ ? *meshing_ : *defaultMeshing_, 0.0f, 8, align_));
 		}
 		else
 		{
@@ -8,19 +8,19 @@
 
 namespace octoon
 {
-	std::map<std::string, hal::GraphicsTexturePtr, std::less<>> textureCaches_;
+	std::map<std::pair<std::string, bool>, hal::GraphicsTexturePtr> textureCaches_;
 
 	hal::GraphicsTexturePtr
 	TextureLoader::load(std::string_view filepath, bool generateMipmap, bool cache) noexcept(false)
 	{
 		assert(!filepath.empty());
 
-		auto it = textureCaches_.find(filepath);
+		std::string path = std::string(filepath);
+
+		auto it = textureCaches_.find(std::make_pair(path, generateMipmap));
 		if (it != textureCaches_.end())
 			return (*it).second;
 
-		std::string path = std::string(filepath);
-
 		Image image;
 		if (!image.load(path))
 			throw runtime::runtime_error::create("Failed to open file :" + path);
@@ -95,7 +95,7 @@ namespace octoon
 			Renderer::instance()->getScriptableRenderContext()->generateMipmap(texture);
 
 		if (cache)
-			textureCaches_[path] = texture;
+			textureCaches_[std::make_pair(path, generateMipmap)] = texture;
 
 		return texture;
 	}
@@ -64,6 +64,12 @@ namespace octoon
 		return timeStep_;
 	}
 
+	float
+	TimerFeature::fixedAlpha() const noexcept
+	{
+		return timeStep_ > 0.0f ? math::clamp(time_ / timeStep_, 0.0f, 1.0f) : 0.0f;
+	}
+
 	float
 	TimerFeature::elapsed() const noexcept
 	{
@@ -109,7 +115,7 @@ namespace octoon
 
 		while (time_ > timeStep_)
 		{
-			this->sendMessage("feature:timer:fixed", timeStep_);
+			this->sendEvent(FixedUpdateEvent, timeStep_);
 			time_  -= timeStep_;
 		}
 	}
@@ -171,6 +171,24 @@ namespace octoon
 		return Renderer::instance()->readNormalBuffer(data);
 	}
 
+	bool
+	VideoFeature::readColorBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return Renderer::instance()->readColorBufferAsync(format, std::move(callback));
+	}
+
+	bool
+	VideoFeature::readAlbedoBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return Renderer::instance()->readAlbedoBufferAsync(format, std::move(callback));
+	}
+
+	bool
+	VideoFeature::readNormalBufferAsync(hal::GraphicsFormat format, ReadbackCallback callback)
+	{
+		return Renderer::instance()->readNormalBufferAsync(format, std::move(callback));
+	}
+
 	void
 	VideoFeature::onActivate() except
 	{